@@ -0,0 +1,206 @@
+// Standard C++ includes
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <variant>
+#include <vector>
+
+// Standard C includes
+#include <cstdlib>
+
+// Mini-parse includes
+#include "arena.h"
+#include "bytecode.h"
+#include "interpreter.h"
+#include "parser.h"
+#include "scanner.h"
+#include "symbol_table.h"
+#include "type.h"
+#include "type_checker.h"
+#include "virtual_machine.h"
+
+// Benchmark includes
+#include "common.h"
+
+using namespace MiniParse;
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+//! Minimum speedup of the virtual machine over the interpreter
+constexpr double minSpeedup = 10.0;
+
+//! Leaky integrate-and-fire neuron update, starting in its refractory period
+const std::string test2(
+    "if ($(RefracTime) <= 0.0) {\n"
+    "  double alpha = (($(Isyn) + $(Ioffset)) * $(Rmembrane)) + $(Vrest);\n"
+    "  $(V) = alpha - ($(ExpTC) * (alpha - $(V)));\n"
+    "}\n"
+    "else {\n"
+    "  $(RefracTime) -= DT;\n"
+    "}\n");
+
+//! Hodgkin-Huxley neuron update, integrated with 25 substeps
+const std::string test3(
+    "double Imem;\n"
+    "unsigned int mt;\n"
+    "double mdt= DT/25.0;\n"
+    "for (mt=0; mt < 25; mt++) {\n"
+    "   Imem= -($(m)*$(m)*$(m)*$(h)*$(gNa)*($(V)-($(ENa)))+\n"
+    "       $(n)*$(n)*$(n)*$(n)*$(gK)*($(V)-($(EK)))+\n"
+    "       $(gl)*($(V)-($(El)))-$(Isyn));\n"
+    "   double a;\n"
+    "   if ($(V) == -52.0) {\n"
+    "       a= 1.28;\n"
+    "   }\n"
+    "   else {\n"
+    "       a= 0.32*(-52.0-$(V))/(exp((-52.0-$(V))/4.0)-1.0);\n"
+    "   }\n"
+    "   double b;\n"
+    "   if ($(V) == -25.0) {\n"
+    "       b= 1.4;\n"
+    "   }\n"
+    "   else {\n"
+    "       b= 0.28*($(V)+25.0)/(exp(($(V)+25.0)/5.0)-1.0);\n"
+    "   }\n"
+    "   $(m)+= (a*(1.0-$(m))-b*$(m))*mdt;\n"
+    "   a= 0.128*exp((-48.0-$(V))/18.0);\n"
+    "   b= 4.0 / (exp((-25.0-$(V))/5.0)+1.0);\n"
+    "   $(h)+= (a*(1.0-$(h))-b*$(h))*mdt;\n"
+    "   if ($(V) == -50.0) {\n"
+    "       a= 0.16;\n"
+    "   }\n"
+    "   else {\n"
+    "       a= 0.032*(-50.0-$(V))/(exp((-50.0-$(V))/5.0)-1.0);\n"
+    "   }\n"
+    "   b= 0.5*exp((-55.0-$(V))/40.0);\n"
+    "   $(n)+= (a*(1.0-$(n))-b*$(n))*mdt;\n"
+    "   $(V)+= Imem/$(C)*mdt;\n"
+    "}\n");
+
+//! Name and initial value of snippet variable
+struct Variable
+{
+    std::string name;
+    double value;
+    bool isConst;
+};
+
+//---------------------------------------------------------------------------
+//! Run snippet numRuns times with the interpreter and with the virtual machine, starting from the same
+//! values of variables each time. Check both give the same final values and that the virtual machine is fast enough
+void run(const std::string &name, const std::string &source, const std::vector<Variable> &variables, size_t numRuns)
+{
+    Bench::ErrorHandler errorHandler;
+    SymbolTable symbolTable;
+    Arena arena;
+    const auto tokens = Scanner::scanSource(source, symbolTable, errorHandler);
+    const auto statements = Parser::parseBlockItemList(tokens, errorHandler, arena);
+
+    TypeChecker::Environment typeEnvironment(symbolTable);
+    typeEnvironment.define<Type::Exp>("exp");
+    for(const auto &v : variables) {
+        typeEnvironment.define<Type::Double>(v.name, v.isConst);
+    }
+    const auto resolution = TypeChecker::typeCheck(statements, typeEnvironment, errorHandler);
+
+    auto makeToken = [&symbolTable](const std::string &name)
+    {
+        return Token(Token::Type::IDENTIFIER, name, 0, Token::LiteralValue(), symbolTable.intern(name));
+    };
+
+    // Interpret snippet with a fresh environment for its declarations each run, enclosed by one holding variables
+    Bench::Exp exp;
+    std::vector<double> interpreterValues;
+    const double interpreterTime = Bench::timeBest(5,
+        [&]()
+        {
+            Interpreter::Environment globals(symbolTable);
+            globals.define("exp", exp);
+            for(const auto &v : variables) {
+                globals.define(makeToken(v.name), v.value);
+            }
+
+            for(size_t r = 0; r < numRuns; r++) {
+                Interpreter::Environment environment(&globals);
+                Interpreter::interpret(statements, environment, resolution);
+            }
+
+            interpreterValues.clear();
+            for(const auto &v : variables) {
+                interpreterValues.push_back(std::get<double>(std::get<Token::LiteralValue>(globals.get(makeToken(v.name)))));
+            }
+        });
+
+    // Execute bytecode with variables bound to external registers
+    const auto program = Bytecode::compile(statements, resolution);
+    std::vector<double> virtualMachineValues;
+    const double virtualMachineTime = Bench::timeBest(5,
+        [&]()
+        {
+            Bytecode::VirtualMachine virtualMachine(program);
+            for(const auto &v : variables) {
+                const auto reg = program.getExternalRegister(v.name);
+                if(reg) {
+                    virtualMachine.getRegister(*reg).f64 = v.value;
+                }
+            }
+
+            for(size_t r = 0; r < numRuns; r++) {
+                virtualMachine.execute();
+            }
+
+            virtualMachineValues.clear();
+            for(const auto &v : variables) {
+                const auto reg = program.getExternalRegister(v.name);
+                virtualMachineValues.push_back(reg ? virtualMachine.getRegister(*reg).f64 : v.value);
+            }
+        });
+
+    for(size_t i = 0; i < variables.size(); i++) {
+        if(interpreterValues[i] != virtualMachineValues[i]) {
+            throw std::runtime_error(name + ": " + variables[i].name + " is " + std::to_string(virtualMachineValues[i])
+                                     + " after virtual machine rather than " + std::to_string(interpreterValues[i]));
+        }
+    }
+
+    const double speedup = interpreterTime / virtualMachineTime;
+    std::cout << name << ":" << std::endl;
+    std::cout << "\tinterpreter: " << (interpreterTime * 1.0E9) / numRuns << " ns/run" << std::endl;
+    std::cout << "\tvirtual machine: " << (virtualMachineTime * 1.0E9) / numRuns << " ns/run" << std::endl;
+    std::cout << "\tspeedup: " << speedup << "x" << std::endl;
+    if(speedup < minSpeedup) {
+        throw std::runtime_error(name + ": virtual machine is less than " + std::to_string(minSpeedup)
+                                 + "x faster than interpreter");
+    }
+}
+}
+
+//---------------------------------------------------------------------------
+// Entry point
+//---------------------------------------------------------------------------
+//! Compare the time taken to run the test2 and test3 snippets from main.cc with Interpreter::interpret and
+//! after compiling them to bytecode with Bytecode::VirtualMachine. Both must give the same results and the
+//! virtual machine must be at least 10x faster
+int main()
+{
+    try
+    {
+        run("test2", test2,
+            {{"DT", 0.1, true}, {"Isyn", 0.5, true}, {"Ioffset", 0.2, true}, {"Rmembrane", 20.0, true},
+             {"Vrest", -65.0, true}, {"ExpTC", 0.995, true}, {"RefracTime", 2.0, false}, {"V", -60.0, false}},
+            20000);
+        run("test3", test3,
+            {{"DT", 0.1, true}, {"gNa", 7.15, true}, {"ENa", 50.0, true}, {"gK", 1.43, true}, {"EK", -95.0, true},
+             {"gl", 0.02672, true}, {"El", -63.563, true}, {"C", 0.143, true}, {"Isyn", 0.5, true},
+             {"V", -60.0, false}, {"m", 0.0529, false}, {"h", 0.3176, false}, {"n", 0.5961, false}},
+            200);
+    }
+    catch(const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
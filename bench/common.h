@@ -0,0 +1,106 @@
+#pragma once
+
+// Standard C++ includes
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+// Standard C includes
+#include <cmath>
+
+// Mini-parse includes
+#include "error_handler.h"
+#include "interpreter.h"
+#include "utils.h"
+
+//---------------------------------------------------------------------------
+// Bench::ErrorHandler
+//---------------------------------------------------------------------------
+//! Error handler which throws on the first error as benchmarks should only be run on valid input
+namespace Bench
+{
+typedef MiniParse::ThrowingErrorHandler ErrorHandler;
+
+//---------------------------------------------------------------------------
+// Bench::Exp
+//---------------------------------------------------------------------------
+//! Exponential function for interpreting the exp calls of neuron models
+class Exp : public MiniParse::Interpreter::Callable
+{
+public:
+    virtual std::optional<size_t> getArity() const final
+    {
+        return 1;
+    }
+
+    virtual MiniParse::Token::LiteralValue call(const std::vector<MiniParse::Token::LiteralValue> &arguments) final
+    {
+        return std::visit(
+            MiniParse::Utils::Overload{
+                [](auto v) { return MiniParse::Token::LiteralValue{std::exp(v)}; },
+                [](std::monostate) { return MiniParse::Token::LiteralValue(); }},
+            arguments.at(0));
+    }
+};
+
+//---------------------------------------------------------------------------
+// Sources
+//---------------------------------------------------------------------------
+//! Hodgkin-Huxley neuron update, integrated with 25 substeps
+inline const std::string hodgkinHuxley =
+    "double Imem;\n"
+    "unsigned int mt;\n"
+    "double mdt= DT/25.0;\n"
+    "for (mt=0; mt < 25; mt++) {\n"
+    "   Imem= -(m*m*m*h*gNa*(V-(ENa))+\n"
+    "       n*n*n*n*gK*(V-(EK))+\n"
+    "       gl*(V-(El))-Isyn);\n"
+    "   double a;\n"
+    "   if (V == -52.0) {\n"
+    "       a= 1.28;\n"
+    "   }\n"
+    "   else {\n"
+    "       a= 0.32*(-52.0-V)/(exp((-52.0-V)/4.0)-1.0);\n"
+    "   }\n"
+    "   double b;\n"
+    "   if (V == -25.0) {\n"
+    "       b= 1.4;\n"
+    "   }\n"
+    "   else {\n"
+    "       b= 0.28*(V+25.0)/(exp((V+25.0)/5.0)-1.0);\n"
+    "   }\n"
+    "   m+= (a*(1.0-m)-b*m)*mdt;\n"
+    "   a= 0.128*exp((-48.0-V)/18.0);\n"
+    "   b= 4.0 / (exp((-25.0-V)/5.0)+1.0);\n"
+    "   h+= (a*(1.0-h)-b*h)*mdt;\n"
+    "   if (V == -50.0) {\n"
+    "       a= 0.16;\n"
+    "   }\n"
+    "   else {\n"
+    "       a= 0.032*(-50.0-V)/(exp((-50.0-V)/5.0)-1.0);\n"
+    "   }\n"
+    "   b= 0.5*exp((-55.0-V)/40.0);\n"
+    "   n+= (a*(1.0-n)-b*n)*mdt;\n"
+    "   V+= Imem/C*mdt;\n"
+    "}\n";
+
+//---------------------------------------------------------------------------
+// Free functions
+//---------------------------------------------------------------------------
+//! Get the shortest time, in seconds, taken by func over numRepeats calls
+template<typename F>
+double timeBest(size_t numRepeats, F func)
+{
+    double best = std::numeric_limits<double>::max();
+    for(size_t r = 0; r < numRepeats; r++) {
+        const auto start = std::chrono::steady_clock::now();
+        func();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+}   // namespace Bench
@@ -0,0 +1,69 @@
+// Standard C++ includes
+#include <iostream>
+#include <string>
+
+// Mini-parse includes
+#include "arena.h"
+#include "interpreter.h"
+#include "parser.h"
+#include "scanner.h"
+#include "symbol_table.h"
+#include "type_checker.h"
+
+// Benchmark includes
+#include "common.h"
+
+using namespace MiniParse;
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+constexpr size_t numIterations = 100000;
+
+//! Interpret loop with numIterations iterations and report time per iteration
+void run(const std::string &name, const std::string &body)
+{
+    const std::string source = "int x = 0;\nfor(int i = 0; i < " + std::to_string(numIterations) + "; i++) " + body + "\n";
+
+    Bench::ErrorHandler errorHandler;
+    SymbolTable symbolTable;
+    Arena arena;
+    const auto tokens = Scanner::scanSource(source, symbolTable, errorHandler);
+    const auto statements = Parser::parseBlockItemList(tokens, errorHandler, arena);
+
+    TypeChecker::Environment typeEnvironment(symbolTable);
+    const auto resolution = TypeChecker::typeCheck(statements, typeEnvironment, errorHandler);
+
+    const double time = Bench::timeBest(5, 
+        [&]()
+        {
+            Interpreter::Environment environment(symbolTable);
+            Interpreter::interpret(statements, environment, resolution);
+        });
+    std::cout << name << ": " << (time * 1.0E9) / numIterations << " ns/iteration" << std::endl;
+}
+}
+
+//---------------------------------------------------------------------------
+// Entry point
+//---------------------------------------------------------------------------
+//! Compare the cost of loop iterations which exit the loop body with break or continue 
+//! to that of ones which complete normally. Before break and continue were propagated 
+//! as completion codes, they were thrown as exceptions and were 1.5-3x slower
+int main()
+{
+    try
+    {
+        run("if-else (baseline)", "if(i % 2 == 0) x -= i; else x += i;");
+        run("if-continue", "if(i % 2 == 0) continue; else x += i;");
+        run("while-break", "while(true) break;");
+        run("switch-break", "switch(i % 2) { case 0: x -= i; break; default: x += i; break; }");
+    }
+    catch(const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,88 @@
+// Standard C++ includes
+#include <iostream>
+#include <random>
+#include <string>
+
+// Standard C includes
+#include <cstdlib>
+
+// Mini-parse includes
+#include "arena.h"
+#include "parser.h"
+#include "scanner.h"
+#include "symbol_table.h"
+
+// Benchmark includes
+#include "common.h"
+
+using namespace MiniParse;
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+constexpr size_t numStatements = 2000;
+constexpr size_t maxDepth = 6;
+
+//! Binary operators, at every precedence level, which generated expressions are built from
+const char *const binaryOperators[] = {"*", "/", "+", "-", "<", ">=", "==", "!=", "&&", "||"};
+
+//---------------------------------------------------------------------------
+//! Generate random expression, in the style of generated code, with
+//! variables and literals as operands and optional parenthesisation
+std::string generateExpression(std::mt19937 &rng, size_t depth, size_t &numOperands)
+{
+    if(depth == 0 || (rng() % 4) == 0) {
+        numOperands++;
+        return ((rng() % 2) == 0) ? ("v" + std::to_string(rng() % 16)) : (std::to_string(rng() % 100) + ".5");
+    }
+
+    const std::string left = generateExpression(rng, depth - 1, numOperands);
+    const std::string right = generateExpression(rng, depth - 1, numOperands);
+    const std::string expression = left + " " + binaryOperators[rng() % std::size(binaryOperators)] + " " + right;
+    return ((rng() % 3) == 0) ? ("(" + expression + ")") : expression;
+}
+}
+
+//---------------------------------------------------------------------------
+// Entry point
+//---------------------------------------------------------------------------
+//! Measure the cost of parsing large arithmetic expressions, like those emitted by
+//! code generators, where almost all time is spent parsing binary operators
+int main()
+{
+    try
+    {
+        // Generate source consisting of numStatements large expression statements
+        std::mt19937 rng(1234);
+        size_t numOperands = 0;
+        std::string source;
+        for(size_t i = 0; i < numStatements; i++) {
+            source += "x = " + generateExpression(rng, maxDepth, numOperands) + ";\n";
+        }
+
+        Bench::ErrorHandler errorHandler;
+        SymbolTable symbolTable;
+        Arena arena;
+        const auto tokens = Scanner::scanSource(source, symbolTable, errorHandler);
+
+        const double time = Bench::timeBest(5,
+            [&]()
+            {
+                {
+                    Parser::parseBlockItemList(tokens, errorHandler, arena);
+                }
+                arena.reset();
+            });
+
+        std::cout << tokens.size() << " tokens, " << numOperands << " operands" << std::endl;
+        std::cout << tokens.size() / (time * 1.0E6) << " M tokens/s, "
+                  << (time * 1.0E9) / numOperands << " ns/operand" << std::endl;
+    }
+    catch(const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,586 @@
+// Standard C++ includes
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <variant>
+
+// Standard C includes
+#include <cstdlib>
+
+// Mini-parse includes
+#include "arena.h"
+#include "expression.h"
+#include "flat_ast.h"
+#include "parser.h"
+#include "scanner.h"
+#include "statement.h"
+#include "symbol_table.h"
+#include "utils.h"
+
+// Benchmark includes
+#include "common.h"
+
+using namespace MiniParse;
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+constexpr size_t numTraversals = 20;
+
+//! Totals accumulated by walking every node of a tree
+struct Totals
+{
+    size_t numNodes = 0;
+    size_t numOperators = 0;
+    double literalSum = 0.0;
+
+    bool operator == (const Totals &other) const
+    {
+        return (numNodes == other.numNodes && numOperators == other.numOperators && literalSum == other.literalSum);
+    }
+};
+
+double getLiteral(const Token::LiteralValue &value)
+{
+    return std::visit(
+        Utils::Overload{
+            [](auto x) { return static_cast<double>(x); },
+            [](std::monostate) { return 0.0; }},
+        value);
+}
+
+//---------------------------------------------------------------------------
+// Walker
+//---------------------------------------------------------------------------
+//! Walk pointer tree, summing literals and counting operators
+class Walker : public Expression::Visitor, public Statement::Visitor
+{
+public:
+    Totals walk(const Statement::StatementList &statements)
+    {
+        m_Totals = Totals();
+        walk(statements.begin(), statements.end());
+        return m_Totals;
+    }
+
+    //---------------------------------------------------------------------------
+    // Expression::Visitor virtuals
+    //---------------------------------------------------------------------------
+    virtual void visit(const Expression::ArraySubscript &arraySubscript) final
+    {
+        m_Totals.numNodes++;
+        arraySubscript.getIndex()->accept(*this);
+    }
+
+    virtual void visit(const Expression::Assignment &assignment) final
+    {
+        m_Totals.numNodes++;
+        m_Totals.numOperators++;
+        assignment.getValue()->accept(*this);
+    }
+
+    virtual void visit(const Expression::Binary &binary) final
+    {
+        m_Totals.numNodes++;
+        m_Totals.numOperators++;
+        binary.getLeft()->accept(*this);
+        binary.getRight()->accept(*this);
+    }
+
+    virtual void visit(const Expression::Call &call) final
+    {
+        m_Totals.numNodes++;
+        call.getCallee()->accept(*this);
+        for(const auto &a : call.getArguments()) {
+            a->accept(*this);
+        }
+    }
+
+    virtual void visit(const Expression::Cast &cast) final
+    {
+        m_Totals.numNodes++;
+        cast.getExpression()->accept(*this);
+    }
+
+    virtual void visit(const Expression::Conditional &conditional) final
+    {
+        m_Totals.numNodes++;
+        conditional.getCondition()->accept(*this);
+        conditional.getTrue()->accept(*this);
+        conditional.getFalse()->accept(*this);
+    }
+
+    virtual void visit(const Expression::Grouping &grouping) final
+    {
+        m_Totals.numNodes++;
+        grouping.getExpression()->accept(*this);
+    }
+
+    virtual void visit(const Expression::Literal &literal) final
+    {
+        m_Totals.numNodes++;
+        m_Totals.literalSum += getLiteral(literal.getValue());
+    }
+
+    virtual void visit(const Expression::Logical &logical) final
+    {
+        m_Totals.numNodes++;
+        m_Totals.numOperators++;
+        logical.getLeft()->accept(*this);
+        logical.getRight()->accept(*this);
+    }
+
+    virtual void visit(const Expression::PostfixIncDec&) final
+    {
+        m_Totals.numNodes++;
+        m_Totals.numOperators++;
+    }
+
+    virtual void visit(const Expression::PrefixIncDec&) final
+    {
+        m_Totals.numNodes++;
+        m_Totals.numOperators++;
+    }
+
+    virtual void visit(const Expression::Variable&) final
+    {
+        m_Totals.numNodes++;
+    }
+
+    virtual void visit(const Expression::Unary &unary) final
+    {
+        m_Totals.numNodes++;
+        m_Totals.numOperators++;
+        unary.getRight()->accept(*this);
+    }
+
+    //---------------------------------------------------------------------------
+    // Statement::Visitor virtuals
+    //---------------------------------------------------------------------------
+    virtual void visit(const Statement::Break&) final
+    {
+        m_Totals.numNodes++;
+    }
+
+    virtual void visit(const Statement::Compound &compound) final
+    {
+        m_Totals.numNodes++;
+        walk(compound.getStatements().begin(), compound.getStatements().end());
+    }
+
+    virtual void visit(const Statement::Continue&) final
+    {
+        m_Totals.numNodes++;
+    }
+
+    virtual void visit(const Statement::Do &doStatement) final
+    {
+        m_Totals.numNodes++;
+        doStatement.getBody()->accept(*this);
+        doStatement.getCondition()->accept(*this);
+    }
+
+    virtual void visit(const Statement::Expression &expression) final
+    {
+        m_Totals.numNodes++;
+        expression.getExpression()->accept(*this);
+    }
+
+    virtual void visit(const Statement::For &forStatement) final
+    {
+        m_Totals.numNodes++;
+        if(forStatement.getInitialiser()) {
+            forStatement.getInitialiser()->accept(*this);
+        }
+        if(forStatement.getCondition()) {
+            forStatement.getCondition()->accept(*this);
+        }
+        if(forStatement.getIncrement()) {
+            forStatement.getIncrement()->accept(*this);
+        }
+        forStatement.getBody()->accept(*this);
+    }
+
+    virtual void visit(const Statement::If &ifStatement) final
+    {
+        m_Totals.numNodes++;
+        ifStatement.getCondition()->accept(*this);
+        ifStatement.getThenBranch()->accept(*this);
+        if(ifStatement.getElseBranch()) {
+            ifStatement.getElseBranch()->accept(*this);
+        }
+    }
+
+    virtual void visit(const Statement::Labelled &labelled) final
+    {
+        m_Totals.numNodes++;
+        if(labelled.getValue()) {
+            labelled.getValue()->accept(*this);
+        }
+        labelled.getBody()->accept(*this);
+    }
+
+    virtual void visit(const Statement::Switch &switchStatement) final
+    {
+        m_Totals.numNodes++;
+        switchStatement.getCondition()->accept(*this);
+        switchStatement.getBody()->accept(*this);
+    }
+
+    virtual void visit(const Statement::VarDeclaration &varDeclaration) final
+    {
+        m_Totals.numNodes++;
+        for(const auto &d : varDeclaration.getInitDeclaratorList()) {
+            if(std::get<1>(d)) {
+                std::get<1>(d)->accept(*this);
+            }
+        }
+    }
+
+    virtual void visit(const Statement::While &whileStatement) final
+    {
+        m_Totals.numNodes++;
+        whileStatement.getCondition()->accept(*this);
+        whileStatement.getBody()->accept(*this);
+    }
+
+    virtual void visit(const Statement::Print &print) final
+    {
+        m_Totals.numNodes++;
+        print.getExpression()->accept(*this);
+    }
+
+private:
+    template<typename I>
+    void walk(I begin, I end)
+    {
+        for(auto s = begin; s != end; ++s) {
+            s->get()->accept(*this);
+        }
+    }
+
+    Totals m_Totals;
+};
+
+//---------------------------------------------------------------------------
+// FlatWalker
+//---------------------------------------------------------------------------
+//! Walk flat tree in the same order as Walker, summing literals and counting operators
+class FlatWalker : public FlatAST::ExpressionVisitor, public FlatAST::StatementVisitor
+{
+public:
+    FlatWalker(const FlatAST::Tree &tree) : m_Tree(tree)
+    {}
+
+    Totals walk()
+    {
+        m_Totals = Totals();
+        for(const auto s : m_Tree.getStatements()) {
+            m_Tree.accept(s, *this);
+        }
+        return m_Totals;
+    }
+
+    //---------------------------------------------------------------------------
+    // FlatAST::ExpressionVisitor virtuals
+    //---------------------------------------------------------------------------
+    virtual void visitArraySubscript(FlatAST::ExpressionIndex arraySubscript) final
+    {
+        m_Totals.numNodes++;
+        m_Tree.accept(m_Tree.getIndex(arraySubscript), *this);
+    }
+
+    virtual void visitAssignment(FlatAST::ExpressionIndex assignment) final
+    {
+        m_Totals.numNodes++;
+        m_Totals.numOperators++;
+        m_Tree.accept(m_Tree.getValue(assignment), *this);
+    }
+
+    virtual void visitBinary(FlatAST::ExpressionIndex binary) final
+    {
+        m_Totals.numNodes++;
+        m_Totals.numOperators++;
+        m_Tree.accept(m_Tree.getLeft(binary), *this);
+        m_Tree.accept(m_Tree.getRight(binary), *this);
+    }
+
+    virtual void visitCall(FlatAST::ExpressionIndex call) final
+    {
+        m_Totals.numNodes++;
+        m_Tree.accept(m_Tree.getCallee(call), *this);
+        for(const auto a : m_Tree.getArguments(call)) {
+            m_Tree.accept(a, *this);
+        }
+    }
+
+    virtual void visitCast(FlatAST::ExpressionIndex cast) final
+    {
+        m_Totals.numNodes++;
+        m_Tree.accept(m_Tree.getExpression(cast), *this);
+    }
+
+    virtual void visitConditional(FlatAST::ExpressionIndex conditional) final
+    {
+        m_Totals.numNodes++;
+        m_Tree.accept(m_Tree.getCondition(conditional), *this);
+        m_Tree.accept(m_Tree.getTrue(conditional), *this);
+        m_Tree.accept(m_Tree.getFalse(conditional), *this);
+    }
+
+    virtual void visitGrouping(FlatAST::ExpressionIndex grouping) final
+    {
+        m_Totals.numNodes++;
+        m_Tree.accept(m_Tree.getExpression(grouping), *this);
+    }
+
+    virtual void visitLiteral(FlatAST::ExpressionIndex literal) final
+    {
+        m_Totals.numNodes++;
+        m_Totals.literalSum += getLiteral(m_Tree.getLiteral(literal));
+    }
+
+    virtual void visitLogical(FlatAST::ExpressionIndex logical) final
+    {
+        m_Totals.numNodes++;
+        m_Totals.numOperators++;
+        m_Tree.accept(m_Tree.getLeft(logical), *this);
+        m_Tree.accept(m_Tree.getRight(logical), *this);
+    }
+
+    virtual void visitPostfixIncDec(FlatAST::ExpressionIndex) final
+    {
+        m_Totals.numNodes++;
+        m_Totals.numOperators++;
+    }
+
+    virtual void visitPrefixIncDec(FlatAST::ExpressionIndex) final
+    {
+        m_Totals.numNodes++;
+        m_Totals.numOperators++;
+    }
+
+    virtual void visitVariable(FlatAST::ExpressionIndex) final
+    {
+        m_Totals.numNodes++;
+    }
+
+    virtual void visitUnary(FlatAST::ExpressionIndex unary) final
+    {
+        m_Totals.numNodes++;
+        m_Totals.numOperators++;
+        m_Tree.accept(m_Tree.getRight(unary), *this);
+    }
+
+    //---------------------------------------------------------------------------
+    // FlatAST::StatementVisitor virtuals
+    //---------------------------------------------------------------------------
+    virtual void visitBreak(FlatAST::StatementIndex) final
+    {
+        m_Totals.numNodes++;
+    }
+
+    virtual void visitCompound(FlatAST::StatementIndex compound) final
+    {
+        m_Totals.numNodes++;
+        for(const auto s : m_Tree.getStatements(compound)) {
+            m_Tree.accept(s, *this);
+        }
+    }
+
+    virtual void visitContinue(FlatAST::StatementIndex) final
+    {
+        m_Totals.numNodes++;
+    }
+
+    virtual void visitDo(FlatAST::StatementIndex doStatement) final
+    {
+        m_Totals.numNodes++;
+        m_Tree.accept(m_Tree.getBody(doStatement), *this);
+        m_Tree.accept(m_Tree.getCondition(doStatement), *this);
+    }
+
+    virtual void visitExpression(FlatAST::StatementIndex expression) final
+    {
+        m_Totals.numNodes++;
+        m_Tree.accept(m_Tree.getExpression(expression), *this);
+    }
+
+    virtual void visitFor(FlatAST::StatementIndex forStatement) final
+    {
+        m_Totals.numNodes++;
+        if(m_Tree.getInitialiser(forStatement) != FlatAST::noStatement) {
+            m_Tree.accept(m_Tree.getInitialiser(forStatement), *this);
+        }
+        if(m_Tree.getCondition(forStatement) != FlatAST::noExpression) {
+            m_Tree.accept(m_Tree.getCondition(forStatement), *this);
+        }
+        if(m_Tree.getIncrement(forStatement) != FlatAST::noExpression) {
+            m_Tree.accept(m_Tree.getIncrement(forStatement), *this);
+        }
+        m_Tree.accept(m_Tree.getBody(forStatement), *this);
+    }
+
+    virtual void visitIf(FlatAST::StatementIndex ifStatement) final
+    {
+        m_Totals.numNodes++;
+        m_Tree.accept(m_Tree.getCondition(ifStatement), *this);
+        m_Tree.accept(m_Tree.getThenBranch(ifStatement), *this);
+        if(m_Tree.getElseBranch(ifStatement) != FlatAST::noStatement) {
+            m_Tree.accept(m_Tree.getElseBranch(ifStatement), *this);
+        }
+    }
+
+    virtual void visitLabelled(FlatAST::StatementIndex labelled) final
+    {
+        m_Totals.numNodes++;
+        if(m_Tree.getValue(labelled) != FlatAST::noExpression) {
+            m_Tree.accept(m_Tree.getValue(labelled), *this);
+        }
+        m_Tree.accept(m_Tree.getBody(labelled), *this);
+    }
+
+    virtual void visitSwitch(FlatAST::StatementIndex switchStatement) final
+    {
+        m_Totals.numNodes++;
+        m_Tree.accept(m_Tree.getCondition(switchStatement), *this);
+        m_Tree.accept(m_Tree.getBody(switchStatement), *this);
+    }
+
+    virtual void visitVarDeclaration(FlatAST::StatementIndex varDeclaration) final
+    {
+        m_Totals.numNodes++;
+        for(const auto &d : m_Tree.getInitDeclaratorList(varDeclaration)) {
+            if(d.initialiser != FlatAST::noExpression) {
+                m_Tree.accept(d.initialiser, *this);
+            }
+        }
+    }
+
+    virtual void visitWhile(FlatAST::StatementIndex whileStatement) final
+    {
+        m_Totals.numNodes++;
+        m_Tree.accept(m_Tree.getCondition(whileStatement), *this);
+        m_Tree.accept(m_Tree.getBody(whileStatement), *this);
+    }
+
+    virtual void visitPrint(FlatAST::StatementIndex print) final
+    {
+        m_Totals.numNodes++;
+        m_Tree.accept(m_Tree.getExpression(print), *this);
+    }
+
+private:
+    const FlatAST::Tree &m_Tree;
+    Totals m_Totals;
+};
+
+//---------------------------------------------------------------------------
+//! Scan flat tree's expression arrays in index order, which is all passes that don't need tree order have to do
+Totals scanExpressions(const FlatAST::Tree &tree)
+{
+    Totals totals;
+    for(size_t i = 0; i < tree.getNumExpressions(); i++) {
+        const FlatAST::ExpressionIndex e{static_cast<uint32_t>(i)};
+        switch(tree.getKind(e)) {
+        case FlatAST::ExpressionKind::LITERAL:
+            totals.literalSum += getLiteral(tree.getLiteral(e));
+            break;
+
+        case FlatAST::ExpressionKind::ASSIGNMENT:
+        case FlatAST::ExpressionKind::BINARY:
+        case FlatAST::ExpressionKind::LOGICAL:
+        case FlatAST::ExpressionKind::POSTFIX_INC_DEC:
+        case FlatAST::ExpressionKind::PREFIX_INC_DEC:
+        case FlatAST::ExpressionKind::UNARY:
+            totals.numOperators++;
+            break;
+
+        default:
+            break;
+        }
+    }
+    totals.numNodes = tree.getNumExpressions();
+    return totals;
+}
+
+//---------------------------------------------------------------------------
+//! Compare traversal of pointer and flat trees built from numSnippets copies of the Hodgkin-Huxley snippet
+void bench(size_t numSnippets)
+{
+    std::string source;
+    for(size_t i = 0; i < numSnippets; i++) {
+        source += "{\n" + Bench::hodgkinHuxley + "}\n";
+    }
+
+    Bench::ErrorHandler errorHandler;
+    SymbolTable symbolTable;
+    const auto tokens = Scanner::scanSource(source, symbolTable, errorHandler);
+
+    Arena arena;
+    const auto heapStatements = Parser::parseBlockItemList(tokens, errorHandler);
+    const auto arenaStatements = Parser::parseBlockItemList(tokens, errorHandler, arena);
+    const FlatAST::Tree tree(arenaStatements);
+
+    // Check all traversals agree
+    Walker walker;
+    FlatWalker flatWalker(tree);
+    const Totals totals = walker.walk(heapStatements);
+    if(!(walker.walk(arenaStatements) == totals) || !(flatWalker.walk() == totals)) {
+        throw std::runtime_error("Flat tree traversal doesn't match pointer tree");
+    }
+    const Totals expressionTotals = scanExpressions(tree);
+    if(expressionTotals.numOperators != totals.numOperators || expressionTotals.literalSum != totals.literalSum) {
+        throw std::runtime_error("Flat tree scan doesn't match pointer tree");
+    }
+
+    // **NOTE** arena size excludes the vectors owned by some nodes such as the statements of compounds
+    const size_t numNodes = totals.numNodes;
+    std::cout << numSnippets << " snippets, " << numNodes << " nodes" << std::endl;
+    std::cout << "\tarena: " << static_cast<double>(arena.getNumBytesAllocated()) / numNodes << " bytes/node" << std::endl;
+    std::cout << "\tflat: " << static_cast<double>(tree.getNumBytes()) / numNodes << " bytes/node" << std::endl;
+
+    // Time traversals, checking each one's totals so they can't be optimised away
+    auto report = [&totals](const char *name, size_t numVisited, auto traverse)
+    {
+        const double time = Bench::timeBest(5,
+            [&]()
+            {
+                size_t numOperators = 0;
+                for(size_t i = 0; i < numTraversals; i++) {
+                    numOperators += traverse().numOperators;
+                }
+                if(numOperators != (totals.numOperators * numTraversals)) {
+                    throw std::runtime_error("Traversal counted wrong number of operators");
+                }
+            });
+        std::cout << "\t" << name << ": " << (time * 1.0E9) / (numVisited * numTraversals) << " ns/node" << std::endl;
+    };
+    report("pointer tree, heap", numNodes, [&]() { return walker.walk(heapStatements); });
+    report("pointer tree, arena", numNodes, [&]() { return walker.walk(arenaStatements); });
+    report("flat visitor", numNodes, [&]() { return flatWalker.walk(); });
+    report("flat linear scan (expressions only)", expressionTotals.numNodes, [&]() { return scanExpressions(tree); });
+}
+}
+
+//---------------------------------------------------------------------------
+// Entry point
+//---------------------------------------------------------------------------
+//! Compare the memory used by, and time taken to walk every node of, pointer trees and
+//! FlatAST::Tree, both while the trees fit in cache and once they no longer do
+int main()
+{
+    try
+    {
+        bench(50);
+        bench(2000);
+    }
+    catch(const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,128 @@
+// Standard C++ includes
+#include <iostream>
+#include <new>
+#include <utility>
+
+// Standard C includes
+#include <cstdlib>
+
+// Mini-parse includes
+#include "arena.h"
+#include "parser.h"
+#include "scanner.h"
+#include "symbol_table.h"
+
+// Benchmark includes
+#include "common.h"
+
+using namespace MiniParse;
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+constexpr size_t numParses = 10000;
+
+//! Number of calls to and bytes requested from the global operator new
+size_t numHeapAllocations = 0;
+size_t numHeapBytes = 0;
+
+//---------------------------------------------------------------------------
+//! Get the number of heap allocations made and bytes requested while calling func
+template<typename F>
+std::pair<size_t, size_t> countHeap(F func)
+{
+    const size_t startAllocations = numHeapAllocations;
+    const size_t startBytes = numHeapBytes;
+    func();
+    return std::make_pair(numHeapAllocations - startAllocations, numHeapBytes - startBytes);
+}
+}
+
+//---------------------------------------------------------------------------
+// Global operator new and delete
+//---------------------------------------------------------------------------
+//! Replacements for the global allocation functions which count allocations and bytes requested
+void *operator new(size_t size)
+{
+    numHeapAllocations++;
+    numHeapBytes += size;
+    if(void *pointer = std::malloc(size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept
+{
+    std::free(pointer);
+}
+
+//---------------------------------------------------------------------------
+// Entry point
+//---------------------------------------------------------------------------
+//! Compare the throughput and memory use of parsing into individually heap-allocated
+//! nodes with parsing into an Arena which is reset and reused between parses
+int main()
+{
+    try
+    {
+        Bench::ErrorHandler errorHandler;
+        SymbolTable symbolTable;
+        const auto tokens = Scanner::scanSource(Bench::hodgkinHuxley, symbolTable, errorHandler);
+
+        // Count nodes and the bytes used by one parse of each kind. Nodes may own additional
+        // heap allocations (e.g. the vectors of statements in a compound) even when arena-allocated
+        Arena arena;
+        const auto heap = countHeap(
+            [&]() { Parser::parseBlockItemList(tokens, errorHandler); });
+
+        // **NOTE** the first parse allocates the arena's block, which reuses it thereafter
+        const auto arenaHeap = countHeap(
+            [&]() { Parser::parseBlockItemList(tokens, errorHandler, arena); });
+        const size_t numNodes = arena.getNumObjects();
+        const size_t arenaBytes = arena.getNumBytesAllocated() + arenaHeap.second - arena.getNumBytesReserved();
+        arena.reset();
+        const auto reusedArenaHeap = countHeap(
+            [&]() { Parser::parseBlockItemList(tokens, errorHandler, arena); });
+        arena.reset();
+
+        const double heapTime = Bench::timeBest(5,
+            [&]()
+            {
+                for(size_t i = 0; i < numParses; i++) {
+                    Parser::parseBlockItemList(tokens, errorHandler);
+                }
+            });
+
+        const double arenaTime = Bench::timeBest(5,
+            [&]()
+            {
+                for(size_t i = 0; i < numParses; i++) {
+                    {
+                        Parser::parseBlockItemList(tokens, errorHandler, arena);
+                    }
+                    arena.reset();
+                }
+            });
+
+        std::cout << numNodes << " nodes per parse" << std::endl;
+        std::cout << "heap: " << (numNodes * numParses) / (heapTime * 1.0E6) << " M nodes/s, "
+                  << static_cast<double>(heap.second) / numNodes << " bytes/node, "
+                  << heap.first << " heap allocations/parse" << std::endl;
+        std::cout << "arena: " << (numNodes * numParses) / (arenaTime * 1.0E6) << " M nodes/s, "
+                  << static_cast<double>(arenaBytes) / numNodes << " bytes/node, "
+                  << reusedArenaHeap.first << " heap allocations/parse" << std::endl;
+    }
+    catch(const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,128 @@
+// Standard C++ includes
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Standard C includes
+#include <cstdlib>
+
+// Mini-parse includes
+#include "arena.h"
+#include "interpreter.h"
+#include "parser.h"
+#include "population_runner.h"
+#include "scanner.h"
+#include "symbol_table.h"
+#include "type.h"
+#include "type_checker.h"
+
+// Benchmark includes
+#include "common.h"
+
+using namespace MiniParse;
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+constexpr size_t numInstances = 2000;
+
+//! Parameters shared by every neuron and their values
+const std::vector<std::pair<std::string, double>> parameters{
+    {"DT", 0.1}, {"gNa", 7.15}, {"ENa", 50.0}, {"gK", 1.43}, {"EK", -95.0}, {"gl", 0.02672}, {"El", -63.563}, {"C", 0.143}};
+
+//! State variables of each neuron
+const std::vector<std::string> stateVariables{"Isyn", "V", "m", "h", "n"};
+
+//---------------------------------------------------------------------------
+//! Get initial values of each state variable for every neuron
+std::vector<std::vector<double>> getInitialState()
+{
+    std::vector<std::vector<double>> state(stateVariables.size(), std::vector<double>(numInstances));
+    for(size_t i = 0; i < numInstances; i++) {
+        state[0][i] = 0.01 * static_cast<double>(i % 100);
+        state[1][i] = -60.0;
+        state[2][i] = 0.0529;
+        state[3][i] = 0.3176;
+        state[4][i] = 0.5961;
+    }
+    return state;
+}
+}
+
+//---------------------------------------------------------------------------
+// Entry point
+//---------------------------------------------------------------------------
+//! Measure how the time taken to update a population of neurons with PopulationRunner scales from one thread
+//! up to the number of hardware threads (or the number given on the command line). Results must not
+//! depend on the number of threads so the state computed with each is compared to that computed with one
+int main(int argc, char **argv)
+{
+    try
+    {
+        const size_t maxThreads = (argc > 1) ? std::strtoul(argv[1], nullptr, 10)
+                                             : std::max(1u, std::thread::hardware_concurrency());
+
+        Bench::ErrorHandler errorHandler;
+        SymbolTable symbolTable;
+        Arena arena;
+        const auto tokens = Scanner::scanSource(Bench::hodgkinHuxley, symbolTable, errorHandler);
+        const auto statements = Parser::parseBlockItemList(tokens, errorHandler, arena);
+
+        TypeChecker::Environment typeEnvironment(symbolTable);
+        typeEnvironment.define<Type::Exp>("exp");
+        for(const auto &p : parameters) {
+            typeEnvironment.define<Type::Double>(p.first, true);
+        }
+        for(const auto &v : stateVariables) {
+            typeEnvironment.define<Type::Double>(v);
+        }
+        const auto resolution = TypeChecker::typeCheck(statements, typeEnvironment, errorHandler);
+
+        // Define function and parameters in globals shared by all threads
+        Bench::Exp exp;
+        Interpreter::Environment globals(symbolTable);
+        globals.define("exp", exp);
+        for(const auto &p : parameters) {
+            globals.define(Token(Token::Type::IDENTIFIER, p.first, 0, Token::LiteralValue(), symbolTable.intern(p.first)),
+                           p.second);
+        }
+
+        std::vector<std::vector<double>> reference;
+        double singleThreadTime = 0.0;
+        for(size_t t = 1; t <= maxThreads; t++) {
+            Interpreter::PopulationRunner runner(statements, globals, resolution, t);
+
+            // Time updates from the same initial state, keeping state from the final repeat
+            std::vector<std::vector<double>> state;
+            const double time = Bench::timeBest(5,
+                [&]()
+                {
+                    state = getInitialState();
+                    for(size_t v = 0; v < stateVariables.size(); v++) {
+                        runner.bindArray(stateVariables[v], state[v].data());
+                    }
+                    runner.run(numInstances);
+                });
+
+            if(t == 1) {
+                singleThreadTime = time;
+                reference = state;
+            }
+            else if(state != reference) {
+                throw std::runtime_error("State updated with " + std::to_string(t) + " threads differs from that with 1");
+            }
+            std::cout << t << " threads: " << (time * 1.0E9) / numInstances << " ns/neuron, speedup "
+                      << singleThreadTime / time << "x" << std::endl;
+        }
+    }
+    catch(const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
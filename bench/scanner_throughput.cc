@@ -0,0 +1,82 @@
+// Standard C++ includes
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <thread>
+
+// Standard C includes
+#include <cstdlib>
+
+// Mini-parse includes
+#include "scanner.h"
+#include "symbol_table.h"
+#include "token_stream.h"
+
+// Benchmark includes
+#include "common.h"
+
+using namespace MiniParse;
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+constexpr size_t sourceSize = 16 * 1024 * 1024;
+}
+
+//---------------------------------------------------------------------------
+// Entry point
+//---------------------------------------------------------------------------
+//! Measure scanner throughput, sequentially and in parallel, over a large synthetic
+//! source built from copies of the Hodgkin-Huxley snippet in nested blocks
+int main()
+{
+    try
+    {
+        std::string source;
+        source.reserve(sourceSize + Bench::hodgkinHuxley.size());
+        while(source.size() < sourceSize) {
+            source += "{\n" + Bench::hodgkinHuxley + "}\n";
+        }
+        const double sizeMB = source.size() / (1024.0 * 1024.0);
+
+        Bench::ErrorHandler errorHandler;
+        SymbolTable symbolTable;
+        size_t numTokens = 0;
+        const double vectorTime = Bench::timeBest(5,
+            [&]()
+            {
+                numTokens = Scanner::scanSource(source, symbolTable, errorHandler).size();
+            });
+        const double streamTime = Bench::timeBest(5,
+            [&]()
+            {
+                Scanner::scanTokenStream(source, symbolTable, errorHandler);
+            });
+
+        std::cout << sizeMB << " MB, " << numTokens << " tokens" << std::endl;
+        std::cout << "scanSource: " << sizeMB / vectorTime << " MB/s" << std::endl;
+        std::cout << "scanTokenStream: " << sizeMB / streamTime << " MB/s" << std::endl;
+
+        // Scan in parallel with doubling numbers of threads, up to one per hardware thread
+        const size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+        for(size_t numThreads = 1;; numThreads = std::min(numThreads * 2, maxThreads)) {
+            const double parallelTime = Bench::timeBest(5,
+                [&]()
+                {
+                    Scanner::scanTokenStreamParallel(source, symbolTable, errorHandler, numThreads);
+                });
+            std::cout << "scanTokenStreamParallel (" << numThreads << " threads): " << sizeMB / parallelTime
+                      << " MB/s, " << streamTime / parallelTime << "x" << std::endl;
+            if(numThreads == maxThreads) {
+                break;
+            }
+        }
+    }
+    catch(const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
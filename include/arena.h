@@ -0,0 +1,108 @@
+#pragma once
+
+// Standard C++ includes
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Standard C includes
+#include <cstddef>
+
+//---------------------------------------------------------------------------
+// MiniParse::ArenaNode
+//---------------------------------------------------------------------------
+namespace MiniParse
+{
+//! Base class for objects such as AST nodes which can either be allocated on the heap or in an Arena
+class ArenaNode
+{
+public:
+    virtual ~ArenaNode() = default;
+
+    bool isArenaAllocated() const { return m_ArenaAllocated; }
+
+private:
+    friend class Arena;
+
+    bool m_ArenaAllocated = false;
+};
+
+//---------------------------------------------------------------------------
+// MiniParse::ArenaDeleter
+//---------------------------------------------------------------------------
+//! Deleter for owning pointers to ArenaNode. Objects allocated in an arena are
+//! destroyed but their memory is only freed when the arena is reset or destroyed.
+//! Objects owned by the one being deleted are deleted iteratively rather than recursively
+//! so deleting deeply-nested trees can't overflow the stack
+struct ArenaDeleter
+{
+    ArenaDeleter() = default;
+
+    //! Allow ownership of heap-allocated objects to be transferred from std::unique_ptr
+    template<typename T>
+    ArenaDeleter(const std::default_delete<T>&)
+    {}
+
+    void operator()(const ArenaNode *object) const;
+};
+
+//---------------------------------------------------------------------------
+// MiniParse::Arena
+//---------------------------------------------------------------------------
+//! Bump allocator which owns all the objects allocated by one or more parses. The arena must outlive
+//! the objects allocated in it and, like the parser itself, should only be used by one thread at a time
+class Arena
+{
+public:
+    Arena(size_t blockSize = 64 * 1024);
+    Arena(const Arena&) = delete;
+
+    //------------------------------------------------------------------------
+    // Public API
+    //------------------------------------------------------------------------
+    //! Allocate uninitialised memory
+    void *allocate(size_t size, size_t alignment);
+
+    //! Construct object in arena
+    template<typename T, typename... Args>
+    std::unique_ptr<T, ArenaDeleter> create(Args&&... args)
+    {
+        T *object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        object->m_ArenaAllocated = true;
+        m_NumObjects++;
+        return std::unique_ptr<T, ArenaDeleter>(object);
+    }
+
+    //! Free all objects allocated in arena in bulk, retaining standard-sized blocks for use by the next parse.
+    //! **NOTE** objects must already have been destroyed by destroying the pointers which own them
+    void reset();
+
+    size_t getNumObjects() const{ return m_NumObjects; }
+    size_t getNumBytesAllocated() const{ return m_NumBytesAllocated; }
+    size_t getNumBytesReserved() const{ return (m_Blocks.size() * m_BlockSize) + m_NumLargeBlockBytes; }
+
+private:
+    //------------------------------------------------------------------------
+    // Members
+    //------------------------------------------------------------------------
+    const size_t m_BlockSize;
+
+    //! Standard-sized blocks, retained by reset
+    std::vector<std::unique_ptr<char[]>> m_Blocks;
+
+    //! Blocks for allocations too large to fit in a standard block
+    std::vector<std::unique_ptr<char[]>> m_LargeBlocks;
+    size_t m_NumLargeBlockBytes;
+
+    //! Index of next block in m_Blocks to allocate from once current one is full
+    size_t m_NextBlock;
+
+    //! Remaining free space in current block
+    char *m_Current;
+    char *m_End;
+
+    size_t m_NumObjects;
+    size_t m_NumBytesAllocated;
+};
+}   // namespace MiniParse
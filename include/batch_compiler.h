@@ -0,0 +1,91 @@
+#pragma once
+
+// Standard C++ includes
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+// Mini-parse includes
+#include "arena.h"
+#include "error_handler.h"
+#include "statement.h"
+#include "symbol_table.h"
+#include "type_checker.h"
+
+// Forward declarations
+namespace MiniParse
+{
+class WorkStealingPool;
+}
+
+//---------------------------------------------------------------------------
+// MiniParse::BatchCompiler::DiagnosticSink
+//---------------------------------------------------------------------------
+namespace MiniParse::BatchCompiler
+{
+//! Thread-safe destination for the errors found while compiling a batch of snippets. Errors are 
+//! collected per snippet so they can be reported in the order snippets were provided, regardless
+//! of which thread compiled them or when
+class DiagnosticSink
+{
+public:
+    //------------------------------------------------------------------------
+    // Public API
+    //------------------------------------------------------------------------
+    //! Add errors found while compiling snippet. Can be called from any thread
+    void add(size_t snippet, ErrorRecorder errors);
+
+    //! Report errors of all snippets to error handler in snippet order
+    void report(ErrorHandler &errorHandler) const;
+
+    //! Report errors of snippet to error handler
+    void report(size_t snippet, ErrorHandler &errorHandler) const;
+
+    //! Get number of snippets with errors
+    size_t getNumSnippetsWithErrors() const;
+
+private:
+    //------------------------------------------------------------------------
+    // Members
+    //------------------------------------------------------------------------
+    mutable std::mutex m_Mutex;
+
+    //! Errors of snippets with errors, ordered by snippet
+    std::map<size_t, ErrorRecorder> m_Errors;
+};
+
+//---------------------------------------------------------------------------
+// MiniParse::BatchCompiler::Result
+//---------------------------------------------------------------------------
+//! Result of compiling a single snippet. Tokens in AST reference the snippet's source, which must outlive it
+struct Result
+{
+    Result(const SymbolTable &globalSymbolTable)
+    :   symbolTable(&globalSymbolTable), arena(std::make_unique<Arena>()), success(false)
+    {}
+
+    //! Symbols of snippet's identifiers, layered over those of the globals
+    SymbolTable symbolTable;
+
+    //! Arena owning nodes of the snippet's AST
+    //! **NOTE** declared before statements so it's destroyed after them
+    std::unique_ptr<Arena> arena;
+
+    Statement::StatementList statements;
+    TypeChecker::Resolution resolution;
+
+    //! Was snippet scanned, parsed and type checked without errors
+    bool success;
+};
+
+//---------------------------------------------------------------------------
+// Free functions
+//---------------------------------------------------------------------------
+//! Scan, parse and type check snippets concurrently on pool, returning their results in the same order.
+//! Snippets are type checked in environments enclosed by globals, which are shared by all workers so
+//! globals and their symbol table must not be modified during compilation. Errors are added to diagnostics
+std::vector<Result> compileBatch(const std::vector<std::string_view> &sources, TypeChecker::Environment &globals,
+                                 DiagnosticSink &diagnostics, WorkStealingPool &pool);
+}   // namespace MiniParse::BatchCompiler
@@ -0,0 +1,93 @@
+#pragma once
+
+// Standard C++ includes
+#include <optional>
+#include <string_view>
+#include <vector>
+
+// Standard C includes
+#include <cstdint>
+
+// GeNN includes
+#include "type.h"
+
+// Mini-parse includes
+#include "bytecode.h"
+
+//---------------------------------------------------------------------------
+// MiniParse::Bytecode::BatchVirtualMachine
+//---------------------------------------------------------------------------
+namespace MiniParse::Bytecode
+{
+//! Executes a program compiled with ControlFlow::MASK for many independent instances at once, e.g. one per neuron.
+//! Each instruction operates on a block of lanes with data in structure-of-arrays layout so the
+//! inner loops can be vectorised and lanes which diverge at branches are handled with masks.
+class BatchVirtualMachine
+{
+public:
+    BatchVirtualMachine(const Program &program);
+
+    //------------------------------------------------------------------------
+    // Constants
+    //------------------------------------------------------------------------
+    //! Number of lanes processed by each instruction - multiple of widest vector width
+    static constexpr size_t blockSize = 32;
+
+    //------------------------------------------------------------------------
+    // LaneRegister
+    //------------------------------------------------------------------------
+    //! Register holding value for every lane in block
+    union alignas(64) LaneRegister
+    {
+        int32_t i32[blockSize];
+        uint32_t u32[blockSize];
+        float f32[blockSize];
+        double f64[blockSize];
+    };
+
+    //------------------------------------------------------------------------
+    // Public API
+    //------------------------------------------------------------------------
+    //! Bind external to array with one value per lane. Values are read before and written back after execution
+    template<typename T>
+    void bindArray(std::string_view name, T *values)
+    {
+        bind(name, values, Type::TypeTraits<T>::NumericType::getInstance(), true);
+    }
+
+    //! Set external to the same value in every lane
+    template<typename T>
+    void setScalar(std::string_view name, T value)
+    {
+        bind(name, &value, Type::TypeTraits<T>::NumericType::getInstance(), false);
+    }
+
+    //! Run program for each of numLanes lanes. Every external must have been bound beforehand
+    void execute(size_t numLanes);
+
+private:
+    //------------------------------------------------------------------------
+    // Binding
+    //------------------------------------------------------------------------
+    //! Storage bound to external - arrays are indexed by lane whereas scalars are stored inline
+    struct Binding
+    {
+        void *array;
+        Register scalar;
+    };
+
+    //------------------------------------------------------------------------
+    // Private methods
+    //------------------------------------------------------------------------
+    void bind(std::string_view name, void *value, const Type::NumericBase *type, bool array);
+
+    //------------------------------------------------------------------------
+    // Members
+    //------------------------------------------------------------------------
+    const Program &m_Program;
+    std::vector<LaneRegister> m_Registers;
+
+    //! Binding of each of program's externals
+    std::vector<std::optional<Binding>> m_Bindings;
+};
+}   // namespace MiniParse::Bytecode
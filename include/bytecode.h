@@ -0,0 +1,181 @@
+#pragma once
+
+// Standard C++ includes
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Standard C includes
+#include <cstdint>
+
+// Mini-parse includes
+#include "statement.h"
+#include "type_checker.h"
+
+// Forward declarations
+namespace Type
+{
+class NumericBase;
+}
+
+//----------------------------------------------------------------------------
+// Macros
+//----------------------------------------------------------------------------
+// X-macro listing all opcodes. Arithmetic opcodes are suffixed with the register field they operate on:
+// I32 is used for bool, int8_t, int16_t and int32_t; U32 for uint8_t, uint16_t and uint32_t
+#define MINI_PARSE_ARITHMETIC_OPCODES(X, TYPE)                                                  \
+    X(ADD_##TYPE) X(SUB_##TYPE) X(MUL_##TYPE) X(DIV_##TYPE)                                     \
+    X(LT_##TYPE) X(LE_##TYPE) X(GT_##TYPE) X(GE_##TYPE) X(EQ_##TYPE) X(NE_##TYPE)               \
+    X(NEG_##TYPE) X(NOT_##TYPE) X(MOV_##TYPE) X(PRINT_##TYPE)
+
+#define MINI_PARSE_INTEGER_OPCODES(X, TYPE)                                                     \
+    X(MOD_##TYPE) X(AND_##TYPE) X(OR_##TYPE) X(XOR_##TYPE) X(SHL_##TYPE) X(SHR_##TYPE)          \
+    X(BNOT_##TYPE)
+
+#define MINI_PARSE_OPCODES(X)                                                                   \
+    MINI_PARSE_ARITHMETIC_OPCODES(X, I32) MINI_PARSE_ARITHMETIC_OPCODES(X, U32)                 \
+    MINI_PARSE_ARITHMETIC_OPCODES(X, F32) MINI_PARSE_ARITHMETIC_OPCODES(X, F64)                 \
+    MINI_PARSE_INTEGER_OPCODES(X, I32) MINI_PARSE_INTEGER_OPCODES(X, U32)                       \
+    X(CVT_I32_U32) X(CVT_I32_F32) X(CVT_I32_F64)                                                \
+    X(CVT_U32_I32) X(CVT_U32_F32) X(CVT_U32_F64)                                                \
+    X(CVT_F32_I32) X(CVT_F32_U32) X(CVT_F32_F64)                                                \
+    X(CVT_F64_I32) X(CVT_F64_U32) X(CVT_F64_F32)                                                \
+    X(SEXT8) X(SEXT16) X(ZEXT8) X(ZEXT16) X(PRINT_BOOL)                                         \
+    X(JMP) X(JZ) X(JNZ) X(CALL_F64) X(HALT)
+
+// X-macro listing opcodes used in place of conditional jumps by programs compiled with masked
+// control flow. IF and LOOP_COND narrow the mask of active lanes, SWITCH_CASE widens it to the lanes
+// where a switch label matches and the other opcodes restore it
+#define MINI_PARSE_MASKED_OPCODES(X)                                                            \
+    X(IF) X(ELSE) X(END_IF) X(LOOP_BEGIN) X(LOOP_COND) X(LOOP_CONTINUE) X(LOOP_END)             \
+    X(BREAK) X(CONTINUE) X(SWITCH_BEGIN) X(SWITCH_CASE) X(SWITCH_END)
+
+//---------------------------------------------------------------------------
+// MiniParse::Bytecode::OpCode
+//---------------------------------------------------------------------------
+namespace MiniParse::Bytecode
+{
+#define MINI_PARSE_OPCODE_ENUM(OP) OP,
+enum class OpCode : uint16_t
+{
+    MINI_PARSE_OPCODES(MINI_PARSE_OPCODE_ENUM)
+    MINI_PARSE_MASKED_OPCODES(MINI_PARSE_OPCODE_ENUM)
+};
+#undef MINI_PARSE_OPCODE_ENUM
+
+//---------------------------------------------------------------------------
+// MiniParse::Bytecode::ControlFlow
+//---------------------------------------------------------------------------
+//! How control flow is compiled
+enum class ControlFlow
+{
+    BRANCH,     //!< Conditional jumps, for executing one instance of program at a time
+    MASK,       //!< Masked opcodes so lanes of BatchVirtualMachine can diverge
+};
+
+//---------------------------------------------------------------------------
+// MiniParse::Bytecode::Instruction
+//---------------------------------------------------------------------------
+//! Three-address instruction. For arithmetic, dst, a and b are register indices,
+//! for jumps a is condition register and dst the target and for calls, b indexes function table.
+//! IF and SWITCH_CASE additionally invert their condition if b is non-zero
+struct Instruction
+{
+    OpCode opCode;
+    uint16_t dst;
+    uint16_t a;
+    uint16_t b;
+};
+
+//---------------------------------------------------------------------------
+// MiniParse::Bytecode::Register
+//---------------------------------------------------------------------------
+//! Untyped register - the type of each access is encoded in the instruction
+union Register
+{
+    int32_t i32;
+    uint32_t u32;
+    float f32;
+    double f64;
+};
+
+//---------------------------------------------------------------------------
+// MiniParse::Bytecode::Program
+//---------------------------------------------------------------------------
+class Program
+{
+public:
+    //------------------------------------------------------------------------
+    // External
+    //------------------------------------------------------------------------
+    //! Variable from enclosing environment, bound to a register
+    struct External
+    {
+        std::string name;
+        const Type::NumericBase *type;
+        uint16_t reg;
+    };
+
+    //------------------------------------------------------------------------
+    // Typedefines
+    //------------------------------------------------------------------------
+    typedef double (*Function)(double);
+
+    Program(std::vector<Instruction> instructions, std::vector<Register> constants,
+            std::vector<const Type::NumericBase*> constantTypes, std::vector<External> externals, std::vector<Function> functions, size_t numRegisters,
+            ControlFlow controlFlow)
+    :   m_Instructions(std::move(instructions)), m_Constants(std::move(constants)),
+        m_ConstantTypes(std::move(constantTypes)),
+        m_Externals(std::move(externals)), m_Functions(std::move(functions)), m_NumRegisters(numRegisters),
+        m_ControlFlow(controlFlow)
+    {}
+
+    //------------------------------------------------------------------------
+    // Public API
+    //------------------------------------------------------------------------
+    const std::vector<Instruction> &getInstructions() const{ return m_Instructions; }
+    const std::vector<External> &getExternals() const{ return m_Externals; }
+    const std::vector<Function> &getFunctions() const{ return m_Functions; }
+
+    //! Constants occupy the final registers, after locals and externals
+    const std::vector<Register> &getConstants() const{ return m_Constants; }
+
+    //! Type whose values fill the register field each constant is stored in
+    const std::vector<const Type::NumericBase*> &getConstantTypes() const{ return m_ConstantTypes; }
+
+    //! Total number of registers including those used for constants
+    size_t getNumRegisters() const{ return m_NumRegisters; }
+
+    ControlFlow getControlFlow() const{ return m_ControlFlow; }
+
+    //! Get register an external variable is bound to (if it is referenced by program)
+    std::optional<uint16_t> getExternalRegister(std::string_view name) const;
+
+    //! Write disassembly of program to string
+    std::string disassemble() const;
+
+private:
+    //------------------------------------------------------------------------
+    // Members
+    //------------------------------------------------------------------------
+    const std::vector<Instruction> m_Instructions;
+    const std::vector<Register> m_Constants;
+    const std::vector<const Type::NumericBase*> m_ConstantTypes;
+    const std::vector<External> m_Externals;
+    const std::vector<Function> m_Functions;
+    const size_t m_NumRegisters;
+    const ControlFlow m_ControlFlow;
+};
+
+//---------------------------------------------------------------------------
+// Free functions
+//---------------------------------------------------------------------------
+//! Compile type-checked statements into register-based bytecode.
+//! Variables not declared within statements are bound to external registers.
+Program compile(const Statement::StatementList &statements, const TypeChecker::Resolution &resolution,
+                ControlFlow controlFlow = ControlFlow::BRANCH);
+
+//! Get name of opcode
+const char *getOpCodeName(OpCode opCode);
+}   // namespace MiniParse::Bytecode
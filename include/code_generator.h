@@ -0,0 +1,117 @@
+#pragma once
+
+// Standard C++ includes
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Standard C includes
+#include <cstdint>
+
+// GeNN includes
+#include "type.h"
+
+// Mini-parse includes
+#include "statement.h"
+
+// Forward declarations
+namespace MiniParse
+{
+class ErrorHandler;
+}
+namespace MiniParse::TypeChecker
+{
+class Environment;
+struct Resolution;
+}
+
+//---------------------------------------------------------------------------
+// MiniParse::CodeGenerator
+//---------------------------------------------------------------------------
+namespace MiniParse::CodeGenerator
+{
+//! External variable or function referenced by statements, resolved using the type checker environment
+struct External
+{
+    std::string name;
+    const Type::Base *type;
+    bool isConst;
+};
+
+//! Get externals referenced by type-checked statements in order of first use
+std::vector<External> getExternals(const Statement::StatementList &statements, const TypeChecker::Environment &environment,
+                                   const TypeChecker::Resolution &resolution, ErrorHandler &errorHandler);
+
+//! Generate complete C++ translation unit which executes statements once for every instance of a population.
+//! Const numeric externals are passed as scalars and non-const numeric externals as arrays with one value per instance.
+//! The translation unit exports extern "C" void miniParseRun(void *const *variables, size_t numInstances) where
+//! variables contains a pointer to the scalar or array of each numeric external in the order returned by getExternals
+std::string generate(const Statement::StatementList &statements, const TypeChecker::Environment &environment,
+                     const TypeChecker::Resolution &resolution, ErrorHandler &errorHandler);
+
+//---------------------------------------------------------------------------
+// MiniParse::CodeGenerator::Module
+//---------------------------------------------------------------------------
+//! Translation unit generated from statements, compiled into a shared library with the system
+//! compiler and loaded into this process. Bindings follow Bytecode::BatchVirtualMachine
+class Module
+{
+public:
+    Module(const Statement::StatementList &statements, const TypeChecker::Environment &environment,
+           const TypeChecker::Resolution &resolution, ErrorHandler &errorHandler, std::string_view compileCommand = "c++ -std=c++17 -O2");
+    Module(const Module&) = delete;
+    ~Module();
+
+    //------------------------------------------------------------------------
+    // Public API
+    //------------------------------------------------------------------------
+    //! Bind non-const external to array with one value per instance
+    template<typename T>
+    void bindArray(std::string_view name, T *values)
+    {
+        bind(name, values, sizeof(T), Type::TypeTraits<T>::NumericType::getInstance(), true);
+    }
+
+    //! Set const external to the same value for every instance
+    template<typename T>
+    void setScalar(std::string_view name, T value)
+    {
+        bind(name, &value, sizeof(T), Type::TypeTraits<T>::NumericType::getInstance(), false);
+    }
+
+    //! Run compiled code for instances 0 to numInstances - 1. Every external must have been bound beforehand
+    void run(size_t numInstances);
+
+    const std::string &getSource() const{ return m_Source; }
+
+private:
+    //------------------------------------------------------------------------
+    // Typedefines
+    //------------------------------------------------------------------------
+    typedef void (*RunFunction)(void *const*, size_t);
+
+    //------------------------------------------------------------------------
+    // Private methods
+    //------------------------------------------------------------------------
+    void bind(std::string_view name, void *value, size_t size, const Type::NumericBase *type, bool array);
+
+    //------------------------------------------------------------------------
+    // Members
+    //------------------------------------------------------------------------
+    std::string m_Source;
+
+    //! Numeric externals, in order expected by generated code
+    std::vector<External> m_Externals;
+
+    //! Pointer to array or scalar storage for each external
+    std::vector<void*> m_Variables;
+
+    //! Storage for scalar values - one 8-byte element per external so any numeric type fits
+    std::vector<uint64_t> m_Scalars;
+
+    std::filesystem::path m_Directory;
+    void *m_Library;
+    RunFunction m_Run;
+};
+}   // namespace MiniParse::CodeGenerator
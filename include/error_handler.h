@@ -1,7 +1,11 @@
 #pragma once
 
 // Standard C++ includes
+#include <optional>
+#include <stdexcept>
+#include <string>
 #include <string_view>
+#include <vector>
 
 // Mini-parse includes
 #include "token.h"
@@ -17,4 +21,80 @@ public:
     virtual void error(size_t line, std::string_view message) = 0;
     virtual void error(const Token &token, std::string_view message) = 0;
 };
+
+//---------------------------------------------------------------------------
+// MiniParse::ThrowingErrorHandler
+//---------------------------------------------------------------------------
+//! Error handler which throws std::runtime_error on the first error e.g. where input is always expected to be valid
+class ThrowingErrorHandler : public ErrorHandler
+{
+public:
+    virtual void error(size_t line, std::string_view message) final
+    {
+        throw std::runtime_error("[line " + std::to_string(line) + "] Error: " + std::string{message});
+    }
+
+    virtual void error(const Token &token, std::string_view message) final
+    {
+        throw std::runtime_error("[line " + std::to_string(token.line) + "] Error at '" 
+                                 + std::string{token.lexeme} + "': " + std::string{message});
+    }
+};
+
+//---------------------------------------------------------------------------
+// MiniParse::ErrorRecorder
+//---------------------------------------------------------------------------
+//! Error handler which records errors so they can be reported later e.g. in a deterministic 
+//! order when they are found by several threads. Errors at tokens keep views of their lexemes
+class ErrorRecorder : public ErrorHandler
+{
+public:
+    virtual void error(size_t line, std::string_view message) final
+    {
+        m_Errors.push_back({line, std::nullopt, std::string{message}});
+    }
+
+    virtual void error(const Token &token, std::string_view message) final
+    {
+        m_Errors.push_back({token.line, token, std::string{message}});
+    }
+
+    //---------------------------------------------------------------------------
+    // Public API
+    //---------------------------------------------------------------------------
+    //! Report recorded errors to error handler, offsetting their lines by numPreviousLines
+    //! e.g. the number of lines before the part of the source they were found in
+    void report(ErrorHandler &errorHandler, size_t numPreviousLines = 0) const
+    {
+        for(const auto &e : m_Errors) {
+            if(e.token) {
+                Token token = *e.token;
+                token.line += numPreviousLines;
+                errorHandler.error(token, e.message);
+            }
+            else {
+                errorHandler.error(e.line + numPreviousLines, e.message);
+            }
+        }
+    }
+
+    bool hasError() const { return !m_Errors.empty(); }
+    size_t getNumErrors() const { return m_Errors.size(); }
+
+private:
+    //---------------------------------------------------------------------------
+    // Error
+    //---------------------------------------------------------------------------
+    struct Error
+    {
+        size_t line;
+        std::optional<Token> token;
+        std::string message;
+    };
+
+    //---------------------------------------------------------------------------
+    // Members
+    //---------------------------------------------------------------------------
+    std::vector<Error> m_Errors;
+};
 }
@@ -5,6 +5,7 @@
 #include <vector>
 
 // Mini-parse includes
+#include "arena.h"
 #include "token.h"
 
 // Forward declarations
@@ -22,15 +23,27 @@ class Base;
 //---------------------------------------------------------------------------
 namespace MiniParse::Expression
 {
-class Base
+class Base : public ArenaNode
 {
 public:
     virtual void accept(Visitor &visitor) const = 0;
 };
 
-typedef std::unique_ptr<Base const> ExpressionPtr;
+typedef std::unique_ptr<Base const, ArenaDeleter> ExpressionPtr;
 typedef std::vector<ExpressionPtr> ExpressionList;
 
+//---------------------------------------------------------------------------
+// MiniParse::Expression::VariableSlot
+//---------------------------------------------------------------------------
+//! Storage of a variable, resolved by the type checker. Locals are found by walking depth
+//! scopes outwards from the access and indexing that scope; globals index a table bound by name
+struct VariableSlot
+{
+    bool global;
+    size_t depth;
+    size_t index;
+};
+
 //---------------------------------------------------------------------------
 // MiniParse::Expression::ArraySubscript
 //---------------------------------------------------------------------------
@@ -0,0 +1,317 @@
+#pragma once
+
+// Standard C++ includes
+#include <limits>
+#include <optional>
+#include <vector>
+
+// Standard C includes
+#include <cstdint>
+
+// Mini-parse includes
+#include "expression.h"
+#include "statement.h"
+#include "token.h"
+#include "type_checker.h"
+
+// Forward declarations
+namespace Type
+{
+class Base;
+}
+
+//---------------------------------------------------------------------------
+// MiniParse::FlatAST
+//---------------------------------------------------------------------------
+//! Compact representation of the AST where each property of every node is stored in
+//! contiguous arrays indexed by 32-bit node index and node types are given by a tag byte
+namespace MiniParse::FlatAST
+{
+//! Index of expression, statement or token within Tree
+enum class ExpressionIndex : uint32_t {};
+enum class StatementIndex : uint32_t {};
+enum class TokenIndex : uint32_t {};
+
+//! Index used for missing children such as the else branch of an if statement without one
+constexpr ExpressionIndex noExpression = ExpressionIndex{std::numeric_limits<uint32_t>::max()};
+constexpr StatementIndex noStatement = StatementIndex{std::numeric_limits<uint32_t>::max()};
+
+enum class ExpressionKind : uint8_t
+{
+    ARRAY_SUBSCRIPT, ASSIGNMENT, BINARY, CALL, CAST, CONDITIONAL, GROUPING,
+    LITERAL, LOGICAL, POSTFIX_INC_DEC, PREFIX_INC_DEC, VARIABLE, UNARY,
+};
+
+enum class StatementKind : uint8_t
+{
+    BREAK, COMPOUND, CONTINUE, DO, EXPRESSION, FOR, IF,
+    LABELLED, SWITCH, VAR_DECLARATION, WHILE, PRINT,
+};
+
+//---------------------------------------------------------------------------
+// MiniParse::FlatAST::Range
+//---------------------------------------------------------------------------
+//! Contiguous range of elements stored within Tree e.g. the arguments of a call
+template<typename T>
+class Range
+{
+public:
+    Range(const T *begin, const T *end) : m_Begin(begin), m_End(end)
+    {}
+
+    const T *begin() const{ return m_Begin; }
+    const T *end() const{ return m_End; }
+    size_t size() const{ return m_End - m_Begin; }
+    bool empty() const{ return (m_Begin == m_End); }
+    const T &operator[](size_t i) const{ return m_Begin[i]; }
+
+private:
+    const T *m_Begin;
+    const T *m_End;
+};
+
+//---------------------------------------------------------------------------
+// MiniParse::FlatAST::Declarator
+//---------------------------------------------------------------------------
+struct Declarator
+{
+    TokenIndex name;
+    ExpressionIndex initialiser;
+};
+
+//---------------------------------------------------------------------------
+// MiniParse::FlatAST::ExpressionVisitor
+//---------------------------------------------------------------------------
+class ExpressionVisitor
+{
+public:
+    virtual void visitArraySubscript(ExpressionIndex arraySubscript) = 0;
+    virtual void visitAssignment(ExpressionIndex assignment) = 0;
+    virtual void visitBinary(ExpressionIndex binary) = 0;
+    virtual void visitCall(ExpressionIndex call) = 0;
+    virtual void visitCast(ExpressionIndex cast) = 0;
+    virtual void visitConditional(ExpressionIndex conditional) = 0;
+    virtual void visitGrouping(ExpressionIndex grouping) = 0;
+    virtual void visitLiteral(ExpressionIndex literal) = 0;
+    virtual void visitLogical(ExpressionIndex logical) = 0;
+    virtual void visitPostfixIncDec(ExpressionIndex postfixIncDec) = 0;
+    virtual void visitPrefixIncDec(ExpressionIndex prefixIncDec) = 0;
+    virtual void visitVariable(ExpressionIndex variable) = 0;
+    virtual void visitUnary(ExpressionIndex unary) = 0;
+};
+
+//---------------------------------------------------------------------------
+// MiniParse::FlatAST::StatementVisitor
+//---------------------------------------------------------------------------
+class StatementVisitor
+{
+public:
+    virtual void visitBreak(StatementIndex breakStatement) = 0;
+    virtual void visitCompound(StatementIndex compound) = 0;
+    virtual void visitContinue(StatementIndex continueStatement) = 0;
+    virtual void visitDo(StatementIndex doStatement) = 0;
+    virtual void visitExpression(StatementIndex expression) = 0;
+    virtual void visitFor(StatementIndex forStatement) = 0;
+    virtual void visitIf(StatementIndex ifStatement) = 0;
+    virtual void visitLabelled(StatementIndex labelled) = 0;
+    virtual void visitSwitch(StatementIndex switchStatement) = 0;
+    virtual void visitVarDeclaration(StatementIndex varDeclaration) = 0;
+    virtual void visitWhile(StatementIndex whileStatement) = 0;
+    virtual void visitPrint(StatementIndex print) = 0;
+};
+
+//---------------------------------------------------------------------------
+// MiniParse::FlatAST::Tree
+//---------------------------------------------------------------------------
+//! Flattened copy of statements. Children are stored before their parents so, for example, iterating over all
+//! expressions in index order visits operands before the operators which use them. Accessors mirror those of
+//! the corresponding Expression and Statement classes and must only be called on nodes of the right kind
+class Tree
+{
+public:
+    Tree(const Statement::StatementList &statements);
+
+    //! Flatten type-checked statements, also storing the resolved type and slot of each expression
+    Tree(const Statement::StatementList &statements, const TypeChecker::Resolution &resolution);
+
+    //------------------------------------------------------------------------
+    // Public API
+    //------------------------------------------------------------------------
+    //! Call visitor method corresponding to kind of node
+    void accept(ExpressionIndex expression, ExpressionVisitor &visitor) const;
+    void accept(StatementIndex statement, StatementVisitor &visitor) const;
+
+    size_t getNumExpressions() const{ return m_ExpressionKinds.size(); }
+    size_t getNumStatements() const{ return m_StatementKinds.size(); }
+
+    //! Bytes of memory allocated by the arrays which store the tree
+    size_t getNumBytes() const;
+
+    //! Top-level statements
+    Range<StatementIndex> getStatements() const{ return getStatementList(m_FirstStatement, m_NumStatements); }
+
+    const Token &getToken(TokenIndex token) const{ return m_Tokens[index(token)]; }
+
+    //------------------------------------------------------------------------
+    // Expressions
+    //------------------------------------------------------------------------
+    ExpressionKind getKind(ExpressionIndex expression) const{ return m_ExpressionKinds[index(expression)]; }
+
+    //! Type resolved by type checker or nullptr if tree was built from statements which weren't type-checked
+    const Type::Base *getType(ExpressionIndex expression) const{ return m_ExpressionTypes[index(expression)]; }
+
+    //! Operator of assignment, binary, logical, increment, decrement and unary expressions
+    const Token &getOperator(ExpressionIndex expression) const{ return getToken(m_ExpressionTokens[index(expression)]); }
+
+    //! Variable name of array subscript, assignment, increment, decrement and variable expressions
+    const Token &getName(ExpressionIndex expression) const;
+
+    //! Slot variable of assignment, increment, decrement or variable expression was resolved to by the type checker
+    std::optional<Expression::VariableSlot> getSlot(ExpressionIndex expression) const;
+
+    //! Children of array subscript, assignment, binary, logical and unary expressions
+    ExpressionIndex getIndex(ExpressionIndex arraySubscript) const{ return getOperand<ExpressionIndex>(arraySubscript, 0); }
+    ExpressionIndex getValue(ExpressionIndex assignment) const{ return getOperand<ExpressionIndex>(assignment, 0); }
+    ExpressionIndex getLeft(ExpressionIndex binary) const{ return getOperand<ExpressionIndex>(binary, 0); }
+    ExpressionIndex getRight(ExpressionIndex expression) const;
+
+    //! Call expressions
+    ExpressionIndex getCallee(ExpressionIndex call) const{ return getOperand<ExpressionIndex>(call, 0); }
+    const Token &getClosingParen(ExpressionIndex call) const{ return getToken(m_ExpressionTokens[index(call)]); }
+    Range<ExpressionIndex> getArguments(ExpressionIndex call) const;
+
+    //! Cast and grouping expressions
+    ExpressionIndex getExpression(ExpressionIndex expression) const{ return getOperand<ExpressionIndex>(expression, 0); }
+    const Type::Base *getCastType(ExpressionIndex cast) const{ return m_Types[getOperand<uint32_t>(cast, 1)]; }
+    bool isCastConst(ExpressionIndex cast) const{ return getOperand<uint32_t>(cast, 2) != 0; }
+
+    //! Conditional expressions
+    ExpressionIndex getCondition(ExpressionIndex conditional) const{ return getOperand<ExpressionIndex>(conditional, 0); }
+    const Token &getQuestion(ExpressionIndex conditional) const{ return getToken(m_ExpressionTokens[index(conditional)]); }
+    ExpressionIndex getTrue(ExpressionIndex conditional) const{ return getOperand<ExpressionIndex>(conditional, 1); }
+    ExpressionIndex getFalse(ExpressionIndex conditional) const{ return getOperand<ExpressionIndex>(conditional, 2); }
+
+    //! Literal expressions
+    const Token::LiteralValue &getLiteral(ExpressionIndex literal) const{ return m_Literals[getOperand<uint32_t>(literal, 0)]; }
+
+    //------------------------------------------------------------------------
+    // Statements
+    //------------------------------------------------------------------------
+    StatementKind getKind(StatementIndex statement) const{ return m_StatementKinds[index(statement)]; }
+
+    //! Token of break and continue statements, keyword of labelled statements and switch keyword of switch statements
+    const Token &getToken(StatementIndex statement) const{ return getToken(m_StatementTokens[index(statement)]); }
+
+    //! Number of slots used by variables declared in compound and for statements
+    size_t getNumSlots(StatementIndex statement) const{ return m_StatementSlots[index(statement)]; }
+
+    //! Compound statements
+    Range<StatementIndex> getStatements(StatementIndex compound) const;
+
+    //! Condition of do, for, if, switch and while statements, expression of expression and print statements
+    //! and value of labelled statements (noExpression for default labels and for loops without a condition)
+    ExpressionIndex getCondition(StatementIndex statement) const;
+    ExpressionIndex getExpression(StatementIndex statement) const{ return getOperand<ExpressionIndex>(statement, 0); }
+    ExpressionIndex getValue(StatementIndex labelled) const{ return getOperand<ExpressionIndex>(labelled, 0); }
+
+    //! Body of do, for, labelled, switch and while statements
+    StatementIndex getBody(StatementIndex statement) const;
+
+    //! For statements
+    StatementIndex getInitialiser(StatementIndex forStatement) const{ return getOperand<StatementIndex>(forStatement, 0); }
+    ExpressionIndex getIncrement(StatementIndex forStatement) const{ return getOperand<ExpressionIndex>(forStatement, 2); }
+
+    //! If statements
+    StatementIndex getThenBranch(StatementIndex ifStatement) const{ return getOperand<StatementIndex>(ifStatement, 1); }
+    StatementIndex getElseBranch(StatementIndex ifStatement) const{ return getOperand<StatementIndex>(ifStatement, 2); }
+
+    //! Switch statements
+    Range<Statement::Switch::Case> getCases(StatementIndex switchStatement) const;
+    const std::optional<Statement::Switch::Case> &getDefault(StatementIndex switchStatement) const;
+
+    //! Variable declarations
+    const Type::Base *getType(StatementIndex varDeclaration) const{ return m_Types[getOperand<uint32_t>(varDeclaration, 2)]; }
+    bool isConst(StatementIndex varDeclaration) const{ return getOperand<uint32_t>(varDeclaration, 3) != 0; }
+    Range<Declarator> getInitDeclaratorList(StatementIndex varDeclaration) const;
+    size_t getFirstSlot(StatementIndex varDeclaration) const{ return m_StatementSlots[index(varDeclaration)]; }
+
+private:
+    //------------------------------------------------------------------------
+    // Builder
+    //------------------------------------------------------------------------
+    //! Visitor used to flatten statements into tree
+    class Builder;
+
+    //------------------------------------------------------------------------
+    // SwitchCases
+    //------------------------------------------------------------------------
+    struct SwitchCases
+    {
+        uint32_t firstCase;
+        uint32_t numCases;
+        std::optional<Statement::Switch::Case> defaultCase;
+    };
+
+    //------------------------------------------------------------------------
+    // Private methods
+    //------------------------------------------------------------------------
+    template<typename I>
+    static size_t index(I i){ return static_cast<size_t>(i); }
+
+    template<typename T>
+    T getOperand(ExpressionIndex expression, size_t operand) const
+    {
+        return static_cast<T>(m_ExpressionOperands[operand][index(expression)]);
+    }
+
+    template<typename T>
+    T getOperand(StatementIndex statement, size_t operand) const
+    {
+        return static_cast<T>(m_StatementOperands[operand][index(statement)]);
+    }
+
+    Range<StatementIndex> getStatementList(uint32_t first, uint32_t count) const
+    {
+        return Range<StatementIndex>(m_StatementLists.data() + first, m_StatementLists.data() + first + count);
+    }
+
+    //------------------------------------------------------------------------
+    // Members
+    //------------------------------------------------------------------------
+    //! Expression nodes. The token is the operator, name, closing parenthesis or question mark of the expression and
+    //! operands are child expressions or indices into the tables below, depending on kind:
+    //! ARRAY_SUBSCRIPT index, CAST expression, type and const, CONDITIONAL condition, true and false,
+    //! ASSIGNMENT value, name and slot, CALL callee, first argument and number of arguments, GROUPING expression,
+    //! BINARY and LOGICAL left and right, LITERAL value, INC_DEC none, name and slot, VARIABLE none, none and slot, UNARY right
+    std::vector<ExpressionKind> m_ExpressionKinds;
+    std::vector<TokenIndex> m_ExpressionTokens;
+    std::vector<uint32_t> m_ExpressionOperands[3];
+    std::vector<const Type::Base*> m_ExpressionTypes;
+
+    //! Statement nodes. The token is the token, keyword or switch keyword of break, continue, labelled and switch
+    //! statements and slots are the number of slots of compound and for statements or first slot of variable declarations.
+    //! Operands are child expressions, child statements or indices into the tables below, depending on kind:
+    //! COMPOUND first statement and number of statements, DO, SWITCH and WHILE condition and body (switch also has cases),
+    //! EXPRESSION and PRINT expression, FOR initialiser, condition, increment and body, IF condition, then and else branch,
+    //! LABELLED value and body, VAR_DECLARATION first declarator, number of declarators, type and const
+    std::vector<StatementKind> m_StatementKinds;
+    std::vector<TokenIndex> m_StatementTokens;
+    std::vector<uint32_t> m_StatementOperands[4];
+    std::vector<uint32_t> m_StatementSlots;
+
+    //! Tables referenced by nodes
+    std::vector<Token> m_Tokens;
+    std::vector<Token::LiteralValue> m_Literals;
+    std::vector<const Type::Base*> m_Types;
+    std::vector<Expression::VariableSlot> m_Slots;
+    std::vector<ExpressionIndex> m_ExpressionLists;
+    std::vector<StatementIndex> m_StatementLists;
+    std::vector<Declarator> m_Declarators;
+    std::vector<Statement::Switch::Case> m_Cases;
+    std::vector<SwitchCases> m_Switches;
+
+    //! Range of top-level statements in m_StatementLists
+    uint32_t m_FirstStatement;
+    uint32_t m_NumStatements;
+};
+}   // namespace MiniParse::FlatAST
@@ -1,6 +1,7 @@
 #pragma once
 
 // Standard C++ includes
+#include <memory>
 #include <optional>
 #include <unordered_map>
 #include <vector>
@@ -8,6 +9,13 @@
 // Mini-parse includes
 #include "expression.h"
 #include "statement.h"
+#include "symbol_table.h"
+
+// Forward declarations
+namespace MiniParse::TypeChecker
+{
+struct Resolution;
+}
 
 //---------------------------------------------------------------------------
 // MiniParse::Interpreter::Callable
@@ -27,11 +35,17 @@ public:
 //---------------------------------------------------------------------------
 // MiniParse::Interpreter::Environment
 //---------------------------------------------------------------------------
+//! Values of variables, keyed by symbol. Enclosed environments share the symbol table of their enclosing environment
 class Environment
 {
 public:
-    Environment(Environment *enclosing = nullptr)
-    :   m_Enclosing(enclosing)
+    Environment(SymbolTable &symbolTable)
+    :   m_Enclosing(nullptr), m_SymbolTable(symbolTable)
+    {
+    }
+
+    Environment(Environment *enclosing)
+    :   m_Enclosing(enclosing), m_SymbolTable(enclosing->m_SymbolTable)
     {
     }
 
@@ -46,6 +60,9 @@ public:
     // **TODO** type
     void define(const Token &name, Token::LiteralValue value);
 
+    //! Define callable, such as a foreign function, as variable with symbol interned in environment's symbol table
+    void define(Symbol name, Callable &callable);
+
     // **TODO** type
     void define(std::string_view name, Callable &callable);
 
@@ -61,16 +78,62 @@ public:
     // **TODO** type
     Value get(const Token &name) const;
 
+    //! Get reference to value of variable, searching enclosing environments
+    Value &getValue(const Token &name);
+
+    //! Get symbol of name, interning its lexeme if token was created without one
+    Symbol getSymbol(const Token &name) const;
+
+    SymbolTable &getSymbolTable() const{ return m_SymbolTable; }
+
 private:
     //------------------------------------------------------------------------
     // Members
     //------------------------------------------------------------------------
     Environment *m_Enclosing;
-    std::unordered_map<std::string_view, Value> m_Values;
+    SymbolTable &m_SymbolTable;
+    std::unordered_map<Symbol, Value> m_Values;
+};
+
+//---------------------------------------------------------------------------
+// MiniParse::Interpreter::Executor
+//---------------------------------------------------------------------------
+//! Repeatedly executes statements against an environment. Unlike interpret, state is reused
+//! between executions so, for example, lookups of global variables are only performed once
+class Executor
+{
+public:
+    Executor(const Statement::StatementList &statements, Environment &environment,
+             const TypeChecker::Resolution &resolution);
+    ~Executor();
+
+    //------------------------------------------------------------------------
+    // Public API
+    //------------------------------------------------------------------------
+    void execute();
+
+    //! Forget the values global variables were bound to by previous executions. Must be called if variables are
+    //! defined in environment after execution as they may hide variables of the same name in enclosing environments
+    void invalidateGlobals();
+
+private:
+    //------------------------------------------------------------------------
+    // Impl
+    //------------------------------------------------------------------------
+    struct Impl;
+
+    //------------------------------------------------------------------------
+    // Members
+    //------------------------------------------------------------------------
+    const Statement::StatementList &m_Statements;
+    Environment &m_Environment;
+    const TypeChecker::Resolution &m_Resolution;
+    std::unique_ptr<Impl> m_Impl;
 };
 
 //---------------------------------------------------------------------------
 // Free functions
 //---------------------------------------------------------------------------
-void interpret(const Statement::StatementList &statements, Environment &environment);
+void interpret(const Statement::StatementList &statements, Environment &environment,
+               const TypeChecker::Resolution &resolution);
 }
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+
+// Standard C++ includes
+#include <string>
+#include <unordered_map>
+
+// Mini-parse includes
+#include "statement.h"
+#include "token.h"
+#include "type_checker.h"
+
+// Forward declarations
+namespace MiniParse
+{
+class ErrorHandler;
+}
+
+//---------------------------------------------------------------------------
+// MiniParse::Optimiser
+//---------------------------------------------------------------------------
+namespace MiniParse::Optimiser
+{
+//! Values of const globals which are known when statements are optimised e.g. model parameters
+typedef std::unordered_map<std::string, Token::LiteralValue> ConstantValues;
+
+//! Build optimised copy of type-checked statements, folding literal subtrees and known constants using
+//! the promotion rules of the type checker and removing identities such as x * 1, x + 0 and - -x.
+//! Resolved types and variable slots of new nodes are added to resolution so the
+//! result can be executed by any backend in place of the original statements
+Statement::StatementList optimise(const Statement::StatementList &statements, TypeChecker::Resolution &resolution,
+                                  const ConstantValues &constantValues = {});
+
+//! Build copy of type-checked statements where side-effect free subexpressions of for, while and do loops whose
+//! values can't change between iterations are evaluated once into const temporaries declared before the loop.
+//! Globals which are const in environment are always invariant; numHoisted is set to the number of subexpressions hoisted
+Statement::StatementList hoistLoopInvariants(const Statement::StatementList &statements, const TypeChecker::Environment &environment,
+                                             TypeChecker::Resolution &resolution, ErrorHandler &errorHandler,
+                                             size_t &numHoisted);
+
+//! Build copy of type-checked statements where side-effect free subexpressions, including calls to pure foreign
+//! functions such as exp and sqrt, which are evaluated more than once within a basic block are evaluated once into
+//! const temporaries. numEliminated is set to the total number of expression nodes which are no longer evaluated
+Statement::StatementList eliminateCommonSubexpressions(const Statement::StatementList &statements,
+                                                       TypeChecker::Resolution &resolution, size_t &numEliminated);
+}   // namespace MiniParse::Optimiser
@@ -12,7 +12,14 @@
 // Forward declarations
 namespace MiniParse
 {
+class Arena;
 class ErrorHandler;
+class TokenStream;
+}
+
+namespace MiniParse::Scanner
+{
+class TokenCursor;
 }
 
 //---------------------------------------------------------------------------
@@ -22,5 +29,36 @@ namespace MiniParse::Parser
 {
 Expression::ExpressionPtr parseExpression(const std::vector<Token> &tokens, ErrorHandler &errorHandler);
 
+//! Parse expression, allocating its nodes in arena which must outlive them
+Expression::ExpressionPtr parseExpression(const std::vector<Token> &tokens, ErrorHandler &errorHandler, Arena &arena);
+
 Statement::StatementList parseBlockItemList(const std::vector<Token> &tokens, ErrorHandler &errorHandler);
+
+//! Parse statements, allocating their nodes in arena which must outlive them
+Statement::StatementList parseBlockItemList(const std::vector<Token> &tokens, ErrorHandler &errorHandler, Arena &arena);
+
+//! Parse expression from stream of compact tokens, which are only expanded into full tokens when stored in AST nodes
+Expression::ExpressionPtr parseExpression(const TokenStream &tokens, ErrorHandler &errorHandler);
+
+//! Parse expression from stream of compact tokens, allocating its nodes in arena which must outlive them
+Expression::ExpressionPtr parseExpression(const TokenStream &tokens, ErrorHandler &errorHandler, Arena &arena);
+
+//! Parse statements from stream of compact tokens, which are only expanded into full tokens when stored in AST nodes
+Statement::StatementList parseBlockItemList(const TokenStream &tokens, ErrorHandler &errorHandler);
+
+//! Parse statements from stream of compact tokens, allocating their nodes in arena which must outlive them
+Statement::StatementList parseBlockItemList(const TokenStream &tokens, ErrorHandler &errorHandler, Arena &arena);
+
+//! Parse expression from tokens scanned on demand by cursor, so scanning and parsing run in a single pass
+Expression::ExpressionPtr parseExpression(Scanner::TokenCursor &tokens, ErrorHandler &errorHandler);
+
+//! Parse expression from tokens scanned on demand by cursor, allocating its nodes in arena which must outlive them
+Expression::ExpressionPtr parseExpression(Scanner::TokenCursor &tokens, ErrorHandler &errorHandler, Arena &arena);
+
+//! Parse statements from tokens scanned on demand by cursor, so scanning and parsing run in a single pass
+//! and only the tokens of the block item being parsed are held in memory
+Statement::StatementList parseBlockItemList(Scanner::TokenCursor &tokens, ErrorHandler &errorHandler);
+
+//! Parse statements from tokens scanned on demand by cursor, allocating their nodes in arena which must outlive them
+Statement::StatementList parseBlockItemList(Scanner::TokenCursor &tokens, ErrorHandler &errorHandler, Arena &arena);
 }   // MiniParse::MiniParse
\ No newline at end of file
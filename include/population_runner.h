@@ -0,0 +1,107 @@
+#pragma once
+
+// Standard C++ includes
+#include <deque>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Mini-parse includes
+#include "interpreter.h"
+#include "utils.h"
+#include "work_stealing_pool.h"
+
+//---------------------------------------------------------------------------
+// MiniParse::Interpreter::PopulationRunner
+//---------------------------------------------------------------------------
+namespace MiniParse::Interpreter
+{
+//! Executes statements once for every instance of a population e.g. every neuron, running instances as
+//! the tasks of a WorkStealingPool. Workers share the read-only statements but each has its own
+//! Executor and an environment holding the values of the instance it is running.
+//! **NOTE** variables in the shared globals environment must not be written by statements
+class PopulationRunner
+{
+public:
+    PopulationRunner(const Statement::StatementList &statements, Environment &globals,
+                     const TypeChecker::Resolution &resolution, size_t numThreads);
+    ~PopulationRunner();
+
+    //------------------------------------------------------------------------
+    // Public API
+    //------------------------------------------------------------------------
+    //! Bind variable to array with one value per instance. Values are read before
+    //! statements are executed for each instance and written back afterwards
+    template<typename T>
+    void bindArray(std::string_view name, T *values)
+    {
+        addBinding(name, values,
+                   [](const void *values, size_t i)
+                   {
+                       return Token::LiteralValue{static_cast<const T*>(values)[i]};
+                   },
+                   [](void *values, size_t i, const Token::LiteralValue &value)
+                   {
+                       static_cast<T*>(values)[i] = std::visit(
+                           Utils::Overload{
+                               [](auto v) { return static_cast<T>(v); },
+                               [](std::monostate)->T { throw std::runtime_error("Invalid value"); }},
+                           value);
+                   });
+    }
+
+    //! Execute statements for instances 0 to numInstances - 1, blocking until all are complete
+    void run(size_t numInstances);
+
+    size_t getNumThreads() const{ return m_Pool.getNumThreads(); }
+
+private:
+    //------------------------------------------------------------------------
+    // Typedefines
+    //------------------------------------------------------------------------
+    typedef Token::LiteralValue (*LoadFunction)(const void*, size_t);
+    typedef void (*StoreFunction)(void*, size_t, const Token::LiteralValue&);
+
+    //------------------------------------------------------------------------
+    // Binding
+    //------------------------------------------------------------------------
+    struct Binding
+    {
+        std::string name;
+        void *values;
+        LoadFunction load;
+        StoreFunction store;
+    };
+
+    //------------------------------------------------------------------------
+    // Worker
+    //------------------------------------------------------------------------
+    //! State used by one of the pool's workers
+    struct Worker;
+
+    //------------------------------------------------------------------------
+    // Private methods
+    //------------------------------------------------------------------------
+    void addBinding(std::string_view name, void *values, LoadFunction load, StoreFunction store);
+
+    //! Execute statements for instance on worker
+    void runInstance(Worker &worker, size_t instance);
+
+    //------------------------------------------------------------------------
+    // Members
+    //------------------------------------------------------------------------
+    const Statement::StatementList &m_Statements;
+    Environment &m_Globals;
+    const TypeChecker::Resolution &m_Resolution;
+
+    //! Bindings - deque is used so names referenced by worker environments are never moved
+    std::deque<Binding> m_Bindings;
+
+    std::vector<std::unique_ptr<Worker>> m_Workers;
+
+    //! Pool is declared last so its threads are stopped before the state they use is destroyed
+    WorkStealingPool m_Pool;
+};
+}   // namespace MiniParse::Interpreter
@@ -6,10 +6,19 @@
 // Mini-parse includes
 #include "statement.h"
 
+// Forward declarations
+namespace MiniParse::FlatAST
+{
+class Tree;
+}
+
 //---------------------------------------------------------------------------
 // MiniParse::PrettyPrinter
 //---------------------------------------------------------------------------
 namespace MiniParse::PrettyPrinter
 {
 std::string print(const Statement::StatementList &statements);
+
+//! Print flattened statements, giving the same output as printing the statements they were flattened from
+std::string print(const FlatAST::Tree &tree);
 }
\ No newline at end of file
@@ -7,8 +7,13 @@
 #include <variant>
 #include <vector>
 
+// Standard C includes
+#include <cassert>
+
 // Mini-parse includes
+#include "symbol_table.h"
 #include "token.h"
+#include "token_stream.h"
 
 // Forward declarations
 namespace MiniParse
@@ -21,6 +26,94 @@ class ErrorHandler;
 //---------------------------------------------------------------------------
 namespace MiniParse::Scanner
 {
-std::vector<Token> scanSource(const std::string_view &source, ErrorHandler &errorHandler);
+//! Scan source into tokens, interning identifiers in symbol table
+std::vector<Token> scanSource(const std::string_view &source, SymbolTable &symbolTable, ErrorHandler &errorHandler);
+
+//! Scan source into stream of compact tokens, which must not outlive source
+TokenStream scanTokenStream(const std::string_view &source, SymbolTable &symbolTable, ErrorHandler &errorHandler);
+
+//! Scan source into stream of compact tokens, splitting it into chunks at new lines which are scanned by up to
+//! numThreads threads (zero to use one per hardware thread). Tokens, symbols and errors are identical to scanTokenStream
+TokenStream scanTokenStreamParallel(const std::string_view &source, SymbolTable &symbolTable, 
+                                    ErrorHandler &errorHandler, size_t numThreads = 0);
+
+//---------------------------------------------------------------------------
+// MiniParse::Scanner::TokenCursor
+//---------------------------------------------------------------------------
+//! Pull-based source of tokens which scans source on demand as the parser advances through it.
+//! Tokens are scanned into fixed-size chunks and only chunks containing tokens which haven't
+//! been released are held in memory so scanning and parsing run in a single pass
+class TokenCursor
+{
+public:
+    typedef Token value_type;
+
+    TokenCursor(std::string_view source, SymbolTable &symbolTable, ErrorHandler &errorHandler);
+
+    //---------------------------------------------------------------------------
+    // Public API
+    //---------------------------------------------------------------------------
+    //! Get token at index from start of source, scanning up to it if required. 
+    //! Token must not have been released and references remain valid until it is
+    const Token &operator[](size_t index)
+    {
+        while(index >= m_EndIndex) {
+            scanTokens();
+        }
+        assert((index >> chunkBits) >= m_FirstChunk);
+        return m_Chunks[(index >> chunkBits) - m_FirstChunk][index & (chunkSize - 1)];
+    }
+
+    //! Release tokens before index which will no longer be accessed
+    void release(size_t index);
+
+    //! Get maximum number of tokens which have been held at once
+    size_t getMaxNumTokens() const { return m_MaxNumChunks * chunkSize; }
+
+private:
+    //---------------------------------------------------------------------------
+    // Constants
+    //---------------------------------------------------------------------------
+    static constexpr size_t chunkBits = 8;
+    static constexpr size_t chunkSize = 1 << chunkBits;
+
+    //! Maximum number of tokens added by scanning one token e.g. $(name, adds IDENTIFIER and LEFT_PAREN
+    static constexpr size_t maxTokensPerScan = 2;
+
+    //---------------------------------------------------------------------------
+    // Private methods
+    //---------------------------------------------------------------------------
+    //! Scan source until the last chunk is full or the end of the source is reached
+    void scanTokens();
+
+    //! Add empty chunk to end of chunks, reusing a spare one if possible
+    std::vector<Token> &addChunk();
+
+    //---------------------------------------------------------------------------
+    // Members
+    //---------------------------------------------------------------------------
+    const std::string_view m_Source;
+    SymbolTable &m_SymbolTable;
+    ErrorHandler &m_ErrorHandler;
+
+    //! Position and line in source scanning will continue from
+    size_t m_Current;
+    size_t m_Line;
+
+    //! Chunks of tokens which have been scanned but not released
+    //! **NOTE** chunks have capacity reserved for the tokens which may overflow them when
+    //! they are scanned so never reallocate and references remain valid
+    std::vector<std::vector<Token>> m_Chunks;
+
+    //! Released chunks which can be reused
+    std::vector<std::vector<Token>> m_SpareChunks;
+
+    //! Index of first chunk in m_Chunks from start of source
+    size_t m_FirstChunk;
+
+    //! Index of next token to be scanned from start of source
+    size_t m_EndIndex;
 
+    size_t m_MaxNumChunks;
+};
 }   // namespace Scanner
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+// Standard C++ includes
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//---------------------------------------------------------------------------
+// MiniParse::SourceManager
+//---------------------------------------------------------------------------
+namespace MiniParse
+{
+//! Owns the text of sources so the views into them held by tokens and AST nodes remain valid.
+//! Files are memory-mapped read-only rather than copied and positions within any source 
+//! can be mapped back to the file and line they came from e.g. to report errors
+class SourceManager
+{
+public:
+    SourceManager();
+    ~SourceManager();
+
+    SourceManager(const SourceManager&) = delete;
+    SourceManager &operator=(const SourceManager&) = delete;
+
+    //! Position within a source
+    struct Location
+    {
+        std::string_view name;
+        size_t line;
+        size_t column;
+    };
+
+    //---------------------------------------------------------------------------
+    // Public API
+    //---------------------------------------------------------------------------
+    //! Map file read-only and get view of its text, valid for the lifetime of the source manager
+    std::string_view addFile(const std::filesystem::path &path);
+
+    //! Map every regular file in directory with extension (including the '.') in order of their paths
+    std::vector<std::string_view> addDirectory(const std::filesystem::path &directory, std::string_view extension);
+
+    //! Take ownership of text of in-memory source e.g. a snippet embedded in a model
+    std::string_view addSource(std::string name, std::string text);
+
+    //! Get location of position in one of the sources e.g. the start of a token's lexeme,
+    //! or nullopt if position isn't within any of them
+    std::optional<Location> getLocation(const char *position) const;
+
+    size_t getNumSources() const { return m_Sources.size(); }
+
+    //! Get total size of memory-mapped files
+    size_t getNumMappedBytes() const { return m_NumMappedBytes; }
+
+private:
+    //---------------------------------------------------------------------------
+    // Source
+    //---------------------------------------------------------------------------
+    struct Source;
+
+    //---------------------------------------------------------------------------
+    // Private methods
+    //---------------------------------------------------------------------------
+    std::string_view addSource(std::unique_ptr<Source> source);
+
+    //---------------------------------------------------------------------------
+    // Members
+    //---------------------------------------------------------------------------
+    std::vector<std::unique_ptr<Source>> m_Sources;
+
+    //! Non-empty sources keyed by address of their first character so positions can be mapped back to them
+    std::map<const char*, const Source*> m_SourcesByAddress;
+
+    size_t m_NumMappedBytes;
+};
+}   // namespace MiniParse
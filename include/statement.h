@@ -2,8 +2,12 @@
 
 // Standard C++ includes
 #include <memory>
+#include <optional>
 #include <vector>
 
+// Standard C includes
+#include <cstdint>
+
 // Mini-parse includes
 #include "expression.h"
 
@@ -22,13 +26,13 @@ class Base;
 //---------------------------------------------------------------------------
 namespace MiniParse::Statement
 {
-class Base
+class Base : public ArenaNode
 {
 public:
     virtual void accept(Visitor &visitor) const = 0;
 };
 
-typedef std::unique_ptr<Base const> StatementPtr;
+typedef std::unique_ptr<Base const, ArenaDeleter> StatementPtr;
 typedef std::vector<StatementPtr> StatementList;
 
 //---------------------------------------------------------------------------
@@ -198,6 +202,19 @@ private:
 class Switch : public Base
 {
 public:
+    //! Case or default label resolved by type checker
+    struct Case
+    {
+        //! Constant value of case converted to promoted type of condition
+        int64_t value;
+
+        //! Index of label amongst labels belonging to switch in the order they appear
+        size_t label;
+
+        //! Index of statement in compound body which begins with label, if label isn't nested within another statement
+        std::optional<size_t> statement;
+    };
+
     Switch(Token switchToken, MiniParse::Expression::ExpressionPtr condition, StatementPtr body)
     :   m_Switch(switchToken), m_Condition(std::move(condition)), m_Body(std::move(body))
     {}
@@ -207,7 +224,7 @@ public:
     const Token &getSwitch() const { return m_Switch; }
     const MiniParse::Expression::Base *getCondition() const { return m_Condition.get(); }
     const Base *getBody() const { return m_Body.get(); }
-    
+
 private:
     const Token m_Switch;
     const MiniParse::Expression::ExpressionPtr m_Condition;
@@ -0,0 +1,81 @@
+#pragma once
+
+// Standard C++ includes
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Standard C includes
+#include <cstdint>
+
+//---------------------------------------------------------------------------
+// MiniParse::Symbol
+//---------------------------------------------------------------------------
+namespace MiniParse
+{
+//! Dense ID of an identifier interned in a SymbolTable
+enum class Symbol : uint32_t
+{
+    //! Symbol of tokens which aren't identifiers or were created without a SymbolTable
+    NONE = 0xFFFFFFFF,
+};
+
+//---------------------------------------------------------------------------
+// MiniParse::SymbolTable
+//---------------------------------------------------------------------------
+//! Assigns each distinct identifier a dense ID so later stages can compare integers rather than strings.
+//! Names are copied so a single table can be shared between all the snippets of a model. Tables can
+//! also be layered over a parent e.g. one per thread over a shared table holding the names of globals
+class SymbolTable
+{
+public:
+    SymbolTable();
+
+    //! Create table whose names include those of parent, which are given the same symbols. Subsequent names 
+    //! are assigned IDs following those in parent, which must not be modified while this table exists
+    //! **NOTE** parent is only read so several threads can each have a table over the same parent
+    explicit SymbolTable(const SymbolTable *parent);
+
+    //---------------------------------------------------------------------------
+    // Public API
+    //---------------------------------------------------------------------------
+    //! Get symbol of name, assigning it the next ID if it hasn't been seen before
+    Symbol intern(std::string_view name);
+
+    //! Get symbol of name without interning it, NONE if it hasn't been seen before
+    Symbol find(std::string_view name) const;
+
+    std::string_view getName(Symbol symbol) const;
+
+    size_t size() const { return m_NumParentSymbols + m_Names.size(); }
+
+private:
+    //---------------------------------------------------------------------------
+    // Private methods
+    //---------------------------------------------------------------------------
+    //! Get symbol of name with hash in this table or its parents, NONE if it hasn't been interned
+    Symbol find(std::string_view name, uint32_t hash) const;
+
+    //! Get slot containing index of name or, if it hasn't been interned in this table, the empty slot it should be inserted into
+    size_t findSlot(std::string_view name, uint32_t hash) const;
+
+    //---------------------------------------------------------------------------
+    // Members
+    //---------------------------------------------------------------------------
+    const SymbolTable *m_Parent;
+
+    //! Number of symbols in parent, which this table's symbols follow
+    size_t m_NumParentSymbols;
+
+    //! Names indexed by symbol minus the number of parent symbols, 
+    //! stored in a deque so views of them remain valid as more are added
+    std::deque<std::string> m_Names;
+
+    //! Hashes of names indexed like names, used to reject non-matching slots without comparing names
+    std::vector<uint32_t> m_Hashes;
+
+    //! Open-addressed hash table of indices of names plus one, zero indicates an empty slot
+    std::vector<uint32_t> m_Slots;
+};
+}   // namespace MiniParse
@@ -7,6 +7,9 @@
 // Standard C includes
 #include <cstdint>
 
+// Mini-parse includes
+#include "symbol_table.h"
+
 //---------------------------------------------------------------------------
 // MiniParse::Token
 //---------------------------------------------------------------------------
@@ -16,7 +19,7 @@ struct Token
 {
     typedef std::variant<std::monostate, bool, float, double, uint32_t, int32_t/*, uint64_t, int64_t*/> LiteralValue;
 
-    enum class Type
+    enum class Type : uint8_t
     {
         // Single-character tokens
         LEFT_PAREN, RIGHT_PAREN, LEFT_BRACE, RIGHT_BRACE, LEFT_SQUARE_BRACKET, RIGHT_SQUARE_BRACKET,
@@ -48,15 +51,21 @@ struct Token
         END_OF_FILE,
     };
 
-    Token(Type type, std::string_view lexeme, size_t line, LiteralValue literalValue = LiteralValue())
-        : type(type), lexeme(lexeme), line(line), literalValue(literalValue)
+    Token(Type type, std::string_view lexeme, size_t line, LiteralValue literalValue = LiteralValue(), 
+          Symbol symbol = Symbol::NONE)
+        : type(type), symbol(symbol), lexeme(lexeme), line(line), literalValue(literalValue)
     {
     }
 
-    const Type type;
-    const std::string_view lexeme;
-    const size_t line;
-    const LiteralValue literalValue;
+    Type type;
+
+    //! Symbol of identifier tokens
+    //! **NOTE** stored after type to fill its padding
+    Symbol symbol;
+
+    std::string_view lexeme;
+    size_t line;
+    LiteralValue literalValue;
 };
 
 }
@@ -0,0 +1,121 @@
+#pragma once
+
+// Standard C++ includes
+#include <string_view>
+#include <vector>
+
+// Standard C includes
+#include <cstdint>
+
+// Mini-parse includes
+#include "token.h"
+#include "utils.h"
+
+//---------------------------------------------------------------------------
+// MiniParse::CompactToken
+//---------------------------------------------------------------------------
+namespace MiniParse
+{
+//! 16 byte token whose lexeme is stored as a range of the TokenStream's source and whose
+//! literal value and line are stored in side tables so it can be navigated without copying
+struct CompactToken
+{
+    Token::Type type;
+
+    //! Offset and length of lexeme in source
+    uint32_t offset;
+    uint32_t length;
+
+    union
+    {
+        //! Index of literal value in stream's literal table, zero if token has no literal value
+        uint32_t literalIndex;
+
+        //! Symbol of identifier tokens, which never have literal values
+        Symbol symbol;
+    };
+};
+
+static_assert(sizeof(CompactToken) == 16);
+
+//---------------------------------------------------------------------------
+// MiniParse::TokenStream
+//---------------------------------------------------------------------------
+//! Stream of compact tokens scanned from a single source, which must outlive the stream
+//! and any full Tokens obtained from it. Line numbers are recovered from a table of line offsets
+class TokenStream
+{
+public:
+    typedef CompactToken value_type;
+
+    //! Position at which the tokens of another stream are appended
+    struct AppendPosition
+    {
+        size_t firstToken;
+        uint32_t numPreviousLiterals;
+    };
+
+    TokenStream(std::string_view source);
+
+    //---------------------------------------------------------------------------
+    // Public API
+    //---------------------------------------------------------------------------
+    //! Add token whose lexeme spans source from offset to end
+    void addToken(Token::Type type, size_t offset, size_t end, const Token::LiteralValue &literalValue = Token::LiteralValue());
+
+    //! Add identifier token whose lexeme spans source from offset to end
+    void addIdentifier(size_t offset, size_t end, Symbol symbol);
+
+    //! Record that a new line starts at offset
+    void addLine(size_t offset);
+
+    //! Append literal values and lines of stream scanned from the part of the same source following this one
+    //! and make space for its tokens. These must be copied with copyTokens before any tokens are accessed
+    AppendPosition prepareAppend(const TokenStream &stream);
+
+    //! Copy tokens of stream into space made by prepareAppend, mapping the symbols of its identifiers through 
+    //! symbols, which is indexed by their original symbol. Tokens of different streams can be copied in parallel
+    void copyTokens(const TokenStream &stream, const AppendPosition &position, const std::vector<Symbol> &symbols);
+
+    const CompactToken &operator[](size_t index) const { return m_Tokens[index]; }
+    size_t size() const { return m_Tokens.size(); }
+    void reserve(size_t numTokens) { m_Tokens.reserve(numTokens); }
+
+    std::string_view getLexeme(const CompactToken &token) const { return m_Source.substr(token.offset, token.length); }
+    const Token::LiteralValue &getLiteralValue(const CompactToken &token) const
+    {
+        return m_Literals[(token.type == Token::Type::IDENTIFIER) ? 0 : token.literalIndex];
+    }
+    Symbol getSymbol(const CompactToken &token) const
+    {
+        return (token.type == Token::Type::IDENTIFIER) ? token.symbol : Symbol::NONE;
+    }
+    size_t getLine(const CompactToken &token) const;
+
+    //! Get line of token, searching outward from the line index in hint which is updated to that of token.
+    //! This is faster than searching all lines when tokens are accessed in roughly source order
+    size_t getLine(const CompactToken &token, size_t &hint) const;
+
+    //! Expand compact token into full token e.g. to store in AST node
+    Token getToken(const CompactToken &token) const;
+
+    //! Expand compact token into full token, using hint to find its line
+    Token getToken(const CompactToken &token, size_t &hint) const;
+
+    std::string_view getSource() const { return m_Source; }
+
+private:
+    //---------------------------------------------------------------------------
+    // Members
+    //---------------------------------------------------------------------------
+    std::string_view m_Source;
+    //! **NOTE** tokens aren't initialised when resized so space can be made for them without writing to it
+    std::vector<CompactToken, Utils::DefaultInitAllocator<CompactToken>> m_Tokens;
+
+    //! Literal values of tokens, starting with an empty value used by all tokens which don't have one
+    std::vector<Token::LiteralValue> m_Literals;
+
+    //! Offsets in source at which each line starts
+    std::vector<uint32_t> m_LineOffsets;
+};
+}   // namespace MiniParse
@@ -5,27 +5,23 @@
 
 // Standard C++ includes
 #include <limits>
-#include <set>
 #include <string>
 #include <string_view>
-#include <typeinfo>
+#include <tuple>
 #include <type_traits>
 #include <vector>
 
 //----------------------------------------------------------------------------
 // Macros
 //----------------------------------------------------------------------------
-#define DECLARE_TYPE(TYPE)                          \
-    private:                                        \
-        /*GENN_EXPORT*/ static TYPE *s_Instance;    \
-    public:                                         \
-        static const TYPE *getInstance()            \
-        {                                           \
-            if(s_Instance == NULL)                  \
-            {                                       \
-                s_Instance = new TYPE;              \
-            }                                       \
-            return s_Instance;                      \
+// **NOTE** instances are constant-initialised so can be used from any thread without synchronisation
+#define DECLARE_TYPE(TYPE)                                      \
+    private:                                                    \
+        /*GENN_EXPORT*/ static const TYPE s_Instance;           \
+    public:                                                     \
+        static constexpr const TYPE *getInstance()              \
+        {                                                       \
+            return &s_Instance;                                 \
         }
 
 #define DECLARE_NUMERIC_TYPE(TYPE, UNDERLYING_TYPE, RANK)                   \
@@ -49,13 +45,19 @@
         using NumericPtrType = TYPE##Ptr;                                   \
     }
 
-#define DECLARE_FOREIGN_FUNCTION_TYPE(TYPE, RETURN_TYPE, ...)       \
-    class TYPE : public ForeignFunction<RETURN_TYPE, __VA_ARGS__>   \
-    {                                                               \
-        DECLARE_TYPE(TYPE)                                          \
+// **NOTE** foreign function types declared outside of this library must be given IDs from Type::firstExternalForeignFunctionID
+#define DECLARE_FOREIGN_FUNCTION_TYPE_ID(TYPE, ID, RETURN_TYPE, ...)                    \
+    class TYPE : public Type::ForeignFunction<RETURN_TYPE, __VA_ARGS__>                 \
+    {                                                                                   \
+        DECLARE_TYPE(TYPE)                                                              \
+        constexpr TYPE() : ForeignFunction(ID)                                          \
+        {}                                                                              \
     }
 
-#define IMPLEMENT_TYPE(TYPE) TYPE *TYPE::s_Instance = NULL
+#define DECLARE_FOREIGN_FUNCTION_TYPE(TYPE, RETURN_TYPE, ...) \
+    DECLARE_FOREIGN_FUNCTION_TYPE_ID(TYPE, getForeignFunctionID<TYPE>(), RETURN_TYPE, __VA_ARGS__)
+
+#define IMPLEMENT_TYPE(TYPE) constexpr TYPE TYPE::s_Instance{}
 #define IMPLEMENT_NUMERIC_TYPE(TYPE) IMPLEMENT_TYPE(TYPE); IMPLEMENT_TYPE(TYPE##Ptr)
 
 //----------------------------------------------------------------------------
@@ -69,6 +71,62 @@ struct TypeTraits
 {
 };
 
+//! Underlying types of numeric types, in order of their indices
+typedef std::tuple<bool, int8_t, int16_t, int32_t, uint8_t, uint16_t, uint32_t, float, double> NumericUnderlyingTypes;
+
+//! Foreign function types, in order of their IDs
+//! **NOTE** foreign function types must be added here to be given an ID
+typedef std::tuple<class Exp, class Sqrt> ForeignFunctionTypes;
+
+//! Get index of type T within tuple of types
+template<typename T, typename Tuple, size_t I = 0>
+constexpr size_t getTupleIndex()
+{
+    if constexpr(std::is_same_v<T, std::tuple_element_t<I, Tuple>>) {
+        return I;
+    }
+    else {
+        return getTupleIndex<T, Tuple, I + 1>();
+    }
+}
+
+//! Get index of numeric type with underlying type T, used to index tables of numeric types
+template<typename T>
+constexpr size_t getNumericIndex()
+{
+    return getTupleIndex<T, NumericUnderlyingTypes>();
+}
+
+//! Number of numeric types (and of numeric pointer types)
+constexpr size_t numNumericTypes = std::tuple_size_v<NumericUnderlyingTypes>;
+
+//! Get ID of numeric type with underlying type T, which is its index
+template<typename T>
+constexpr uint16_t getNumericID()
+{
+    return static_cast<uint16_t>(getNumericIndex<T>());
+}
+
+//! Get ID of pointer to numeric type with underlying type T, which follow those of numeric types
+template<typename T>
+constexpr uint16_t getNumericPtrID()
+{
+    return static_cast<uint16_t>(numNumericTypes + getNumericIndex<T>());
+}
+
+//! Get ID of foreign function type T, which follow those of numeric pointer types
+template<typename T>
+constexpr uint16_t getForeignFunctionID()
+{
+    return static_cast<uint16_t>((2 * numNumericTypes) + getTupleIndex<T, ForeignFunctionTypes>());
+}
+
+//! First ID of foreign function types declared outside of this library, which follow those declared within it
+constexpr uint16_t firstExternalForeignFunctionID = static_cast<uint16_t>((2 * numNumericTypes) + std::tuple_size_v<ForeignFunctionTypes>);
+
+//! Set of type specifier keywords, encoded as a bitmask with one bit per keyword
+typedef uint16_t TypeSpecifiers;
+
 //----------------------------------------------------------------------------
 // Type::Base
 //----------------------------------------------------------------------------
@@ -76,19 +134,66 @@ struct TypeTraits
 class Base
 {
 public:
+    //! Kind of type, used to downcast without RTTI
+    enum class Kind : uint8_t
+    {
+        NUMERIC,
+        NUMERIC_PTR,
+        FOREIGN_FUNCTION,
+    };
+
+    constexpr Base(Kind kind, uint16_t id) : m_Kind(kind), m_ID(id)
+    {}
+
     //------------------------------------------------------------------------
     // Declared virtuals
     //------------------------------------------------------------------------
     virtual std::string getTypeName() const = 0;
-    virtual size_t getTypeHash() const = 0;
+
+    //------------------------------------------------------------------------
+    // Public API
+    //------------------------------------------------------------------------
+    Kind getKind() const { return m_Kind; }
+
+    //! Get small integer ID, unique to this type and stable between runs
+    uint16_t getID() const { return m_ID; }
+
+private:
+    //------------------------------------------------------------------------
+    // Members
+    //------------------------------------------------------------------------
+    const Kind m_Kind;
+    const uint16_t m_ID;
 };
 
+//! Downcast type to T, one of the abstract type classes, returning nullptr if type is null or of another kind
+template<typename T>
+const T *dynamicCast(const Base *type)
+{
+    return (type && type->getKind() == T::kind) ? static_cast<const T*>(type) : nullptr;
+}
+
 //----------------------------------------------------------------------------
 // Type::NumericBase
 //----------------------------------------------------------------------------
 class NumericBase : public Base
 {
 public:
+    constexpr NumericBase(uint16_t id) : Base(kind, id)
+    {}
+
+    //------------------------------------------------------------------------
+    // Constants
+    //------------------------------------------------------------------------
+    static constexpr Kind kind = Kind::NUMERIC;
+
+    //------------------------------------------------------------------------
+    // Public API
+    //------------------------------------------------------------------------
+    //! Get index of this type amongst numeric types
+    //! **NOTE** the IDs of numeric types are their indices
+    size_t getIndex() const { return getID(); }
+
     //------------------------------------------------------------------------
     // Declared virtuals
     //------------------------------------------------------------------------
@@ -108,6 +213,14 @@ public:
 class NumericPtrBase : public Base
 {
 public:
+    constexpr NumericPtrBase(uint16_t id) : Base(kind, id)
+    {}
+
+    //------------------------------------------------------------------------
+    // Constants
+    //------------------------------------------------------------------------
+    static constexpr Kind kind = Kind::NUMERIC_PTR;
+
     //------------------------------------------------------------------------
     // Declared virtuals
     //------------------------------------------------------------------------
@@ -121,15 +234,19 @@ template<typename T, int Rank>
 class Numeric : public NumericBase
 {
 public:
+    constexpr Numeric() : NumericBase(getNumericID<T>())
+    {}
+
     //------------------------------------------------------------------------
     // Typedefines
     //------------------------------------------------------------------------
     typedef T UnderlyingType;
 
     //------------------------------------------------------------------------
-    // Base virtuals
+    // Constants
     //------------------------------------------------------------------------
-    virtual size_t getTypeHash() const final { return typeid(T).hash_code(); }
+    //! Rank, available at compile time for building tables of numeric types
+    static constexpr int rank = Rank;
 
     //------------------------------------------------------------------------
     // NumericBase virtuals
@@ -154,11 +271,13 @@ template<typename T>
 class NumericPtr : public NumericPtrBase
 {
 public:
+    constexpr NumericPtr() : NumericPtrBase(getNumericPtrID<typename T::UnderlyingType>())
+    {}
+
     //------------------------------------------------------------------------
     // Base virtuals
     //------------------------------------------------------------------------
     virtual std::string getTypeName() const final { return T::getInstance()->getTypeName() + "*"; }
-    virtual size_t getTypeHash() const final { return typeid(std::add_pointer_t<typename T::UnderlyingType>).hash_code(); }
 
     //------------------------------------------------------------------------
     // NumericArrayBase virtuals
@@ -172,11 +291,18 @@ public:
 class ForeignFunctionBase : public Base
 {
 public:
+    constexpr ForeignFunctionBase(uint16_t id) : Base(kind, id)
+    {}
+
+    //------------------------------------------------------------------------
+    // Constants
+    //------------------------------------------------------------------------
+    static constexpr Kind kind = Kind::FOREIGN_FUNCTION;
+
     //------------------------------------------------------------------------
     // Base virtuals
     //------------------------------------------------------------------------
     virtual std::string getTypeName() const = 0;
-    virtual size_t getTypeHash() const = 0;
 
     //------------------------------------------------------------------------
     // Declared virtuals
@@ -192,6 +318,9 @@ template<typename ReturnType, typename ...ArgTypes>
 class ForeignFunction : public ForeignFunctionBase
 {
 public:
+    constexpr ForeignFunction(uint16_t id) : ForeignFunctionBase(id)
+    {}
+
     //------------------------------------------------------------------------
     // Base virtuals
     //------------------------------------------------------------------------
@@ -203,14 +332,6 @@ public:
         return typeName;
     }
 
-    virtual size_t getTypeHash() const final
-    {
-        // Start with seed of return type hash
-        size_t seed = getReturnType()->getTypeHash();
-        updateTypeHash<ArgTypes...>(seed);
-        return seed;
-    }
-
     //------------------------------------------------------------------------
     // ForeignFunctionBase virtuals
     //------------------------------------------------------------------------
@@ -231,19 +352,6 @@ private:
     //------------------------------------------------------------------------
     // Private methods
     //------------------------------------------------------------------------
-    template <typename T, typename... Args>
-    static void updateTypeHash(size_t &seed)
-    {
-        // Combine hashes with argument type
-        // **NOTE** this is the boost::hash_combine algorithm
-        seed ^= T::getInstance()->getTypeHash() + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-
-        // If there are more arguments left in pack, recurse
-        if constexpr (sizeof...(Args)) {
-            updateTypeHash<Args...>(seed);
-        }
-    }
-
     template <typename T, typename... Args>
     static void updateTypeName(std::string &typeName)
     {
@@ -292,9 +400,12 @@ DECLARE_NUMERIC_TYPE(Double, double, 60);
 DECLARE_FOREIGN_FUNCTION_TYPE(Exp, Double, Double);
 DECLARE_FOREIGN_FUNCTION_TYPE(Sqrt, Double, Double);
 
+//! Get bit encoding type specifier keyword, or zero if keyword isn't a type specifier
+TypeSpecifiers getTypeSpecifier(std::string_view keyword);
+
 //! Look up type based on set of type specifiers
-const NumericBase *getNumericType(const std::set<std::string_view> &typeSpecifiers);
-const NumericPtrBase *getNumericPtrType(const std::set<std::string_view> &typeSpecifiers);
+const NumericBase *getNumericType(TypeSpecifiers typeSpecifiers);
+const NumericPtrBase *getNumericPtrType(TypeSpecifiers typeSpecifiers);
 const NumericBase *getPromotedType(const NumericBase *type);
 const NumericBase *getCommonType(const NumericBase *a, const NumericBase *b);
 }   // namespace Type
@@ -1,12 +1,18 @@
 #pragma once
 
 // Standard C++ includes
+#include <optional>
 #include <stdexcept>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
+
+// Standard C includes
+#include <cstdint>
 
 // Mini-parse includes
 #include "statement.h"
+#include "symbol_table.h"
 
 // Forward declarations
 namespace MiniParse
@@ -20,15 +26,102 @@ class Base;
 }
 
 //---------------------------------------------------------------------------
-// MiniParse::TypeChecker::Environment
+// MiniParse::TypeChecker::SwitchTable
 //---------------------------------------------------------------------------
 namespace MiniParse::TypeChecker
 {
+//! Types of every expression visited by the type checker, used by later compilation stages
+typedef std::unordered_map<const Expression::Base*, const Type::Base*> ResolvedTypeMap;
+
+//! Case and default labels of a switch statement resolved by the type checker
+class SwitchTable
+{
+public:
+    typedef Statement::Switch::Case Case;
+
+    SwitchTable(std::vector<Case> cases, std::optional<Case> defaultCase);
+
+    //---------------------------------------------------------------------------
+    // Public API
+    //---------------------------------------------------------------------------
+    //! Cases sorted by value
+    const std::vector<Case> &getCases() const { return m_Cases; }
+    const std::optional<Case> &getDefault() const { return m_Default; }
+
+    //! Find case with value converted to promoted type of condition, falling back to default
+    const Case *findCase(int64_t value) const;
+
+private:
+    //---------------------------------------------------------------------------
+    // Members
+    //---------------------------------------------------------------------------
+    std::vector<Case> m_Cases;
+    std::optional<Case> m_Default;
+
+    //! If case values are dense, index of case for each value from that of first case onwards, otherwise empty
+    //! **NOTE** indices rather than pointers are stored so tables can be copied. Values without a case use m_Cases.size()
+    std::vector<uint32_t> m_JumpTable;
+};
+
+//---------------------------------------------------------------------------
+// MiniParse::TypeChecker::Resolution
+//---------------------------------------------------------------------------
+//! Everything the type checker resolves about statements, used by later compilation stages and backends.
+//! This is stored in side tables keyed by node rather than in the AST so the AST remains read-only
+//! and the same statements can be checked repeatedly or executed concurrently
+struct Resolution
+{
+    //---------------------------------------------------------------------------
+    // Public API
+    //---------------------------------------------------------------------------
+    //! Get slot variable of assignment, increment, decrement or variable expression was resolved to
+    std::optional<Expression::VariableSlot> getSlot(const Expression::Base *expression) const;
+
+    //! Get number of variable slots in scope of compound or for statement
+    size_t getNumSlots(const Statement::Base *statement) const;
+
+    //! Get slot of first variable declared by declaration (subsequent variables use consecutive slots)
+    size_t getFirstSlot(const Statement::VarDeclaration *varDeclaration) const;
+
+    //! Get case table of switch statement
+    const SwitchTable &getSwitchTable(const Statement::Switch *switchStatement) const;
+
+    //---------------------------------------------------------------------------
+    // Members
+    //---------------------------------------------------------------------------
+    ResolvedTypeMap types;
+
+    //! Slots variables were resolved to, keyed by assignment, increment, decrement and variable expressions
+    std::unordered_map<const Expression::Base*, Expression::VariableSlot> slots;
+
+    //! Number of slots in scope of compound and for statements and first slot of variable declarations
+    std::unordered_map<const Statement::Base*, size_t> statementSlots;
+
+    std::unordered_map<const Statement::Switch*, SwitchTable> switchTables;
+};
+
+//---------------------------------------------------------------------------
+// MiniParse::TypeChecker::Environment
+//---------------------------------------------------------------------------
+//! Types of variables, keyed by symbol. Enclosed environments share the symbol table of their enclosing environment
 class Environment
 {
 public:
-    Environment(Environment *enclosing = nullptr)
-        : m_Enclosing(enclosing)
+    Environment(SymbolTable &symbolTable)
+        : m_Enclosing(nullptr), m_SymbolTable(symbolTable)
+    {
+    }
+
+    Environment(Environment *enclosing)
+        : m_Enclosing(enclosing), m_SymbolTable(enclosing->m_SymbolTable)
+    {
+    }
+
+    //! Create environment with its own symbol table, layered over that of enclosing environment, so
+    //! enclosing environment can be shared between threads e.g. to provide read-only builtins
+    //! **NOTE** enclosing environments must only be looked up with tokens which have symbols
+    Environment(Environment *enclosing, SymbolTable &symbolTable)
+        : m_Enclosing(enclosing), m_SymbolTable(symbolTable)
     {
     }
 
@@ -36,29 +129,52 @@ public:
     // Public API
     //---------------------------------------------------------------------------
     template<typename T>
-    void define(std::string_view name, bool isConst = false)
+    void define(Symbol name, bool isConst = false)
     {
-        if(!m_Types.try_emplace(name, T::getInstance(), isConst).second) {
-            throw std::runtime_error("Redeclaration of '" + std::string{name} + "'");
+        if(!m_Types.try_emplace(name, T::getInstance(), isConst, m_Types.size()).second) {
+            throw std::runtime_error("Redeclaration of '" + std::string{m_SymbolTable.getName(name)} + "'");
         }
     }
+
+    template<typename T>
+    void define(std::string_view name, bool isConst = false)
+    {
+        define<T>(m_SymbolTable.intern(name), isConst);
+    }
+
     void define(const Token &name, const Type::Base *type, bool isConst, ErrorHandler &errorHandler);
     const Type::Base *assign(const Token &name, const Type::Base *assignedType, bool assignedConst, 
-                             Token::Type op, ErrorHandler &errorHandler);
+                             Token::Type op, ErrorHandler &errorHandler, bool initializer = false);
     const Type::Base *incDec(const Token &name, const Token &op, ErrorHandler &errorHandler);
     std::tuple<const Type::Base*, bool> getType(const Token &name, ErrorHandler &errorHandler) const;
 
+    //! Get number of environments outwards from this one that name is defined in and its slot within that environment
+    std::tuple<size_t, size_t> getSlot(const Token &name, ErrorHandler &errorHandler) const;
+
+    //! Get number of slots required to store variables defined in this environment
+    size_t getNumSlots() const{ return m_Types.size(); }
+
+    //! Get symbol of name, interning its lexeme if token was created without one e.g. by the optimiser
+    Symbol getSymbol(const Token &name) const;
+
+    SymbolTable &getSymbolTable() const{ return m_SymbolTable; }
+
 private:
     //---------------------------------------------------------------------------
     // Members
     //---------------------------------------------------------------------------
     Environment *m_Enclosing;
-    std::unordered_map<std::string_view, std::tuple<const Type::Base*, bool>> m_Types;
+    SymbolTable &m_SymbolTable;
+    std::unordered_map<Symbol, std::tuple<const Type::Base*, bool, size_t>> m_Types;
 };
 
 //---------------------------------------------------------------------------
 // Free functions
 //---------------------------------------------------------------------------
-void typeCheck(const Statement::StatementList &statements, Environment &environment, 
-               ErrorHandler &errorHandler);
+//! Type check statements and resolve the variables they access and the labels of their switch statements.
+//! **NOTE** statements are checked in their own scope, enclosed by environment, so variables they declare at the
+//! top level are local to them rather than being defined in environment. Only variables defined in environment
+//! by the caller are resolved as globals and these are the only variables visible to the caller after execution
+Resolution typeCheck(const Statement::StatementList &statements, Environment &environment, 
+                     ErrorHandler &errorHandler);
 }   // namespace MiniParse::TypeChecker
\ No newline at end of file
@@ -2,13 +2,46 @@
 
 // Standard C++ includes
 #include <charconv>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include <type_traits>
+#include <utility>
 
 namespace MiniParse::Utils
 {
     template<class... Ts> struct Overload : Ts... { using Ts::operator()...; };
     template<class... Ts> Overload(Ts...) -> Overload<Ts...>; // line not needed in
 
+    //! Allocator which default-initialises elements rather than value-initialising them, so resizing a
+    //! vector of trivial types reserves space for elements without writing to them
+    template<typename T, typename A = std::allocator<T>>
+    class DefaultInitAllocator : public A
+    {
+    public:
+        template<typename U>
+        struct rebind
+        {
+            using other = DefaultInitAllocator<U, typename std::allocator_traits<A>::template rebind_alloc<U>>;
+        };
+
+        using A::A;
+
+        template<typename U>
+        void construct(U *p) noexcept(std::is_nothrow_default_constructible_v<U>)
+        {
+            ::new(static_cast<void*>(p)) U;
+        }
+
+        template<typename U, typename... Args>
+        void construct(U *p, Args&&... args)
+        {
+            std::allocator_traits<A>::construct(static_cast<A&>(*this), p, std::forward<Args>(args)...);
+        }
+    };
+
     template<typename T>
     T toCharsThrow(std::string_view input, int base = 10)
     {
@@ -0,0 +1,36 @@
+#pragma once
+
+// Standard C++ includes
+#include <vector>
+
+// Mini-parse includes
+#include "bytecode.h"
+
+//---------------------------------------------------------------------------
+// MiniParse::Bytecode::VirtualMachine
+//---------------------------------------------------------------------------
+namespace MiniParse::Bytecode
+{
+//! Executes bytecode programs using a private register file
+class VirtualMachine
+{
+public:
+    VirtualMachine(const Program &program);
+
+    //------------------------------------------------------------------------
+    // Public API
+    //------------------------------------------------------------------------
+    //! Run program from the start. External registers should be set beforehand and read back after
+    void execute();
+
+    Register &getRegister(uint16_t reg){ return m_Registers[reg]; }
+    const Register &getRegister(uint16_t reg) const{ return m_Registers[reg]; }
+
+private:
+    //------------------------------------------------------------------------
+    // Members
+    //------------------------------------------------------------------------
+    const Program &m_Program;
+    std::vector<Register> m_Registers;
+};
+}   // namespace MiniParse::Bytecode
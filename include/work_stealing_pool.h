@@ -0,0 +1,70 @@
+#pragma once
+
+// Standard C++ includes
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//---------------------------------------------------------------------------
+// MiniParse::WorkStealingPool
+//---------------------------------------------------------------------------
+namespace MiniParse
+{
+//! Persistent pool of worker threads which run batches of independent tasks. Each worker starts with
+//! a contiguous range of task indices and, when it runs out, steals the second half of the range
+//! remaining to another worker so load stays balanced when the cost of tasks varies widely
+class WorkStealingPool
+{
+public:
+    //! Task function, called with the index of the task and of the worker running it
+    typedef std::function<void(size_t, size_t)> Task;
+
+    //! Create pool with numThreads workers, zero to use one per hardware thread
+    WorkStealingPool(size_t numThreads = 0);
+    ~WorkStealingPool();
+
+    //------------------------------------------------------------------------
+    // Public API
+    //------------------------------------------------------------------------
+    //! Run task with indices 0 to numTasks - 1, blocking until all are complete. If any task 
+    //! throws, the worker running it stops and the first exception is re-thrown once the others have finished
+    void run(size_t numTasks, Task task);
+
+    size_t getNumThreads() const{ return m_Workers.size(); }
+
+private:
+    //------------------------------------------------------------------------
+    // Worker
+    //------------------------------------------------------------------------
+    struct Worker;
+
+    //------------------------------------------------------------------------
+    // Private methods
+    //------------------------------------------------------------------------
+    void workerThread(Worker &worker);
+
+    //! Get next task from worker's range, stealing half of another worker's remaining range if it's empty.
+    //! Returns false if there are no tasks remaining in any worker's range
+    bool getTask(Worker &worker, size_t &task);
+
+    //------------------------------------------------------------------------
+    // Members
+    //------------------------------------------------------------------------
+    std::vector<std::unique_ptr<Worker>> m_Workers;
+
+    //! Task being run, only modified while workers are idle
+    Task m_Task;
+
+    //! State shared with workers, protected by mutex
+    std::mutex m_Mutex;
+    std::condition_variable m_StartCondition;
+    std::condition_variable m_DoneCondition;
+    size_t m_Generation;
+    size_t m_NumRemaining;
+    bool m_Stop;
+    std::exception_ptr m_Exception;
+};
+}   // namespace MiniParse
@@ -0,0 +1,98 @@
+#include "arena.h"
+
+// Standard C includes
+#include <cassert>
+#include <cstdint>
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+//! Objects whose deletion has been deferred by the deletion in progress on this thread
+thread_local std::vector<const MiniParse::ArenaNode*> *pendingDeletions = nullptr;
+//---------------------------------------------------------------------------
+char *align(char *pointer, size_t alignment)
+{
+    const uintptr_t address = reinterpret_cast<uintptr_t>(pointer);
+    return reinterpret_cast<char*>((address + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1));
+}
+}
+
+//---------------------------------------------------------------------------
+// MiniParse::ArenaDeleter
+//---------------------------------------------------------------------------
+void MiniParse::ArenaDeleter::operator()(const ArenaNode *object) const
+{
+    // If another deletion is in progress, object is owned by one being deleted so defer
+    if(pendingDeletions) {
+        pendingDeletions->push_back(object);
+        return;
+    }
+
+    // Otherwise, delete object and then any it owns, which will be deferred until their owner's destructor has returned
+    std::vector<const ArenaNode*> deletions{object};
+    pendingDeletions = &deletions;
+    while(!deletions.empty()) {
+        const ArenaNode *deletion = deletions.back();
+        deletions.pop_back();
+
+        if(deletion->isArenaAllocated()) {
+            deletion->~ArenaNode();
+        }
+        else {
+            delete deletion;
+        }
+    }
+    pendingDeletions = nullptr;
+}
+
+//---------------------------------------------------------------------------
+// MiniParse::Arena
+//---------------------------------------------------------------------------
+MiniParse::Arena::Arena(size_t blockSize)
+:   m_BlockSize(blockSize), m_NumLargeBlockBytes(0), m_NextBlock(0), m_Current(nullptr), m_End(nullptr),
+    m_NumObjects(0), m_NumBytesAllocated(0)
+{
+}
+//---------------------------------------------------------------------------
+void *MiniParse::Arena::allocate(size_t size, size_t alignment)
+{
+    // **NOTE** blocks are allocated with new[] so are only aligned for fundamental types
+    assert(alignment <= alignof(std::max_align_t));
+    m_NumBytesAllocated += size;
+
+    // If allocation fits in remainder of current block, bump pointer
+    char *start = align(m_Current, alignment);
+    if(m_Current && (start + size) <= m_End) {
+        m_Current = start + size;
+        return start;
+    }
+
+    // Otherwise, if allocation wouldn't fit in a standard block, give it its own
+    if(size > m_BlockSize) {
+        m_LargeBlocks.emplace_back(new char[size]);
+        m_NumLargeBlockBytes += size;
+        return m_LargeBlocks.back().get();
+    }
+
+    // Otherwise, move onto next block, re-using any retained by reset
+    if(m_NextBlock == m_Blocks.size()) {
+        m_Blocks.emplace_back(new char[m_BlockSize]);
+    }
+    start = m_Blocks[m_NextBlock++].get();
+    m_Current = start + size;
+    m_End = start + m_BlockSize;
+    return start;
+}
+//---------------------------------------------------------------------------
+void MiniParse::Arena::reset()
+{
+    m_LargeBlocks.clear();
+    m_NumLargeBlockBytes = 0;
+    m_NextBlock = 0;
+    m_Current = nullptr;
+    m_End = nullptr;
+    m_NumObjects = 0;
+    m_NumBytesAllocated = 0;
+}
@@ -0,0 +1,85 @@
+#include "batch_compiler.h"
+
+// Mini-parse includes
+#include "parser.h"
+#include "scanner.h"
+#include "token_stream.h"
+#include "work_stealing_pool.h"
+
+//---------------------------------------------------------------------------
+// MiniParse::BatchCompiler::DiagnosticSink
+//---------------------------------------------------------------------------
+void MiniParse::BatchCompiler::DiagnosticSink::add(size_t snippet, ErrorRecorder errors)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Errors.insert_or_assign(snippet, std::move(errors));
+}
+//---------------------------------------------------------------------------
+void MiniParse::BatchCompiler::DiagnosticSink::report(ErrorHandler &errorHandler) const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for(const auto &e : m_Errors) {
+        e.second.report(errorHandler);
+    }
+}
+//---------------------------------------------------------------------------
+void MiniParse::BatchCompiler::DiagnosticSink::report(size_t snippet, ErrorHandler &errorHandler) const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    const auto e = m_Errors.find(snippet);
+    if(e != m_Errors.cend()) {
+        e->second.report(errorHandler);
+    }
+}
+//---------------------------------------------------------------------------
+size_t MiniParse::BatchCompiler::DiagnosticSink::getNumSnippetsWithErrors() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Errors.size();
+}
+
+//---------------------------------------------------------------------------
+// MiniParse::BatchCompiler
+//---------------------------------------------------------------------------
+std::vector<MiniParse::BatchCompiler::Result> MiniParse::BatchCompiler::compileBatch(
+    const std::vector<std::string_view> &sources, TypeChecker::Environment &globals,
+    DiagnosticSink &diagnostics, WorkStealingPool &pool)
+{
+    // Create results with symbol tables layered over that of globals
+    std::vector<Result> results;
+    results.reserve(sources.size());
+    for(size_t i = 0; i < sources.size(); i++) {
+        results.emplace_back(globals.getSymbolTable());
+    }
+
+    // Compile each snippet into its own result
+    // **NOTE** workers only write to their snippet's result and only read globals
+    pool.run(sources.size(),
+             [&sources, &globals, &diagnostics, &results](size_t snippet, size_t)
+             {
+                 Result &result = results[snippet];
+                 ErrorRecorder errors;
+                 const auto tokens = Scanner::scanTokenStream(sources[snippet], result.symbolTable, errors);
+                 if(!errors.hasError()) {
+                     result.statements = Parser::parseBlockItemList(tokens, errors, *result.arena);
+                 }
+                 if(!errors.hasError()) {
+                     // **NOTE** type checker throws once it has reported an error so only re-throw other exceptions
+                     try {
+                         TypeChecker::Environment environment(&globals, result.symbolTable);
+                         result.resolution = TypeChecker::typeCheck(result.statements, environment, errors);
+                     }
+                     catch(...) {
+                         if(!errors.hasError()) {
+                             throw;
+                         }
+                     }
+                 }
+
+                 result.success = !errors.hasError();
+                 if(!result.success) {
+                     diagnostics.add(snippet, std::move(errors));
+                 }
+             });
+    return results;
+}
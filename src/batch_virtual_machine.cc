@@ -0,0 +1,508 @@
+#include "batch_virtual_machine.h"
+
+// Standard C++ includes
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+using namespace MiniParse::Bytecode;
+
+//---------------------------------------------------------------------------
+// Macros
+//---------------------------------------------------------------------------
+// Lanes are independent so, even when an instruction's destination is also one of its operands,
+// lane loops carry no dependencies and can be vectorised without runtime alias checks
+#if defined(__GNUC__) && !defined(__clang__)
+    #define MINI_PARSE_IVDEP _Pragma("GCC ivdep")
+#else
+    #define MINI_PARSE_IVDEP
+#endif
+
+// Detect ThreadSanitizer builds under both GCC and Clang
+#if defined(__SANITIZE_THREAD__)
+    #define MINI_PARSE_THREAD_SANITIZER
+#elif defined(__has_feature)
+    #if __has_feature(thread_sanitizer)
+        #define MINI_PARSE_THREAD_SANITIZER
+    #endif
+#endif
+
+// On x86-64 Linux, compile the block kernel for several instruction sets and pick the best at load time.
+// **NOTE** unlike VirtualMachine, dispatch uses a switch as functions containing label tables can't be cloned
+// and, because each instruction processes a whole block of lanes, dispatch overhead is amortised anyway.
+// Clones are selected by ifunc resolvers which run before the ThreadSanitizer runtime is initialised
+// and crash any program this is linked into so, in ThreadSanitizer builds, only the default kernel is built
+#if defined(__GNUC__) && defined(__x86_64__) && defined(__linux__) && !defined(MINI_PARSE_THREAD_SANITIZER)
+    #define MINI_PARSE_TARGET_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+    #define MINI_PARSE_TARGET_CLONES
+#endif
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+constexpr size_t blockSize = BatchVirtualMachine::blockSize;
+static_assert(blockSize <= 64, "Lane masks are stored in 64-bit words");
+
+//! Mask with bit set for every lane in block
+constexpr uint64_t allLanes = (blockSize == 64) ? ~0ull : ((1ull << blockSize) - 1);
+
+//! Lanes active when IF was executed and lanes where its condition was true
+struct IfState
+{
+    uint64_t parent;
+    uint64_t condition;
+};
+
+//! Lanes active when loop was entered, lanes which have not exited and lanes which have continued this iteration
+struct LoopState
+{
+    uint64_t parent;
+    uint64_t active;
+    uint64_t continued;
+};
+
+//---------------------------------------------------------------------------
+//! Convert floating point value to integer, giving zero rather than undefined behaviour if it's out of range
+//! **NOTE** every lane is converted so inactive lanes, which hold arbitrary values, must be handled safely
+template<typename T, typename F>
+T convertToInteger(F value)
+{
+    // **NOTE** value is exactly representable as a double and comparisons are false if it's NaN
+    const double v = value;
+    if(v > (static_cast<double>(std::numeric_limits<T>::min()) - 1.0)
+       && v < (static_cast<double>(std::numeric_limits<T>::max()) + 1.0))
+    {
+        return static_cast<T>(value);
+    }
+    else {
+        return 0;
+    }
+}
+//---------------------------------------------------------------------------
+//! Call f with null pointer of the C++ type corresponding to type
+template<typename F>
+void visitType(const Type::NumericBase *type, F f)
+{
+    if(type == Type::Bool::getInstance()) {
+        f(static_cast<bool*>(nullptr));
+    }
+    else if(type == Type::Int8::getInstance()) {
+        f(static_cast<int8_t*>(nullptr));
+    }
+    else if(type == Type::Int16::getInstance()) {
+        f(static_cast<int16_t*>(nullptr));
+    }
+    else if(type == Type::Int32::getInstance()) {
+        f(static_cast<int32_t*>(nullptr));
+    }
+    else if(type == Type::Uint8::getInstance()) {
+        f(static_cast<uint8_t*>(nullptr));
+    }
+    else if(type == Type::Uint16::getInstance()) {
+        f(static_cast<uint16_t*>(nullptr));
+    }
+    else if(type == Type::Uint32::getInstance()) {
+        f(static_cast<uint32_t*>(nullptr));
+    }
+    else if(type == Type::Float::getInstance()) {
+        f(static_cast<float*>(nullptr));
+    }
+    else {
+        f(static_cast<double*>(nullptr));
+    }
+}
+//---------------------------------------------------------------------------
+//! Get field of (lane) register used to store values of C++ type T
+template<typename T, typename R>
+auto &getField(R &reg)
+{
+    if constexpr(std::is_same_v<T, double>) {
+        return reg.f64;
+    }
+    else if constexpr(std::is_same_v<T, float>) {
+        return reg.f32;
+    }
+    else if constexpr(std::is_signed_v<T>) {
+        return reg.i32;
+    }
+    else {
+        return reg.u32;
+    }
+}
+//---------------------------------------------------------------------------
+//! Copy values of lanes from array into register
+template<typename T>
+void gatherLanes(BatchVirtualMachine::LaneRegister &reg, const void *array, size_t firstLane, size_t numLanes)
+{
+    std::copy_n(static_cast<const T*>(array) + firstLane, numLanes, getField<T>(reg));
+}
+//---------------------------------------------------------------------------
+//! Copy values of lanes from register back into array
+template<typename T>
+void scatterLanes(const BatchVirtualMachine::LaneRegister &reg, void *array, size_t firstLane, size_t numLanes)
+{
+    const auto &field = getField<T>(reg);
+    std::transform(field, field + numLanes, static_cast<T*>(array) + firstLane,
+                   [](auto v) { return static_cast<T>(v); });
+}
+
+typedef void (*GatherFunction)(BatchVirtualMachine::LaneRegister&, const void*, size_t, size_t);
+typedef void (*ScatterFunction)(const BatchVirtualMachine::LaneRegister&, void*, size_t, size_t);
+
+//---------------------------------------------------------------------------
+//! Get mask of lanes where register is non-zero
+uint64_t getConditionMask(const BatchVirtualMachine::LaneRegister &reg)
+{
+    uint64_t mask = 0;
+    for(size_t l = 0; l < blockSize; l++) {
+        mask |= static_cast<uint64_t>(reg.i32[l] != 0) << l;
+    }
+    return mask;
+}
+//---------------------------------------------------------------------------
+//! Run program for one block of lanes, of which the first numLanes are valid
+MINI_PARSE_TARGET_CLONES
+void executeBlock(const Program &program, BatchVirtualMachine::LaneRegister *r, size_t firstLane, size_t numLanes,
+                  std::vector<IfState> &ifStack, std::vector<LoopState> &loopStack)
+{
+    const Instruction *pc = program.getInstructions().data();
+    const Instruction *const instructions = pc;
+    const Program::Function *const functions = program.getFunctions().data();
+
+    // Per-lane copy of mask for blending results
+    // **NOTE** when every lane is active, results are written without blending
+    uint64_t mask = 0;
+    bool full = false;
+    alignas(64) uint32_t laneMask[blockSize];
+    auto setMask = [&mask, &full, &laneMask](uint64_t newMask)
+    {
+        mask = newMask;
+        full = (newMask == allLanes);
+        for(size_t l = 0; l < blockSize; l++) {
+            laneMask[l] = (newMask >> l) & 1;
+        }
+    };
+
+    // Lanes which haven't left innermost loop through break or continue
+    auto getLiveLanes = [&loopStack]()
+    {
+        return loopStack.empty() ? allLanes : (loopStack.back().active & ~loopStack.back().continued);
+    };
+
+    ifStack.clear();
+    loopStack.clear();
+    setMask((numLanes == blockSize) ? allLanes : ((1ull << numLanes) - 1));
+
+    #define CASE(OP) case OpCode::OP:
+    #define NEXT() pc++; continue
+    #define DISPATCH_JUMP() continue
+    while(true) {
+        switch(pc->opCode) {
+
+    // Write value, calculated from operands a and b, to destination field in active lanes
+    // **NOTE** value is calculated for every lane and blended so loops contain no branches
+    #define LANES(DST_FIELD, SRC_FIELD, VALUE)                                                              \
+    {                                                                                                       \
+        auto *const d = r[pc->dst].DST_FIELD;                                                               \
+        const auto *const a = r[pc->a].SRC_FIELD;                                                           \
+        const auto *const b = r[pc->b].SRC_FIELD;                                                           \
+        static_cast<void>(b);                                                                               \
+        if(full) {                                                                                          \
+            MINI_PARSE_IVDEP for(size_t l = 0; l < blockSize; l++) { d[l] = (VALUE); }                      \
+        }                                                                                                   \
+        else {                                                                                              \
+            MINI_PARSE_IVDEP for(size_t l = 0; l < blockSize; l++) {                                        \
+                const auto v = (VALUE);                                                                     \
+                d[l] = laneMask[l] ? v : d[l];                                                              \
+            }                                                                                               \
+        }                                                                                                   \
+        NEXT();                                                                                             \
+    }
+
+    // **NOTE** inactive lanes hold arbitrary values so signed integer arithmetic is performed
+    // in the corresponding unsigned ARITHMETIC_TYPE, where it wraps rather than overflowing
+    #define ARITHMETIC(C_TYPE, ARITHMETIC_TYPE, OP) static_cast<C_TYPE>(static_cast<ARITHMETIC_TYPE>(a[l]) OP static_cast<ARITHMETIC_TYPE>(b[l]))
+    #define ARITHMETIC_CASES(TYPE, FIELD, C_TYPE, ARITHMETIC_TYPE)                                          \
+        CASE(ADD_##TYPE) LANES(FIELD, FIELD, ARITHMETIC(C_TYPE, ARITHMETIC_TYPE, +))                        \
+        CASE(SUB_##TYPE) LANES(FIELD, FIELD, ARITHMETIC(C_TYPE, ARITHMETIC_TYPE, -))                        \
+        CASE(MUL_##TYPE) LANES(FIELD, FIELD, ARITHMETIC(C_TYPE, ARITHMETIC_TYPE, *))                        \
+        CASE(LT_##TYPE) LANES(i32, FIELD, a[l] < b[l])                                                      \
+        CASE(LE_##TYPE) LANES(i32, FIELD, a[l] <= b[l])                                                     \
+        CASE(GT_##TYPE) LANES(i32, FIELD, a[l] > b[l])                                                      \
+        CASE(GE_##TYPE) LANES(i32, FIELD, a[l] >= b[l])                                                     \
+        CASE(EQ_##TYPE) LANES(i32, FIELD, a[l] == b[l])                                                     \
+        CASE(NE_##TYPE) LANES(i32, FIELD, a[l] != b[l])                                                     \
+        CASE(NEG_##TYPE) LANES(FIELD, FIELD, static_cast<C_TYPE>(-static_cast<ARITHMETIC_TYPE>(a[l])))      \
+        CASE(NOT_##TYPE) LANES(i32, FIELD, !a[l])                                                           \
+        CASE(MOV_##TYPE) LANES(FIELD, FIELD, a[l])
+
+    // **NOTE** inactive lanes hold arbitrary values so integer division is guarded against trapping and shifts
+    // are guarded against undefined behaviour. Left shifts are performed on unsigned values so they never overflow
+    #define SAFE_SHIFT (static_cast<uint32_t>(b[l]) < 32)
+    #define INTEGER_CASES(TYPE, FIELD, C_TYPE, SAFE_DIVISOR)                                                \
+        CASE(DIV_##TYPE) LANES(FIELD, FIELD, SAFE_DIVISOR ? (a[l] / b[l]) : 0)                              \
+        CASE(MOD_##TYPE) LANES(FIELD, FIELD, SAFE_DIVISOR ? (a[l] % b[l]) : 0)                              \
+        CASE(AND_##TYPE) LANES(FIELD, FIELD, a[l] & b[l])                                                   \
+        CASE(OR_##TYPE) LANES(FIELD, FIELD, a[l] | b[l])                                                    \
+        CASE(XOR_##TYPE) LANES(FIELD, FIELD, a[l] ^ b[l])                                                   \
+        CASE(SHL_##TYPE) LANES(FIELD, FIELD, SAFE_SHIFT ? static_cast<C_TYPE>(static_cast<uint32_t>(a[l]) << b[l]) : 0) \
+        CASE(SHR_##TYPE) LANES(FIELD, FIELD, SAFE_SHIFT ? (a[l] >> b[l]) : 0)                               \
+        CASE(BNOT_##TYPE) LANES(FIELD, FIELD, ~a[l])
+
+    #define CONVERSION_CASE(FROM, FROM_FIELD, TO, TO_FIELD, TO_TYPE)                                        \
+        CASE(CVT_##FROM##_##TO) LANES(TO_FIELD, FROM_FIELD, static_cast<TO_TYPE>(a[l]))
+
+    #define INTEGER_CONVERSION_CASE(FROM, FROM_FIELD, TO, TO_FIELD, TO_TYPE)                                \
+        CASE(CVT_##FROM##_##TO) LANES(TO_FIELD, FROM_FIELD, convertToInteger<TO_TYPE>(a[l]))
+
+    #define PRINT_CASE(OP, PREFIX, VALUE)                                                                   \
+        CASE(OP)                                                                                            \
+            for(size_t l = 0; l < blockSize; l++) {                                                         \
+                if(laneMask[l]) {                                                                           \
+                    std::cout << "[" << (firstLane + l) << "] " PREFIX << (VALUE) << std::endl;             \
+                }                                                                                           \
+            }                                                                                               \
+            NEXT();
+
+    ARITHMETIC_CASES(I32, i32, int32_t, uint32_t)
+    ARITHMETIC_CASES(U32, u32, uint32_t, uint32_t)
+    ARITHMETIC_CASES(F32, f32, float, float)
+    ARITHMETIC_CASES(F64, f64, double, double)
+    INTEGER_CASES(I32, i32, int32_t, (b[l] != 0 && (b[l] != -1 || a[l] != std::numeric_limits<int32_t>::min())))
+    INTEGER_CASES(U32, u32, uint32_t, (b[l] != 0))
+    CASE(DIV_F32) LANES(f32, f32, a[l] / b[l])
+    CASE(DIV_F64) LANES(f64, f64, a[l] / b[l])
+
+    CONVERSION_CASE(I32, i32, U32, u32, uint32_t)
+    CONVERSION_CASE(I32, i32, F32, f32, float)
+    CONVERSION_CASE(I32, i32, F64, f64, double)
+    CONVERSION_CASE(U32, u32, I32, i32, int32_t)
+    CONVERSION_CASE(U32, u32, F32, f32, float)
+    CONVERSION_CASE(U32, u32, F64, f64, double)
+    INTEGER_CONVERSION_CASE(F32, f32, I32, i32, int32_t)
+    INTEGER_CONVERSION_CASE(F32, f32, U32, u32, uint32_t)
+    CONVERSION_CASE(F32, f32, F64, f64, double)
+    INTEGER_CONVERSION_CASE(F64, f64, I32, i32, int32_t)
+    INTEGER_CONVERSION_CASE(F64, f64, U32, u32, uint32_t)
+    CONVERSION_CASE(F64, f64, F32, f32, float)
+
+    CASE(SEXT8) LANES(i32, i32, static_cast<int8_t>(a[l]))
+    CASE(SEXT16) LANES(i32, i32, static_cast<int16_t>(a[l]))
+    CASE(ZEXT8) LANES(u32, u32, static_cast<uint8_t>(a[l]))
+    CASE(ZEXT16) LANES(u32, u32, static_cast<uint16_t>(a[l]))
+
+    PRINT_CASE(PRINT_I32, "(int32_t)", r[pc->a].i32[l])
+    PRINT_CASE(PRINT_U32, "(uint32_t)", r[pc->a].u32[l])
+    PRINT_CASE(PRINT_F32, "(float)", r[pc->a].f32[l])
+    PRINT_CASE(PRINT_F64, "(double)", r[pc->a].f64[l])
+    PRINT_CASE(PRINT_BOOL, "(bool)", (r[pc->a].i32[l] != 0))
+
+    // Foreign functions are called individually for each active lane
+    CASE(CALL_F64)
+        for(size_t l = 0; l < blockSize; l++) {
+            if(laneMask[l]) {
+                r[pc->dst].f64[l] = functions[pc->b](r[pc->a].f64[l]);
+            }
+        }
+        NEXT();
+
+    CASE(JMP) pc = instructions + pc->dst; DISPATCH_JUMP();
+    CASE(HALT) return;
+
+    // Narrow mask to lanes where condition holds, skipping to ELSE or END_IF if there are none
+    CASE(IF)
+    {
+        const uint64_t condition = getConditionMask(r[pc->a]) ^ (pc->b ? allLanes : 0);
+        ifStack.push_back({mask, condition});
+        setMask(mask & condition);
+        pc = mask ? (pc + 1) : (instructions + pc->dst);
+        DISPATCH_JUMP();
+    }
+
+    // Switch to lanes where condition didn't hold, skipping to END_IF if there are none
+    CASE(ELSE)
+    {
+        const auto &top = ifStack.back();
+        setMask(top.parent & ~top.condition & getLiveLanes());
+        pc = mask ? (pc + 1) : (instructions + pc->dst);
+        DISPATCH_JUMP();
+    }
+
+    CASE(END_IF) setMask(ifStack.back().parent & getLiveLanes()); ifStack.pop_back(); NEXT();
+    CASE(LOOP_BEGIN) loopStack.push_back({mask, mask, 0}); NEXT();
+
+    // Remove lanes where condition doesn't hold from loop, exiting if there are none left
+    CASE(LOOP_COND)
+    {
+        auto &top = loopStack.back();
+        top.active &= getConditionMask(r[pc->a]);
+        setMask(top.active);
+        pc = mask ? (pc + 1) : (instructions + pc->dst);
+        DISPATCH_JUMP();
+    }
+
+    // Re-enable lanes which continued for next iteration, exiting if no lanes remain
+    CASE(LOOP_CONTINUE)
+    {
+        auto &top = loopStack.back();
+        top.continued = 0;
+        setMask(top.active);
+        pc = mask ? (pc + 1) : (instructions + pc->dst);
+        DISPATCH_JUMP();
+    }
+
+    CASE(LOOP_END) setMask(loopStack.back().parent); loopStack.pop_back(); NEXT();
+
+    // Switch bodies are treated like loops which run once so BREAK removes lanes from them.
+    // No lanes are active until SWITCH_CASE enables those where label matches, falling through to subsequent labels
+    CASE(SWITCH_BEGIN) loopStack.push_back({mask, mask, 0}); setMask(0); NEXT();
+    CASE(SWITCH_CASE)
+    {
+        const uint64_t condition = getConditionMask(r[pc->a]) ^ (pc->b ? allLanes : 0);
+        setMask(mask | (condition & getLiveLanes()));
+        NEXT();
+    }
+
+    // Pass lanes which continued on to enclosing loop
+    CASE(SWITCH_END)
+    {
+        const auto top = loopStack.back();
+        loopStack.pop_back();
+        if(!loopStack.empty()) {
+            loopStack.back().continued |= top.continued;
+        }
+        setMask(top.parent & getLiveLanes());
+        NEXT();
+    }
+
+    CASE(BREAK) loopStack.back().active &= ~mask; setMask(0); NEXT();
+    CASE(CONTINUE) loopStack.back().continued |= mask; setMask(0); NEXT();
+
+    // Conditional jumps can't be used when lanes diverge
+    CASE(JZ) CASE(JNZ)
+        throw std::runtime_error("Invalid opcode '" + std::string{getOpCodeName(pc->opCode)} + "'");
+
+        }
+    }
+
+    #undef LANES
+    #undef ARITHMETIC
+    #undef ARITHMETIC_CASES
+    #undef INTEGER_CASES
+    #undef SAFE_SHIFT
+    #undef CONVERSION_CASE
+    #undef INTEGER_CONVERSION_CASE
+    #undef PRINT_CASE
+    #undef CASE
+    #undef NEXT
+    #undef DISPATCH_JUMP
+}
+}   // Anonymous namespace
+
+//---------------------------------------------------------------------------
+// MiniParse::Bytecode::BatchVirtualMachine
+//---------------------------------------------------------------------------
+BatchVirtualMachine::BatchVirtualMachine(const Program &program)
+:   m_Program(program), m_Registers(program.getNumRegisters()), m_Bindings(program.getExternals().size())
+{
+    if(program.getControlFlow() != ControlFlow::MASK) {
+        throw std::runtime_error("BatchVirtualMachine requires programs compiled with masked control flow");
+    }
+
+    // Broadcast constants into the field of the final registers they are read from
+    const auto &constants = program.getConstants();
+    const size_t constantBase = m_Registers.size() - constants.size();
+    for(size_t i = 0; i < constants.size(); i++) {
+        auto &reg = m_Registers[constantBase + i];
+        visitType(program.getConstantTypes()[i],
+                  [&reg, &constants, i](auto *tag)
+                  {
+                      using T = std::remove_pointer_t<decltype(tag)>;
+                      std::fill_n(getField<T>(reg), blockSize, getField<T>(constants[i]));
+                  });
+    }
+}
+//---------------------------------------------------------------------------
+void BatchVirtualMachine::execute(size_t numLanes)
+{
+    const auto &externals = m_Program.getExternals();
+    for(size_t i = 0; i < externals.size(); i++) {
+        if(!m_Bindings[i]) {
+            throw std::runtime_error("External '" + externals[i].name + "' has not been bound");
+        }
+    }
+
+    // Resolve how each external is transferred to and from its register once, rather than every block
+    // **NOTE** scalars are re-broadcast every block in case program writes to them
+    std::vector<std::tuple<LaneRegister*, void*, GatherFunction, ScatterFunction>> arrays;
+    std::vector<std::pair<LaneRegister*, LaneRegister>> scalars;
+    for(size_t i = 0; i < externals.size(); i++) {
+        auto *reg = &m_Registers[externals[i].reg];
+        const auto &binding = *m_Bindings[i];
+        visitType(externals[i].type,
+                  [reg, &binding, &arrays, &scalars](auto *tag)
+                  {
+                      using T = std::remove_pointer_t<decltype(tag)>;
+                      if(binding.array) {
+                          arrays.emplace_back(reg, binding.array, &gatherLanes<T>, &scatterLanes<T>);
+                      }
+                      else {
+                          LaneRegister broadcast;
+                          std::fill_n(getField<T>(broadcast), blockSize, getField<T>(binding.scalar));
+                          scalars.emplace_back(reg, broadcast);
+                      }
+                  });
+    }
+
+    std::vector<IfState> ifStack;
+    std::vector<LoopState> loopStack;
+    for(size_t firstLane = 0; firstLane < numLanes; firstLane += blockSize) {
+        const size_t numBlockLanes = std::min(blockSize, numLanes - firstLane);
+
+        // Gather externals into registers
+        for(const auto &a : arrays) {
+            std::get<2>(a)(*std::get<0>(a), std::get<1>(a), firstLane, numBlockLanes);
+        }
+        for(const auto &s : scalars) {
+            *s.first = s.second;
+        }
+
+        executeBlock(m_Program, m_Registers.data(), firstLane, numBlockLanes, ifStack, loopStack);
+
+        // Scatter array externals back from registers
+        for(const auto &a : arrays) {
+            std::get<3>(a)(*std::get<0>(a), std::get<1>(a), firstLane, numBlockLanes);
+        }
+    }
+}
+//---------------------------------------------------------------------------
+void BatchVirtualMachine::bind(std::string_view name, void *value, const Type::NumericBase *type, bool array)
+{
+    const auto &externals = m_Program.getExternals();
+    const auto external = std::find_if(externals.cbegin(), externals.cend(),
+                                       [name](const auto &e) { return e.name == name; });
+    if(external == externals.cend()) {
+        throw std::runtime_error("Program has no external '" + std::string{name} + "'");
+    }
+    if(external->type != type) {
+        throw std::runtime_error("Cannot bind value of type '" + type->getTypeName() + "' to external '"
+                                 + external->name + "' of type '" + external->type->getTypeName() + "'");
+    }
+
+    auto &binding = m_Bindings[std::distance(externals.cbegin(), external)];
+    binding.emplace();
+    binding->array = array ? value : nullptr;
+    if(!array) {
+        visitType(type,
+                  [&binding, value](auto *tag)
+                  {
+                      using T = std::remove_pointer_t<decltype(tag)>;
+                      getField<T>(binding->scalar) = *static_cast<const T*>(value);
+                  });
+    }
+}
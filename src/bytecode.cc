@@ -0,0 +1,1209 @@
+#include "bytecode.h"
+
+// Standard C++ includes
+#include <algorithm>
+#include <array>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+// Standard C includes
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+// GeNN includes
+#include "type.h"
+
+// Mini-parse includes
+#include "utils.h"
+
+using namespace MiniParse;
+using namespace MiniParse::Bytecode;
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+//! Register field used to store values of each type
+enum class Kind
+{
+    I32, U32, F32, F64
+};
+
+typedef std::array<std::optional<OpCode>, 4> KindOpCodes;
+
+#define KIND_OPCODES(OP) KindOpCodes{OpCode::OP##_I32, OpCode::OP##_U32, OpCode::OP##_F32, OpCode::OP##_F64}
+#define INTEGER_KIND_OPCODES(OP) KindOpCodes{OpCode::OP##_I32, OpCode::OP##_U32, std::nullopt, std::nullopt}
+
+//! Switch statements with up to this many cases in a range are dispatched by comparing with each in turn
+constexpr size_t maxLinearSwitchCases = 4;
+
+const std::unordered_map<Token::Type, KindOpCodes> binaryOpCodes{
+    {Token::Type::PLUS, KIND_OPCODES(ADD)},
+    {Token::Type::MINUS, KIND_OPCODES(SUB)},
+    {Token::Type::STAR, KIND_OPCODES(MUL)},
+    {Token::Type::SLASH, KIND_OPCODES(DIV)},
+    {Token::Type::LESS, KIND_OPCODES(LT)},
+    {Token::Type::LESS_EQUAL, KIND_OPCODES(LE)},
+    {Token::Type::GREATER, KIND_OPCODES(GT)},
+    {Token::Type::GREATER_EQUAL, KIND_OPCODES(GE)},
+    {Token::Type::EQUAL_EQUAL, KIND_OPCODES(EQ)},
+    {Token::Type::NOT_EQUAL, KIND_OPCODES(NE)},
+    {Token::Type::PERCENT, INTEGER_KIND_OPCODES(MOD)},
+    {Token::Type::AMPERSAND, INTEGER_KIND_OPCODES(AND)},
+    {Token::Type::PIPE, INTEGER_KIND_OPCODES(OR)},
+    {Token::Type::CARET, INTEGER_KIND_OPCODES(XOR)},
+    {Token::Type::SHIFT_LEFT, INTEGER_KIND_OPCODES(SHL)},
+    {Token::Type::SHIFT_RIGHT, INTEGER_KIND_OPCODES(SHR)}};
+
+//! Binary operator used to implement each compound assignment operator
+const std::unordered_map<Token::Type, Token::Type> compoundAssignmentOperators{
+    {Token::Type::STAR_EQUAL, Token::Type::STAR},
+    {Token::Type::SLASH_EQUAL, Token::Type::SLASH},
+    {Token::Type::PERCENT_EQUAL, Token::Type::PERCENT},
+    {Token::Type::PLUS_EQUAL, Token::Type::PLUS},
+    {Token::Type::MINUS_EQUAL, Token::Type::MINUS},
+    {Token::Type::AMPERSAND_EQUAL, Token::Type::AMPERSAND},
+    {Token::Type::CARET_EQUAL, Token::Type::CARET},
+    {Token::Type::PIPE_EQUAL, Token::Type::PIPE},
+    {Token::Type::SHIFT_LEFT_EQUAL, Token::Type::SHIFT_LEFT},
+    {Token::Type::SHIFT_RIGHT_EQUAL, Token::Type::SHIFT_RIGHT}};
+
+//! Conversion opcodes indexed by source and destination kind
+const std::optional<OpCode> conversionOpCodes[4][4]{
+    {std::nullopt, OpCode::CVT_I32_U32, OpCode::CVT_I32_F32, OpCode::CVT_I32_F64},
+    {OpCode::CVT_U32_I32, std::nullopt, OpCode::CVT_U32_F32, OpCode::CVT_U32_F64},
+    {OpCode::CVT_F32_I32, OpCode::CVT_F32_U32, std::nullopt, OpCode::CVT_F32_F64},
+    {OpCode::CVT_F64_I32, OpCode::CVT_F64_U32, OpCode::CVT_F64_F32, std::nullopt}};
+
+//! Implementations of foreign function types
+const std::unordered_map<const Type::Base*, Program::Function> foreignFunctions{
+    {Type::Exp::getInstance(), [](double x) { return std::exp(x); }},
+    {Type::Sqrt::getInstance(), [](double x) { return std::sqrt(x); }}};
+
+//---------------------------------------------------------------------------
+Kind getKind(const Type::NumericBase *type)
+{
+    if(type == Type::Double::getInstance()) {
+        return Kind::F64;
+    }
+    else if(type == Type::Float::getInstance()) {
+        return Kind::F32;
+    }
+    else {
+        return type->isSigned() ? Kind::I32 : Kind::U32;
+    }
+}
+//---------------------------------------------------------------------------
+//! Get the type whose values fill the register field of kind exactly
+const Type::NumericBase *getKindType(Kind kind)
+{
+    switch(kind) {
+    case Kind::I32: return Type::Int32::getInstance();
+    case Kind::U32: return Type::Uint32::getInstance();
+    case Kind::F32: return Type::Float::getInstance();
+    default: return Type::Double::getInstance();
+    }
+}
+//---------------------------------------------------------------------------
+OpCode selectOpCode(const KindOpCodes &opCodes, Kind kind, const Token &token)
+{
+    const auto &opCode = opCodes[static_cast<size_t>(kind)];
+    if(!opCode) {
+        throw std::runtime_error("Unsupported operand type for '" + std::string{token.lexeme}
+                                 + "' at line " + std::to_string(token.line));
+    }
+    return *opCode;
+}
+//---------------------------------------------------------------------------
+template<typename F>
+auto visitRegister(Register value, Kind kind, F f)
+{
+    switch(kind) {
+    case Kind::I32: return f(value.i32);
+    case Kind::U32: return f(value.u32);
+    case Kind::F32: return f(value.f32);
+    default: return f(value.f64);
+    }
+}
+//---------------------------------------------------------------------------
+//! Convert value to type, following the same rules as conversion instructions
+template<typename T>
+Register convertValue(T value, const Type::NumericBase *type)
+{
+    Register reg;
+    reg.f64 = 0.0;
+    if(type == Type::Bool::getInstance()) {
+        reg.u32 = (value != 0);
+    }
+    else if(type == Type::Int8::getInstance()) {
+        reg.i32 = static_cast<int8_t>(value);
+    }
+    else if(type == Type::Int16::getInstance()) {
+        reg.i32 = static_cast<int16_t>(value);
+    }
+    else if(type == Type::Int32::getInstance()) {
+        reg.i32 = static_cast<int32_t>(value);
+    }
+    else if(type == Type::Uint8::getInstance()) {
+        reg.u32 = static_cast<uint8_t>(value);
+    }
+    else if(type == Type::Uint16::getInstance()) {
+        reg.u32 = static_cast<uint16_t>(value);
+    }
+    else if(type == Type::Uint32::getInstance()) {
+        reg.u32 = static_cast<uint32_t>(value);
+    }
+    else if(type == Type::Float::getInstance()) {
+        reg.f32 = static_cast<float>(value);
+    }
+    else {
+        reg.f64 = static_cast<double>(value);
+    }
+    return reg;
+}
+
+//---------------------------------------------------------------------------
+// Operand
+//---------------------------------------------------------------------------
+//! Register operand - external and constant registers are relocated once number of locals is known
+struct Operand
+{
+    enum class Space
+    {
+        LOCAL, EXTERNAL, CONSTANT
+    };
+
+    Space space;
+    uint16_t index;
+
+    bool operator == (const Operand &other) const{ return (space == other.space) && (index == other.index); }
+    bool operator != (const Operand &other) const{ return !(*this == other); }
+};
+
+//---------------------------------------------------------------------------
+// Compiler
+//---------------------------------------------------------------------------
+class Compiler : public Expression::Visitor, public Statement::Visitor
+{
+public:
+    Compiler(const TypeChecker::Resolution &resolution, ControlFlow controlFlow)
+    :   m_Resolution(resolution), m_ControlFlow(controlFlow), m_NextRegister(0), m_MaxRegisters(0)
+    {
+    }
+
+    //---------------------------------------------------------------------------
+    // Public API
+    //---------------------------------------------------------------------------
+    Program compile(const Statement::StatementList &statements)
+    {
+        // Compile statements in top-level scope
+        compileScope(statements);
+        emit(OpCode::HALT);
+
+        // **NOTE** jump targets are stored in 16-bit instruction fields
+        if(m_Instructions.size() > std::numeric_limits<uint16_t>::max()) {
+            throw std::runtime_error("Program too large");
+        }
+
+        // Relocate external and constant operands to registers after locals
+        const uint16_t externalBase = m_MaxRegisters;
+        const size_t constantBase = externalBase + m_Externals.size();
+        const size_t numRegisters = constantBase + m_Constants.size();
+        if(numRegisters > std::numeric_limits<uint16_t>::max()) {
+            throw std::runtime_error("Program requires too many registers");
+        }
+        for(const auto &f : m_Fixups) {
+            auto &field = m_Instructions.at(std::get<0>(f)).*std::get<1>(f);
+            field += (std::get<2>(f) == Operand::Space::EXTERNAL) ? externalBase : static_cast<uint16_t>(constantBase);
+        }
+        for(auto &e : m_Externals) {
+            e.reg += externalBase;
+        }
+
+        return Program(std::move(m_Instructions), std::move(m_Constants), std::move(m_ConstantTypes),
+                       std::move(m_Externals), std::move(m_Functions), numRegisters, m_ControlFlow);
+    }
+
+    //---------------------------------------------------------------------------
+    // Expression::Visitor virtuals
+    //---------------------------------------------------------------------------
+    virtual void visit(const Expression::ArraySubscript &arraySubscript) final
+    {
+        throw std::runtime_error("Array subscripts are not supported by bytecode at line "
+                                 + std::to_string(arraySubscript.getPointerName().line));
+    }
+
+    virtual void visit(const Expression::Assignment &assignment) final
+    {
+        const auto target = takeTarget();
+
+        const auto [variable, variableType] = getVariable(assignment.getVarName(), getType(&assignment));
+        const auto *valueType = getNumericType(assignment.getValue());
+
+        // If this is a plain assignment, compile value straight into variable if possible
+        const auto op = assignment.getOperator();
+        if(op.type == Token::Type::EQUAL) {
+            const auto value = compileExpression(assignment.getValue(),
+                                                 (valueType == variableType) ? std::make_optional(variable) : std::nullopt);
+            convert(value, valueType, variableType, variable);
+        }
+        // Otherwise, perform binary operation in common type and convert back
+        else {
+            const auto binaryOp = compoundAssignmentOperators.at(op.type);
+            const auto value = compileExpression(assignment.getValue());
+            const bool shift = (binaryOp == Token::Type::SHIFT_LEFT || binaryOp == Token::Type::SHIFT_RIGHT);
+            const auto *commonType = shift ? Type::getPromotedType(variableType) : Type::getCommonType(variableType, valueType);
+            const auto left = convert(variable, variableType, commonType);
+            const auto right = convert(value, valueType, commonType);
+            const auto dst = (commonType == variableType) ? variable : allocateTemp();
+            emit(selectOpCode(binaryOpCodes.at(binaryOp), getKind(commonType), op), dst, left, right);
+            convert(dst, commonType, variableType, variable);
+        }
+
+        setResult(variable, variableType, target);
+    }
+
+    virtual void visit(const Expression::Binary &binary) final
+    {
+        const auto target = takeTarget();
+        const auto op = binary.getOperator();
+
+        // If operator is comma, evaluate left for side effects and return right
+        if(op.type == Token::Type::COMMA) {
+            compileExpression(binary.getLeft());
+            m_Result = compileExpression(binary.getRight(), target);
+            m_ResultType = getNumericType(binary.getRight());
+            return;
+        }
+
+        const auto *leftType = getNumericType(binary.getLeft());
+        const auto *rightType = getNumericType(binary.getRight());
+        const auto *resultType = getNumericType(&binary);
+
+        // Determine type operation is performed in
+        const auto *operationType = resultType;
+        if(op.type == Token::Type::LESS || op.type == Token::Type::LESS_EQUAL
+           || op.type == Token::Type::GREATER || op.type == Token::Type::GREATER_EQUAL
+           || op.type == Token::Type::EQUAL_EQUAL || op.type == Token::Type::NOT_EQUAL)
+        {
+            operationType = Type::getCommonType(leftType, rightType);
+        }
+
+        // Compile operands and convert to operation type
+        const auto left = convert(compileExpression(binary.getLeft()), leftType, operationType);
+        const auto right = convert(compileExpression(binary.getRight()), rightType, operationType);
+
+        const auto dst = target ? *target : allocateTemp();
+        emit(selectOpCode(binaryOpCodes.at(op.type), getKind(operationType), op), dst, left, right);
+        m_Result = dst;
+        m_ResultType = resultType;
+    }
+
+    virtual void visit(const Expression::Call &call) final
+    {
+        const auto target = takeTarget();
+
+        // Lookup implementation of callee's function type
+        const auto function = foreignFunctions.find(getType(call.getCallee()));
+        if(function == foreignFunctions.cend()) {
+            throw std::runtime_error("Called object is not a supported function at line "
+                                     + std::to_string(call.getClosingParen().line));
+        }
+
+        // Get index of function in table, adding if required
+        auto functionIndex = std::find(m_Functions.cbegin(), m_Functions.cend(), function->second);
+        if(functionIndex == m_Functions.cend()) {
+            functionIndex = m_Functions.insert(m_Functions.cend(), function->second);
+        }
+
+        // **NOTE** all supported foreign functions take a single double argument
+        const auto *argument = call.getArguments().at(0).get();
+        const auto argumentValue = convert(compileExpression(argument), getNumericType(argument),
+                                           Type::Double::getInstance());
+
+        const auto dst = target ? *target : allocateTemp();
+        emit(OpCode::CALL_F64, dst, argumentValue,
+             static_cast<uint16_t>(std::distance(m_Functions.cbegin(), functionIndex)));
+        m_Result = dst;
+        m_ResultType = Type::Double::getInstance();
+    }
+
+    virtual void visit(const Expression::Cast &cast) final
+    {
+        const auto target = takeTarget();
+        const auto *castType = Type::dynamicCast<Type::NumericBase>(cast.getType());
+        if(!castType) {
+            throw std::runtime_error("Pointer casts are not supported by bytecode");
+        }
+
+        const auto value = compileExpression(cast.getExpression());
+        m_Result = convert(value, getNumericType(cast.getExpression()), castType, target);
+        m_ResultType = castType;
+    }
+
+    virtual void visit(const Expression::Conditional &conditional) final
+    {
+        const auto target = takeTarget();
+        const auto *resultType = getNumericType(&conditional);
+        const auto dst = allocateTemp();
+
+        // Jump to false branch if condition is false
+        const auto condition = compileCondition(conditional.getCondition());
+        const size_t falseJump = isMasked() ? emitIf(condition) : emitJump(OpCode::JZ, condition);
+
+        // Compile true branch into destination and jump to end
+        convert(compileExpression(conditional.getTrue()), getNumericType(conditional.getTrue()), resultType, dst);
+        if(isMasked()) {
+            patchJump(falseJump);
+        }
+        const size_t endJump = emitJump(isMasked() ? OpCode::ELSE : OpCode::JMP);
+        if(!isMasked()) {
+            patchJump(falseJump);
+        }
+
+        // Compile false branch into destination
+        convert(compileExpression(conditional.getFalse()), getNumericType(conditional.getFalse()), resultType, dst);
+        patchJump(endJump);
+        if(isMasked()) {
+            emit(OpCode::END_IF);
+        }
+
+        setResult(dst, resultType, target);
+    }
+
+    virtual void visit(const Expression::Grouping &grouping) final
+    {
+        const auto target = takeTarget();
+        m_Result = compileExpression(grouping.getExpression(), target);
+        m_ResultType = getNumericType(grouping.getExpression());
+    }
+
+    virtual void visit(const Expression::Literal &literal) final
+    {
+        const auto target = takeTarget();
+        const auto *type = getNumericType(&literal);
+        const auto value = std::visit(
+            Utils::Overload{
+                [type](auto v) { return convertValue(v, type); },
+                [](std::monostate)->Register { throw std::runtime_error("Invalid literal"); }},
+            literal.getValue());
+
+        setResult(getConstant(value, getKind(type)), type, target);
+    }
+
+    virtual void visit(const Expression::Logical &logical) final
+    {
+        const auto target = takeTarget();
+        const auto dst = allocateTemp();
+
+        // Evaluate truthiness of left operand into destination
+        const auto *leftType = getNumericType(logical.getLeft());
+        convert(compileExpression(logical.getLeft()), leftType, Type::Bool::getInstance(), dst);
+
+        // If result is already determined, skip evaluation of right operand
+        const bool orOperator = (logical.getOperator().type == Token::Type::PIPE_PIPE);
+        const size_t shortCircuitJump = isMasked() ? emitIf(dst, orOperator) : emitJump(orOperator ? OpCode::JNZ : OpCode::JZ, dst);
+        const auto *rightType = getNumericType(logical.getRight());
+        convert(compileExpression(logical.getRight()), rightType, Type::Bool::getInstance(), dst);
+        patchJump(shortCircuitJump);
+        if(isMasked()) {
+            emit(OpCode::END_IF);
+        }
+
+        // **NOTE** bool and int32 share a register field
+        setResult(dst, Type::Int32::getInstance(), target);
+    }
+
+    virtual void visit(const Expression::PostfixIncDec &postfixIncDec) final
+    {
+        const auto target = takeTarget();
+        const auto [variable, variableType] = getVariable(postfixIncDec.getVarName(), getType(&postfixIncDec));
+
+        // Copy previous value before updating variable
+        const auto previous = allocateTemp();
+        emit(selectOpCode(KIND_OPCODES(MOV), getKind(variableType), postfixIncDec.getOperator()), previous, variable);
+        compileIncDec(variable, variableType, postfixIncDec.getOperator());
+        setResult(previous, variableType, target);
+    }
+
+    virtual void visit(const Expression::PrefixIncDec &prefixIncDec) final
+    {
+        const auto target = takeTarget();
+        const auto [variable, variableType] = getVariable(prefixIncDec.getVarName(), getType(&prefixIncDec));
+        compileIncDec(variable, variableType, prefixIncDec.getOperator());
+        setResult(variable, variableType, target);
+    }
+
+    virtual void visit(const Expression::Variable &variable) final
+    {
+        const auto target = takeTarget();
+        const auto [operand, type] = getVariable(variable.getName(), getType(&variable));
+        setResult(operand, type, target);
+    }
+
+    virtual void visit(const Expression::Unary &unary) final
+    {
+        const auto target = takeTarget();
+        const auto op = unary.getOperator();
+        const auto *rightType = getNumericType(unary.getRight());
+        const auto *resultType = getNumericType(&unary);
+        const auto right = compileExpression(unary.getRight());
+        if(op.type == Token::Type::PLUS) {
+            m_Result = convert(right, rightType, resultType, target);
+        }
+        else if(op.type == Token::Type::MINUS || op.type == Token::Type::TILDA) {
+            const auto dst = target ? *target : allocateTemp();
+            const auto &opCodes = (op.type == Token::Type::MINUS) ? KIND_OPCODES(NEG) : INTEGER_KIND_OPCODES(BNOT);
+            emit(selectOpCode(opCodes, getKind(resultType), op), dst, convert(right, rightType, resultType));
+            m_Result = dst;
+        }
+        else if(op.type == Token::Type::NOT) {
+            const auto dst = target ? *target : allocateTemp();
+            emit(selectOpCode(KIND_OPCODES(NOT), getKind(rightType), op), dst, right);
+            m_Result = dst;
+        }
+        else {
+            throw std::runtime_error("Pointer operations are not supported by bytecode at line " + std::to_string(op.line));
+        }
+        m_ResultType = resultType;
+    }
+
+    //---------------------------------------------------------------------------
+    // Statement::Visitor virtuals
+    //---------------------------------------------------------------------------
+    virtual void visit(const Statement::Break &breakStatement) final
+    {
+        if(m_JumpContexts.empty()) {
+            throw std::runtime_error("Statement not within loop at line " + std::to_string(breakStatement.getToken().line));
+        }
+
+        // With masked control flow, lanes which break are simply removed from loop's mask
+        if(isMasked()) {
+            emit(OpCode::BREAK);
+        }
+        else {
+            m_JumpContexts.back().breakJumps.push_back(emitJump(OpCode::JMP));
+        }
+    }
+
+    virtual void visit(const Statement::Compound &compound) final
+    {
+        compileScope(compound.getStatements());
+    }
+
+    virtual void visit(const Statement::Continue &continueStatement) final
+    {
+        // Search outwards for enclosing loop
+        auto loop = std::find_if(m_JumpContexts.rbegin(), m_JumpContexts.rend(),
+                                 [](const auto &c) { return c.loop; });
+        if(loop == m_JumpContexts.rend()) {
+            throw std::runtime_error("Statement not within loop at line " + std::to_string(continueStatement.getToken().line));
+        }
+
+        // With masked control flow, lanes which continue are masked off until end of loop body
+        if(isMasked()) {
+            emit(OpCode::CONTINUE);
+        }
+        else {
+            loop->continueJumps.push_back(emitJump(OpCode::JMP));
+        }
+    }
+
+    virtual void visit(const Statement::Do &doStatement) final
+    {
+        m_JumpContexts.push_back({true, {}, {}});
+        beginLoop();
+
+        // Compile body
+        const size_t start = m_Instructions.size();
+        compileStatement(doStatement.getBody());
+
+        // Compile condition and jump back to start if true
+        continueLoop();
+        const auto condition = compileCondition(doStatement.getCondition());
+        if(isMasked()) {
+            m_JumpContexts.back().breakJumps.push_back(emitJump(OpCode::LOOP_COND, condition));
+            emitJump(OpCode::JMP, std::nullopt, start);
+        }
+        else {
+            emitJump(OpCode::JNZ, condition, start);
+        }
+
+        endLoop();
+    }
+
+    virtual void visit(const Statement::Expression &expression) final
+    {
+        compileExpression(expression.getExpression());
+    }
+
+    virtual void visit(const Statement::For &forStatement) final
+    {
+        // Create new scope for loop initialisation
+        m_Scopes.emplace_back();
+        const auto scopeRegister = m_NextRegister;
+
+        // Compile initialiser if statement present
+        if(forStatement.getInitialiser()) {
+            compileStatement(forStatement.getInitialiser());
+        }
+
+        // Compile condition, jumping out of loop if false
+        m_JumpContexts.push_back({true, {}, {}});
+        beginLoop();
+        const size_t start = m_Instructions.size();
+        if(forStatement.getCondition()) {
+            compileLoopCondition(forStatement.getCondition());
+        }
+
+        // Compile body
+        compileStatement(forStatement.getBody());
+
+        // Compile incrementer if present and jump back to condition
+        continueLoop();
+        if(forStatement.getIncrement()) {
+            compileExpressionStatement(forStatement.getIncrement());
+        }
+        emitJump(OpCode::JMP, std::nullopt, start);
+
+        endLoop();
+
+        // Restore scope
+        m_NextRegister = scopeRegister;
+        m_Scopes.pop_back();
+    }
+
+    virtual void visit(const Statement::If &ifStatement) final
+    {
+        // With masked control flow, IF jumps to ELSE or END_IF so they can update the mask
+        const auto condition = compileCondition(ifStatement.getCondition());
+        const size_t elseJump = isMasked() ? emitIf(condition) : emitJump(OpCode::JZ, condition);
+        compileStatement(ifStatement.getThenBranch());
+        if(ifStatement.getElseBranch()) {
+            if(isMasked()) {
+                patchJump(elseJump);
+            }
+            const size_t endJump = emitJump(isMasked() ? OpCode::ELSE : OpCode::JMP);
+            if(!isMasked()) {
+                patchJump(elseJump);
+            }
+            compileStatement(ifStatement.getElseBranch());
+            patchJump(endJump);
+        }
+        else {
+            patchJump(elseJump);
+        }
+
+        if(isMasked()) {
+            emit(OpCode::END_IF);
+        }
+    }
+
+    virtual void visit(const Statement::Labelled &labelled) final
+    {
+        if(m_SwitchContexts.empty()) {
+            throw std::runtime_error("Statement not within switch statement at line "
+                                     + std::to_string(labelled.getKeyword().line));
+        }
+
+        // Record position of label, in the same order the type checker numbered them
+        auto &switchContext = m_SwitchContexts.back();
+        const size_t label = switchContext.labelPositions.size();
+        switchContext.labelPositions.push_back(m_Instructions.size());
+
+        // With masked control flow, enable lanes where label matches condition
+        if(isMasked()) {
+            const auto &[match, invert] = switchContext.labelMatches.at(label);
+            emit(OpCode::SWITCH_CASE, {}, match, invert ? 1 : 0);
+        }
+        compileStatement(labelled.getBody());
+    }
+
+    virtual void visit(const Statement::Switch &switchStatement) final
+    {
+        if(isMasked()) {
+            compileMaskedSwitch(switchStatement);
+            return;
+        }
+
+        // Compile condition and jump to dispatch code
+        // **NOTE** the condition register remains allocated while the body is compiled
+        const auto *conditionType = getNumericType(switchStatement.getCondition());
+        const auto condition = compileExpression(switchStatement.getCondition());
+        const size_t dispatchJump = emitJump(OpCode::JMP);
+
+        // Compile body, recording positions of labels
+        m_JumpContexts.push_back({false, {}, {}});
+        m_SwitchContexts.emplace_back();
+        compileStatement(switchStatement.getBody());
+        m_JumpContexts.back().breakJumps.push_back(emitJump(OpCode::JMP));
+
+        // Convert condition to the promoted type case values were converted to and
+        // binary search the sorted case values for the label to jump to
+        patchJump(dispatchJump);
+        const auto *promotedType = Type::getPromotedType(conditionType);
+        compileSwitchDispatch(switchStatement, convert(condition, conditionType, promotedType), promotedType,
+                              0, m_Resolution.getSwitchTable(&switchStatement).getCases().size());
+        patchJumps(m_JumpContexts.back().breakJumps);
+        m_SwitchContexts.pop_back();
+        m_JumpContexts.pop_back();
+    }
+
+    virtual void visit(const Statement::VarDeclaration &varDeclaration) final
+    {
+        const auto *type = Type::dynamicCast<Type::NumericBase>(varDeclaration.getType());
+        if(!type) {
+            throw std::runtime_error("Pointer variables are not supported by bytecode");
+        }
+
+        for(const auto &var : varDeclaration.getInitDeclaratorList()) {
+            // Allocate register for variable and add to scope
+            const auto variable = allocateTemp();
+            m_Scopes.back().insert_or_assign(std::get<0>(var).lexeme, std::make_tuple(variable, type));
+
+            // If there's an initialiser, compile it directly into variable's register if possible
+            if(std::get<1>(var)) {
+                const auto *initialiserType = getNumericType(std::get<1>(var).get());
+                const auto value = compileExpression(std::get<1>(var).get(),
+                                                     (initialiserType == type) ? std::make_optional(variable) : std::nullopt);
+                convert(value, initialiserType, type, variable);
+            }
+
+            // Free any temporaries used by initialiser
+            m_NextRegister = variable.index + 1;
+        }
+    }
+
+    virtual void visit(const Statement::While &whileStatement) final
+    {
+        m_JumpContexts.push_back({true, {}, {}});
+        beginLoop();
+        const size_t start = m_Instructions.size();
+        compileLoopCondition(whileStatement.getCondition());
+
+        compileStatement(whileStatement.getBody());
+
+        continueLoop();
+        emitJump(OpCode::JMP, std::nullopt, start);
+
+        endLoop();
+    }
+
+    virtual void visit(const Statement::Print &print) final
+    {
+        const auto *type = getNumericType(print.getExpression());
+        const auto value = compileExpression(print.getExpression());
+        if(type == Type::Bool::getInstance()) {
+            emit(OpCode::PRINT_BOOL, value, value);
+        }
+        else {
+            emit(selectOpCode(KIND_OPCODES(PRINT), getKind(type), Token(Token::Type::PRINT, "print", 0)), value, value);
+        }
+    }
+
+private:
+    //---------------------------------------------------------------------------
+    // JumpContext
+    //---------------------------------------------------------------------------
+    //! Jumps out of loop or switch which need patching once their target is known
+    struct JumpContext
+    {
+        bool loop;
+        std::vector<size_t> breakJumps;
+        std::vector<size_t> continueJumps;
+    };
+
+    //---------------------------------------------------------------------------
+    // SwitchContext
+    //---------------------------------------------------------------------------
+    struct SwitchContext
+    {
+        //! Instruction index of each label within switch body, indexed by Statement::Switch::Case::label
+        std::vector<size_t> labelPositions;
+
+        //! With masked control flow, register holding whether each label matches condition and whether it should be inverted
+        std::vector<std::tuple<Operand, bool>> labelMatches;
+    };
+
+    //---------------------------------------------------------------------------
+    // Private methods
+    //---------------------------------------------------------------------------
+    void compileScope(const Statement::StatementList &statements)
+    {
+        m_Scopes.emplace_back();
+        const auto scopeRegister = m_NextRegister;
+        for(const auto &s : statements) {
+            compileStatement(s.get());
+        }
+        m_NextRegister = scopeRegister;
+        m_Scopes.pop_back();
+    }
+
+    void compileStatement(const Statement::Base *statement)
+    {
+        // Free temporaries allocated by statement unless it declares variables
+        const auto statementRegister = m_NextRegister;
+        statement->accept(*this);
+        if(!dynamic_cast<const Statement::VarDeclaration*>(statement)) {
+            m_NextRegister = statementRegister;
+        }
+    }
+
+    void compileExpressionStatement(const Expression::Base *expression)
+    {
+        const auto statementRegister = m_NextRegister;
+        compileExpression(expression);
+        m_NextRegister = statementRegister;
+    }
+
+    //! Compile expression, optionally providing register result should be written to
+    //! **NOTE** the result is only guaranteed to be in target if it doesn't need converting
+    Operand compileExpression(const Expression::Base *expression, std::optional<Operand> target = std::nullopt)
+    {
+        m_Target = target;
+        expression->accept(*this);
+        return m_Result;
+    }
+
+    //! Compile expression to a register which is zero if expression is false
+    Operand compileCondition(const Expression::Base *expression)
+    {
+        const auto value = compileExpression(expression);
+        const auto *type = getNumericType(expression);
+
+        // Integer registers are already usable as conditions
+        const auto kind = getKind(type);
+        if((kind == Kind::I32 || kind == Kind::U32) && value.space != Operand::Space::CONSTANT) {
+            return value;
+        }
+        else {
+            return convert(value, type, Type::Bool::getInstance());
+        }
+    }
+
+    //! Compile condition of loop, exiting loop when it is false
+    void compileLoopCondition(const Expression::Base *condition)
+    {
+        m_JumpContexts.back().breakJumps.push_back(
+            emitJump(isMasked() ? OpCode::LOOP_COND : OpCode::JZ, compileCondition(condition)));
+    }
+
+    //! Start loop on top of jump context stack
+    void beginLoop()
+    {
+        if(isMasked()) {
+            emit(OpCode::LOOP_BEGIN);
+        }
+    }
+
+    //! Target continue statements of loop on top of jump context stack at next instruction
+    void continueLoop()
+    {
+        // With masked control flow, re-enable lanes which continued, exiting loop if there are none
+        if(isMasked()) {
+            m_JumpContexts.back().breakJumps.push_back(emitJump(OpCode::LOOP_CONTINUE));
+        }
+        else {
+            patchJumps(m_JumpContexts.back().continueJumps);
+        }
+    }
+
+    //! Target break statements of loop on top of jump context stack at next instruction and pop it
+    void endLoop()
+    {
+        patchJumps(m_JumpContexts.back().breakJumps);
+        if(isMasked()) {
+            emit(OpCode::LOOP_END);
+        }
+        m_JumpContexts.pop_back();
+    }
+
+    //! Compile switch statement with masked control flow. Lanes may take different labels so, rather than jumping,
+    //! condition is compared with every case value before the body and lanes where they match are enabled at each label
+    void compileMaskedSwitch(const Statement::Switch &switchStatement)
+    {
+        // **NOTE** labels nested within other statements of the body e.g. Duff's device would be reached with
+        // the mask of the statement they are nested in, rather than that of the switch, so aren't supported
+        const auto &switchTable = m_Resolution.getSwitchTable(&switchStatement);
+        const auto &cases = switchTable.getCases();
+        const auto &defaultCase = switchTable.getDefault();
+        if(std::any_of(cases.cbegin(), cases.cend(), [](const auto &c) { return !c.statement; })
+           || (defaultCase && !defaultCase->statement))
+        {
+            throw std::runtime_error("Case label not at top level of switch body is not supported with masked control flow at line "
+                                     + std::to_string(switchStatement.getSwitch().line));
+        }
+
+        // Convert condition to the promoted type case values were converted to
+        // **NOTE** registers holding matches remain allocated while the body is compiled
+        const auto *conditionType = getNumericType(switchStatement.getCondition());
+        const auto *promotedType = Type::getPromotedType(conditionType);
+        const auto kind = getKind(promotedType);
+        const auto condition = convert(compileExpression(switchStatement.getCondition()), conditionType, promotedType);
+
+        // Compare condition with each case value, also combining matches so default can be taken if there are none
+        SwitchContext switchContext;
+        switchContext.labelMatches.resize(cases.size() + (defaultCase ? 1 : 0));
+        std::optional<Operand> anyMatch;
+        for(const auto &c : cases) {
+            const auto match = allocateTemp();
+            emit(selectOpCode(KIND_OPCODES(EQ), kind, switchStatement.getSwitch()), match, condition,
+                 getConstant(convertValue(c.value, promotedType), kind));
+            switchContext.labelMatches.at(c.label) = std::make_tuple(match, false);
+
+            if(defaultCase) {
+                if(anyMatch) {
+                    emit(OpCode::OR_I32, *anyMatch, *anyMatch, match);
+                }
+                else {
+                    anyMatch = allocateTemp();
+                    emit(OpCode::MOV_I32, *anyMatch, match);
+                }
+            }
+        }
+        if(defaultCase) {
+            const auto defaultMatch = anyMatch ? *anyMatch : getConstant(convertValue(0, Type::Int32::getInstance()), Kind::I32);
+            switchContext.labelMatches.at(defaultCase->label) = std::make_tuple(defaultMatch, true);
+        }
+
+        // Compile body between instructions which manage the mask
+        // **NOTE** break and continue are emitted as BREAK and CONTINUE so no jumps need patching
+        m_JumpContexts.push_back({false, {}, {}});
+        m_SwitchContexts.push_back(std::move(switchContext));
+        emit(OpCode::SWITCH_BEGIN);
+        compileStatement(switchStatement.getBody());
+        emit(OpCode::SWITCH_END);
+        m_SwitchContexts.pop_back();
+        m_JumpContexts.pop_back();
+    }
+
+    //! Emit binary search of cases [begin, end) for the one matching condition, jumping to default
+    //! label or out of switch if there's no match. Small ranges are compared against each value in turn
+    void compileSwitchDispatch(const Statement::Switch &switchStatement, Operand condition, const Type::NumericBase *type,
+                               size_t begin, size_t end)
+    {
+        const auto &switchTable = m_Resolution.getSwitchTable(&switchStatement);
+        const auto &cases = switchTable.getCases();
+        const auto &switchContext = m_SwitchContexts.back();
+        const auto kind = getKind(type);
+        if((end - begin) <= maxLinearSwitchCases) {
+            for(size_t i = begin; i < end; i++) {
+                const auto match = allocateTemp();
+                emit(selectOpCode(KIND_OPCODES(EQ), kind, switchStatement.getSwitch()), match, condition,
+                     getConstant(convertValue(cases[i].value, type), kind));
+                emitJump(OpCode::JNZ, match, switchContext.labelPositions.at(cases[i].label));
+            }
+
+            // Jump to default label if there is one, otherwise out of switch
+            if(switchTable.getDefault()) {
+                emitJump(OpCode::JMP, std::nullopt, switchContext.labelPositions.at(switchTable.getDefault()->label));
+            }
+            else {
+                m_JumpContexts.back().breakJumps.push_back(emitJump(OpCode::JMP));
+            }
+        }
+        else {
+            // Search upper half of cases unless condition is less than middle value
+            const size_t middle = begin + ((end - begin) / 2);
+            const auto less = allocateTemp();
+            emit(selectOpCode(KIND_OPCODES(LT), kind, switchStatement.getSwitch()), less, condition,
+                 getConstant(convertValue(cases[middle].value, type), kind));
+            const size_t lessJump = emitJump(OpCode::JNZ, less);
+            compileSwitchDispatch(switchStatement, condition, type, middle, end);
+
+            patchJump(lessJump);
+            compileSwitchDispatch(switchStatement, condition, type, begin, middle);
+        }
+    }
+
+    void compileIncDec(Operand variable, const Type::NumericBase *variableType, const Token &op)
+    {
+        // Add or subtract one in register field
+        const auto kind = getKind(variableType);
+        const auto one = getConstant(convertValue(1, getKindType(kind)), kind);
+        emit(selectOpCode((op.type == Token::Type::PLUS_PLUS) ? KIND_OPCODES(ADD) : KIND_OPCODES(SUB), kind, op),
+             variable, variable, one);
+
+        // Truncate if variable is smaller than register field
+        convert(variable, getKindType(kind), variableType, variable);
+    }
+
+    //! Convert value between types, optionally into target register
+    Operand convert(Operand value, const Type::NumericBase *fromType, const Type::NumericBase *toType,
+                    std::optional<Operand> target = std::nullopt)
+    {
+        const auto fromKind = getKind(fromType);
+        const auto toKind = getKind(toType);
+
+        // If value is constant, convert at compile time
+        if(value.space == Operand::Space::CONSTANT && fromType != toType) {
+            const auto converted = visitRegister(m_Constants.at(value.index), fromKind,
+                                                 [toType](auto v) { return convertValue(v, toType); });
+            value = getConstant(converted, toKind);
+        }
+        // Otherwise, if conversion to bool is required, compare with zero
+        else if(toType == Type::Bool::getInstance() && fromType != toType) {
+            const auto dst = target ? *target : allocateTemp();
+            const auto zero = getConstant(convertValue(0, fromType), fromKind);
+            emit(selectOpCode(KIND_OPCODES(NE), fromKind, Token(Token::Type::NOT_EQUAL, "!=", 0)), dst, value, zero);
+            return dst;
+        }
+        // Otherwise, if any other conversion is required
+        else if(fromType != toType) {
+            const auto dst = target ? *target : allocateTemp();
+            const auto *conversion = &conversionOpCodes[static_cast<size_t>(fromKind)][static_cast<size_t>(toKind)];
+            if(*conversion) {
+                emit(**conversion, dst, value);
+                value = dst;
+            }
+
+            // Sign or zero-extend types smaller than register field
+            if(toType == Type::Int8::getInstance()) {
+                emit(OpCode::SEXT8, dst, value);
+                value = dst;
+            }
+            else if(toType == Type::Int16::getInstance()) {
+                emit(OpCode::SEXT16, dst, value);
+                value = dst;
+            }
+            else if(toType == Type::Uint8::getInstance()) {
+                emit(OpCode::ZEXT8, dst, value);
+                value = dst;
+            }
+            else if(toType == Type::Uint16::getInstance()) {
+                emit(OpCode::ZEXT16, dst, value);
+                value = dst;
+            }
+        }
+
+        // Move to target if value isn't already there
+        if(target && *target != value) {
+            emit(selectOpCode(KIND_OPCODES(MOV), toKind, Token(Token::Type::EQUAL, "=", 0)), *target, value);
+            return *target;
+        }
+        else {
+            return value;
+        }
+    }
+
+    //! Take target register for result of current expression
+    std::optional<Operand> takeTarget()
+    {
+        const auto target = m_Target;
+        m_Target.reset();
+        return target;
+    }
+
+    void setResult(Operand value, const Type::NumericBase *type, std::optional<Operand> target)
+    {
+        m_Result = target ? convert(value, type, type, target) : value;
+        m_ResultType = type;
+    }
+
+    Operand allocateTemp()
+    {
+        if(m_NextRegister == std::numeric_limits<uint16_t>::max()) {
+            throw std::runtime_error("Program requires too many registers");
+        }
+        const Operand operand{Operand::Space::LOCAL, m_NextRegister++};
+        m_MaxRegisters = std::max(m_MaxRegisters, m_NextRegister);
+        return operand;
+    }
+
+    Operand getConstant(Register value, Kind kind)
+    {
+        // Use bit pattern of value to find existing constant
+        uint64_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(Register));
+        const auto c = m_ConstantIndices.try_emplace(std::make_pair(kind, bits), m_Constants.size());
+        if(c.second) {
+            m_Constants.push_back(value);
+            m_ConstantTypes.push_back(getKindType(kind));
+        }
+        return Operand{Operand::Space::CONSTANT, static_cast<uint16_t>(c.first->second)};
+    }
+
+    std::tuple<Operand, const Type::NumericBase*> getVariable(const Token &name, const Type::Base *variableType)
+    {
+        // Search scopes outwards for variable
+        for(auto s = m_Scopes.crbegin(); s != m_Scopes.crend(); s++) {
+            const auto v = s->find(name.lexeme);
+            if(v != s->cend()) {
+                return v->second;
+            }
+        }
+
+        // Otherwise, find or create external
+        auto external = std::find_if(m_Externals.cbegin(), m_Externals.cend(),
+                                     [name](const auto &e) { return e.name == name.lexeme; });
+        if(external == m_Externals.cend()) {
+            const auto *type = Type::dynamicCast<Type::NumericBase>(variableType);
+            if(!type) {
+                throw std::runtime_error("Variable '" + std::string{name.lexeme} + "' has unsupported type at line "
+                                         + std::to_string(name.line));
+            }
+            external = m_Externals.insert(m_Externals.cend(),
+                                          Program::External{std::string{name.lexeme}, type,
+                                                            static_cast<uint16_t>(m_Externals.size())});
+        }
+        return std::make_tuple(Operand{Operand::Space::EXTERNAL, external->reg}, external->type);
+    }
+
+    const Type::Base *getType(const Expression::Base *expression) const
+    {
+        return m_Resolution.types.at(expression);
+    }
+
+    const Type::NumericBase *getNumericType(const Expression::Base *expression) const
+    {
+        const auto *type = Type::dynamicCast<Type::NumericBase>(getType(expression));
+        if(!type) {
+            throw std::runtime_error("Expression of type '" + getType(expression)->getTypeName()
+                                     + "' is not supported by bytecode");
+        }
+        return type;
+    }
+
+    size_t emit(OpCode opCode, Operand dst = {}, Operand a = {}, Operand b = {})
+    {
+        const size_t index = m_Instructions.size();
+        m_Instructions.push_back({opCode, dst.index, a.index, b.index});
+        addFixup(index, &Instruction::dst, dst);
+        addFixup(index, &Instruction::a, a);
+        addFixup(index, &Instruction::b, b);
+        return index;
+    }
+
+    size_t emit(OpCode opCode, Operand dst, Operand a, uint16_t b)
+    {
+        const size_t index = emit(opCode, dst, a);
+        m_Instructions.back().b = b;
+        return index;
+    }
+
+    //! Emit jump instruction, conditional on value of register if provided
+    size_t emitJump(OpCode opCode, std::optional<Operand> condition = std::nullopt, size_t target = 0)
+    {
+        const size_t index = emit(opCode, Operand{}, condition.value_or(Operand{}));
+        m_Instructions.back().dst = getJumpTarget(target);
+        return index;
+    }
+
+    //! Emit IF instruction which masks off lanes where condition is zero (or non-zero if invert is set)
+    size_t emitIf(Operand condition, bool invert = false)
+    {
+        const size_t index = emitJump(OpCode::IF, condition);
+        m_Instructions.back().b = invert ? 1 : 0;
+        return index;
+    }
+
+    bool isMasked() const{ return (m_ControlFlow == ControlFlow::MASK); }
+
+    //! Patch jump so it targets the next instruction to be emitted
+    void patchJump(size_t jump)
+    {
+        m_Instructions.at(jump).dst = getJumpTarget(m_Instructions.size());
+    }
+
+    //! Check jump target fits in 16-bit instruction field
+    static uint16_t getJumpTarget(size_t target)
+    {
+        if(target > std::numeric_limits<uint16_t>::max()) {
+            throw std::runtime_error("Program too large");
+        }
+        return static_cast<uint16_t>(target);
+    }
+
+    void patchJumps(const std::vector<size_t> &jumps)
+    {
+        for(size_t j : jumps) {
+            patchJump(j);
+        }
+    }
+
+    void addFixup(size_t index, uint16_t Instruction::*field, Operand operand)
+    {
+        if(operand.space != Operand::Space::LOCAL) {
+            m_Fixups.emplace_back(index, field, operand.space);
+        }
+    }
+
+    //---------------------------------------------------------------------------
+    // Members
+    //---------------------------------------------------------------------------
+    const TypeChecker::Resolution &m_Resolution;
+    const ControlFlow m_ControlFlow;
+
+    std::vector<Instruction> m_Instructions;
+    std::vector<Register> m_Constants;
+    std::vector<const Type::NumericBase*> m_ConstantTypes;
+    std::vector<Program::External> m_Externals;
+    std::vector<Program::Function> m_Functions;
+
+    std::map<std::pair<Kind, uint64_t>, size_t> m_ConstantIndices;
+    std::vector<std::tuple<size_t, uint16_t Instruction::*, Operand::Space>> m_Fixups;
+
+    std::vector<std::unordered_map<std::string_view, std::tuple<Operand, const Type::NumericBase*>>> m_Scopes;
+    std::vector<JumpContext> m_JumpContexts;
+    std::vector<SwitchContext> m_SwitchContexts;
+
+    uint16_t m_NextRegister;
+    uint16_t m_MaxRegisters;
+
+    std::optional<Operand> m_Target;
+    Operand m_Result;
+    const Type::NumericBase *m_ResultType;
+};
+}   // Anonymous namespace
+
+//---------------------------------------------------------------------------
+// MiniParse::Bytecode::Program
+//---------------------------------------------------------------------------
+namespace MiniParse::Bytecode
+{
+std::optional<uint16_t> Program::getExternalRegister(std::string_view name) const
+{
+    const auto external = std::find_if(m_Externals.cbegin(), m_Externals.cend(),
+                                       [name](const auto &e) { return e.name == name; });
+    if(external == m_Externals.cend()) {
+        return std::nullopt;
+    }
+    else {
+        return external->reg;
+    }
+}
+//---------------------------------------------------------------------------
+std::string Program::disassemble() const
+{
+    std::ostringstream stream;
+    for(size_t i = 0; i < m_Instructions.size(); i++) {
+        const auto &instruction = m_Instructions[i];
+        stream << i << ": " << getOpCodeName(instruction.opCode) << " " << instruction.dst
+               << ", " << instruction.a << ", " << instruction.b << std::endl;
+    }
+    return stream.str();
+}
+
+//---------------------------------------------------------------------------
+// Free functions
+//---------------------------------------------------------------------------
+Program compile(const Statement::StatementList &statements, const TypeChecker::Resolution &resolution,
+                ControlFlow controlFlow)
+{
+    Compiler compiler(resolution, controlFlow);
+    return compiler.compile(statements);
+}
+//---------------------------------------------------------------------------
+const char *getOpCodeName(OpCode opCode)
+{
+#define MINI_PARSE_OPCODE_NAME(OP) #OP,
+    static const char *names[] = {MINI_PARSE_OPCODES(MINI_PARSE_OPCODE_NAME)
+                                  MINI_PARSE_MASKED_OPCODES(MINI_PARSE_OPCODE_NAME)};
+#undef MINI_PARSE_OPCODE_NAME
+    return names[static_cast<size_t>(opCode)];
+}
+}   // namespace MiniParse::Bytecode
@@ -0,0 +1,482 @@
+#include "code_generator.h"
+
+// Standard C++ includes
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+// Standard C includes
+#include <cstdlib>
+#include <cstring>
+
+// POSIX includes
+#ifndef _WIN32
+#include <dlfcn.h>
+#endif
+
+// Mini-parse includes
+#include "error_handler.h"
+#include "expression.h"
+#include "pretty_printer.h"
+#include "type_checker.h"
+
+using namespace MiniParse;
+using namespace MiniParse::CodeGenerator;
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+//! Standard library implementations of foreign function types
+const std::unordered_map<const Type::Base*, std::string_view> foreignFunctions{
+    {Type::Exp::getInstance(), "std::exp"},
+    {Type::Sqrt::getInstance(), "std::sqrt"}};
+
+//---------------------------------------------------------------------------
+// ExternalVisitor
+//---------------------------------------------------------------------------
+//! Visitor which finds variables and functions type checker resolved to the global environment
+class ExternalVisitor : public Expression::Visitor, public Statement::Visitor
+{
+public:
+    ExternalVisitor(const TypeChecker::Environment &environment, const TypeChecker::Resolution &resolution,
+                    ErrorHandler &errorHandler)
+    :   m_Environment(environment), m_Resolution(resolution), m_ErrorHandler(errorHandler)
+    {
+    }
+
+    //---------------------------------------------------------------------------
+    // Public API
+    //---------------------------------------------------------------------------
+    std::vector<External> getExternals(const Statement::StatementList &statements)
+    {
+        m_Externals.clear();
+        for(auto &s : statements) {
+            s.get()->accept(*this);
+        }
+        return m_Externals;
+    }
+
+    //---------------------------------------------------------------------------
+    // Expression::Visitor virtuals
+    //---------------------------------------------------------------------------
+    virtual void visit(const Expression::ArraySubscript &arraySubscript) final
+    {
+        throw std::runtime_error("Array subscripts are not supported by code generator at line "
+                                 + std::to_string(arraySubscript.getPointerName().line));
+    }
+
+    virtual void visit(const Expression::Assignment &assignment) final
+    {
+        addExternal(assignment.getVarName(), m_Resolution.getSlot(&assignment));
+        assignment.getValue()->accept(*this);
+    }
+
+    virtual void visit(const Expression::Binary &binary) final
+    {
+        binary.getLeft()->accept(*this);
+        binary.getRight()->accept(*this);
+    }
+
+    virtual void visit(const Expression::Call &call) final
+    {
+        call.getCallee()->accept(*this);
+        for(const auto &a : call.getArguments()) {
+            a->accept(*this);
+        }
+    }
+
+    virtual void visit(const Expression::Cast &cast) final
+    {
+        cast.getExpression()->accept(*this);
+    }
+
+    virtual void visit(const Expression::Conditional &conditional) final
+    {
+        conditional.getCondition()->accept(*this);
+        conditional.getTrue()->accept(*this);
+        conditional.getFalse()->accept(*this);
+    }
+
+    virtual void visit(const Expression::Grouping &grouping) final
+    {
+        grouping.getExpression()->accept(*this);
+    }
+
+    virtual void visit(const Expression::Literal&) final
+    {
+    }
+
+    virtual void visit(const Expression::Logical &logical) final
+    {
+        logical.getLeft()->accept(*this);
+        logical.getRight()->accept(*this);
+    }
+
+    virtual void visit(const Expression::PostfixIncDec &postfixIncDec) final
+    {
+        addExternal(postfixIncDec.getVarName(), m_Resolution.getSlot(&postfixIncDec));
+    }
+
+    virtual void visit(const Expression::PrefixIncDec &prefixIncDec) final
+    {
+        addExternal(prefixIncDec.getVarName(), m_Resolution.getSlot(&prefixIncDec));
+    }
+
+    virtual void visit(const Expression::Variable &variable) final
+    {
+        addExternal(variable.getName(), m_Resolution.getSlot(&variable));
+    }
+
+    virtual void visit(const Expression::Unary &unary) final
+    {
+        unary.getRight()->accept(*this);
+    }
+
+    //---------------------------------------------------------------------------
+    // Statement::Visitor virtuals
+    //---------------------------------------------------------------------------
+    virtual void visit(const Statement::Break&) final
+    {
+    }
+
+    virtual void visit(const Statement::Compound &compound) final
+    {
+        for(auto &s : compound.getStatements()) {
+            s->accept(*this);
+        }
+    }
+
+    virtual void visit(const Statement::Continue&) final
+    {
+    }
+
+    virtual void visit(const Statement::Do &doStatement) final
+    {
+        doStatement.getBody()->accept(*this);
+        doStatement.getCondition()->accept(*this);
+    }
+
+    virtual void visit(const Statement::Expression &expression) final
+    {
+        expression.getExpression()->accept(*this);
+    }
+
+    virtual void visit(const Statement::For &forStatement) final
+    {
+        if(forStatement.getInitialiser()) {
+            forStatement.getInitialiser()->accept(*this);
+        }
+        if(forStatement.getCondition()) {
+            forStatement.getCondition()->accept(*this);
+        }
+        if(forStatement.getIncrement()) {
+            forStatement.getIncrement()->accept(*this);
+        }
+        forStatement.getBody()->accept(*this);
+    }
+
+    virtual void visit(const Statement::If &ifStatement) final
+    {
+        ifStatement.getCondition()->accept(*this);
+        ifStatement.getThenBranch()->accept(*this);
+        if(ifStatement.getElseBranch()) {
+            ifStatement.getElseBranch()->accept(*this);
+        }
+    }
+
+    virtual void visit(const Statement::Labelled &labelled) final
+    {
+        if(labelled.getValue()) {
+            labelled.getValue()->accept(*this);
+        }
+        labelled.getBody()->accept(*this);
+    }
+
+    virtual void visit(const Statement::Switch &switchStatement) final
+    {
+        switchStatement.getCondition()->accept(*this);
+        switchStatement.getBody()->accept(*this);
+    }
+
+    virtual void visit(const Statement::VarDeclaration &varDeclaration) final
+    {
+        for(const auto &var : varDeclaration.getInitDeclaratorList()) {
+            if(std::get<1>(var)) {
+                std::get<1>(var)->accept(*this);
+            }
+        }
+    }
+
+    virtual void visit(const Statement::While &whileStatement) final
+    {
+        whileStatement.getCondition()->accept(*this);
+        whileStatement.getBody()->accept(*this);
+    }
+
+    virtual void visit(const Statement::Print &print) final
+    {
+        print.getExpression()->accept(*this);
+    }
+
+private:
+    //---------------------------------------------------------------------------
+    // Private methods
+    //---------------------------------------------------------------------------
+    void addExternal(const Token &name, const std::optional<Expression::VariableSlot> &slot)
+    {
+        // **NOTE** statements must have been type checked so every variable has been resolved to a slot
+        if(!slot) {
+            throw std::runtime_error("Variable '" + std::string{name.lexeme} + "' has not been resolved at line "
+                                     + std::to_string(name.line));
+        }
+
+        // If variable is global and hasn't already been found, add it to externals
+        if(slot->global && std::none_of(m_Externals.cbegin(), m_Externals.cend(),
+                                        [name](const auto &e) { return e.name == name.lexeme; }))
+        {
+            const auto [type, isConst] = m_Environment.getType(name, m_ErrorHandler);
+            m_Externals.push_back({std::string{name.lexeme}, type, isConst});
+        }
+    }
+
+    //---------------------------------------------------------------------------
+    // Members
+    //---------------------------------------------------------------------------
+    const TypeChecker::Environment &m_Environment;
+    const TypeChecker::Resolution &m_Resolution;
+    ErrorHandler &m_ErrorHandler;
+    std::vector<External> m_Externals;
+};
+
+//---------------------------------------------------------------------------
+std::vector<External> getNumericExternals(const std::vector<External> &externals)
+{
+    std::vector<External> numericExternals;
+    std::copy_if(externals.cbegin(), externals.cend(), std::back_inserter(numericExternals),
+                 [](const auto &e) { return Type::dynamicCast<Type::NumericBase>(e.type) != nullptr; });
+    return numericExternals;
+}
+}   // Anonymous namespace
+
+//---------------------------------------------------------------------------
+// MiniParse::CodeGenerator
+//---------------------------------------------------------------------------
+std::vector<External> MiniParse::CodeGenerator::getExternals(const Statement::StatementList &statements,
+                                                             const TypeChecker::Environment &environment,
+                                                             const TypeChecker::Resolution &resolution,
+                                                             ErrorHandler &errorHandler)
+{
+    ExternalVisitor visitor(environment, resolution, errorHandler);
+    return visitor.getExternals(statements);
+}
+//---------------------------------------------------------------------------
+std::string MiniParse::CodeGenerator::generate(const Statement::StatementList &statements,
+                                               const TypeChecker::Environment &environment,
+                                               const TypeChecker::Resolution &resolution,
+                                               ErrorHandler &errorHandler)
+{
+    const auto externals = getExternals(statements, environment, resolution, errorHandler);
+
+    std::ostringstream os;
+    os << "// Generated by MiniParse::CodeGenerator" << std::endl;
+    os << "#include <cmath>" << std::endl;
+    os << "#include <cstddef>" << std::endl;
+    os << "#include <cstdint>" << std::endl;
+    os << "#include <iostream>" << std::endl;
+    os << "#include <limits>" << std::endl;
+    os << std::endl;
+
+    // **NOTE** code is generated in an anonymous namespace so unqualified lookup of
+    // function names finds the wrappers defined here rather than the C library functions
+    os << "namespace" << std::endl;
+    os << "{" << std::endl;
+
+    // Generate print overloads matching output of interpreter and virtual machine
+    for(const auto &t : {"bool", "int32_t", "uint32_t", "float", "double"}) {
+        os << "void print(" << t << " x){ std::cout << \"(" << t << ")\" << x << std::endl; }" << std::endl;
+    }
+    os << std::endl;
+
+    // Generate wrapper for each foreign function
+    for(const auto &e : externals) {
+        if(Type::dynamicCast<Type::NumericBase>(e.type)) {
+            continue;
+        }
+        const auto function = foreignFunctions.find(e.type);
+        if(function == foreignFunctions.cend()) {
+            throw std::runtime_error("External '" + e.name + "' has unsupported type '" + e.type->getTypeName() + "'");
+        }
+        // **NOTE** all supported foreign functions take a single double argument
+        os << "double " << e.name << "(double x){ return " << function->second << "(x); }" << std::endl;
+    }
+    os << std::endl;
+
+    os << "void run(void *const *miniParseVariables, size_t miniParseNumInstances)" << std::endl;
+    os << "{" << std::endl;
+
+    // Load scalars once and get pointers to arrays
+    const auto numericExternals = getNumericExternals(externals);
+    for(size_t i = 0; i < numericExternals.size(); i++) {
+        const auto &e = numericExternals[i];
+        const std::string typeName = e.type->getTypeName();
+        if(e.isConst) {
+            os << "    const " << typeName << " " << e.name << " = *static_cast<const " << typeName
+               << "*>(miniParseVariables[" << i << "]);" << std::endl;
+        }
+        else {
+            os << "    " << typeName << " *const miniParseArray" << i << " = static_cast<" << typeName
+               << "*>(miniParseVariables[" << i << "]);" << std::endl;
+        }
+    }
+
+    // Loop through instances, reading array values into local variables
+    os << "    for(size_t miniParseInstance = 0; miniParseInstance < miniParseNumInstances; miniParseInstance++) {" << std::endl;
+    for(size_t i = 0; i < numericExternals.size(); i++) {
+        const auto &e = numericExternals[i];
+        if(!e.isConst) {
+            os << "        " << e.type->getTypeName() << " " << e.name << " = miniParseArray" << i << "[miniParseInstance];" << std::endl;
+        }
+    }
+
+    // Insert statements in their own scope
+    os << "        {" << std::endl;
+    os << PrettyPrinter::print(statements);
+    os << "        }" << std::endl;
+
+    // Write back array values
+    for(size_t i = 0; i < numericExternals.size(); i++) {
+        const auto &e = numericExternals[i];
+        if(!e.isConst) {
+            os << "        miniParseArray" << i << "[miniParseInstance] = " << e.name << ";" << std::endl;
+        }
+    }
+    os << "    }" << std::endl;
+    os << "}" << std::endl;
+    os << "}   // Anonymous namespace" << std::endl;
+    os << std::endl;
+
+    os << "extern \"C\" void miniParseRun(void *const *miniParseVariables, size_t miniParseNumInstances)" << std::endl;
+    os << "{" << std::endl;
+    os << "    run(miniParseVariables, miniParseNumInstances);" << std::endl;
+    os << "}" << std::endl;
+    return os.str();
+}
+
+//---------------------------------------------------------------------------
+// MiniParse::CodeGenerator::Module
+//---------------------------------------------------------------------------
+Module::Module(const Statement::StatementList &statements, const TypeChecker::Environment &environment,
+               const TypeChecker::Resolution &resolution, ErrorHandler &errorHandler, std::string_view compileCommand)
+:   m_Source(generate(statements, environment, resolution, errorHandler)),
+    m_Externals(getNumericExternals(getExternals(statements, environment, resolution, errorHandler))),
+    m_Variables(m_Externals.size(), nullptr), m_Scalars(m_Externals.size(), 0),
+    m_Library(nullptr), m_Run(nullptr)
+{
+#ifdef _WIN32
+    (void)compileCommand;
+    throw std::runtime_error("Loading generated code is not supported on Windows");
+#else
+    // Create private temporary directory
+    std::string directoryTemplate = (std::filesystem::temp_directory_path() / "mini_parse_XXXXXX").string();
+    if(!mkdtemp(directoryTemplate.data())) {
+        throw std::runtime_error("Unable to create temporary directory '" + directoryTemplate + "'");
+    }
+    m_Directory = directoryTemplate;
+
+    try {
+        // Write source
+        const auto sourcePath = m_Directory / "module.cc";
+        const auto libraryPath = m_Directory / "module.so";
+        const auto logPath = m_Directory / "module.log";
+        {
+            std::ofstream source(sourcePath);
+            source << m_Source;
+            if(!source) {
+                throw std::runtime_error("Unable to write '" + sourcePath.string() + "'");
+            }
+        }
+
+        // Compile into shared library
+        const std::string command = std::string{compileCommand} + " -shared -fPIC -o \"" + libraryPath.string() + "\" \""
+                                    + sourcePath.string() + "\" > \"" + logPath.string() + "\" 2>&1";
+        if(std::system(command.c_str()) != 0) {
+            std::ifstream log(logPath);
+            std::ostringstream logStream;
+            logStream << log.rdbuf();
+            throw std::runtime_error("Compiling generated code failed:\n" + logStream.str());
+        }
+
+        // Load library and find entry point
+        m_Library = dlopen(libraryPath.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if(!m_Library) {
+            throw std::runtime_error("Unable to load generated code: " + std::string{dlerror()});
+        }
+        m_Run = reinterpret_cast<RunFunction>(dlsym(m_Library, "miniParseRun"));
+        if(!m_Run) {
+            throw std::runtime_error("Unable to find entry point in generated code: " + std::string{dlerror()});
+        }
+    }
+    catch(...) {
+        if(m_Library) {
+            dlclose(m_Library);
+        }
+        std::error_code ec;
+        std::filesystem::remove_all(m_Directory, ec);
+        throw;
+    }
+#endif
+}
+//---------------------------------------------------------------------------
+Module::~Module()
+{
+#ifndef _WIN32
+    dlclose(m_Library);
+    std::error_code ec;
+    std::filesystem::remove_all(m_Directory, ec);
+#endif
+}
+//---------------------------------------------------------------------------
+void Module::run(size_t numInstances)
+{
+    // Check all externals are bound
+    const auto unbound = std::find(m_Variables.cbegin(), m_Variables.cend(), nullptr);
+    if(unbound != m_Variables.cend()) {
+        throw std::runtime_error("External '" + m_Externals[std::distance(m_Variables.cbegin(), unbound)].name + "' is not bound");
+    }
+
+    m_Run(m_Variables.data(), numInstances);
+}
+//---------------------------------------------------------------------------
+void Module::bind(std::string_view name, void *value, size_t size, const Type::NumericBase *type, bool array)
+{
+    const auto external = std::find_if(m_Externals.cbegin(), m_Externals.cend(),
+                                       [name](const auto &e) { return e.name == name; });
+    if(external == m_Externals.cend()) {
+        throw std::runtime_error("Module has no external '" + std::string{name} + "'");
+    }
+    if(external->type != type) {
+        throw std::runtime_error("Cannot bind value of type '" + type->getTypeName() + "' to external '"
+                                 + external->name + "' of type '" + external->type->getTypeName() + "'");
+    }
+    if(external->isConst == array) {
+        throw std::runtime_error("External '" + external->name + "' must be bound to "
+                                 + (external->isConst ? "a scalar" : "an array") + " as it is "
+                                 + (external->isConst ? "const" : "not const"));
+    }
+
+    // Point variable at array or copy scalar into storage
+    const size_t index = std::distance(m_Externals.cbegin(), external);
+    if(array) {
+        m_Variables[index] = value;
+    }
+    else {
+        std::memcpy(&m_Scalars[index], value, size);
+        m_Variables[index] = &m_Scalars[index];
+    }
+}
@@ -0,0 +1,550 @@
+#include "flat_ast.h"
+
+// Standard C++ includes
+#include <array>
+#include <stdexcept>
+#include <tuple>
+
+// Standard C includes
+#include <cassert>
+
+using namespace MiniParse;
+using namespace MiniParse::FlatAST;
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+constexpr uint32_t noSlot = std::numeric_limits<uint32_t>::max();
+constexpr TokenIndex noToken = TokenIndex{std::numeric_limits<uint32_t>::max()};
+
+template<typename T>
+size_t getNumBytes(const std::vector<T> &vector)
+{
+    return vector.capacity() * sizeof(T);
+}
+
+template<typename T>
+uint32_t checkIndex(const std::vector<T> &vector)
+{
+    if(vector.size() >= std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("AST too large to flatten");
+    }
+    return static_cast<uint32_t>(vector.size());
+}
+}   // Anonymous namespace
+
+//---------------------------------------------------------------------------
+// MiniParse::FlatAST::Tree::Builder
+//---------------------------------------------------------------------------
+class MiniParse::FlatAST::Tree::Builder : public Expression::Visitor, public Statement::Visitor
+{
+public:
+    Builder(Tree &tree, const TypeChecker::Resolution *resolution)
+    :   m_Tree(tree), m_Resolution(resolution)
+    {}
+
+    //---------------------------------------------------------------------------
+    // Public API
+    //---------------------------------------------------------------------------
+    void build(const Statement::StatementList &statements)
+    {
+        std::tie(m_Tree.m_FirstStatement, m_Tree.m_NumStatements) = addStatementList(statements);
+
+        // Release capacity left over from growing arrays as tree is complete
+        m_Tree.m_ExpressionKinds.shrink_to_fit();
+        m_Tree.m_ExpressionTokens.shrink_to_fit();
+        m_Tree.m_ExpressionTypes.shrink_to_fit();
+        m_Tree.m_StatementKinds.shrink_to_fit();
+        m_Tree.m_StatementTokens.shrink_to_fit();
+        m_Tree.m_StatementSlots.shrink_to_fit();
+        m_Tree.m_Tokens.shrink_to_fit();
+        m_Tree.m_Literals.shrink_to_fit();
+        m_Tree.m_Types.shrink_to_fit();
+        m_Tree.m_Slots.shrink_to_fit();
+        m_Tree.m_ExpressionLists.shrink_to_fit();
+        m_Tree.m_StatementLists.shrink_to_fit();
+        m_Tree.m_Declarators.shrink_to_fit();
+        m_Tree.m_Cases.shrink_to_fit();
+        m_Tree.m_Switches.shrink_to_fit();
+        for(auto &o : m_Tree.m_ExpressionOperands) {
+            o.shrink_to_fit();
+        }
+        for(auto &o : m_Tree.m_StatementOperands) {
+            o.shrink_to_fit();
+        }
+    }
+
+    //---------------------------------------------------------------------------
+    // Expression::Visitor virtuals
+    //---------------------------------------------------------------------------
+    virtual void visit(const Expression::ArraySubscript &arraySubscript) final
+    {
+        const auto index = add(arraySubscript.getIndex().get());
+        addExpression(arraySubscript, ExpressionKind::ARRAY_SUBSCRIPT, addToken(arraySubscript.getPointerName()),
+                      {static_cast<uint32_t>(index), 0, 0});
+    }
+
+    virtual void visit(const Expression::Assignment &assignment) final
+    {
+        const auto value = add(assignment.getValue());
+        addExpression(assignment, ExpressionKind::ASSIGNMENT, addToken(assignment.getOperator()),
+                      {static_cast<uint32_t>(value), static_cast<uint32_t>(addToken(assignment.getVarName())),
+                       addSlot(assignment)});
+    }
+
+    virtual void visit(const Expression::Binary &binary) final
+    {
+        const auto left = add(binary.getLeft());
+        const auto right = add(binary.getRight());
+        addExpression(binary, ExpressionKind::BINARY, addToken(binary.getOperator()),
+                      {static_cast<uint32_t>(left), static_cast<uint32_t>(right), 0});
+    }
+
+    virtual void visit(const Expression::Call &call) final
+    {
+        const auto callee = add(call.getCallee());
+
+        // Add arguments and then copy indices contiguously into list
+        std::vector<ExpressionIndex> arguments;
+        arguments.reserve(call.getArguments().size());
+        for(const auto &a : call.getArguments()) {
+            arguments.push_back(add(a.get()));
+        }
+        const uint32_t firstArgument = checkIndex(m_Tree.m_ExpressionLists);
+        m_Tree.m_ExpressionLists.insert(m_Tree.m_ExpressionLists.end(), arguments.cbegin(), arguments.cend());
+
+        addExpression(call, ExpressionKind::CALL, addToken(call.getClosingParen()),
+                      {static_cast<uint32_t>(callee), firstArgument, static_cast<uint32_t>(arguments.size())});
+    }
+
+    virtual void visit(const Expression::Cast &cast) final
+    {
+        const auto expression = add(cast.getExpression());
+        addExpression(cast, ExpressionKind::CAST, noToken,
+                      {static_cast<uint32_t>(expression), addType(cast.getType()), cast.isConst() ? 1u : 0u});
+    }
+
+    virtual void visit(const Expression::Conditional &conditional) final
+    {
+        const auto condition = add(conditional.getCondition());
+        const auto trueExpression = add(conditional.getTrue());
+        const auto falseExpression = add(conditional.getFalse());
+        addExpression(conditional, ExpressionKind::CONDITIONAL, addToken(conditional.getQuestion()),
+                      {static_cast<uint32_t>(condition), static_cast<uint32_t>(trueExpression),
+                       static_cast<uint32_t>(falseExpression)});
+    }
+
+    virtual void visit(const Expression::Grouping &grouping) final
+    {
+        const auto expression = add(grouping.getExpression());
+        addExpression(grouping, ExpressionKind::GROUPING, noToken, {static_cast<uint32_t>(expression), 0, 0});
+    }
+
+    virtual void visit(const Expression::Literal &literal) final
+    {
+        const uint32_t value = checkIndex(m_Tree.m_Literals);
+        m_Tree.m_Literals.push_back(literal.getValue());
+        addExpression(literal, ExpressionKind::LITERAL, noToken, {value, 0, 0});
+    }
+
+    virtual void visit(const Expression::Logical &logical) final
+    {
+        const auto left = add(logical.getLeft());
+        const auto right = add(logical.getRight());
+        addExpression(logical, ExpressionKind::LOGICAL, addToken(logical.getOperator()),
+                      {static_cast<uint32_t>(left), static_cast<uint32_t>(right), 0});
+    }
+
+    virtual void visit(const Expression::PostfixIncDec &postfixIncDec) final
+    {
+        addExpression(postfixIncDec, ExpressionKind::POSTFIX_INC_DEC, addToken(postfixIncDec.getOperator()),
+                      {0, static_cast<uint32_t>(addToken(postfixIncDec.getVarName())), addSlot(postfixIncDec)});
+    }
+
+    virtual void visit(const Expression::PrefixIncDec &prefixIncDec) final
+    {
+        addExpression(prefixIncDec, ExpressionKind::PREFIX_INC_DEC, addToken(prefixIncDec.getOperator()),
+                      {0, static_cast<uint32_t>(addToken(prefixIncDec.getVarName())), addSlot(prefixIncDec)});
+    }
+
+    virtual void visit(const Expression::Variable &variable) final
+    {
+        addExpression(variable, ExpressionKind::VARIABLE, addToken(variable.getName()),
+                      {0, 0, addSlot(variable)});
+    }
+
+    virtual void visit(const Expression::Unary &unary) final
+    {
+        const auto right = add(unary.getRight());
+        addExpression(unary, ExpressionKind::UNARY, addToken(unary.getOperator()),
+                      {static_cast<uint32_t>(right), 0, 0});
+    }
+
+    //---------------------------------------------------------------------------
+    // Statement::Visitor virtuals
+    //---------------------------------------------------------------------------
+    virtual void visit(const Statement::Break &breakStatement) final
+    {
+        addStatement(StatementKind::BREAK, addToken(breakStatement.getToken()), {0, 0, 0, 0});
+    }
+
+    virtual void visit(const Statement::Compound &compound) final
+    {
+        const auto [first, count] = addStatementList(compound.getStatements());
+        addStatement(StatementKind::COMPOUND, noToken, {first, count, 0, 0}, getNumSlots(compound));
+    }
+
+    virtual void visit(const Statement::Continue &continueStatement) final
+    {
+        addStatement(StatementKind::CONTINUE, addToken(continueStatement.getToken()), {0, 0, 0, 0});
+    }
+
+    virtual void visit(const Statement::Do &doStatement) final
+    {
+        const auto body = add(doStatement.getBody());
+        const auto condition = add(doStatement.getCondition());
+        addStatement(StatementKind::DO, noToken, {static_cast<uint32_t>(condition), static_cast<uint32_t>(body), 0, 0});
+    }
+
+    virtual void visit(const Statement::Expression &expression) final
+    {
+        const auto e = add(expression.getExpression());
+        addStatement(StatementKind::EXPRESSION, noToken, {static_cast<uint32_t>(e), 0, 0, 0});
+    }
+
+    virtual void visit(const Statement::For &forStatement) final
+    {
+        const auto initialiser = add(forStatement.getInitialiser());
+        const auto condition = add(forStatement.getCondition());
+        const auto increment = add(forStatement.getIncrement());
+        const auto body = add(forStatement.getBody());
+        addStatement(StatementKind::FOR, noToken,
+                     {static_cast<uint32_t>(initialiser), static_cast<uint32_t>(condition),
+                      static_cast<uint32_t>(increment), static_cast<uint32_t>(body)},
+                     getNumSlots(forStatement));
+    }
+
+    virtual void visit(const Statement::If &ifStatement) final
+    {
+        const auto condition = add(ifStatement.getCondition());
+        const auto thenBranch = add(ifStatement.getThenBranch());
+        const auto elseBranch = add(ifStatement.getElseBranch());
+        addStatement(StatementKind::IF, noToken,
+                     {static_cast<uint32_t>(condition), static_cast<uint32_t>(thenBranch),
+                      static_cast<uint32_t>(elseBranch), 0});
+    }
+
+    virtual void visit(const Statement::Labelled &labelled) final
+    {
+        const auto value = add(labelled.getValue());
+        const auto body = add(labelled.getBody());
+        addStatement(StatementKind::LABELLED, addToken(labelled.getKeyword()),
+                     {static_cast<uint32_t>(value), static_cast<uint32_t>(body), 0, 0});
+    }
+
+    virtual void visit(const Statement::Switch &switchStatement) final
+    {
+        const auto condition = add(switchStatement.getCondition());
+        const auto body = add(switchStatement.getBody());
+
+        // Copy case table resolved by type checker if there is one
+        const uint32_t switchCases = checkIndex(m_Tree.m_Switches);
+        if(m_Resolution) {
+            const auto &switchTable = m_Resolution->getSwitchTable(&switchStatement);
+            const auto &cases = switchTable.getCases();
+            m_Tree.m_Switches.push_back({checkIndex(m_Tree.m_Cases), static_cast<uint32_t>(cases.size()),
+                                         switchTable.getDefault()});
+            m_Tree.m_Cases.insert(m_Tree.m_Cases.end(), cases.cbegin(), cases.cend());
+        }
+        else {
+            m_Tree.m_Switches.push_back({checkIndex(m_Tree.m_Cases), 0, std::nullopt});
+        }
+
+        addStatement(StatementKind::SWITCH, addToken(switchStatement.getSwitch()),
+                     {static_cast<uint32_t>(condition), static_cast<uint32_t>(body), switchCases, 0});
+    }
+
+    virtual void visit(const Statement::VarDeclaration &varDeclaration) final
+    {
+        // Add initialisers and then copy declarators contiguously into list
+        std::vector<Declarator> declarators;
+        declarators.reserve(varDeclaration.getInitDeclaratorList().size());
+        for(const auto &d : varDeclaration.getInitDeclaratorList()) {
+            const auto name = addToken(std::get<0>(d));
+            declarators.push_back({name, add(std::get<1>(d).get())});
+        }
+        const uint32_t firstDeclarator = checkIndex(m_Tree.m_Declarators);
+        m_Tree.m_Declarators.insert(m_Tree.m_Declarators.end(), declarators.cbegin(), declarators.cend());
+
+        addStatement(StatementKind::VAR_DECLARATION, noToken,
+                     {firstDeclarator, static_cast<uint32_t>(declarators.size()),
+                      addType(varDeclaration.getType()), varDeclaration.isConst() ? 1u : 0u},
+                     getNumSlots(varDeclaration));
+    }
+
+    virtual void visit(const Statement::While &whileStatement) final
+    {
+        const auto condition = add(whileStatement.getCondition());
+        const auto body = add(whileStatement.getBody());
+        addStatement(StatementKind::WHILE, noToken, {static_cast<uint32_t>(condition), static_cast<uint32_t>(body), 0, 0});
+    }
+
+    virtual void visit(const Statement::Print &print) final
+    {
+        const auto expression = add(print.getExpression());
+        addStatement(StatementKind::PRINT, noToken, {static_cast<uint32_t>(expression), 0, 0, 0});
+    }
+
+private:
+    //---------------------------------------------------------------------------
+    // Private methods
+    //---------------------------------------------------------------------------
+    ExpressionIndex add(const Expression::Base *expression)
+    {
+        if(expression) {
+            expression->accept(*this);
+            return m_Expression;
+        }
+        else {
+            return noExpression;
+        }
+    }
+
+    StatementIndex add(const Statement::Base *statement)
+    {
+        if(statement) {
+            statement->accept(*this);
+            return m_Statement;
+        }
+        else {
+            return noStatement;
+        }
+    }
+
+    std::tuple<uint32_t, uint32_t> addStatementList(const Statement::StatementList &statements)
+    {
+        // Add statements and then copy indices contiguously into list
+        std::vector<StatementIndex> indices;
+        indices.reserve(statements.size());
+        for(const auto &s : statements) {
+            indices.push_back(add(s.get()));
+        }
+        const uint32_t first = checkIndex(m_Tree.m_StatementLists);
+        m_Tree.m_StatementLists.insert(m_Tree.m_StatementLists.end(), indices.cbegin(), indices.cend());
+        return std::make_tuple(first, static_cast<uint32_t>(indices.size()));
+    }
+
+    void addExpression(const Expression::Base &expression, ExpressionKind kind, TokenIndex token,
+                       std::array<uint32_t, 3> operands)
+    {
+        m_Expression = ExpressionIndex{checkIndex(m_Tree.m_ExpressionKinds)};
+        m_Tree.m_ExpressionKinds.push_back(kind);
+        m_Tree.m_ExpressionTokens.push_back(token);
+        for(size_t i = 0; i < operands.size(); i++) {
+            m_Tree.m_ExpressionOperands[i].push_back(operands[i]);
+        }
+
+        // Copy resolved type if there is one
+        const Type::Base *type = nullptr;
+        if(m_Resolution) {
+            const auto resolvedType = m_Resolution->types.find(&expression);
+            if(resolvedType != m_Resolution->types.cend()) {
+                type = resolvedType->second;
+            }
+        }
+        m_Tree.m_ExpressionTypes.push_back(type);
+    }
+
+    void addStatement(StatementKind kind, TokenIndex token, std::array<uint32_t, 4> operands, size_t slots = 0)
+    {
+        m_Statement = StatementIndex{checkIndex(m_Tree.m_StatementKinds)};
+        m_Tree.m_StatementKinds.push_back(kind);
+        m_Tree.m_StatementTokens.push_back(token);
+        for(size_t i = 0; i < operands.size(); i++) {
+            m_Tree.m_StatementOperands[i].push_back(operands[i]);
+        }
+        m_Tree.m_StatementSlots.push_back(static_cast<uint32_t>(slots));
+    }
+
+    TokenIndex addToken(const Token &token)
+    {
+        const TokenIndex index{checkIndex(m_Tree.m_Tokens)};
+        m_Tree.m_Tokens.push_back(token);
+        return index;
+    }
+
+    uint32_t addType(const Type::Base *type)
+    {
+        const uint32_t index = checkIndex(m_Tree.m_Types);
+        m_Tree.m_Types.push_back(type);
+        return index;
+    }
+
+    uint32_t addSlot(const Expression::Base &expression)
+    {
+        const auto slot = m_Resolution ? m_Resolution->getSlot(&expression) : std::nullopt;
+        if(slot) {
+            const uint32_t index = checkIndex(m_Tree.m_Slots);
+            m_Tree.m_Slots.push_back(*slot);
+            return index;
+        }
+        else {
+            return noSlot;
+        }
+    }
+
+    //! Get number of slots in scope of compound or for statement or first slot of variable declaration
+    size_t getNumSlots(const Statement::Base &statement) const
+    {
+        return m_Resolution ? m_Resolution->getNumSlots(&statement) : 0;
+    }
+
+    //---------------------------------------------------------------------------
+    // Members
+    //---------------------------------------------------------------------------
+    Tree &m_Tree;
+    const TypeChecker::Resolution *m_Resolution;
+
+    //! Index of most recently added expression and statement
+    ExpressionIndex m_Expression;
+    StatementIndex m_Statement;
+};
+
+//---------------------------------------------------------------------------
+// MiniParse::FlatAST::Tree
+//---------------------------------------------------------------------------
+MiniParse::FlatAST::Tree::Tree(const Statement::StatementList &statements)
+{
+    Builder builder(*this, nullptr);
+    builder.build(statements);
+}
+//---------------------------------------------------------------------------
+MiniParse::FlatAST::Tree::Tree(const Statement::StatementList &statements, const TypeChecker::Resolution &resolution)
+{
+    Builder builder(*this, &resolution);
+    builder.build(statements);
+}
+//---------------------------------------------------------------------------
+void MiniParse::FlatAST::Tree::accept(ExpressionIndex expression, ExpressionVisitor &visitor) const
+{
+    switch(getKind(expression)) {
+    case ExpressionKind::ARRAY_SUBSCRIPT:   visitor.visitArraySubscript(expression); break;
+    case ExpressionKind::ASSIGNMENT:        visitor.visitAssignment(expression); break;
+    case ExpressionKind::BINARY:            visitor.visitBinary(expression); break;
+    case ExpressionKind::CALL:              visitor.visitCall(expression); break;
+    case ExpressionKind::CAST:              visitor.visitCast(expression); break;
+    case ExpressionKind::CONDITIONAL:       visitor.visitConditional(expression); break;
+    case ExpressionKind::GROUPING:          visitor.visitGrouping(expression); break;
+    case ExpressionKind::LITERAL:           visitor.visitLiteral(expression); break;
+    case ExpressionKind::LOGICAL:           visitor.visitLogical(expression); break;
+    case ExpressionKind::POSTFIX_INC_DEC:   visitor.visitPostfixIncDec(expression); break;
+    case ExpressionKind::PREFIX_INC_DEC:    visitor.visitPrefixIncDec(expression); break;
+    case ExpressionKind::VARIABLE:          visitor.visitVariable(expression); break;
+    case ExpressionKind::UNARY:             visitor.visitUnary(expression); break;
+    }
+}
+//---------------------------------------------------------------------------
+void MiniParse::FlatAST::Tree::accept(StatementIndex statement, StatementVisitor &visitor) const
+{
+    switch(getKind(statement)) {
+    case StatementKind::BREAK:              visitor.visitBreak(statement); break;
+    case StatementKind::COMPOUND:           visitor.visitCompound(statement); break;
+    case StatementKind::CONTINUE:           visitor.visitContinue(statement); break;
+    case StatementKind::DO:                 visitor.visitDo(statement); break;
+    case StatementKind::EXPRESSION:         visitor.visitExpression(statement); break;
+    case StatementKind::FOR:                visitor.visitFor(statement); break;
+    case StatementKind::IF:                 visitor.visitIf(statement); break;
+    case StatementKind::LABELLED:           visitor.visitLabelled(statement); break;
+    case StatementKind::SWITCH:             visitor.visitSwitch(statement); break;
+    case StatementKind::VAR_DECLARATION:    visitor.visitVarDeclaration(statement); break;
+    case StatementKind::WHILE:              visitor.visitWhile(statement); break;
+    case StatementKind::PRINT:              visitor.visitPrint(statement); break;
+    }
+}
+//---------------------------------------------------------------------------
+size_t MiniParse::FlatAST::Tree::getNumBytes() const
+{
+    size_t numBytes = sizeof(Tree) + ::getNumBytes(m_ExpressionKinds) + ::getNumBytes(m_ExpressionTokens)
+        + ::getNumBytes(m_ExpressionTypes) + ::getNumBytes(m_StatementKinds) + ::getNumBytes(m_StatementTokens)
+        + ::getNumBytes(m_StatementSlots) + ::getNumBytes(m_Tokens) + ::getNumBytes(m_Literals)
+        + ::getNumBytes(m_Types) + ::getNumBytes(m_Slots) + ::getNumBytes(m_ExpressionLists)
+        + ::getNumBytes(m_StatementLists) + ::getNumBytes(m_Declarators) + ::getNumBytes(m_Cases)
+        + ::getNumBytes(m_Switches);
+    for(const auto &o : m_ExpressionOperands) {
+        numBytes += ::getNumBytes(o);
+    }
+    for(const auto &o : m_StatementOperands) {
+        numBytes += ::getNumBytes(o);
+    }
+    return numBytes;
+}
+//---------------------------------------------------------------------------
+const Token &MiniParse::FlatAST::Tree::getName(ExpressionIndex expression) const
+{
+    const auto kind = getKind(expression);
+    if(kind == ExpressionKind::ARRAY_SUBSCRIPT || kind == ExpressionKind::VARIABLE) {
+        return getToken(m_ExpressionTokens[index(expression)]);
+    }
+    else {
+        assert(kind == ExpressionKind::ASSIGNMENT || kind == ExpressionKind::POSTFIX_INC_DEC
+               || kind == ExpressionKind::PREFIX_INC_DEC);
+        return getToken(getOperand<TokenIndex>(expression, 1));
+    }
+}
+//---------------------------------------------------------------------------
+std::optional<Expression::VariableSlot> MiniParse::FlatAST::Tree::getSlot(ExpressionIndex expression) const
+{
+    const uint32_t slot = getOperand<uint32_t>(expression, 2);
+    if(slot == noSlot) {
+        return std::nullopt;
+    }
+    else {
+        return m_Slots[slot];
+    }
+}
+//---------------------------------------------------------------------------
+ExpressionIndex MiniParse::FlatAST::Tree::getRight(ExpressionIndex expression) const
+{
+    return getOperand<ExpressionIndex>(expression, (getKind(expression) == ExpressionKind::UNARY) ? 0 : 1);
+}
+//---------------------------------------------------------------------------
+Range<ExpressionIndex> MiniParse::FlatAST::Tree::getArguments(ExpressionIndex call) const
+{
+    const auto *first = m_ExpressionLists.data() + getOperand<uint32_t>(call, 1);
+    return Range<ExpressionIndex>(first, first + getOperand<uint32_t>(call, 2));
+}
+//---------------------------------------------------------------------------
+Range<StatementIndex> MiniParse::FlatAST::Tree::getStatements(StatementIndex compound) const
+{
+    return getStatementList(getOperand<uint32_t>(compound, 0), getOperand<uint32_t>(compound, 1));
+}
+//---------------------------------------------------------------------------
+ExpressionIndex MiniParse::FlatAST::Tree::getCondition(StatementIndex statement) const
+{
+    return getOperand<ExpressionIndex>(statement, (getKind(statement) == StatementKind::FOR) ? 1 : 0);
+}
+//---------------------------------------------------------------------------
+StatementIndex MiniParse::FlatAST::Tree::getBody(StatementIndex statement) const
+{
+    return getOperand<StatementIndex>(statement, (getKind(statement) == StatementKind::FOR) ? 3 : 1);
+}
+//---------------------------------------------------------------------------
+Range<Statement::Switch::Case> MiniParse::FlatAST::Tree::getCases(StatementIndex switchStatement) const
+{
+    const auto &switchCases = m_Switches[getOperand<uint32_t>(switchStatement, 2)];
+    const auto *first = m_Cases.data() + switchCases.firstCase;
+    return Range<Statement::Switch::Case>(first, first + switchCases.numCases);
+}
+//---------------------------------------------------------------------------
+const std::optional<Statement::Switch::Case> &MiniParse::FlatAST::Tree::getDefault(StatementIndex switchStatement) const
+{
+    return m_Switches[getOperand<uint32_t>(switchStatement, 2)].defaultCase;
+}
+//---------------------------------------------------------------------------
+Range<Declarator> MiniParse::FlatAST::Tree::getInitDeclaratorList(StatementIndex varDeclaration) const
+{
+    const auto *first = m_Declarators.data() + getOperand<uint32_t>(varDeclaration, 0);
+    return Range<Declarator>(first, first + getOperand<uint32_t>(varDeclaration, 1));
+}
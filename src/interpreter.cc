@@ -10,8 +10,10 @@
 
 // Standard C includes
 #include <cassert>
+#include <cstdint>
 
 // Mini-parse includes
+#include "type_checker.h"
 #include "utils.h"
 
 using namespace MiniParse;
@@ -30,122 +32,154 @@ bool isTruthy(MiniParse::Token::LiteralValue value)
             [](std::monostate) { return false; }},
         value);
 }
-
-//---------------------------------------------------------------------------
-// Break
-//---------------------------------------------------------------------------
-class Break
-{
-};
-
-//---------------------------------------------------------------------------
-// Continue
 //---------------------------------------------------------------------------
-class Continue
+int64_t getCaseValue(MiniParse::Token::LiteralValue value)
 {
-};
-
-//---------------------------------------------------------------------------
-// SwitchLabelVisitor
+    return std::visit(
+        MiniParse::Utils::Overload{
+            [](auto x)->int64_t
+            {
+                if constexpr(std::is_integral_v<decltype(x)>) {
+                    return static_cast<int64_t>(x);
+                }
+                else {
+                    throw std::runtime_error("Invalid switch condition");
+                }
+            },
+            [](std::monostate)->int64_t { throw std::runtime_error("Invalid switch condition"); }},
+        value);
+}
 //---------------------------------------------------------------------------
-class SwitchLabelVisitor : public Statement::Visitor
+size_t getNumSlots(const Statement::StatementList &statements)
 {
-public:
-    SwitchLabelVisitor()
-    {
-    }
-    
-    //---------------------------------------------------------------------------
-    // Public API
-    //---------------------------------------------------------------------------
-    const std::vector<std::pair<const Expression::Base*, size_t>> getSwitchCaseJumps() const{ return m_SwitchCaseJumps; }
-    std::optional<size_t> getSwitchDefaultJump() const { return m_SwitchDefaultJump; }
-    
-    //---------------------------------------------------------------------------
-    // Statement::Visitor virtuals
-    //---------------------------------------------------------------------------
-    virtual void visit(const Statement::Break&) final
-    {
-    }
-
-    virtual void visit(const Statement::Compound &compound) final
-    {
-        const auto &statements = compound.getStatements();
-        for(m_CurrentStatementIdx = 0; (*m_CurrentStatementIdx) < statements.size(); (*m_CurrentStatementIdx)++) {
-            statements[*m_CurrentStatementIdx].get()->accept(*this);
-        }
-        m_CurrentStatementIdx.reset();
-    }
-
-    virtual void visit(const Statement::Continue&) final
-    {
-    }
-
-    virtual void visit(const Statement::Do &doStatement) final
-    {
-        doStatement.getBody()->accept(*this);
-    }
-
-    virtual void visit(const Statement::Expression&) final
-    {
-    }
-
-    virtual void visit(const Statement::For &forStatement) final
-    {
-        // Interpret initialiser if statement present
-        if(forStatement.getInitialiser()) {
-            forStatement.getInitialiser()->accept(*this);
-        }
-
-        forStatement.getBody()->accept(*this);
-    }
-
-    virtual void visit(const Statement::If &ifStatement) final
-    {
-        ifStatement.getThenBranch()->accept(*this);
-        ifStatement.getElseBranch()->accept(*this);
-    }
-
-    virtual void visit(const Statement::Labelled &labelled) final
-    {
-        // If label has a value i.e. it's a case not a default, add value expression and statement index to vector of labelled statements
-        if (labelled.getValue()) {
-            m_SwitchCaseJumps.emplace_back(labelled.getValue(), 
-                                           m_CurrentStatementIdx.value());
-        }
-        // Otherwise, add statement index to vector of labelled statements
-        else {
-            assert(!m_SwitchDefaultJump);
-            m_SwitchDefaultJump = m_CurrentStatementIdx.value();
+    // Count variables declared directly within statements
+    size_t numSlots = 0;
+    for(const auto &s : statements) {
+        const auto *varDeclaration = dynamic_cast<const Statement::VarDeclaration*>(s.get());
+        if(varDeclaration) {
+            numSlots += varDeclaration->getInitDeclaratorList().size();
         }
     }
+    return numSlots;
+}
+//---------------------------------------------------------------------------
+Token::LiteralValue assignValue(Token::LiteralValue &variable, Token::LiteralValue value, Token::Type op)
+{
+#ifdef _WIN32
+    #pragma warning(push)
+    #pragma warning(disable: 4804)  // unsafe use of type 'bool' in operation
+    #pragma warning(disable: 4805)  // unsafe mix of type 'type' and type 'type' in operation
+#endif
 
-    virtual void visit(const Statement::Switch &switchStatement) final
-    {
-        // **TODO** handle nested switch
-        assert(false);
-    }
+    using Type = Token::Type;
 
-    virtual void visit(const Statement::VarDeclaration&) final
-    {
-    }
+    variable = std::visit(
+        Utils::Overload{
+            [op](auto current, auto assign)
+            { 
+                if(op == Type::EQUAL) {
+                    return Token::LiteralValue(assign);
+                }
+                else if(op == Type::STAR_EQUAL) {
+                    return Token::LiteralValue(current * assign);
+                }
+                else if(op == Type::SLASH_EQUAL) {
+                    return Token::LiteralValue(current / assign);
+                }
+                else if(op == Type::PLUS_EQUAL) {
+                    return Token::LiteralValue(current + assign);
+                }
+                else if(op == Type::MINUS_EQUAL) {
+                    return Token::LiteralValue(current - assign);
+                }
+                else if constexpr(std::is_integral_v<decltype(current)> && std::is_integral_v<decltype(assign)>) {
+                    if(op == Type::PERCENT_EQUAL) {
+                        return Token::LiteralValue(current % assign);
+                    }
+                    else if(op == Type::AMPERSAND_EQUAL) {
+                        return Token::LiteralValue(current & assign);
+                    }
+                    else if(op == Type::CARET_EQUAL) {
+                        return Token::LiteralValue(current ^ assign);
+                    }
+                    else if(op == Type::PIPE_EQUAL) {
+                        return Token::LiteralValue(current | assign);
+                    }
+                    else if(op == Type::SHIFT_LEFT_EQUAL) {
+                        return Token::LiteralValue(current << assign);
+                    }
+                    else if(op == Type::SHIFT_RIGHT_EQUAL) {
+                        return Token::LiteralValue(current >> assign);
+                    }
+                }
+                throw std::runtime_error("Unsupported assignment operation");
+            },
+            [op](std::monostate, auto assign) 
+            { 
+                if(op == Type::EQUAL) {
+                    return Token::LiteralValue(assign);
+                }
+                else {
+                    throw std::runtime_error("Invalid assignment operand");
+                }
+            },
+            [](std::monostate, std::monostate)->Token::LiteralValue { throw std::runtime_error("Invalid assignment operand"); },
+            [](auto, std::monostate)->Token::LiteralValue { throw std::runtime_error("Invalid assignment operand"); }},
+        variable, value);
 
-    virtual void visit(const Statement::While &whileStatement) final
-    {
-        whileStatement.getBody()->accept(*this);
-    }
+#ifdef _WIN32
+    #pragma warning(pop)
+#endif
+    return variable;
+}
+//---------------------------------------------------------------------------
+Token::LiteralValue incDecValue(Token::LiteralValue value, Token::Type op)
+{
+    using Type = Token::Type;
 
-    virtual void visit(const Statement::Print&) final
-    {
-    }
+    return std::visit(
+        Utils::Overload{
+            [op](auto variable)
+            { 
+                if(op == Type::PLUS_PLUS) {
+                    return Token::LiteralValue(variable + 1);
+                }
+                else if(op == Type::MINUS_MINUS) {
+                    return Token::LiteralValue(variable - 1);
+                }
+                else {
+                    throw std::runtime_error("Unsupported increment/decrement operation");
+                }
+            },
+            [](std::monostate)->Token::LiteralValue { throw std::runtime_error("Invalid increment/decrement operand"); }},
+        value);
+}
+//---------------------------------------------------------------------------
+Token::LiteralValue prefixIncDecValue(Token::LiteralValue &variable, Token::Type op)
+{
+    // Update variable and return new value
+    variable = incDecValue(variable, op);
+    return variable;
+}
+//---------------------------------------------------------------------------
+Token::LiteralValue postfixIncDecValue(Token::LiteralValue &variable, Token::Type op)
+{
+    // Update variable and return previous value
+    const auto prevValue = variable;
+    variable = incDecValue(variable, op);
+    return prevValue;
+}
 
-private:
-    //---------------------------------------------------------------------------
-    // Members
-    //---------------------------------------------------------------------------
-    std::optional<size_t> m_CurrentStatementIdx;
-    std::vector<std::pair<const Expression::Base*, size_t>> m_SwitchCaseJumps;
-    std::optional<size_t> m_SwitchDefaultJump;
+//---------------------------------------------------------------------------
+// Completion
+//---------------------------------------------------------------------------
+//! How execution of a statement completed - break and continue
+//! propagate outwards until they reach the enclosing loop or switch
+enum class Completion
+{
+    NORMAL,
+    BREAK,
+    CONTINUE,
 };
 
 //---------------------------------------------------------------------------
@@ -155,7 +189,7 @@ class Visitor : public Expression::Visitor, public Statement::Visitor
 {
 public:
     Visitor()
-    :   m_Environment(nullptr)
+    :   m_Completion(Completion::NORMAL), m_Resolution(nullptr), m_Globals(nullptr)
     {
     }
     //---------------------------------------------------------------------------
@@ -163,18 +197,56 @@ public:
     //---------------------------------------------------------------------------
     Token::LiteralValue evaluate(const Expression::Base *expression)
     {
-        expression->accept(*this);
+        // **NOTE** rather than recursing, expressions are visited repeatedly from an explicit stack of 
+        // frames until they have evaluated all of their operands so nesting depth is only limited by heap memory
+        const size_t numFrames = m_Frames.size();
+        m_Frames.push_back({expression, 0});
+        while(true) {
+            // Visit expression at top of stack
+            const size_t numVisitFrames = m_Frames.size();
+            m_Frames.back().expression->accept(*this);
+
+            // If visit didn't push an operand, it's complete
+            if(m_Frames.size() == numVisitFrames) {
+                m_Frames.pop_back();
+
+                // Stop if this was the expression being evaluated, otherwise push value as operand of parent
+                if(m_Frames.size() == numFrames) {
+                    break;
+                }
+                m_Operands.push_back(m_Value);
+            }
+        }
         return std::get<Token::LiteralValue>(m_Value);
     }
 
-    void interpret(const Statement::StatementList &statements, Environment &environment)
+    Completion execute(const Statement::Base *statement)
     {
-        Environment *previous = m_Environment;
-        m_Environment = &environment;
-        for(auto &s : statements) {
-            s.get()->accept(*this);
+        m_Completion = Completion::NORMAL;
+        statement->accept(*this);
+        return m_Completion;
+    }
+
+    void interpret(const Statement::StatementList &statements, Environment &environment,
+                   const TypeChecker::Resolution &resolution)
+    {
+        m_Resolution = &resolution;
+
+        // Statements are executed in their own scope with globals provided by environment
+        // **NOTE** values are never removed from environments so globals resolved by previous calls with
+        // the same environment can be reused unless new variables have hidden them, see invalidateGlobals
+        if(m_Globals != &environment) {
+            m_Globals = &environment;
+            m_GlobalValues.clear();
         }
-        m_Environment = previous;
+        pushScope(getNumSlots(statements));
+        execute(statements);
+        popScope();
+    }
+
+    void invalidateGlobals()
+    {
+        m_GlobalValues.clear();
     }
 
     //---------------------------------------------------------------------------
@@ -187,8 +259,12 @@ public:
 
     virtual void visit(const Expression::Assignment &assignment) final
     {
-        auto value = evaluate(assignment.getValue());
-        m_Value = m_Environment->assign(assignment.getVarName(), value, assignment.getOperator().type);
+        if(evaluateOperands({assignment.getValue()})) {
+            return;
+        }
+        auto value = popValue();
+        m_Value = assignValue(getVariable(assignment.getVarName(), m_Resolution->getSlot(&assignment)),
+                              value, assignment.getOperator().type);
     }
 
     virtual void visit(const Expression::Binary &binary) final
@@ -205,8 +281,11 @@ public:
 #endif
         using Type = Token::Type;
 
-        auto leftValue = evaluate(binary.getLeft());
-        auto rightValue = evaluate(binary.getRight());
+        if(evaluateOperands({binary.getLeft(), binary.getRight()})) {
+            return;
+        }
+        auto rightValue = popValue();
+        auto leftValue = popValue();
 
         const auto opType = binary.getOperator().type;
         m_Value = std::visit(
@@ -238,7 +317,7 @@ public:
                         return Token::LiteralValue(left < right);
                     }
                     else if(opType == Type::LESS_EQUAL) {
-                        return Token::LiteralValue(left < right);
+                        return Token::LiteralValue(left <= right);
                     }
                     else if(opType == Type::NOT_EQUAL) {
                         return Token::LiteralValue(left != right);
@@ -281,16 +360,26 @@ public:
 
     virtual void visit(const Expression::Call &call) final
     {
-        // Evaluate callee and extract callabale
-        // **NOTE** we can't call evaluate as that returns a value
-        call.getCallee()->accept(*this);
-        auto callable = std::get<std::reference_wrapper<Callable>>(m_Value);
+        // Evaluate callee followed by arguments
+        // **NOTE** callee is evaluated to a callable rather than a value
+        const size_t numOperands = m_Frames.back().numOperands;
+        if(numOperands == 0) {
+            pushOperand(call.getCallee());
+            return;
+        }
+        else if(numOperands <= call.getArguments().size()) {
+            pushOperand(call.getArguments()[numOperands - 1].get());
+            return;
+        }
 
-        // Evaluate arguments
+        // Extract callable and arguments from operands
+        const size_t firstOperand = m_Operands.size() - numOperands;
+        auto callable = std::get<std::reference_wrapper<Callable>>(m_Operands[firstOperand]);
         std::vector<Token::LiteralValue> arguments;
-        for(const auto &arg : call.getArguments()) {
-            arguments.push_back(evaluate(arg.get()));
+        for(size_t i = firstOperand + 1; i < m_Operands.size(); i++) {
+            arguments.push_back(std::get<Token::LiteralValue>(m_Operands[i]));
         }
+        m_Operands.resize(firstOperand);
 
         // If callable has fixed arity
         if(callable.get().getArity()) {
@@ -308,26 +397,35 @@ public:
 
     virtual void visit(const Expression::Cast &cast) final
     {
-        m_Value = evaluate(cast.getExpression());
+        if(evaluateOperands({cast.getExpression()})) {
+            return;
+        }
+        m_Value = popValue();
 
         assert(false);
     }
 
     virtual void visit(const Expression::Conditional &conditional) final
     {
-        auto conditionValue = evaluate(conditional.getCondition());
-
-        if(isTruthy(conditionValue)) {
-            m_Value = evaluate(conditional.getTrue());
+        // Evaluate condition followed by whichever expression it selects
+        const size_t numOperands = m_Frames.back().numOperands;
+        if(numOperands == 0) {
+            pushOperand(conditional.getCondition());
+        }
+        else if(numOperands == 1) {
+            pushOperand(isTruthy(popValue()) ? conditional.getTrue() : conditional.getFalse());
         }
         else {
-            m_Value = evaluate(conditional.getFalse());
+            m_Value = popValue();
         }
     }
 
     virtual void visit(const Expression::Grouping &grouping) final
     {
-        evaluate(grouping.getExpression());
+        if(evaluateOperands({grouping.getExpression()})) {
+            return;
+        }
+        m_Value = popValue();
     }
 
     virtual void visit(const Expression::Literal &literal) final
@@ -337,14 +435,26 @@ public:
 
     virtual void visit(const Expression::Logical &logical) final
     {
-        auto leftValue = evaluate(logical.getLeft());
+        // If right operand has been evaluated, it determines value
+        const size_t numOperands = m_Frames.back().numOperands;
+        if(numOperands == 2) {
+            m_Value = (int)isTruthy(popValue());
+            return;
+        }
+        // Otherwise, evaluate left operand
+        else if(numOperands == 0) {
+            pushOperand(logical.getLeft());
+            return;
+        }
+
+        auto leftValue = popValue();
 
         if(logical.getOperator().type == Token::Type::PIPE_PIPE) {
             if(isTruthy(leftValue)) {
                 m_Value = 1;
             }
             else {
-                m_Value = (int)isTruthy(evaluate(logical.getRight()));
+                pushOperand(logical.getRight());
             }
         }
         else {
@@ -352,24 +462,33 @@ public:
                 m_Value = 0;
             }
             else {
-                m_Value = (int)isTruthy(evaluate(logical.getRight()));
+                pushOperand(logical.getRight());
             }
         }
     }
 
     virtual void visit(const Expression::PostfixIncDec &postfixIncDec) final
     {
-        m_Value = m_Environment->postfixIncDec(postfixIncDec.getVarName(), postfixIncDec.getOperator().type);
+        m_Value = postfixIncDecValue(getVariable(postfixIncDec.getVarName(), m_Resolution->getSlot(&postfixIncDec)),
+                                     postfixIncDec.getOperator().type);
     }
 
     virtual void visit(const Expression::PrefixIncDec &prefixIncDec) final
     {
-        m_Value = m_Environment->prefixIncDec(prefixIncDec.getVarName(), prefixIncDec.getOperator().type);
+        m_Value = prefixIncDecValue(getVariable(prefixIncDec.getVarName(), m_Resolution->getSlot(&prefixIncDec)),
+                                    prefixIncDec.getOperator().type);
     }
 
     virtual void visit(const Expression::Variable &variable) final
     {
-        m_Value = m_Environment->get(variable.getName());
+        // **NOTE** globals may be callable so are read directly
+        const auto slot = getSlot(variable.getName(), m_Resolution->getSlot(&variable));
+        if(slot.global) {
+            m_Value = getGlobal(variable.getName(), slot);
+        }
+        else {
+            m_Value = getLocal(slot);
+        }
     }
 
     virtual void visit(const Expression::Unary &unary) final
@@ -384,7 +503,10 @@ public:
 #endif
         using Type = Token::Type;
 
-        auto rightValue = evaluate(unary.getRight());
+        if(evaluateOperands({unary.getRight()})) {
+            return;
+        }
+        auto rightValue = popValue();
 
         const auto opType = unary.getOperator().type;
         m_Value = std::visit(
@@ -422,34 +544,30 @@ public:
     //---------------------------------------------------------------------------
     virtual void visit(const Statement::Break&) final
     {
-        throw Break();
+        m_Completion = Completion::BREAK;
     }
 
     virtual void visit(const Statement::Compound &compound) final
     {
-        Environment environment(m_Environment);
-        interpret(compound.getStatements(), environment);
+        pushScope(m_Resolution->getNumSlots(&compound));
+        m_Completion = execute(compound.getStatements());
+        popScope();
     }
 
     virtual void visit(const Statement::Continue&) final
     {
-         throw Continue();
+        m_Completion = Completion::CONTINUE;
     }
 
     virtual void visit(const Statement::Do &doStatement) final
     {
         do {
-            try {
-                doStatement.getBody()->accept(*this);
-            }
-            // Break if we encounter break exception and ignore continue exceptions
-            catch(Break&) {
+            // Stop if body breaks, continue is handled by falling through to condition
+            if(execute(doStatement.getBody()) == Completion::BREAK) {
                 break;
             }
-            catch(Continue&) {
-            }
-        
         } while(isTruthy(evaluate(doStatement.getCondition())));
+        m_Completion = Completion::NORMAL;
     }
 
     virtual void visit(const Statement::Expression &expression) final
@@ -459,52 +577,45 @@ public:
 
     virtual void visit(const Statement::For &forStatement) final
     {
-        // Create new environment for loop initialisation
-        Environment *previous = m_Environment;
-        Environment environment(m_Environment);
-        m_Environment = &environment;
+        // Create new scope for loop initialisation
+        pushScope(m_Resolution->getNumSlots(&forStatement));
 
         // Interpret initialiser if statement present
         if(forStatement.getInitialiser()) {
-            forStatement.getInitialiser()->accept(*this);
+            execute(forStatement.getInitialiser());
         }
 
         // While condition is true
         while(isTruthy(evaluate(forStatement.getCondition()))) {
-            // Interpret body
-            try {
-                forStatement.getBody()->accept(*this);
-            }
-            // Break if we encounter break exception and ignore continue exceptions
-            catch(Break&) {
+            // Interpret body, stopping if it breaks
+            if(execute(forStatement.getBody()) == Completion::BREAK) {
                 break;
             }
-            catch(Continue&) {
-            }
 
             // Interpret incrementer if present
             if(forStatement.getIncrement()) {
-                forStatement.getIncrement()->accept(*this);
+                evaluate(forStatement.getIncrement());
             }
         }
 
-        // Restore environment
-        m_Environment = previous;
+        // Restore scope
+        popScope();
+        m_Completion = Completion::NORMAL;
     }
 
     virtual void visit(const Statement::If &ifStatement) final
     {
         if(isTruthy(evaluate(ifStatement.getCondition()))) {
-            ifStatement.getThenBranch()->accept(*this);
+            m_Completion = execute(ifStatement.getThenBranch());
         }
         else if(ifStatement.getElseBranch()) {
-            ifStatement.getElseBranch()->accept(*this);
+            m_Completion = execute(ifStatement.getElseBranch());
         }
     }
 
     virtual void visit(const Statement::Labelled &labelled) final
     {
-        labelled.getBody()->accept(*this);
+        m_Completion = execute(labelled.getBody());
     }
 
     virtual void visit(const Statement::Switch &switchStatement) final
@@ -514,65 +625,65 @@ public:
         const auto *compoundBody = dynamic_cast<const Statement::Compound*>(switchStatement.getBody());
         assert(compoundBody);
 
-        // Visit switch statement body using special visitor class to find labelled statements
-        SwitchLabelVisitor switchLabelVisitor;
-        compoundBody->accept(switchLabelVisitor);
-
         // Evaluate value
-        auto value = evaluate(switchStatement.getCondition());
-        
-        // Search cases for jump that matches value
-        const auto &switchCaseJumps = switchLabelVisitor.getSwitchCaseJumps();
-        const auto jumpIter = std::find_if(switchCaseJumps.cbegin(), switchCaseJumps.cend(),
-                                          [value, this](const auto &jump)
-                                          {
-                                              return (evaluate(jump.first) == value);
-                                          });
-        
-        // If matching case was found, use this as jump destination, otherwise use default
-        const std::optional<size_t> jump = (jumpIter != switchCaseJumps.cend()) ? jumpIter->second : switchLabelVisitor.getSwitchDefaultJump();
-    
+        const int64_t value = getCaseValue(evaluate(switchStatement.getCondition()));
+
+        // Find matching case or default in table resolved by type checker
+        const auto *switchCase = m_Resolution->getSwitchTable(&switchStatement).findCase(value);
+        std::optional<size_t> jump;
+        if(switchCase) {
+            // **NOTE** labels nested within other statements of the body e.g. Duff's device aren't supported
+            if(!switchCase->statement) {
+                throw std::runtime_error("Case label not at top level of switch body is not supported");
+            }
+            jump = switchCase->statement;
+        }
+
+        // Create scope for body
+        pushScope(m_Resolution->getNumSlots(compoundBody));
+
         // If jump target was found
         if(jump) {
             // Loop through statements in body, starting from jump
+            // **NOTE** continue propagates to the enclosing loop
             for(size_t s = jump.value(); s < compoundBody->getStatements().size(); s++) {
-                try {
-                    compoundBody->getStatements().at(s).get()->accept(*this);
+                const Completion completion = execute(compoundBody->getStatements().at(s).get());
+                if(completion == Completion::CONTINUE) {
+                    popScope();
+                    m_Completion = completion;
+                    return;
                 }
-                // Break if we encounter break exception and ignore continue exceptions
-                catch(Break&) {
+                else if(completion == Completion::BREAK) {
                     break;
                 }
             }
         }
+        popScope();
+        m_Completion = Completion::NORMAL;
     }
 
     virtual void visit(const Statement::VarDeclaration &varDeclaration) final
     {
         // **TODO** something with type
+        size_t slot = m_Resolution->getFirstSlot(&varDeclaration);
         for(const auto &var : varDeclaration.getInitDeclaratorList()) {
             Token::LiteralValue value;
             if(std::get<1>(var)) {
                 evaluate(std::get<1>(var).get());
                 value = std::get<Token::LiteralValue>(m_Value);
             }
-            m_Environment->define(std::get<0>(var), value);
+            getLocal({false, 0, slot++}) = value;
         }
     }
 
     virtual void visit(const Statement::While &whileStatement) final
     {
         while(isTruthy(evaluate(whileStatement.getCondition()))) {
-            try {
-                whileStatement.getBody()->accept(*this);
-            }
-            // Break if we encounter break exception and ignore continue exceptions
-            catch(Break&) {
+            if(execute(whileStatement.getBody()) == Completion::BREAK) {
                 break;
             }
-            catch(Continue&) {
-            }
         }
+        m_Completion = Completion::NORMAL;
     }
 
     virtual void visit(const Statement::Print &print) final
@@ -596,12 +707,129 @@ public:
     }
 
 private:
+    //---------------------------------------------------------------------------
+    // Frame
+    //---------------------------------------------------------------------------
+    //! Expression being evaluated and how many of its operands have been evaluated so far
+    struct Frame
+    {
+        const Expression::Base *expression;
+        size_t numOperands;
+    };
+
+    //---------------------------------------------------------------------------
+    // Private methods
+    //---------------------------------------------------------------------------
+    //! Push operand of expression being visited to be evaluated, after which expression will be visited again
+    void pushOperand(const Expression::Base *operand)
+    {
+        m_Frames.back().numOperands++;
+        m_Frames.push_back({operand, 0});
+    }
+
+    //! Push next operand of expression being visited to be evaluated, returning false once all have been evaluated
+    //! and their values are on the top of the operand stack (in order) for the expression to pop
+    bool evaluateOperands(std::initializer_list<const Expression::Base*> operands)
+    {
+        const size_t numOperands = m_Frames.back().numOperands;
+        if(numOperands < operands.size()) {
+            pushOperand(operands.begin()[numOperands]);
+            return true;
+        }
+        else {
+            return false;
+        }
+    }
+
+    Token::LiteralValue popValue()
+    {
+        const auto value = std::get<Token::LiteralValue>(m_Operands.back());
+        m_Operands.pop_back();
+        return value;
+    }
+
+    Completion execute(const Statement::StatementList &statements)
+    {
+        // Execute statements until one doesn't complete normally
+        for(auto &s : statements) {
+            const Completion completion = execute(s.get());
+            if(completion != Completion::NORMAL) {
+                return completion;
+            }
+        }
+        return Completion::NORMAL;
+    }
+
+    void pushScope(size_t numSlots)
+    {
+        m_Scopes.push_back(m_Locals.size());
+        m_Locals.resize(m_Locals.size() + numSlots);
+    }
+
+    void popScope()
+    {
+        m_Locals.resize(m_Scopes.back());
+        m_Scopes.pop_back();
+    }
+
+    const Expression::VariableSlot &getSlot(const Token &name, const std::optional<Expression::VariableSlot> &slot) const
+    {
+        if(!slot) {
+            throw std::runtime_error("Variable '" + std::string{name.lexeme} + "' at line " + std::to_string(name.line) + " has not been resolved by type checker");
+        }
+        return *slot;
+    }
+
+    Token::LiteralValue &getLocal(const Expression::VariableSlot &slot)
+    {
+        return m_Locals[m_Scopes[m_Scopes.size() - 1 - slot.depth] + slot.index];
+    }
+
+    Environment::Value &getGlobal(const Token &name, const Expression::VariableSlot &slot)
+    {
+        // Bind global to value in environment by name on first access
+        if(slot.index >= m_GlobalValues.size()) {
+            m_GlobalValues.resize(slot.index + 1, nullptr);
+        }
+        if(!m_GlobalValues[slot.index]) {
+            m_GlobalValues[slot.index] = &m_Globals->getValue(name);
+        }
+        return *m_GlobalValues[slot.index];
+    }
+
+    Token::LiteralValue &getVariable(const Token &name, const std::optional<Expression::VariableSlot> &slot)
+    {
+        const auto &resolvedSlot = getSlot(name, slot);
+        if(resolvedSlot.global) {
+            return std::get<Token::LiteralValue>(getGlobal(name, resolvedSlot));
+        }
+        else {
+            return getLocal(resolvedSlot);
+        }
+    }
+
     //---------------------------------------------------------------------------
     // Members
     //---------------------------------------------------------------------------
     Environment::Value m_Value;
-    
-    Environment *m_Environment;
+    Completion m_Completion;
+
+    //! Slots and scopes resolved by type checker for statements being executed
+    const TypeChecker::Resolution *m_Resolution;
+
+    //! Stack of expressions being evaluated and of values of operands evaluated so far
+    std::vector<Frame> m_Frames;
+    std::vector<Environment::Value> m_Operands;
+
+    //! Values of local variables in all scopes
+    std::vector<Token::LiteralValue> m_Locals;
+
+    //! Index of first local variable in each scope
+    std::vector<size_t> m_Scopes;
+
+    //! Environment containing global variables and values bound to each global index
+    Environment *m_Globals;
+    std::vector<Environment::Value*> m_GlobalValues;
 };
 }
 
@@ -612,183 +840,49 @@ namespace MiniParse::Interpreter
 {
 void Environment::define(const Token &name, Token::LiteralValue value)
 {
-    if(!m_Values.try_emplace(name.lexeme, value).second) {
+    if(!m_Values.try_emplace(getSymbol(name), value).second) {
         throw std::runtime_error("Redeclaration of '" + std::string{name.lexeme} + "' at line " + std::to_string(name.line));
     }
 }
 //---------------------------------------------------------------------------
-void Environment::define(std::string_view name, Callable &callable)
+void Environment::define(Symbol name, Callable &callable)
 {
     if(!m_Values.try_emplace(name, callable).second) {
-        throw std::runtime_error("Redeclaration of '" + std::string{name});
+        throw std::runtime_error("Redeclaration of '" + std::string{m_SymbolTable.getName(name)} + "'");
     }
 }
 //---------------------------------------------------------------------------
+void Environment::define(std::string_view name, Callable &callable)
+{
+    define(m_SymbolTable.intern(name), callable);
+}
+//---------------------------------------------------------------------------
 Environment::Value Environment::assign(const Token &name, Token::LiteralValue value, Token::Type op)
 {
-#ifdef _WIN32
-    #pragma warning(push)
-    #pragma warning(disable: 4804)  // unsafe use of type 'bool' in operation
-    #pragma warning(disable: 4805)  // unsafe mix of type 'type' and type 'type' in operation
-#endif
-
-    using Type = Token::Type;
-
-    auto variable = m_Values.find(name.lexeme);
-    if(variable == m_Values.end()) {
-        if(m_Enclosing) {
-            return m_Enclosing->assign(name, value, op);
-        }
-        else {
-            throw std::runtime_error("Undefined variable '" + std::string{name.lexeme} + "' at line " + std::to_string(name.line));
-        }
-    }
-    else {
-        auto newValue = std::visit(
-            Utils::Overload{
-                [op](auto variable, auto assign)
-                { 
-                    if(op == Type::EQUAL) {
-                        return Token::LiteralValue(assign);
-                    }
-                    else if(op == Type::STAR_EQUAL) {
-                        return Token::LiteralValue(variable * assign);
-                    }
-                    else if(op == Type::SLASH_EQUAL) {
-                        return Token::LiteralValue(variable / assign);
-                    }
-                    else if(op == Type::PLUS_EQUAL) {
-                        return Token::LiteralValue(variable + assign);
-                    }
-                    else if(op == Type::MINUS_EQUAL) {
-                        return Token::LiteralValue(variable - assign);
-                    }
-                    else if constexpr(std::is_integral_v<decltype(variable)> && std::is_integral_v<decltype(assign)>) {
-                        if(op == Type::PERCENT_EQUAL) {
-                            return Token::LiteralValue(variable % assign);
-                        }
-                        else if(op == Type::AMPERSAND_EQUAL) {
-                            return Token::LiteralValue(variable & assign);
-                        }
-                        else if(op == Type::CARET_EQUAL) {
-                            return Token::LiteralValue(variable ^ assign);
-                        }
-                        else if(op == Type::PIPE_EQUAL) {
-                            return Token::LiteralValue(variable | assign);
-                        }
-                        else if(op == Type::SHIFT_LEFT_EQUAL) {
-                            return Token::LiteralValue(variable << assign);
-                        }
-                        else if(op == Type::SHIFT_RIGHT_EQUAL) {
-                            return Token::LiteralValue(variable >> assign);
-                        }
-                    }
-                    throw std::runtime_error("Unsupported assignment operation");
-                },
-                [op](std::monostate, auto assign) 
-                { 
-                    if(op == Type::EQUAL) {
-                        return Token::LiteralValue(assign);
-                    }
-                    else {
-                        throw std::runtime_error("Invalid assignment operand");
-                    }
-                },
-                [](std::monostate, std::monostate)->Token::LiteralValue { throw std::runtime_error("Invalid assignment operand"); },
-                [](auto, std::monostate)->Token::LiteralValue { throw std::runtime_error("Invalid assignment operand"); }},
-            std::get<Token::LiteralValue>(variable->second), value);
-
-        // Update environemnt with new value and return
-        std::get<Token::LiteralValue>(variable->second) = newValue;
-        return newValue;
-    }
-
-#ifdef _WIN32
-    #pragma warning(pop)
-#endif
+    return assignValue(std::get<Token::LiteralValue>(getValue(name)), value, op);
 }
 //---------------------------------------------------------------------------
 Environment::Value Environment::prefixIncDec(const Token &name, Token::Type op)
 {
-    using Type = Token::Type;
-
-    auto variable = m_Values.find(name.lexeme);
-    if(variable == m_Values.end()) {
-        if(m_Enclosing) {
-            return m_Enclosing->prefixIncDec(name, op);
-        }
-        else {
-            throw std::runtime_error("Undefined variable '" + std::string{name.lexeme} + "' at line " + std::to_string(name.line));
-        }
-    }
-    else {
-        // Perform operation on variable value
-        std::get<Token::LiteralValue>(variable->second) = std::visit(
-            Utils::Overload{
-                [op](auto variable)
-                { 
-                    if(op == Type::PLUS_PLUS) {
-                        return Token::LiteralValue(variable + 1);
-                    }
-                    else if(op == Type::MINUS_MINUS) {
-                        return Token::LiteralValue(variable - 1);
-                    }
-                    else {
-                        throw std::runtime_error("Unsupported prefix operation");
-                    }
-                },
-                [](std::monostate)->Token::LiteralValue { throw std::runtime_error("Invalid prefix operand"); }},
-            std::get<Token::LiteralValue>(variable->second));
-
-        // Return updated value
-        return std::get<Token::LiteralValue>(variable->second);
-    }
+    return prefixIncDecValue(std::get<Token::LiteralValue>(getValue(name)), op);
 }
 //---------------------------------------------------------------------------
 Environment::Value Environment::postfixIncDec(const Token &name, Token::Type op)
 {
-    using Type = Token::Type;
-
-    auto variable = m_Values.find(name.lexeme);
-    if(variable == m_Values.end()) {
-        if(m_Enclosing) {
-            return m_Enclosing->postfixIncDec(name, op);
-        }
-        else {
-            throw std::runtime_error("Undefined variable '" + std::string{name.lexeme} + "' at line " + std::to_string(name.line));
-        }
-    }
-    else {
-        // Perform operation on variable value
-        const auto prevValue = std::get<Token::LiteralValue>(variable->second);
-        std::get<Token::LiteralValue>(variable->second) = std::visit(
-            Utils::Overload{
-                [op](auto variable)
-                { 
-                    if(op == Type::PLUS_PLUS) {
-                        return Token::LiteralValue(variable + 1);
-                    }
-                    else if(op == Type::MINUS_MINUS) {
-                        return Token::LiteralValue(variable - 1);
-                    }
-                    else {
-                        throw std::runtime_error("Unsupported postfix operation");
-                    }
-                },
-                [](std::monostate)->Token::LiteralValue { throw std::runtime_error("Invalid postfix operand"); }},
-            std::get<Token::LiteralValue>(variable->second));
-
-        // Return previous value
-        return prevValue;
-    }
+    return postfixIncDecValue(std::get<Token::LiteralValue>(getValue(name)), op);
 }
 //---------------------------------------------------------------------------
 Environment::Value Environment::get(const Token &name) const
 {
-    auto val = m_Values.find(std::string{name.lexeme});
+    return const_cast<Environment*>(this)->getValue(name);
+}
+//---------------------------------------------------------------------------
+Environment::Value &Environment::getValue(const Token &name)
+{
+    auto val = m_Values.find(getSymbol(name));
     if(val == m_Values.end()) {
         if(m_Enclosing) {
-            return m_Enclosing->get(name);
+            return m_Enclosing->getValue(name);
         }
         else {
             throw std::runtime_error("Undefined variable '" + std::string{name.lexeme} + "' at line " + std::to_string(name.line));
@@ -798,10 +892,47 @@ Environment::Value Environment::get(const Token &name) const
         return val->second;
     }
 }
+//---------------------------------------------------------------------------
+Symbol Environment::getSymbol(const Token &name) const
+{
+    return (name.symbol == Symbol::NONE) ? m_SymbolTable.intern(name.lexeme) : name.symbol;
+}
+//---------------------------------------------------------------------------
+// MiniParse::Interpreter::Executor::Impl
+//---------------------------------------------------------------------------
+struct Executor::Impl
+{
+    Visitor visitor;
+};
 
-void interpret(const Statement::StatementList &statements, Environment &environment)
+//---------------------------------------------------------------------------
+// MiniParse::Interpreter::Executor
+//---------------------------------------------------------------------------
+Executor::Executor(const Statement::StatementList &statements, Environment &environment,
+                   const TypeChecker::Resolution &resolution)
+:   m_Statements(statements), m_Environment(environment), m_Resolution(resolution), m_Impl(std::make_unique<Impl>())
+{
+}
+//---------------------------------------------------------------------------
+Executor::~Executor() = default;
+//---------------------------------------------------------------------------
+void Executor::execute()
+{
+    m_Impl->visitor.interpret(m_Statements, m_Environment, m_Resolution);
+}
+//---------------------------------------------------------------------------
+void Executor::invalidateGlobals()
+{
+    m_Impl->visitor.invalidateGlobals();
+}
+
+//---------------------------------------------------------------------------
+// Free functions
+//---------------------------------------------------------------------------
+void interpret(const Statement::StatementList &statements, Environment &environment,
+               const TypeChecker::Resolution &resolution)
 {
     Visitor interpreter;
-    interpreter.interpret(statements, environment);
+    interpreter.interpret(statements, environment, resolution);
 }
 }   // namespace MiniParse::Interpreter
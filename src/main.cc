@@ -1,23 +1,31 @@
 // Standard C++ includes
 #include <iostream>
-#include <regex>
 #include <string>
+#include <tuple>
 #include <variant>
+#include <vector>
 
 // Standard C includes
 #include <cassert>
 #include <cmath>
 
 // Mini-parse includes
+#include "arena.h"
+#include "batch_compiler.h"
+#include "bytecode.h"
 #include "error_handler.h"
 #include "expression.h"
 #include "interpreter.h"
+#include "optimiser.h"
 #include "parser.h"
 #include "pretty_printer.h"
 #include "scanner.h"
+#include "source_manager.h"
 #include "type.h"
 #include "type_checker.h"
 #include "utils.h"
+#include "virtual_machine.h"
+#include "work_stealing_pool.h"
 
 using namespace MiniParse;
 
@@ -85,12 +93,6 @@ std::string test3(
     "   $(V)+= Imem/$(C)*mdt;\n"
     "}\n");
 
-std::string removeOldStyleVar(const std::string &input) {
-    std::regex variable(R"(\$\(([_a-zA-Z][a-zA-Z0-9]*)\))");
- 
-    return std::regex_replace(input, variable, "$1");
-}
-
 class ErrorHandler : public MiniParse::ErrorHandler
 {
 public:
@@ -142,18 +144,44 @@ public:
             arguments[0]);
     }
 };
-    
+
+//! GeNN function which adds synapse to postsynaptic neuron from kernel row, column and input and output channel.
+//! Only used to type check snippets so it's not one of the library's foreign function types which backends can call
+//! **NOTE** there is no void type so, although it's only called for its side effects, this returns int
+DECLARE_FOREIGN_FUNCTION_TYPE_ID(AddSynapse, Type::firstExternalForeignFunctionID,
+                                 Type::Int32, Type::Int32, Type::Int32, Type::Int32, Type::Uint32, Type::Uint32);
+IMPLEMENT_TYPE(AddSynapse);
 
 int main()
 {
     ::ErrorHandler errorHandler;
     try
     {
+        // Scan and parse GeNN snippets
+        // **NOTE** $(name) and $(func, args...) substitutions are scanned natively into identifiers and calls
+        // and the identifiers of all snippets are interned in a single symbol table. The source
+        // manager owns the snippets' text so the lexemes of their tokens can be mapped back to them
+        std::cout << "SCANNING GENN SNIPPETS" << std::endl;
+        SourceManager snippetSourceManager;
+        SymbolTable snippetSymbolTable;
+        for(const auto &[name, snippet] : {std::make_tuple("test", &test), std::make_tuple("test2", &test2), 
+                                           std::make_tuple("test3", &test3)}) 
+        {
+            Arena snippetArena;
+            const auto snippetSource = snippetSourceManager.addSource(name, *snippet);
+            const auto snippetTokens = Scanner::scanSource(snippetSource, snippetSymbolTable, errorHandler);
+            assert(snippetSourceManager.getLocation(snippetTokens.back().lexeme.data())->name == name);
+            const auto snippetStatements = Parser::parseBlockItemList(snippetTokens, errorHandler, snippetArena);
+            assert(!errorHandler.hasError());
+            std::cout << PrettyPrinter::print(snippetStatements) << std::endl;
+        }
+        std::cout << snippetSymbolTable.size() << " distinct identifiers" << std::endl;
+
         std::cout << "SCANNING" << std::endl;
         // Scan
-        const std::string source = removeOldStyleVar(test3);
+        SymbolTable symbolTable;
         /*const auto tokens = MiniParse::Scanner::scanSource(
-            source, errorHandler);
+            test3, symbolTable, errorHandler);
         const auto tokens = MiniParse::Scanner::scanSource(
             "int x = 4, y;\n"
             "print ((12 + x) * 5) + 3;\n"
@@ -163,7 +191,7 @@ int main()
             "y *= 2;\n"
             "print y;\n"
             "print 100;\n"
-            "print true;\n", errorHandler);
+            "print true;\n", symbolTable, errorHandler);
         const auto tokens = MiniParse::Scanner::scanSource(
             "int x = 4;\n"
             "print x;\n"
@@ -172,11 +200,11 @@ int main()
             "    print x;\n"
             "}\n"
             "print x;\n"
-            "print y;\n", errorHandler);
+            "print y;\n", symbolTable, errorHandler);
         const auto tokens = MiniParse::Scanner::scanSource(
             "double x = 2.0f;\n"
             "print x;\n"
-            "print sqrt(x);\n", errorHandler);
+            "print sqrt(x);\n", symbolTable, errorHandler);
         const auto tokens = Scanner::scanSource(
             "print floatArray[0];\n"
             "print intArray[0];\n"
@@ -188,7 +216,7 @@ int main()
             "   if(x < 0.1f) {\n"
             "       break;\n"
             "   }\n"
-            "}\n", errorHandler);*/
+            "}\n", symbolTable, errorHandler);*/
         const auto tokens = Scanner::scanSource(
             "int x = 3;\n"
             "switch(x) {\n"
@@ -204,19 +232,20 @@ int main()
             "case 7:\n"
             "    print(7);\n"
             "}\n",
-            errorHandler);
+            symbolTable, errorHandler);
         assert(!errorHandler.hasError());
         
         std::cout << "PARSING" << std::endl;
 
-        // Parse
-        auto statements = Parser::parseBlockItemList(tokens, errorHandler);
+        // Parse, allocating nodes in arena
+        Arena arena;
+        auto statements = Parser::parseBlockItemList(tokens, errorHandler, arena);
         assert(!errorHandler.hasError());
 
 
         std::cout << "TYPE CHECKING" << std::endl;
 
-        TypeChecker::Environment typeEnvironment;
+        TypeChecker::Environment typeEnvironment(symbolTable);
         
         typeEnvironment.define<Type::Double>("DT", true);
         typeEnvironment.define<Type::Double>("Isyn", true); 
@@ -231,21 +260,77 @@ int main()
         typeEnvironment.define<Type::Double>("m");
         typeEnvironment.define<Type::Double>("h");
         typeEnvironment.define<Type::Double>("n");
+
+        // Substitutions used by the other GeNN snippets
+        typeEnvironment.define<Type::Int32>("outRow");
+        typeEnvironment.define<Type::Int32>("maxOutRow", true);
+        typeEnvironment.define<Type::Int32>("endRow", true);
+        typeEnvironment.define<Type::Int32>("inRow", true);
+        typeEnvironment.define<Type::Int32>("inCol", true);
+        typeEnvironment.define<Type::Int32>("minOutCol", true);
+        typeEnvironment.define<Type::Int32>("maxOutCol", true);
+        typeEnvironment.define<Type::Uint32>("inChan", true);
+        typeEnvironment.define<Type::Uint32>("conv_sh", true);
+        typeEnvironment.define<Type::Uint32>("conv_sw", true);
+        typeEnvironment.define<Type::Uint32>("conv_padh", true);
+        typeEnvironment.define<Type::Uint32>("conv_padw", true);
+        typeEnvironment.define<Type::Uint32>("conv_ow", true);
+        typeEnvironment.define<Type::Uint32>("conv_oc", true);
+        typeEnvironment.define<AddSynapse>("addSynapse");
+        typeEnvironment.define<Type::Double>("RefracTime");
+        typeEnvironment.define<Type::Double>("Ioffset", true);
+        typeEnvironment.define<Type::Double>("Rmembrane", true);
+        typeEnvironment.define<Type::Double>("Vrest", true);
+        typeEnvironment.define<Type::Double>("ExpTC", true);
+
         typeEnvironment.define<Type::Int32Ptr>("intArray");
         typeEnvironment.define<Type::FloatPtr>("floatArray");
         typeEnvironment.define<Type::Exp>("exp");
         typeEnvironment.define<Type::Sqrt>("sqrt");
-        TypeChecker::typeCheck(statements, typeEnvironment, errorHandler);
+        auto resolution = TypeChecker::typeCheck(statements, typeEnvironment, errorHandler);
         assert(!errorHandler.hasError());
 
+        // Compile GeNN snippets concurrently with the type environment's variables as shared globals
+        // **NOTE** errors are reported in snippet order once all snippets have been compiled
+        std::cout << "BATCH COMPILING GENN SNIPPETS" << std::endl;
+        {
+            WorkStealingPool pool;
+            BatchCompiler::DiagnosticSink diagnostics;
+            const auto results = BatchCompiler::compileBatch({test, test2, test3}, typeEnvironment, diagnostics, pool);
+
+            ::ErrorHandler batchErrorHandler;
+            diagnostics.report(batchErrorHandler);
+            for(size_t i = 0; i < results.size(); i++) {
+                std::cout << "Snippet " << i << (results[i].success ? " compiled" : " failed") << std::endl;
+            }
+        }
+
+        std::cout << "OPTIMISING" << std::endl;
+        const auto foldedStatements = Optimiser::optimise(statements, resolution);
+        size_t numHoisted = 0;
+        const auto hoistedStatements = Optimiser::hoistLoopInvariants(foldedStatements, typeEnvironment, resolution, 
+                                                                      errorHandler, numHoisted);
+        std::cout << "Hoisted " << numHoisted << " loop-invariant subexpressions" << std::endl;
+        size_t numEliminated = 0;
+        const auto optimisedStatements = Optimiser::eliminateCommonSubexpressions(hoistedStatements, resolution, numEliminated);
+        std::cout << "Eliminated " << numEliminated << " common subexpression nodes" << std::endl;
+
         std::cout << "PRETTY PRINTING" << std::endl;
-        std::cout << PrettyPrinter::print(statements) << std::endl;
+        std::cout << PrettyPrinter::print(optimisedStatements) << std::endl;
         
         std::cout << "INTERPRETTING" << std::endl;
         Sqrt sqrt;
-        Interpreter::Environment environment;
+        Interpreter::Environment environment(symbolTable);
         environment.define("sqrt", sqrt);
-        Interpreter::interpret(statements, environment);
+        Interpreter::interpret(optimisedStatements, environment, resolution);
+
+        std::cout << "COMPILING BYTECODE" << std::endl;
+        const auto program = Bytecode::compile(optimisedStatements, resolution);
+        std::cout << program.disassemble() << std::endl;
+
+        std::cout << "EXECUTING BYTECODE" << std::endl;
+        Bytecode::VirtualMachine virtualMachine(program);
+        virtualMachine.execute();
     }
     catch(const std::exception &e) {
         std::cerr << e.what() << std::endl;
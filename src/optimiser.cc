@@ -0,0 +1,2004 @@
+#include "optimiser.h"
+
+// Standard C++ includes
+#include <algorithm>
+#include <charconv>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+// Standard C includes
+#include <cassert>
+#include <cmath>
+
+// GeNN includes
+#include "type.h"
+
+// Mini-parse includes
+#include "expression.h"
+#include "utils.h"
+
+using namespace MiniParse;
+using namespace MiniParse::Optimiser;
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+//! Call f with a value of the C++ type underlying numeric type
+template<typename F>
+void visitNumericType(const Type::NumericBase *type, F f)
+{
+    if(type == Type::Bool::getInstance()) {
+        f(bool{});
+    }
+    else if(type == Type::Int8::getInstance()) {
+        f(int8_t{});
+    }
+    else if(type == Type::Int16::getInstance()) {
+        f(int16_t{});
+    }
+    else if(type == Type::Int32::getInstance()) {
+        f(int32_t{});
+    }
+    else if(type == Type::Uint8::getInstance()) {
+        f(uint8_t{});
+    }
+    else if(type == Type::Uint16::getInstance()) {
+        f(uint16_t{});
+    }
+    else if(type == Type::Uint32::getInstance()) {
+        f(uint32_t{});
+    }
+    else if(type == Type::Float::getInstance()) {
+        f(float{});
+    }
+    else if(type == Type::Double::getInstance()) {
+        f(double{});
+    }
+    else {
+        throw std::runtime_error("Unsupported type '" + type->getTypeName() + "'");
+    }
+}
+//---------------------------------------------------------------------------
+//! Get literal value converted to C++ type T
+template<typename T>
+T getValue(const Token::LiteralValue &value)
+{
+    return std::visit(
+        Utils::Overload{
+            [](auto v) { return static_cast<T>(v); },
+            [](std::monostate)->T { throw std::runtime_error("Invalid literal"); }},
+        value);
+}
+//---------------------------------------------------------------------------
+//! Convert value to numeric type, storing types without literals as the int32 they would be promoted to
+template<typename T>
+Token::LiteralValue makeLiteralValue(T value, const Type::NumericBase *type)
+{
+    Token::LiteralValue literalValue;
+    visitNumericType(type,
+                     [value, &literalValue](auto tag)
+                     {
+                         using U = decltype(tag);
+                         const U converted = static_cast<U>(value);
+                         if constexpr(std::is_constructible_v<Token::LiteralValue, U> && (sizeof(U) >= sizeof(int32_t) || std::is_same_v<U, bool>)) {
+                             literalValue = converted;
+                         }
+                         else {
+                             literalValue = static_cast<int32_t>(converted);
+                         }
+                     });
+    return literalValue;
+}
+//---------------------------------------------------------------------------
+//! Evaluate binary arithmetic or bitwise operator on values of common type.
+//! Integer arithmetic wraps and operations which are undefined at runtime are not folded
+template<typename T>
+std::optional<T> foldArithmetic(Token::Type op, T left, T right)
+{
+    if constexpr(std::is_integral_v<T>) {
+        using U = std::make_unsigned_t<T>;
+        const U l = static_cast<U>(left);
+        const U r = static_cast<U>(right);
+        switch(op) {
+        case Token::Type::PLUS: return static_cast<T>(static_cast<U>(l + r));
+        case Token::Type::MINUS: return static_cast<T>(static_cast<U>(l - r));
+        case Token::Type::STAR: return static_cast<T>(static_cast<U>(l * r));
+        case Token::Type::CARET: return left ^ right;
+        case Token::Type::AMPERSAND: return left & right;
+        case Token::Type::PIPE: return left | right;
+        case Token::Type::SLASH:
+        case Token::Type::PERCENT:
+            if(right == 0 || (std::is_signed_v<T> && left == std::numeric_limits<T>::min() && right == static_cast<T>(-1))) {
+                return std::nullopt;
+            }
+            return (op == Token::Type::SLASH) ? (left / right) : (left % right);
+        default: return std::nullopt;
+        }
+    }
+    else {
+        switch(op) {
+        case Token::Type::PLUS: return left + right;
+        case Token::Type::MINUS: return left - right;
+        case Token::Type::STAR: return left * right;
+        case Token::Type::SLASH: return left / right;
+        default: return std::nullopt;
+        }
+    }
+}
+//---------------------------------------------------------------------------
+//! Evaluate relational or equality operator on values of common type
+template<typename T>
+std::optional<int32_t> foldComparison(Token::Type op, T left, T right)
+{
+    switch(op) {
+    case Token::Type::GREATER: return left > right;
+    case Token::Type::GREATER_EQUAL: return left >= right;
+    case Token::Type::LESS: return left < right;
+    case Token::Type::LESS_EQUAL: return left <= right;
+    case Token::Type::EQUAL_EQUAL: return left == right;
+    case Token::Type::NOT_EQUAL: return left != right;
+    default: return std::nullopt;
+    }
+}
+//---------------------------------------------------------------------------
+const Expression::Base *skipGroupings(const Expression::Base *expression)
+{
+    while(auto grouping = dynamic_cast<const Expression::Grouping*>(expression)) {
+        expression = grouping->getExpression();
+    }
+    return expression;
+}
+//---------------------------------------------------------------------------
+//! Is expression a literal with given value? Zero must be positive so x - 0.0 is only removed when exact
+bool isLiteral(const Expression::Base *expression, double value)
+{
+    const auto *literal = dynamic_cast<const Expression::Literal*>(expression);
+    if(!literal) {
+        return false;
+    }
+    const double literalValue = getValue<double>(literal->getValue());
+    return (literalValue == value) && !std::signbit(literalValue);
+}
+
+//---------------------------------------------------------------------------
+//! Is type that of a foreign function without side effects?
+bool isPureFunction(const Type::Base *type)
+{
+    return (type == Type::Exp::getInstance() || type == Type::Sqrt::getInstance());
+}
+//---------------------------------------------------------------------------
+//! Get view of string with static storage duration, used to name variables introduced by passes
+std::string_view getPersistentName(const std::string &name)
+{
+    static std::mutex mutex;
+    static std::unordered_set<std::string> names;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    return *names.insert(name).first;
+}
+//---------------------------------------------------------------------------
+//! Count variables declared directly within statements
+size_t getNumDeclared(const Statement::StatementList &statements)
+{
+    size_t numDeclared = 0;
+    for(const auto &s : statements) {
+        if(const auto *varDeclaration = dynamic_cast<const Statement::VarDeclaration*>(s.get())) {
+            numDeclared += varDeclaration->getInitDeclaratorList().size();
+        }
+    }
+    return numDeclared;
+}
+
+//---------------------------------------------------------------------------
+// WriteVisitor
+//---------------------------------------------------------------------------
+//! Visitor which finds names of variables written or declared by statements and expressions
+//! and, if resolved types are provided, whether they call any functions with side effects
+class WriteVisitor : public Expression::Visitor, public Statement::Visitor
+{
+public:
+    WriteVisitor(const TypeChecker::ResolvedTypeMap *resolvedTypes = nullptr)
+    :   m_ResolvedTypes(resolvedTypes), m_ImpureCalls(false)
+    {
+    }
+
+    //---------------------------------------------------------------------------
+    // Public API
+    //---------------------------------------------------------------------------
+    template<typename T>
+    void add(const T *node)
+    {
+        if(node) {
+            node->accept(*this);
+        }
+    }
+
+    const std::unordered_set<std::string_view> &getNames() const{ return m_Names; }
+    bool hasImpureCalls() const{ return m_ImpureCalls; }
+
+    //---------------------------------------------------------------------------
+    // Expression::Visitor virtuals
+    //---------------------------------------------------------------------------
+    virtual void visit(const Expression::ArraySubscript &arraySubscript) final
+    {
+        add(arraySubscript.getIndex().get());
+    }
+
+    virtual void visit(const Expression::Assignment &assignment) final
+    {
+        add(assignment.getValue());
+        m_Names.insert(assignment.getVarName().lexeme);
+    }
+
+    virtual void visit(const Expression::Binary &binary) final
+    {
+        add(binary.getLeft());
+        add(binary.getRight());
+    }
+
+    virtual void visit(const Expression::Call &call) final
+    {
+        if(m_ResolvedTypes) {
+            const auto calleeType = m_ResolvedTypes->find(call.getCallee());
+            if(calleeType == m_ResolvedTypes->cend() || !isPureFunction(calleeType->second)) {
+                m_ImpureCalls = true;
+            }
+        }
+        add(call.getCallee());
+        for(const auto &a : call.getArguments()) {
+            add(a.get());
+        }
+    }
+
+    virtual void visit(const Expression::Cast &cast) final
+    {
+        add(cast.getExpression());
+    }
+
+    virtual void visit(const Expression::Conditional &conditional) final
+    {
+        add(conditional.getCondition());
+        add(conditional.getTrue());
+        add(conditional.getFalse());
+    }
+
+    virtual void visit(const Expression::Grouping &grouping) final
+    {
+        add(grouping.getExpression());
+    }
+
+    virtual void visit(const Expression::Literal&) final
+    {
+    }
+
+    virtual void visit(const Expression::Logical &logical) final
+    {
+        add(logical.getLeft());
+        add(logical.getRight());
+    }
+
+    virtual void visit(const Expression::PostfixIncDec &postfixIncDec) final
+    {
+        m_Names.insert(postfixIncDec.getVarName().lexeme);
+    }
+
+    virtual void visit(const Expression::PrefixIncDec &prefixIncDec) final
+    {
+        m_Names.insert(prefixIncDec.getVarName().lexeme);
+    }
+
+    virtual void visit(const Expression::Variable&) final
+    {
+    }
+
+    virtual void visit(const Expression::Unary &unary) final
+    {
+        add(unary.getRight());
+    }
+
+    //---------------------------------------------------------------------------
+    // Statement::Visitor virtuals
+    //---------------------------------------------------------------------------
+    virtual void visit(const Statement::Break&) final
+    {
+    }
+
+    virtual void visit(const Statement::Compound &compound) final
+    {
+        for(const auto &s : compound.getStatements()) {
+            add(s.get());
+        }
+    }
+
+    virtual void visit(const Statement::Continue&) final
+    {
+    }
+
+    virtual void visit(const Statement::Do &doStatement) final
+    {
+        add(doStatement.getBody());
+        add(doStatement.getCondition());
+    }
+
+    virtual void visit(const Statement::Expression &expression) final
+    {
+        add(expression.getExpression());
+    }
+
+    virtual void visit(const Statement::For &forStatement) final
+    {
+        add(forStatement.getInitialiser());
+        add(forStatement.getCondition());
+        add(forStatement.getIncrement());
+        add(forStatement.getBody());
+    }
+
+    virtual void visit(const Statement::If &ifStatement) final
+    {
+        add(ifStatement.getCondition());
+        add(ifStatement.getThenBranch());
+        add(ifStatement.getElseBranch());
+    }
+
+    virtual void visit(const Statement::Labelled &labelled) final
+    {
+        add(labelled.getValue());
+        add(labelled.getBody());
+    }
+
+    virtual void visit(const Statement::Switch &switchStatement) final
+    {
+        add(switchStatement.getCondition());
+        add(switchStatement.getBody());
+    }
+
+    virtual void visit(const Statement::VarDeclaration &varDeclaration) final
+    {
+        for(const auto &var : varDeclaration.getInitDeclaratorList()) {
+            add(std::get<1>(var).get());
+            m_Names.insert(std::get<0>(var).lexeme);
+        }
+    }
+
+    virtual void visit(const Statement::While &whileStatement) final
+    {
+        add(whileStatement.getCondition());
+        add(whileStatement.getBody());
+    }
+
+    virtual void visit(const Statement::Print &print) final
+    {
+        add(print.getExpression());
+    }
+
+private:
+    //---------------------------------------------------------------------------
+    // Members
+    //---------------------------------------------------------------------------
+    const TypeChecker::ResolvedTypeMap *m_ResolvedTypes;
+    std::unordered_set<std::string_view> m_Names;
+    bool m_ImpureCalls;
+};
+
+//---------------------------------------------------------------------------
+// ValueNumberer
+//---------------------------------------------------------------------------
+//! Visitor which numbers the values of expressions in a basic block. Side-effect free subexpressions
+//! are given keys describing their structure, with variables identified by name and a version which
+//! is incremented whenever they are written, so subexpressions with equal keys have equal values
+class ValueNumberer : public Expression::Visitor
+{
+public:
+    //! Subexpression which could be replaced by a temporary
+    struct Occurrence
+    {
+        const Expression::Base *expression;
+        std::string key;
+
+        //! Index of statement within block
+        size_t statement;
+
+        //! Number of nodes in subexpression
+        size_t size;
+
+        //! Index of first occurrence within this one - occurrences are recorded in post-order
+        size_t firstDescendant;
+
+        //! Is subexpression only evaluated conditionally e.g. within right operand of &&
+        bool conditional;
+    };
+
+    ValueNumberer(const TypeChecker::ResolvedTypeMap &resolvedTypes)
+    :   m_ResolvedTypes(resolvedTypes), m_Written(nullptr), m_Statement(0), m_ConditionalDepth(0), m_NumNodes(0)
+    {
+    }
+
+    //---------------------------------------------------------------------------
+    // Public API
+    //---------------------------------------------------------------------------
+    //! Number expression evaluated by statement with index statement. Subexpressions
+    //! reading the variables written by the statement are not recorded
+    void add(const Expression::Base *expression, size_t statement, const std::unordered_set<std::string_view> &written)
+    {
+        m_Written = &written;
+        m_Statement = statement;
+        number(expression);
+    }
+
+    //! Mark variable as written so expressions subsequently reading it get new keys
+    void write(std::string_view name)
+    {
+        m_Versions[name]++;
+    }
+
+    const std::vector<Occurrence> &getOccurrences() const{ return m_Occurrences; }
+
+    //---------------------------------------------------------------------------
+    // Expression::Visitor virtuals
+    //---------------------------------------------------------------------------
+    virtual void visit(const Expression::ArraySubscript &arraySubscript) final
+    {
+        // **NOTE** array elements may be written through other names
+        number(arraySubscript.getIndex().get());
+        setKey(m_NumNodes + 1, std::nullopt);
+    }
+
+    virtual void visit(const Expression::Assignment &assignment) final
+    {
+        number(assignment.getValue());
+        setKey(m_NumNodes + 1, std::nullopt);
+    }
+
+    virtual void visit(const Expression::Binary &binary) final
+    {
+        const auto left = number(binary.getLeft());
+        const size_t numNodes = m_NumNodes;
+        const auto right = number(binary.getRight());
+        setKey(numNodes + m_NumNodes + 1, 
+               (left && right) ? std::make_optional("(" + *left + std::string{binary.getOperator().lexeme} + *right + ")") : std::nullopt);
+    }
+
+    virtual void visit(const Expression::Call &call) final
+    {
+        // Only calls to pure foreign functions have no side effects
+        const auto *calleeType = getType(call.getCallee());
+        const auto callee = number(call.getCallee());
+        size_t numNodes = m_NumNodes + 1;
+        std::optional<std::string> key;
+        if(callee && isPureFunction(calleeType)) {
+            key = *callee + "(";
+        }
+        for(const auto &a : call.getArguments()) {
+            const auto argument = number(a.get());
+            numNodes += m_NumNodes;
+            if(key && argument) {
+                *key += *argument + ",";
+            }
+            else {
+                key = std::nullopt;
+            }
+        }
+        setKey(numNodes, key ? std::make_optional(*key + ")") : std::nullopt);
+    }
+
+    virtual void visit(const Expression::Cast &cast) final
+    {
+        const auto expression = number(cast.getExpression());
+        setKey(m_NumNodes + 1, expression ? std::make_optional("(" + cast.getType()->getTypeName() + ")" + *expression) : std::nullopt);
+    }
+
+    virtual void visit(const Expression::Conditional &conditional) final
+    {
+        const auto condition = number(conditional.getCondition());
+        size_t numNodes = m_NumNodes + 1;
+
+        m_ConditionalDepth++;
+        const auto trueExpression = number(conditional.getTrue());
+        numNodes += m_NumNodes;
+        const auto falseExpression = number(conditional.getFalse());
+        numNodes += m_NumNodes;
+        m_ConditionalDepth--;
+
+        setKey(numNodes, (condition && trueExpression && falseExpression) 
+               ? std::make_optional("(" + *condition + "?" + *trueExpression + ":" + *falseExpression + ")") : std::nullopt);
+    }
+
+    virtual void visit(const Expression::Grouping &grouping) final
+    {
+        // **NOTE** parentheses don't change value
+        const auto expression = number(grouping.getExpression());
+        setKey(m_NumNodes + 1, expression);
+    }
+
+    virtual void visit(const Expression::Literal &literal) final
+    {
+        // Include type so, for example, 1 and 1.0 are distinguished
+        // **NOTE** std::to_string rounds floating point values to 6 decimal places so shortest round-tripping form is used
+        const auto *type = getType(&literal);
+        setKey(1, std::visit(
+            Utils::Overload{
+                [type](auto x)->std::optional<std::string>
+                {
+                    char buffer[64];
+                    std::to_chars_result result;
+                    if constexpr(std::is_same_v<decltype(x), bool>) {
+                        result = std::to_chars(buffer, buffer + sizeof(buffer), static_cast<int>(x));
+                    }
+                    else {
+                        result = std::to_chars(buffer, buffer + sizeof(buffer), x);
+                    }
+                    return type->getTypeName() + ":" + std::string(buffer, result.ptr);
+                },
+                [](std::monostate)->std::optional<std::string> { return std::nullopt; }},
+            literal.getValue()));
+    }
+
+    virtual void visit(const Expression::Logical &logical) final
+    {
+        const auto left = number(logical.getLeft());
+        const size_t numNodes = m_NumNodes;
+
+        // Right operand is only evaluated if left doesn't determine result
+        m_ConditionalDepth++;
+        const auto right = number(logical.getRight());
+        m_ConditionalDepth--;
+        setKey(numNodes + m_NumNodes + 1,
+               (left && right) ? std::make_optional("(" + *left + std::string{logical.getOperator().lexeme} + *right + ")") : std::nullopt);
+    }
+
+    virtual void visit(const Expression::PostfixIncDec&) final
+    {
+        setKey(1, std::nullopt);
+    }
+
+    virtual void visit(const Expression::PrefixIncDec&) final
+    {
+        setKey(1, std::nullopt);
+    }
+
+    virtual void visit(const Expression::Variable &variable) final
+    {
+        const auto name = variable.getName().lexeme;
+        if(m_Written->find(name) != m_Written->cend()) {
+            setKey(1, std::nullopt);
+        }
+        else {
+            const auto version = m_Versions.find(name);
+            setKey(1, std::string{name} + "@" + std::to_string((version == m_Versions.cend()) ? 0 : version->second));
+        }
+    }
+
+    virtual void visit(const Expression::Unary &unary) final
+    {
+        // Dereferenced memory may be written through other pointers
+        const auto right = number(unary.getRight());
+        const auto opType = unary.getOperator().type;
+        setKey(m_NumNodes + 1, (right && opType != Token::Type::STAR && opType != Token::Type::AMPERSAND)
+               ? std::make_optional(std::string{unary.getOperator().lexeme} + *right) : std::nullopt);
+    }
+
+private:
+    //---------------------------------------------------------------------------
+    // Private methods
+    //---------------------------------------------------------------------------
+    //! Get key of expression, recording it as an occurrence if it is a non-trivial numeric expression
+    std::optional<std::string> number(const Expression::Base *expression)
+    {
+        const size_t firstDescendant = m_Occurrences.size();
+        expression->accept(*this);
+
+        // **NOTE** groupings are recorded via the expression they contain
+        if(m_Key && Type::dynamicCast<Type::NumericBase>(getType(expression))
+           && !dynamic_cast<const Expression::Literal*>(expression) && !dynamic_cast<const Expression::Variable*>(expression)
+           && !dynamic_cast<const Expression::Grouping*>(expression))
+        {
+            m_Occurrences.push_back({expression, *m_Key, m_Statement, m_NumNodes, firstDescendant, m_ConditionalDepth > 0});
+        }
+        return std::move(m_Key);
+    }
+
+    void setKey(size_t numNodes, std::optional<std::string> key)
+    {
+        m_NumNodes = numNodes;
+        m_Key = std::move(key);
+    }
+
+    const Type::Base *getType(const Expression::Base *expression) const
+    {
+        const auto type = m_ResolvedTypes.find(expression);
+        return (type == m_ResolvedTypes.cend()) ? nullptr : type->second;
+    }
+
+    //---------------------------------------------------------------------------
+    // Members
+    //---------------------------------------------------------------------------
+    const TypeChecker::ResolvedTypeMap &m_ResolvedTypes;
+    const std::unordered_set<std::string_view> *m_Written;
+    size_t m_Statement;
+    size_t m_ConditionalDepth;
+    std::unordered_map<std::string_view, size_t> m_Versions;
+    std::vector<Occurrence> m_Occurrences;
+
+    //! Key and number of nodes of most recently visited expression
+    std::optional<std::string> m_Key;
+    size_t m_NumNodes;
+};
+
+//---------------------------------------------------------------------------
+// InvariantFinder
+//---------------------------------------------------------------------------
+//! Visitor which finds the largest subexpressions evaluated by a loop whose values don't change between iterations
+class InvariantFinder : public Expression::Visitor, public Statement::Visitor
+{
+public:
+    //! Loop-invariant subexpression and the number of scopes between it and the statement list containing the loop
+    struct Invariant
+    {
+        const Expression::Base *expression;
+        size_t depth;
+    };
+
+    InvariantFinder(const TypeChecker::Resolution &resolution, const TypeChecker::Environment &environment,
+                    ErrorHandler &errorHandler, const std::unordered_set<const Expression::Base*> &hoisted)
+    :   m_Resolution(resolution), m_Environment(environment), m_ErrorHandler(errorHandler), m_Hoisted(hoisted),
+        m_ImpureCalls(false), m_Depth(0), m_GuardDepth(0), m_Exited(false), m_Invariant(false), m_ReadsVariables(false)
+    {
+    }
+
+    //---------------------------------------------------------------------------
+    // Public API
+    //---------------------------------------------------------------------------
+    std::vector<Invariant> find(const Statement::Base *loop)
+    {
+        // Find variables written within loop
+        WriteVisitor writeVisitor(&m_Resolution.types);
+        writeVisitor.add(loop);
+        m_Written = writeVisitor.getNames();
+        m_ImpureCalls = writeVisitor.hasImpureCalls();
+        m_Invariants.clear();
+        m_GuardDepth = 0;
+        m_Exited = false;
+
+        // **NOTE** initialiser of for statement is only evaluated once so isn't searched
+        if(const auto *forStatement = dynamic_cast<const Statement::For*>(loop)) {
+            m_Depth = 1;
+            addRoot(forStatement->getCondition());
+            m_GuardDepth++;
+            addRoot(forStatement->getIncrement());
+            forStatement->getBody()->accept(*this);
+            m_GuardDepth--;
+        }
+        else {
+            m_Depth = 0;
+            loop->accept(*this);
+        }
+        return m_Invariants;
+    }
+
+    //---------------------------------------------------------------------------
+    // Expression::Visitor virtuals
+    //---------------------------------------------------------------------------
+    virtual void visit(const Expression::ArraySubscript &arraySubscript) final
+    {
+        // **NOTE** elements can't be written by statements but are only assumed not to be written 
+        // elsewhere during the loop if pointer is const in the environment and no functions with side effects are called.
+        // Like integer division, reads are only hoisted if they are certain to be evaluated as index may be out of bounds
+        const auto &name = arraySubscript.getPointerName();
+        const bool hoistable = (!m_ImpureCalls && m_GuardDepth == 0 && !m_Exited
+                                && m_Written.find(name.lexeme) == m_Written.cend()
+                                && std::get<1>(m_Environment.getType(name, m_ErrorHandler)));
+        visitChildren({arraySubscript.getIndex().get()}, hoistable);
+        m_ReadsVariables = true;
+    }
+
+    virtual void visit(const Expression::Assignment &assignment) final
+    {
+        visitChildren({assignment.getValue()}, false);
+    }
+
+    virtual void visit(const Expression::Binary &binary) final
+    {
+        // Integer division is only hoisted if it can't trap as it may not have been evaluated
+        const auto opType = binary.getOperator().type;
+        const auto *resultType = Type::dynamicCast<Type::NumericBase>(getType(&binary));
+        bool hoistable = true;
+        if((opType == Token::Type::SLASH || opType == Token::Type::PERCENT) && resultType && resultType->isIntegral()) {
+            const auto *divisor = dynamic_cast<const Expression::Literal*>(skipGroupings(binary.getRight()));
+            hoistable = (divisor && getValue<int64_t>(divisor->getValue()) > 0);
+        }
+        visitChildren({binary.getLeft(), binary.getRight()}, hoistable);
+    }
+
+    virtual void visit(const Expression::Call &call) final
+    {
+        std::vector<const Expression::Base*> children{call.getCallee()};
+        for(const auto &a : call.getArguments()) {
+            children.push_back(a.get());
+        }
+        visitChildren(children, isPureFunction(getType(call.getCallee())));
+    }
+
+    virtual void visit(const Expression::Cast &cast) final
+    {
+        visitChildren({cast.getExpression()}, true);
+    }
+
+    virtual void visit(const Expression::Conditional &conditional) final
+    {
+        visitChildren({conditional.getCondition(), conditional.getTrue(), conditional.getFalse()}, true, 1);
+    }
+
+    virtual void visit(const Expression::Grouping &grouping) final
+    {
+        grouping.getExpression()->accept(*this);
+    }
+
+    virtual void visit(const Expression::Literal&) final
+    {
+        m_Invariant = true;
+        m_ReadsVariables = false;
+    }
+
+    virtual void visit(const Expression::Logical &logical) final
+    {
+        // Right operand is only evaluated if left doesn't determine result
+        visitChildren({logical.getLeft(), logical.getRight()}, true, 1);
+    }
+
+    virtual void visit(const Expression::PostfixIncDec&) final
+    {
+        m_Invariant = false;
+        m_ReadsVariables = true;
+    }
+
+    virtual void visit(const Expression::PrefixIncDec&) final
+    {
+        m_Invariant = false;
+        m_ReadsVariables = true;
+    }
+
+    virtual void visit(const Expression::Variable &variable) final
+    {
+        // Const globals never change. Other variables don't change if they aren't written within loop
+        // and, for globals, no functions with side effects are called which could write them
+        const auto &name = variable.getName();
+        const auto slot = m_Resolution.getSlot(&variable);
+        if(slot && slot->global) {
+            m_Invariant = (std::get<1>(m_Environment.getType(name, m_ErrorHandler))
+                           || (!m_ImpureCalls && m_Written.find(name.lexeme) == m_Written.cend()));
+        }
+        else {
+            m_Invariant = (m_Written.find(name.lexeme) == m_Written.cend());
+        }
+        m_ReadsVariables = true;
+    }
+
+    virtual void visit(const Expression::Unary &unary) final
+    {
+        const auto opType = unary.getOperator().type;
+        visitChildren({unary.getRight()}, opType != Token::Type::STAR && opType != Token::Type::AMPERSAND);
+    }
+
+    //---------------------------------------------------------------------------
+    // Statement::Visitor virtuals
+    //---------------------------------------------------------------------------
+    virtual void visit(const Statement::Break&) final
+    {
+        m_Exited = true;
+    }
+
+    virtual void visit(const Statement::Compound &compound) final
+    {
+        m_Depth++;
+        for(const auto &s : compound.getStatements()) {
+            s->accept(*this);
+        }
+        m_Depth--;
+    }
+
+    virtual void visit(const Statement::Continue&) final
+    {
+        m_Exited = true;
+    }
+
+    virtual void visit(const Statement::Do &doStatement) final
+    {
+        doStatement.getBody()->accept(*this);
+        addRoot(doStatement.getCondition());
+    }
+
+    virtual void visit(const Statement::Expression &expression) final
+    {
+        addRoot(expression.getExpression());
+    }
+
+    virtual void visit(const Statement::For &forStatement) final
+    {
+        m_Depth++;
+        if(forStatement.getInitialiser()) {
+            forStatement.getInitialiser()->accept(*this);
+        }
+        addRoot(forStatement.getCondition());
+
+        // Increment and body may not be evaluated
+        m_GuardDepth++;
+        addRoot(forStatement.getIncrement());
+        forStatement.getBody()->accept(*this);
+        m_GuardDepth--;
+        m_Depth--;
+    }
+
+    virtual void visit(const Statement::If &ifStatement) final
+    {
+        addRoot(ifStatement.getCondition());
+        m_GuardDepth++;
+        ifStatement.getThenBranch()->accept(*this);
+        if(ifStatement.getElseBranch()) {
+            ifStatement.getElseBranch()->accept(*this);
+        }
+        m_GuardDepth--;
+    }
+
+    virtual void visit(const Statement::Labelled &labelled) final
+    {
+        // **NOTE** case values must remain constant expressions
+        labelled.getBody()->accept(*this);
+    }
+
+    virtual void visit(const Statement::Switch &switchStatement) final
+    {
+        addRoot(switchStatement.getCondition());
+        m_GuardDepth++;
+        switchStatement.getBody()->accept(*this);
+        m_GuardDepth--;
+    }
+
+    virtual void visit(const Statement::VarDeclaration &varDeclaration) final
+    {
+        for(const auto &var : varDeclaration.getInitDeclaratorList()) {
+            addRoot(std::get<1>(var).get());
+        }
+    }
+
+    virtual void visit(const Statement::While &whileStatement) final
+    {
+        addRoot(whileStatement.getCondition());
+        m_GuardDepth++;
+        whileStatement.getBody()->accept(*this);
+        m_GuardDepth--;
+    }
+
+    virtual void visit(const Statement::Print &print) final
+    {
+        addRoot(print.getExpression());
+    }
+
+private:
+    //---------------------------------------------------------------------------
+    // Private methods
+    //---------------------------------------------------------------------------
+    //! Visit children of expression which is invariant if it's hoistable and all of its children are invariant.
+    //! If it isn't invariant, its invariant children are the largest invariant subexpressions.
+    //! Children from firstGuarded onwards may not be evaluated e.g. the arms of a conditional
+    void visitChildren(const std::vector<const Expression::Base*> &children, bool hoistable,
+                       size_t firstGuarded = std::numeric_limits<size_t>::max())
+    {
+        std::vector<std::pair<const Expression::Base*, bool>> invariantChildren;
+        bool invariant = hoistable;
+        bool readsVariables = false;
+        for(size_t i = 0; i < children.size(); i++) {
+            const auto *c = children[i];
+            if(i == firstGuarded) {
+                m_GuardDepth++;
+            }
+            c->accept(*this);
+            if(m_Invariant) {
+                invariantChildren.emplace_back(c, m_ReadsVariables);
+            }
+            else {
+                invariant = false;
+            }
+            readsVariables |= m_ReadsVariables;
+        }
+        if(firstGuarded < children.size()) {
+            m_GuardDepth--;
+        }
+
+        if(!invariant) {
+            for(const auto &c : invariantChildren) {
+                addInvariant(c.first, c.second);
+            }
+        }
+        m_Invariant = invariant;
+        m_ReadsVariables = readsVariables;
+    }
+
+    void addRoot(const Expression::Base *expression)
+    {
+        if(expression) {
+            expression->accept(*this);
+            if(m_Invariant) {
+                addInvariant(expression, m_ReadsVariables);
+            }
+        }
+    }
+
+    void addInvariant(const Expression::Base *expression, bool readsVariables)
+    {
+        // **NOTE** subexpressions which only involve literals are left for constant folding
+        expression = skipGroupings(expression);
+        if(readsVariables && m_Hoisted.find(expression) == m_Hoisted.cend()
+           && Type::dynamicCast<Type::NumericBase>(getType(expression))
+           && !dynamic_cast<const Expression::Literal*>(expression) && !dynamic_cast<const Expression::Variable*>(expression))
+        {
+            m_Invariants.push_back({expression, m_Depth});
+        }
+    }
+
+    const Type::Base *getType(const Expression::Base *expression) const
+    {
+        const auto type = m_Resolution.types.find(expression);
+        return (type == m_Resolution.types.cend()) ? nullptr : type->second;
+    }
+
+    //---------------------------------------------------------------------------
+    // Members
+    //---------------------------------------------------------------------------
+    const TypeChecker::Resolution &m_Resolution;
+    const TypeChecker::Environment &m_Environment;
+    ErrorHandler &m_ErrorHandler;
+
+    //! Expressions already hoisted out of enclosing loops
+    const std::unordered_set<const Expression::Base*> &m_Hoisted;
+
+    std::unordered_set<std::string_view> m_Written;
+    bool m_ImpureCalls;
+    size_t m_Depth;
+    std::vector<Invariant> m_Invariants;
+
+    //! Number of enclosing branches and loop bodies which may not be evaluated each time loop is entered
+    //! and has a break or continue been visited, after which subsequent statements may not be evaluated
+    size_t m_GuardDepth;
+    bool m_Exited;
+
+    //! Is most recently visited expression invariant and does it read any variables
+    bool m_Invariant;
+    bool m_ReadsVariables;
+};
+
+//---------------------------------------------------------------------------
+// Rewriter
+//---------------------------------------------------------------------------
+//! Visitor which builds a copy of statements, preserving the resolved types and slots of each node.
+//! Passes derive from this and override visits of the nodes they transform
+class Rewriter : public Expression::Visitor, public Statement::Visitor
+{
+public:
+    Rewriter(TypeChecker::Resolution &resolution)
+    :   m_Resolution(resolution)
+    {
+    }
+
+    //---------------------------------------------------------------------------
+    // Public API
+    //---------------------------------------------------------------------------
+    Statement::StatementList rewriteProgram(const Statement::StatementList &statements)
+    {
+        // **NOTE** backends allocate slots for top-level variables by counting declarations
+        size_t numSlots = getNumDeclared(statements);
+        return rewrite(statements, numSlots);
+    }
+
+    //---------------------------------------------------------------------------
+    // Expression::Visitor virtuals
+    //---------------------------------------------------------------------------
+    virtual void visit(const Expression::ArraySubscript &arraySubscript) override
+    {
+        setResult(std::make_unique<Expression::ArraySubscript>(arraySubscript.getPointerName(),
+                                                               rewrite(arraySubscript.getIndex().get())),
+                  &arraySubscript);
+    }
+
+    virtual void visit(const Expression::Assignment &assignment) override
+    {
+        auto rewrittenAssignment = std::make_unique<Expression::Assignment>(assignment.getVarName(), assignment.getOperator(),
+                                                                            rewrite(assignment.getValue()));
+        copySlot(*rewrittenAssignment, assignment);
+        setResult(std::move(rewrittenAssignment), &assignment);
+    }
+
+    virtual void visit(const Expression::Binary &binary) override
+    {
+        setResult(std::make_unique<Expression::Binary>(rewrite(binary.getLeft()), binary.getOperator(), rewrite(binary.getRight())),
+                  &binary);
+    }
+
+    virtual void visit(const Expression::Call &call) override
+    {
+        Expression::ExpressionList arguments;
+        arguments.reserve(call.getArguments().size());
+        for(const auto &a : call.getArguments()) {
+            arguments.push_back(rewrite(a.get()));
+        }
+        setResult(std::make_unique<Expression::Call>(rewrite(call.getCallee()), call.getClosingParen(), std::move(arguments)),
+                  &call);
+    }
+
+    virtual void visit(const Expression::Cast &cast) override
+    {
+        setResult(std::make_unique<Expression::Cast>(cast.getType(), cast.isConst(), rewrite(cast.getExpression())), &cast);
+    }
+
+    virtual void visit(const Expression::Conditional &conditional) override
+    {
+        setResult(std::make_unique<Expression::Conditional>(rewrite(conditional.getCondition()), conditional.getQuestion(),
+                                                            rewrite(conditional.getTrue()), rewrite(conditional.getFalse())),
+                  &conditional);
+    }
+
+    virtual void visit(const Expression::Grouping &grouping) override
+    {
+        setResult(std::make_unique<Expression::Grouping>(rewrite(grouping.getExpression())), &grouping);
+    }
+
+    virtual void visit(const Expression::Literal &literal) override
+    {
+        setResult(std::make_unique<Expression::Literal>(literal.getValue()), &literal);
+    }
+
+    virtual void visit(const Expression::Logical &logical) override
+    {
+        setResult(std::make_unique<Expression::Logical>(rewrite(logical.getLeft()), logical.getOperator(), rewrite(logical.getRight())),
+                  &logical);
+    }
+
+    virtual void visit(const Expression::PostfixIncDec &postfixIncDec) override
+    {
+        auto rewrittenPostfixIncDec = std::make_unique<Expression::PostfixIncDec>(postfixIncDec.getVarName(),
+                                                                                  postfixIncDec.getOperator());
+        copySlot(*rewrittenPostfixIncDec, postfixIncDec);
+        setResult(std::move(rewrittenPostfixIncDec), &postfixIncDec);
+    }
+
+    virtual void visit(const Expression::PrefixIncDec &prefixIncDec) override
+    {
+        auto rewrittenPrefixIncDec = std::make_unique<Expression::PrefixIncDec>(prefixIncDec.getVarName(),
+                                                                                prefixIncDec.getOperator());
+        copySlot(*rewrittenPrefixIncDec, prefixIncDec);
+        setResult(std::move(rewrittenPrefixIncDec), &prefixIncDec);
+    }
+
+    virtual void visit(const Expression::Variable &variable) override
+    {
+        auto rewrittenVariable = std::make_unique<Expression::Variable>(variable.getName());
+        copySlot(*rewrittenVariable, variable);
+        setResult(std::move(rewrittenVariable), &variable);
+    }
+
+    virtual void visit(const Expression::Unary &unary) override
+    {
+        setResult(std::make_unique<Expression::Unary>(unary.getOperator(), rewrite(unary.getRight())), &unary);
+    }
+
+    //---------------------------------------------------------------------------
+    // Statement::Visitor virtuals
+    //---------------------------------------------------------------------------
+    virtual void visit(const Statement::Break &breakStatement) override
+    {
+        m_Statement = std::make_unique<Statement::Break>(breakStatement.getToken());
+    }
+
+    virtual void visit(const Statement::Compound &compound) override
+    {
+        size_t numSlots = m_Resolution.getNumSlots(&compound);
+        auto rewrittenStatements = rewrite(compound.getStatements(), numSlots);
+        auto rewrittenCompound = std::make_unique<Statement::Compound>(std::move(rewrittenStatements));
+        m_Resolution.statementSlots[rewrittenCompound.get()] = numSlots;
+        m_Statement = std::move(rewrittenCompound);
+    }
+
+    virtual void visit(const Statement::Continue &continueStatement) override
+    {
+        m_Statement = std::make_unique<Statement::Continue>(continueStatement.getToken());
+    }
+
+    virtual void visit(const Statement::Do &doStatement) override
+    {
+        auto body = rewrite(doStatement.getBody());
+        m_Statement = std::make_unique<Statement::Do>(rewrite(doStatement.getCondition()), std::move(body));
+    }
+
+    virtual void visit(const Statement::Expression &expression) override
+    {
+        m_Statement = std::make_unique<Statement::Expression>(rewrite(expression.getExpression()));
+    }
+
+    virtual void visit(const Statement::For &forStatement) override
+    {
+        auto initialiser = rewrite(forStatement.getInitialiser());
+        auto condition = rewrite(forStatement.getCondition());
+        auto increment = rewrite(forStatement.getIncrement());
+        auto rewrittenFor = std::make_unique<Statement::For>(std::move(initialiser), std::move(condition), std::move(increment),
+                                                             rewrite(forStatement.getBody()));
+        m_Resolution.statementSlots[rewrittenFor.get()] = m_Resolution.getNumSlots(&forStatement);
+        m_Statement = std::move(rewrittenFor);
+    }
+
+    virtual void visit(const Statement::If &ifStatement) override
+    {
+        auto condition = rewrite(ifStatement.getCondition());
+        auto thenBranch = rewrite(ifStatement.getThenBranch());
+        m_Statement = std::make_unique<Statement::If>(std::move(condition), std::move(thenBranch),
+                                                      rewrite(ifStatement.getElseBranch()));
+    }
+
+    virtual void visit(const Statement::Labelled &labelled) override
+    {
+        auto value = rewrite(labelled.getValue());
+        m_Statement = std::make_unique<Statement::Labelled>(labelled.getKeyword(), std::move(value), rewrite(labelled.getBody()));
+    }
+
+    virtual void visit(const Statement::Switch &switchStatement) override
+    {
+        auto condition = rewrite(switchStatement.getCondition());
+        auto rewrittenSwitch = std::make_unique<Statement::Switch>(switchStatement.getSwitch(), std::move(condition),
+                                                                   rewrite(switchStatement.getBody()));
+
+        // **NOTE** labels are copied in order and statements are never inserted into switch bodies so case table remains valid
+        m_Resolution.switchTables.insert_or_assign(rewrittenSwitch.get(), m_Resolution.getSwitchTable(&switchStatement));
+        m_Statement = std::move(rewrittenSwitch);
+    }
+
+    virtual void visit(const Statement::VarDeclaration &varDeclaration) override
+    {
+        Statement::VarDeclaration::InitDeclaratorList initDeclaratorList;
+        initDeclaratorList.reserve(varDeclaration.getInitDeclaratorList().size());
+        for(const auto &var : varDeclaration.getInitDeclaratorList()) {
+            initDeclaratorList.emplace_back(std::get<0>(var), rewrite(std::get<1>(var).get()));
+        }
+        auto rewrittenVarDeclaration = std::make_unique<Statement::VarDeclaration>(varDeclaration.getType(), varDeclaration.isConst(),
+                                                                                   std::move(initDeclaratorList));
+        m_Resolution.statementSlots[rewrittenVarDeclaration.get()] = m_Resolution.getFirstSlot(&varDeclaration);
+        m_Statement = std::move(rewrittenVarDeclaration);
+    }
+
+    virtual void visit(const Statement::While &whileStatement) override
+    {
+        auto condition = rewrite(whileStatement.getCondition());
+        m_Statement = std::make_unique<Statement::While>(std::move(condition), rewrite(whileStatement.getBody()));
+    }
+
+    virtual void visit(const Statement::Print &print) override
+    {
+        m_Statement = std::make_unique<Statement::Print>(rewrite(print.getExpression()));
+    }
+
+protected:
+    //---------------------------------------------------------------------------
+    // Declared virtuals
+    //---------------------------------------------------------------------------
+    virtual Expression::ExpressionPtr rewrite(const Expression::Base *expression)
+    {
+        if(expression) {
+            expression->accept(*this);
+            return std::move(m_Result);
+        }
+        else {
+            return nullptr;
+        }
+    }
+
+    //! Rewrite list of statements in a scope with numSlots slots, updating numSlots if variables are added
+    virtual Statement::StatementList rewrite(const Statement::StatementList &statements, size_t&)
+    {
+        Statement::StatementList rewrittenStatements;
+        rewrittenStatements.reserve(statements.size());
+        for(const auto &s : statements) {
+            rewrittenStatements.push_back(rewrite(s.get()));
+        }
+        return rewrittenStatements;
+    }
+
+    //---------------------------------------------------------------------------
+    // Protected methods
+    //---------------------------------------------------------------------------
+    Statement::StatementPtr rewrite(const Statement::Base *statement)
+    {
+        if(statement) {
+            statement->accept(*this);
+            return std::move(m_Statement);
+        }
+        else {
+            return nullptr;
+        }
+    }
+
+    const Type::Base *getType(const Expression::Base *expression) const
+    {
+        const auto type = m_Resolution.types.find(expression);
+        return (type == m_Resolution.types.cend()) ? nullptr : type->second;
+    }
+
+    const TypeChecker::Resolution &getResolution() const{ return m_Resolution; }
+
+    //! Set result to new expression with same type as original
+    //! **NOTE** resolution is keyed by address so entries left by freed nodes at the same address are replaced or removed
+    void setResult(Expression::ExpressionPtr expression, const Expression::Base *original)
+    {
+        if(const auto *type = getType(original)) {
+            m_Resolution.types[expression.get()] = type;
+        }
+        else {
+            m_Resolution.types.erase(expression.get());
+        }
+        m_Result = std::move(expression);
+    }
+
+    void setResult(Expression::ExpressionPtr expression)
+    {
+        m_Result = std::move(expression);
+    }
+
+    void setSlot(const Expression::Base &expression, Expression::VariableSlot slot)
+    {
+        m_Resolution.slots[&expression] = slot;
+    }
+
+    void copySlot(const Expression::Base &expression, const Expression::Base &original)
+    {
+        if(const auto slot = m_Resolution.getSlot(&original)) {
+            setSlot(expression, *slot);
+        }
+        else {
+            m_Resolution.slots.erase(&expression);
+        }
+    }
+
+    //! Create declaration of const local variable initialised with expression
+    Statement::StatementPtr createTemporary(std::string_view name, size_t slot, Expression::ExpressionPtr initialiser,
+                                            const Type::Base *type)
+    {
+        const Token token(Token::Type::IDENTIFIER, name, 0);
+        Statement::VarDeclaration::InitDeclaratorList initDeclaratorList;
+        initDeclaratorList.emplace_back(token, std::move(initialiser));
+        auto varDeclaration = std::make_unique<Statement::VarDeclaration>(type, true, std::move(initDeclaratorList));
+        m_Resolution.statementSlots[varDeclaration.get()] = slot;
+        return varDeclaration;
+    }
+
+    //! Create reference to temporary from scope depth scopes inside the one it was declared in
+    Expression::ExpressionPtr createTemporaryReference(std::string_view name, size_t slot, size_t depth, const Type::Base *type)
+    {
+        auto variable = std::make_unique<Expression::Variable>(Token(Token::Type::IDENTIFIER, name, 0));
+        m_Resolution.slots[variable.get()] = Expression::VariableSlot{false, depth, slot};
+        m_Resolution.types[variable.get()] = type;
+        return variable;
+    }
+
+private:
+    //---------------------------------------------------------------------------
+    // Members
+    //---------------------------------------------------------------------------
+    TypeChecker::Resolution &m_Resolution;
+    Expression::ExpressionPtr m_Result;
+    Statement::StatementPtr m_Statement;
+};
+
+//---------------------------------------------------------------------------
+// Folder
+//---------------------------------------------------------------------------
+//! Rewriter which folds constant expressions and removes identities
+class Folder : public Rewriter
+{
+public:
+    Folder(TypeChecker::Resolution &resolution, const ConstantValues &constantValues)
+    :   Rewriter(resolution), m_ConstantValues(constantValues)
+    {
+    }
+
+    using Rewriter::visit;
+
+    //---------------------------------------------------------------------------
+    // Expression::Visitor virtuals
+    //---------------------------------------------------------------------------
+    virtual void visit(const Expression::Assignment &assignment) final
+    {
+        checkNotConstant(assignment.getVarName(), getResolution().getSlot(&assignment));
+        Rewriter::visit(assignment);
+    }
+
+    virtual void visit(const Expression::Binary &binary) final
+    {
+        auto left = rewrite(binary.getLeft());
+        auto right = rewrite(binary.getRight());
+        const auto opType = binary.getOperator().type;
+        const auto *leftLiteral = dynamic_cast<const Expression::Literal*>(left.get());
+        const auto *rightLiteral = dynamic_cast<const Expression::Literal*>(right.get());
+
+        // If left operand of comma is literal, it has no side effects so result is just right operand
+        if(opType == Token::Type::COMMA) {
+            if(leftLiteral) {
+                setResult(std::move(right));
+            }
+            else {
+                setResult(std::make_unique<Expression::Binary>(std::move(left), binary.getOperator(), std::move(right)), &binary);
+            }
+            return;
+        }
+
+        const auto *leftType = Type::dynamicCast<Type::NumericBase>(getType(left.get()));
+        const auto *rightType = Type::dynamicCast<Type::NumericBase>(getType(right.get()));
+        const auto *resultType = Type::dynamicCast<Type::NumericBase>(getType(&binary));
+        if(leftType && rightType && resultType) {
+            // If both operands are literals, fold
+            if(leftLiteral && rightLiteral) {
+                if(auto value = foldBinary(opType, leftLiteral->getValue(), leftType,
+                                           rightLiteral->getValue(), rightType, resultType))
+                {
+                    setResult(std::make_unique<Expression::Literal>(*value), &binary);
+                    return;
+                }
+            }
+            // Otherwise, if operation is an identity which doesn't change the type of the other operand, remove it
+            else {
+                const bool integral = resultType->isIntegral();
+                const bool leftIdentity = (leftType == resultType)
+                    && (((opType == Token::Type::STAR || opType == Token::Type::SLASH) && isLiteral(right.get(), 1.0))
+                        || ((opType == Token::Type::MINUS || (integral && opType == Token::Type::PLUS)) && isLiteral(right.get(), 0.0))
+                        || (integral && (opType == Token::Type::PIPE || opType == Token::Type::CARET || opType == Token::Type::SHIFT_LEFT
+                                         || opType == Token::Type::SHIFT_RIGHT) && isLiteral(right.get(), 0.0)));
+                const bool rightIdentity = (rightType == resultType)
+                    && ((opType == Token::Type::STAR && isLiteral(left.get(), 1.0))
+                        || (integral && (opType == Token::Type::PLUS || opType == Token::Type::PIPE || opType == Token::Type::CARET)
+                            && isLiteral(left.get(), 0.0)));
+                if(leftIdentity) {
+                    setResult(std::move(left));
+                    return;
+                }
+                else if(rightIdentity) {
+                    setResult(std::move(right));
+                    return;
+                }
+            }
+        }
+        setResult(std::make_unique<Expression::Binary>(std::move(left), binary.getOperator(), std::move(right)), &binary);
+    }
+
+    virtual void visit(const Expression::Cast &cast) final
+    {
+        auto expression = rewrite(cast.getExpression());
+        const auto *literal = dynamic_cast<const Expression::Literal*>(expression.get());
+        const auto *castType = Type::dynamicCast<Type::NumericBase>(cast.getType());
+        if(literal && castType) {
+            setResult(std::make_unique<Expression::Literal>(convertLiteral(literal->getValue(), castType)), &cast);
+        }
+        else {
+            setResult(std::make_unique<Expression::Cast>(cast.getType(), cast.isConst(), std::move(expression)), &cast);
+        }
+    }
+
+    virtual void visit(const Expression::Conditional &conditional) final
+    {
+        auto condition = rewrite(conditional.getCondition());
+        auto trueExpression = rewrite(conditional.getTrue());
+        auto falseExpression = rewrite(conditional.getFalse());
+
+        // If condition is literal, select branch
+        if(const auto *conditionLiteral = dynamic_cast<const Expression::Literal*>(condition.get())) {
+            auto &selected = getValue<bool>(conditionLiteral->getValue()) ? trueExpression : falseExpression;
+
+            // If selected branch is a literal, convert to result type
+            const auto *resultType = getType(&conditional);
+            if(const auto *selectedLiteral = dynamic_cast<const Expression::Literal*>(selected.get())) {
+                setResult(std::make_unique<Expression::Literal>(
+                            convertLiteral(selectedLiteral->getValue(), Type::dynamicCast<Type::NumericBase>(resultType))),
+                          &conditional);
+                return;
+            }
+            // Otherwise, if it already has result type, use it directly
+            else if(getType(selected.get()) == resultType) {
+                setResult(std::move(selected));
+                return;
+            }
+        }
+        setResult(std::make_unique<Expression::Conditional>(std::move(condition), conditional.getQuestion(),
+                                                            std::move(trueExpression), std::move(falseExpression)),
+                  &conditional);
+    }
+
+    virtual void visit(const Expression::Grouping &grouping) final
+    {
+        // Parentheses around literals are no longer required
+        auto expression = rewrite(grouping.getExpression());
+        if(dynamic_cast<const Expression::Literal*>(expression.get())) {
+            setResult(std::move(expression));
+        }
+        else {
+            setResult(std::make_unique<Expression::Grouping>(std::move(expression)), &grouping);
+        }
+    }
+
+    virtual void visit(const Expression::Logical &logical) final
+    {
+        auto left = rewrite(logical.getLeft());
+        auto right = rewrite(logical.getRight());
+        const bool orOperator = (logical.getOperator().type == Token::Type::PIPE_PIPE);
+
+        // If left operand is literal
+        if(const auto *leftLiteral = dynamic_cast<const Expression::Literal*>(left.get())) {
+            // If it determines the result, right operand is never evaluated
+            const bool leftValue = getValue<bool>(leftLiteral->getValue());
+            if(leftValue == orOperator) {
+                setResult(std::make_unique<Expression::Literal>(int32_t{orOperator}), &logical);
+                return;
+            }
+            // Otherwise, if right operand is also literal, result is its truth value
+            else if(const auto *rightLiteral = dynamic_cast<const Expression::Literal*>(right.get())) {
+                setResult(std::make_unique<Expression::Literal>(int32_t{getValue<bool>(rightLiteral->getValue())}), &logical);
+                return;
+            }
+        }
+        setResult(std::make_unique<Expression::Logical>(std::move(left), logical.getOperator(), std::move(right)), &logical);
+    }
+
+    virtual void visit(const Expression::PostfixIncDec &postfixIncDec) final
+    {
+        checkNotConstant(postfixIncDec.getVarName(), getResolution().getSlot(&postfixIncDec));
+        Rewriter::visit(postfixIncDec);
+    }
+
+    virtual void visit(const Expression::PrefixIncDec &prefixIncDec) final
+    {
+        checkNotConstant(prefixIncDec.getVarName(), getResolution().getSlot(&prefixIncDec));
+        Rewriter::visit(prefixIncDec);
+    }
+
+    virtual void visit(const Expression::Variable &variable) final
+    {
+        // If variable is a global with a known value, replace with literal
+        const auto constant = m_ConstantValues.find(std::string{variable.getName().lexeme});
+        const auto *type = Type::dynamicCast<Type::NumericBase>(getType(&variable));
+        const auto slot = getResolution().getSlot(&variable);
+        if(type && slot && slot->global && constant != m_ConstantValues.cend()) {
+            setResult(std::make_unique<Expression::Literal>(convertLiteral(constant->second, type)), &variable);
+        }
+        else {
+            Rewriter::visit(variable);
+        }
+    }
+
+    virtual void visit(const Expression::Unary &unary) final
+    {
+        const auto opType = unary.getOperator().type;
+        const auto *resultType = Type::dynamicCast<Type::NumericBase>(getType(&unary));
+        if(resultType && (opType == Token::Type::MINUS || opType == Token::Type::TILDA)) {
+            // If operator is applied twice to an expression which already has result type, remove both
+            const auto *inner = dynamic_cast<const Expression::Unary*>(skipGroupings(unary.getRight()));
+            if(inner && inner->getOperator().type == opType && getType(inner->getRight()) == resultType) {
+                setResult(rewrite(inner->getRight()));
+                return;
+            }
+        }
+
+        auto right = rewrite(unary.getRight());
+        if(resultType) {
+            // If operand is a literal, fold
+            if(const auto *rightLiteral = dynamic_cast<const Expression::Literal*>(right.get())) {
+                if(auto value = foldUnary(opType, rightLiteral->getValue(), resultType)) {
+                    setResult(std::make_unique<Expression::Literal>(*value), &unary);
+                    return;
+                }
+            }
+            // Otherwise, if operator is unary plus which doesn't change operand type, remove it
+            else if(opType == Token::Type::PLUS && getType(right.get()) == resultType) {
+                setResult(std::move(right));
+                return;
+            }
+        }
+        setResult(std::make_unique<Expression::Unary>(unary.getOperator(), std::move(right)), &unary);
+    }
+
+private:
+    //---------------------------------------------------------------------------
+    // Private methods
+    //---------------------------------------------------------------------------
+    void checkNotConstant(const Token &name, const std::optional<Expression::VariableSlot> &slot) const
+    {
+        if(slot && slot->global && m_ConstantValues.find(std::string{name.lexeme}) != m_ConstantValues.cend()) {
+            throw std::runtime_error("Global '" + std::string{name.lexeme} + "' with constant value is modified at line "
+                                     + std::to_string(name.line));
+        }
+    }
+
+    Token::LiteralValue convertLiteral(const Token::LiteralValue &value, const Type::NumericBase *type) const
+    {
+        return std::visit(
+            Utils::Overload{
+                [type](auto v) { return makeLiteralValue(v, type); },
+                [](std::monostate)->Token::LiteralValue { throw std::runtime_error("Invalid literal"); }},
+            value);
+    }
+
+    std::optional<Token::LiteralValue> foldBinary(Token::Type opType, const Token::LiteralValue &left, const Type::NumericBase *leftType,
+                                                  const Token::LiteralValue &right, const Type::NumericBase *rightType,
+                                                  const Type::NumericBase *resultType) const
+    {
+        std::optional<Token::LiteralValue> result;
+
+        // Shifts are performed in promoted type of left operand and are only folded if shift is in range
+        if(opType == Token::Type::SHIFT_LEFT || opType == Token::Type::SHIFT_RIGHT) {
+            const auto shift = getValue<int64_t>(right);
+            if(shift >= 0 && shift < 32) {
+                visitNumericType(resultType,
+                                 [&result, opType, &left, shift](auto tag)
+                                 {
+                                     using T = decltype(tag);
+                                     if constexpr(std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+                                         using U = std::make_unsigned_t<T>;
+                                         const T l = getValue<T>(left);
+                                         result = (opType == Token::Type::SHIFT_LEFT) ? static_cast<T>(static_cast<U>(l) << shift) : static_cast<T>(l >> shift);
+                                     }
+                                 });
+            }
+        }
+        // Otherwise, operation is performed in common type
+        else {
+            visitNumericType(Type::getCommonType(leftType, rightType),
+                             [&result, opType, &left, &right](auto tag)
+                             {
+                                 using T = decltype(tag);
+                                 const T l = getValue<T>(left);
+                                 const T r = getValue<T>(right);
+                                 if(const auto comparison = foldComparison(opType, l, r)) {
+                                     result = *comparison;
+                                 }
+                                 else if constexpr(!std::is_same_v<T, bool>) {
+                                     if(const auto arithmetic = foldArithmetic(opType, l, r)) {
+                                         result = *arithmetic;
+                                     }
+                                 }
+                             });
+        }
+
+        // Convert result to type checker's result type
+        if(result) {
+            return convertLiteral(*result, resultType);
+        }
+        else {
+            return std::nullopt;
+        }
+    }
+
+    std::optional<Token::LiteralValue> foldUnary(Token::Type opType, const Token::LiteralValue &right,
+                                                 const Type::NumericBase *resultType) const
+    {
+        if(opType == Token::Type::NOT) {
+            return makeLiteralValue(!getValue<bool>(right), resultType);
+        }
+
+        // Arithmetic and bitwise operators are performed in promoted type
+        std::optional<Token::LiteralValue> result;
+        visitNumericType(resultType,
+                         [&result, opType, &right](auto tag)
+                         {
+                             using T = decltype(tag);
+                             const T r = getValue<T>(right);
+                             if(opType == Token::Type::PLUS) {
+                                 result = r;
+                             }
+                             else if constexpr(std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+                                 using U = std::make_unsigned_t<T>;
+                                 if(opType == Token::Type::MINUS) {
+                                     result = static_cast<T>(static_cast<U>(-static_cast<U>(r)));
+                                 }
+                                 else if(opType == Token::Type::TILDA) {
+                                     result = static_cast<T>(~r);
+                                 }
+                             }
+                             else if constexpr(std::is_floating_point_v<T>) {
+                                 if(opType == Token::Type::MINUS) {
+                                     result = -r;
+                                 }
+                             }
+                         });
+        return result;
+    }
+
+    //---------------------------------------------------------------------------
+    // Members
+    //---------------------------------------------------------------------------
+    const ConstantValues &m_ConstantValues;
+};
+
+//---------------------------------------------------------------------------
+// CommonSubexpressionEliminator
+//---------------------------------------------------------------------------
+//! Rewriter which replaces repeated side-effect free subexpressions within each basic block with
+//! const temporaries declared in the enclosing scope immediately before the first statement using them
+class CommonSubexpressionEliminator : public Rewriter
+{
+public:
+    CommonSubexpressionEliminator(TypeChecker::Resolution &resolution)
+    :   Rewriter(resolution), m_NumEliminated(0), m_NumTemporaries(0)
+    {
+    }
+
+    //---------------------------------------------------------------------------
+    // Public API
+    //---------------------------------------------------------------------------
+    size_t getNumEliminated() const{ return m_NumEliminated; }
+
+protected:
+    //---------------------------------------------------------------------------
+    // Rewriter virtuals
+    //---------------------------------------------------------------------------
+    virtual Expression::ExpressionPtr rewrite(const Expression::Base *expression) final
+    {
+        const auto replacement = m_Replacements.find(expression);
+        if(replacement == m_Replacements.cend()) {
+            return Rewriter::rewrite(expression);
+        }
+        else {
+            const auto &temporary = replacement->second;
+            return createTemporaryReference(temporary.name, temporary.slot, 0, temporary.type);
+        }
+    }
+
+    virtual Statement::StatementList rewrite(const Statement::StatementList &statements, size_t &numSlots) final
+    {
+        // **NOTE** declarations are not inserted into switch bodies as jumps to labels would bypass them
+        if(std::any_of(statements.cbegin(), statements.cend(), 
+                       [](const auto &s){ return dynamic_cast<const Statement::Labelled*>(s.get()) != nullptr; }))
+        {
+            return Rewriter::rewrite(statements, numSlots);
+        }
+
+        // Find temporaries required by each basic block
+        std::vector<Temporary> temporaries;
+        size_t blockStart = 0;
+        for(size_t i = 0; i < statements.size(); i++) {
+            const auto *statement = statements[i].get();
+            const auto *ifStatement = dynamic_cast<const Statement::If*>(statement);
+
+            // If statement ends block, eliminate subexpressions from block
+            if(!dynamic_cast<const Statement::Expression*>(statement) && !dynamic_cast<const Statement::VarDeclaration*>(statement)
+               && !dynamic_cast<const Statement::Print*>(statement))
+            {
+                // **NOTE** condition of if statement is evaluated unconditionally at the end of the block
+                eliminate(statements, blockStart, ifStatement ? (i + 1) : i, numSlots, temporaries);
+                blockStart = i + 1;
+            }
+        }
+        eliminate(statements, blockStart, statements.size(), numSlots, temporaries);
+
+        // Rewrite statements, inserting declarations of temporaries before the first statement using them
+        Statement::StatementList rewrittenStatements;
+        rewrittenStatements.reserve(statements.size() + temporaries.size());
+        auto temporary = temporaries.cbegin();
+        for(size_t i = 0; i < statements.size(); i++) {
+            for(; temporary != temporaries.cend() && temporary->statement == i; temporary++) {
+                // **NOTE** call base class directly so initialiser isn't itself replaced by temporary
+                rewrittenStatements.push_back(createTemporary(temporary->name, temporary->slot,
+                                                              Rewriter::rewrite(temporary->initialiser), temporary->type));
+            }
+            rewrittenStatements.push_back(Rewriter::rewrite(statements[i].get()));
+        }
+        numSlots += temporaries.size();
+        return rewrittenStatements;
+    }
+
+private:
+    //---------------------------------------------------------------------------
+    // Temporary
+    //---------------------------------------------------------------------------
+    struct Temporary
+    {
+        std::string_view name;
+        size_t slot;
+        const Type::Base *type;
+        const Expression::Base *initialiser;
+
+        //! Index of statement temporary must be declared before
+        size_t statement;
+    };
+
+    //---------------------------------------------------------------------------
+    // Private methods
+    //---------------------------------------------------------------------------
+    //! Select subexpressions to replace within block of statements between begin and end
+    void eliminate(const Statement::StatementList &statements, size_t begin, size_t end, 
+                   size_t numSlots, std::vector<Temporary> &temporaries)
+    {
+        // Number values of expressions evaluated by each statement
+        ValueNumberer numberer(getResolution().types);
+        for(size_t i = begin; i < end; i++) {
+            const auto *statement = statements[i].get();
+            const Expression::Base *expression = nullptr;
+            std::optional<std::string_view> target;
+            WriteVisitor writeVisitor;
+            if(const auto *expressionStatement = dynamic_cast<const Statement::Expression*>(statement)) {
+                // If expression is an assignment, target is only written after value is evaluated
+                expression = expressionStatement->getExpression();
+                if(const auto *assignment = dynamic_cast<const Expression::Assignment*>(expression)) {
+                    target = assignment->getVarName().lexeme;
+                    writeVisitor.add(assignment->getValue());
+                }
+                else {
+                    writeVisitor.add(expression);
+                }
+                numberer.add(expression, i, writeVisitor.getNames());
+            }
+            else if(const auto *varDeclaration = dynamic_cast<const Statement::VarDeclaration*>(statement)) {
+                writeVisitor.add(varDeclaration);
+                for(const auto &var : varDeclaration->getInitDeclaratorList()) {
+                    if(std::get<1>(var)) {
+                        numberer.add(std::get<1>(var).get(), i, writeVisitor.getNames());
+                    }
+                }
+            }
+            else if(const auto *print = dynamic_cast<const Statement::Print*>(statement)) {
+                writeVisitor.add(print->getExpression());
+                numberer.add(print->getExpression(), i, writeVisitor.getNames());
+            }
+            else if(const auto *ifStatement = dynamic_cast<const Statement::If*>(statement)) {
+                writeVisitor.add(ifStatement->getCondition());
+                numberer.add(ifStatement->getCondition(), i, writeVisitor.getNames());
+            }
+
+            // Subsequent reads of written variables get new values
+            for(const auto &n : writeVisitor.getNames()) {
+                numberer.write(n);
+            }
+            if(target) {
+                numberer.write(*target);
+            }
+        }
+
+        // Group occurrences by key and sort keys so the largest subexpressions are considered first
+        const auto &occurrences = numberer.getOccurrences();
+        std::unordered_map<std::string_view, std::vector<size_t>> keyOccurrences;
+        std::vector<std::string_view> keys;
+        for(size_t i = 0; i < occurrences.size(); i++) {
+            auto &k = keyOccurrences[occurrences[i].key];
+            if(k.empty()) {
+                keys.push_back(occurrences[i].key);
+            }
+            k.push_back(i);
+        }
+        std::stable_sort(keys.begin(), keys.end(),
+                         [&keyOccurrences, &occurrences](auto a, auto b)
+                         {
+                             return occurrences[keyOccurrences[a].front()].size > occurrences[keyOccurrences[b].front()].size;
+                         });
+
+        std::vector<bool> removed(occurrences.size(), false);
+        std::vector<size_t> initialisers;
+        for(const auto k : keys) {
+            // Find first occurrence which is always evaluated and hasn't been removed by replacing a larger subexpression
+            const auto &indices = keyOccurrences[k];
+            const auto first = std::find_if(indices.cbegin(), indices.cend(),
+                                            [&occurrences, &removed](size_t i){ return !removed[i] && !occurrences[i].conditional; });
+            if(first == indices.cend()) {
+                continue;
+            }
+
+            // Find subsequent occurrences
+            std::vector<size_t> uses;
+            std::copy_if(std::next(first), indices.cend(), std::back_inserter(uses), [&removed](size_t i){ return !removed[i]; });
+            if(uses.empty()) {
+                continue;
+            }
+
+            // Replace first occurrence and subsequent ones with temporary, removing the subexpressions within subsequent ones
+            const std::string_view name = getPersistentName("miniParseCSE" + std::to_string(m_NumTemporaries++));
+            const auto *type = getResolution().types.at(occurrences[*first].expression);
+            const size_t slot = numSlots + temporaries.size() + initialisers.size();
+            m_Replacements.try_emplace(occurrences[*first].expression, Temporary{name, slot, type, nullptr, 0});
+            for(size_t u : uses) {
+                std::fill(removed.begin() + occurrences[u].firstDescendant, removed.begin() + u, true);
+                m_Replacements.try_emplace(occurrences[u].expression, Temporary{name, slot, type, nullptr, 0});
+                m_NumEliminated += occurrences[u].size;
+            }
+            initialisers.push_back(*first);
+        }
+
+        // Declare temporaries in post-order of initialisers so temporaries used in initialisers are declared first
+        std::vector<size_t> order(initialisers.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&initialisers](size_t a, size_t b){ return initialisers[a] < initialisers[b]; });
+        for(size_t o : order) {
+            const auto &occurrence = occurrences[initialisers[o]];
+            const auto &replacement = m_Replacements.at(occurrence.expression);
+            temporaries.push_back({replacement.name, replacement.slot, replacement.type,
+                                   occurrence.expression, occurrence.statement});
+        }
+    }
+
+    //---------------------------------------------------------------------------
+    // Members
+    //---------------------------------------------------------------------------
+    std::unordered_map<const Expression::Base*, Temporary> m_Replacements;
+    size_t m_NumEliminated;
+    size_t m_NumTemporaries;
+};
+
+//---------------------------------------------------------------------------
+// LoopInvariantHoister
+//---------------------------------------------------------------------------
+//! Rewriter which evaluates loop-invariant subexpressions into const temporaries declared before loops
+class LoopInvariantHoister : public Rewriter
+{
+public:
+    LoopInvariantHoister(TypeChecker::Resolution &resolution, const TypeChecker::Environment &environment,
+                         ErrorHandler &errorHandler)
+    :   Rewriter(resolution), m_Environment(environment), m_ErrorHandler(errorHandler), m_Depth(0), m_VariableDepthOffset(0)
+    {
+    }
+
+    //---------------------------------------------------------------------------
+    // Public API
+    //---------------------------------------------------------------------------
+    size_t getNumHoisted() const{ return m_Hoisted.size(); }
+
+    using Rewriter::visit;
+
+    //---------------------------------------------------------------------------
+    // Expression::Visitor virtuals
+    //---------------------------------------------------------------------------
+    virtual void visit(const Expression::Variable &variable) final
+    {
+        // If variable is within a hoisted subexpression, it's now referenced from a scope outside its original one
+        auto rewrittenVariable = std::make_unique<Expression::Variable>(variable.getName());
+        if(auto slot = getResolution().getSlot(&variable)) {
+            if(!slot->global) {
+                assert(slot->depth >= m_VariableDepthOffset);
+                slot->depth -= m_VariableDepthOffset;
+            }
+            setSlot(*rewrittenVariable, *slot);
+        }
+        setResult(std::move(rewrittenVariable), &variable);
+    }
+
+    //---------------------------------------------------------------------------
+    // Statement::Visitor virtuals
+    //---------------------------------------------------------------------------
+    virtual void visit(const Statement::Compound &compound) final
+    {
+        m_Depth++;
+        Rewriter::visit(compound);
+        m_Depth--;
+    }
+
+    virtual void visit(const Statement::For &forStatement) final
+    {
+        m_Depth++;
+        Rewriter::visit(forStatement);
+        m_Depth--;
+    }
+
+protected:
+    //---------------------------------------------------------------------------
+    // Rewriter virtuals
+    //---------------------------------------------------------------------------
+    virtual Expression::ExpressionPtr rewrite(const Expression::Base *expression) final
+    {
+        const auto replacement = m_Replacements.find(expression);
+        if(replacement == m_Replacements.cend()) {
+            return Rewriter::rewrite(expression);
+        }
+        else {
+            const auto &temporary = replacement->second;
+            return createTemporaryReference(temporary.name, temporary.slot, m_Depth - temporary.depth, temporary.type);
+        }
+    }
+
+    virtual Statement::StatementList rewrite(const Statement::StatementList &statements, size_t &numSlots) final
+    {
+        // **NOTE** declarations are not inserted into switch bodies as jumps to labels would bypass them
+        if(std::any_of(statements.cbegin(), statements.cend(), 
+                       [](const auto &s){ return dynamic_cast<const Statement::Labelled*>(s.get()) != nullptr; }))
+        {
+            return Rewriter::rewrite(statements, numSlots);
+        }
+
+        Statement::StatementList rewrittenStatements;
+        rewrittenStatements.reserve(statements.size());
+        size_t numTemporaries = 0;
+        for(const auto &s : statements) {
+            // If statement is a loop, declare temporaries for its invariant subexpressions before it
+            if(dynamic_cast<const Statement::For*>(s.get()) || dynamic_cast<const Statement::While*>(s.get())
+               || dynamic_cast<const Statement::Do*>(s.get()))
+            {
+                InvariantFinder finder(getResolution(), m_Environment, m_ErrorHandler, m_Hoisted);
+                for(const auto &invariant : finder.find(s.get())) {
+                    const auto name = getPersistentName("miniParseLICM" + std::to_string(m_Hoisted.size()));
+                    const size_t slot = numSlots + numTemporaries++;
+                    const auto *type = getResolution().types.at(invariant.expression);
+
+                    // **NOTE** call base class directly so initialiser isn't itself replaced by temporary
+                    m_VariableDepthOffset = invariant.depth;
+                    rewrittenStatements.push_back(createTemporary(name, slot, Rewriter::rewrite(invariant.expression), type));
+                    m_VariableDepthOffset = 0;
+
+                    m_Replacements.try_emplace(invariant.expression, Temporary{name, slot, m_Depth, type});
+                    m_Hoisted.insert(invariant.expression);
+                }
+            }
+            rewrittenStatements.push_back(Rewriter::rewrite(s.get()));
+        }
+        numSlots += numTemporaries;
+        return rewrittenStatements;
+    }
+
+private:
+    //---------------------------------------------------------------------------
+    // Temporary
+    //---------------------------------------------------------------------------
+    struct Temporary
+    {
+        std::string_view name;
+        size_t slot;
+
+        //! Depth of scope temporary is declared in
+        size_t depth;
+
+        const Type::Base *type;
+    };
+
+    //---------------------------------------------------------------------------
+    // Members
+    //---------------------------------------------------------------------------
+    const TypeChecker::Environment &m_Environment;
+    ErrorHandler &m_ErrorHandler;
+    std::unordered_map<const Expression::Base*, Temporary> m_Replacements;
+    std::unordered_set<const Expression::Base*> m_Hoisted;
+
+    //! Depth of scope currently being rewritten
+    size_t m_Depth;
+
+    //! Number of scopes by which variables being rewritten have moved outwards
+    size_t m_VariableDepthOffset;
+};
+}   // Anonymous namespace
+
+//---------------------------------------------------------------------------
+// MiniParse::Optimiser
+//---------------------------------------------------------------------------
+Statement::StatementList MiniParse::Optimiser::optimise(const Statement::StatementList &statements,
+                                                        TypeChecker::Resolution &resolution,
+                                                        const ConstantValues &constantValues)
+{
+    Folder folder(resolution, constantValues);
+    return folder.rewriteProgram(statements);
+}
+//---------------------------------------------------------------------------
+Statement::StatementList MiniParse::Optimiser::eliminateCommonSubexpressions(const Statement::StatementList &statements,
+                                                                             TypeChecker::Resolution &resolution,
+                                                                             size_t &numEliminated)
+{
+    CommonSubexpressionEliminator eliminator(resolution);
+    auto eliminatedStatements = eliminator.rewriteProgram(statements);
+    numEliminated = eliminator.getNumEliminated();
+    return eliminatedStatements;
+}
+//---------------------------------------------------------------------------
+Statement::StatementList MiniParse::Optimiser::hoistLoopInvariants(const Statement::StatementList &statements,
+                                                                   const TypeChecker::Environment &environment,
+                                                                   TypeChecker::Resolution &resolution,
+                                                                   ErrorHandler &errorHandler, size_t &numHoisted)
+{
+    LoopInvariantHoister hoister(resolution, environment, errorHandler);
+    auto hoistedStatements = hoister.rewriteProgram(statements);
+    numHoisted = hoister.getNumHoisted();
+    return hoistedStatements;
+}
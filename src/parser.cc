@@ -1,11 +1,12 @@
 #include "parser.h"
 
 // Standard C++ includes
+#include <array>
 #include <map>
 #include <optional>
-#include <set>
 #include <stack>
 #include <stdexcept>
+#include <type_traits>
 
 // Standard C includes
 #include <cassert>
@@ -14,7 +15,10 @@
 #include "type.h"
 
 // Mini-parse includes
+#include "arena.h"
 #include "error_handler.h"
+#include "scanner.h"
+#include "token_stream.h"
 
 using namespace MiniParse;
 
@@ -33,12 +37,17 @@ class ParseError
 //---------------------------------------------------------------------------
 // ParserState
 //---------------------------------------------------------------------------
-//! Class encapsulated logic to navigate through tokens
+//! Class encapsulated logic to navigate through tokens. Tokens can either be a vector of full tokens, 
+//! a TokenStream of compact tokens or a TokenCursor which scans tokens as they are required
+template<typename Tokens>
 class ParserState
 {
 public:
-    ParserState(const std::vector<Token> &tokens, ErrorHandler &errorHandler)
-        : m_Current(0), m_Tokens(tokens), m_ErrorHandler(errorHandler)
+    //! Type of tokens being navigated through
+    typedef typename Tokens::value_type TokenType;
+
+    ParserState(Tokens &tokens, ErrorHandler &errorHandler, Arena *arena = nullptr)
+        : m_Current(0), m_LineHint(0), m_Tokens(tokens), m_ErrorHandler(errorHandler), m_Arena(arena)
     {}
 
     //---------------------------------------------------------------------------
@@ -66,7 +75,7 @@ public:
         return false;
     }
 
-    Token advance()
+    const TokenType &advance()
     {
         if(!isAtEnd()) {
             m_Current++;
@@ -75,7 +84,7 @@ public:
         return previous();
     }
 
-    Token rewind()
+    const TokenType &rewind()
     {
         if(m_Current > 0) {
             m_Current--;
@@ -84,28 +93,28 @@ public:
         return peek();
     }
 
-    Token peek() const
+    const TokenType &peek() const
     {
-        return m_Tokens.at(m_Current);
+        return m_Tokens[m_Current];
     }
 
-    Token previous() const
+    const TokenType &previous() const
     {
         assert(m_Current > 0);
-        return m_Tokens.at(m_Current - 1);
+        return m_Tokens[m_Current - 1];
     }
 
     void error(std::string_view message) const
     {
-        m_ErrorHandler.error(peek(), message);
+        error(peek(), message);
     }
 
-    void error(Token token, std::string_view message) const
+    void error(const TokenType &token, std::string_view message) const
     {
-        m_ErrorHandler.error(token, message);
+        m_ErrorHandler.error(getToken(token), message);
     }
 
-    Token consume(Token::Type type, std::string_view message) 
+    const TokenType &consume(Token::Type type, std::string_view message) 
     {
         if(check(type)) {
             return advance();
@@ -127,19 +136,76 @@ public:
 
     bool isAtEnd() const { return (peek().type == Token::Type::END_OF_FILE); }
 
+    //! Indicate that tokens before the current one will no longer be accessed
+    void releaseTokens()
+    {
+        if constexpr(std::is_same_v<Tokens, Scanner::TokenCursor>) {
+            m_Tokens.release(m_Current);
+        }
+    }
+
+    //! Get full token e.g. to store in AST node, which is only constructed if tokens are compact
+    decltype(auto) getToken(const TokenType &token) const
+    {
+        if constexpr(std::is_same_v<TokenType, Token>) {
+            return token;
+        }
+        else {
+            return m_Tokens.getToken(token, m_LineHint);
+        }
+    }
+
+    std::string_view getLexeme(const TokenType &token) const
+    {
+        if constexpr(std::is_same_v<TokenType, Token>) {
+            return token.lexeme;
+        }
+        else {
+            return m_Tokens.getLexeme(token);
+        }
+    }
+
+    const Token::LiteralValue &getLiteralValue(const TokenType &token) const
+    {
+        if constexpr(std::is_same_v<TokenType, Token>) {
+            return token.literalValue;
+        }
+        else {
+            return m_Tokens.getLiteralValue(token);
+        }
+    }
+
+    //! Create AST node in arena if one was provided, otherwise on the heap
+    template<typename T, typename... Args>
+    std::unique_ptr<T, ArenaDeleter> create(Args&&... args)
+    {
+        if(m_Arena) {
+            return m_Arena->create<T>(std::forward<Args>(args)...);
+        }
+        else {
+            return std::unique_ptr<T, ArenaDeleter>(new T(std::forward<Args>(args)...));
+        }
+    }
+
 private:
     //---------------------------------------------------------------------------
     // Members
     //---------------------------------------------------------------------------
     size_t m_Current;
 
-    const std::vector<Token> &m_Tokens;
+    //! Index of line last token was expanded from, used to speed up finding lines of compact tokens
+    mutable size_t m_LineHint;
+
+    Tokens &m_Tokens;
 
     ErrorHandler &m_ErrorHandler;
+
+    Arena *m_Arena;
 };
 
 
-void synchronise(ParserState &parserState)
+template<typename Tokens>
+void synchronise(ParserState<Tokens> &parserState)
 {
     parserState.advance();
     while(!parserState.isAtEnd()) {
@@ -161,43 +227,60 @@ void synchronise(ParserState &parserState)
 }
 
 // Forward declarations
-Expression::ExpressionPtr parseCast(ParserState &parserState);
-Expression::ExpressionPtr parseAssignment(ParserState &parserState);
-Expression::ExpressionPtr parseExpression(ParserState &parserState);
-Statement::StatementPtr parseBlockItem(ParserState &parserState);
-Statement::StatementPtr parseDeclaration(ParserState &parserState);
-Statement::StatementPtr parseStatement(ParserState &parserState);
-
-// Helper to parse binary expressions
-// **THINK I think this COULD be variadic but not clear if that's a good idea or not
-template<typename N>
-Expression::ExpressionPtr parseBinary(ParserState &parserState, N nonTerminal, std::initializer_list<Token::Type> types)
+template<typename Tokens>
+Statement::StatementPtr parseBlockItem(ParserState<Tokens> &parserState);
+template<typename Tokens>
+Statement::StatementPtr parseDeclaration(ParserState<Tokens> &parserState);
+template<typename Tokens>
+Statement::StatementPtr parseStatement(ParserState<Tokens> &parserState);
+
+//! Precedence of each binary operator token, from logical-OR (lowest) to multiplicative (highest).
+//! Tokens which aren't binary operators have a precedence of zero so terminate precedence climbing
+constexpr auto binaryPrecedence = []()
 {
-    auto expression = nonTerminal(parserState);
-    while(parserState.match(types)) {
-        Token op = parserState.previous();
-        expression = std::make_unique<Expression::Binary>(std::move(expression), op, nonTerminal(parserState));
-    }
-
-    return expression;
-}
-
-std::tuple<const Type::Base*, bool> parseDeclarationSpecifiers(ParserState &parserState)
+    std::array<int, static_cast<size_t>(Token::Type::END_OF_FILE) + 1> precedence{};
+    precedence[static_cast<size_t>(Token::Type::PIPE_PIPE)] = 1;
+    precedence[static_cast<size_t>(Token::Type::AMPERSAND_AMPERSAND)] = 2;
+    precedence[static_cast<size_t>(Token::Type::PIPE)] = 3;
+    precedence[static_cast<size_t>(Token::Type::CARET)] = 4;
+    precedence[static_cast<size_t>(Token::Type::AMPERSAND)] = 5;
+    precedence[static_cast<size_t>(Token::Type::NOT_EQUAL)] = 6;
+    precedence[static_cast<size_t>(Token::Type::EQUAL_EQUAL)] = 6;
+    precedence[static_cast<size_t>(Token::Type::GREATER)] = 7;
+    precedence[static_cast<size_t>(Token::Type::GREATER_EQUAL)] = 7;
+    precedence[static_cast<size_t>(Token::Type::LESS)] = 7;
+    precedence[static_cast<size_t>(Token::Type::LESS_EQUAL)] = 7;
+    precedence[static_cast<size_t>(Token::Type::SHIFT_LEFT)] = 8;
+    precedence[static_cast<size_t>(Token::Type::SHIFT_RIGHT)] = 8;
+    precedence[static_cast<size_t>(Token::Type::MINUS)] = 9;
+    precedence[static_cast<size_t>(Token::Type::PLUS)] = 9;
+    precedence[static_cast<size_t>(Token::Type::STAR)] = 10;
+    precedence[static_cast<size_t>(Token::Type::SLASH)] = 10;
+    precedence[static_cast<size_t>(Token::Type::PERCENT)] = 10;
+    return precedence;
+}();
+
+template<typename Tokens>
+std::tuple<const Type::Base*, bool> parseDeclarationSpecifiers(ParserState<Tokens> &parserState)
 {
     // Loop through type qualifier and specifier tokens
-    std::set<std::string_view> typeQualifiers{};
-    std::set<std::string_view> typeSpecifiers{};
+    // **NOTE** this only works as const is the ONLY supported qualifier
+    bool isConst = false;
+    Type::TypeSpecifiers typeSpecifiers = 0;
     do {
-        // Add token lexeme to appropriate set, giving error if duplicate 
+        // Add qualifier or specifier to set, giving error if duplicate 
         if(parserState.previous().type == Token::Type::TYPE_QUALIFIER) {
-            if(!typeQualifiers.insert(parserState.previous().lexeme).second) {
+            if(isConst) {
                 parserState.error(parserState.previous(), "duplicate type qualifier");
             }
+            isConst = true;
         }
         else {
-            if(!typeSpecifiers.insert(parserState.previous().lexeme).second) {
+            const auto typeSpecifier = Type::getTypeSpecifier(parserState.getLexeme(parserState.previous()));
+            if(typeSpecifiers & typeSpecifier) {
                 parserState.error(parserState.previous(), "duplicate type specifier");
             }
+            typeSpecifiers |= typeSpecifier;
         }
     } while(parserState.match({Token::Type::TYPE_QUALIFIER, Token::Type::TYPE_SPECIFIER}));
     
@@ -209,344 +292,559 @@ std::tuple<const Type::Base*, bool> parseDeclarationSpecifiers(ParserState &pars
         parserState.error("Unknown type specifier");
     }
 
-    // Determine constness
-    // **NOTE** this only works as const is the ONLY supported qualifier
-    return std::make_tuple(type, !typeQualifiers.empty());
+    return std::make_tuple(type, isConst);
 }
 
-Expression::ExpressionPtr parsePrimary(ParserState &parserState)
+//---------------------------------------------------------------------------
+// ExpressionParser
+//---------------------------------------------------------------------------
+//! Parses expressions without recursing through the grammar. Each production which is waiting for 
+//! an operand to be parsed is represented by a frame on an explicit stack, which is continued once 
+//! the operand has been parsed, so nesting depth is only limited by heap memory
+template<typename Tokens>
+class ExpressionParser
 {
-    // primary-expression ::=
-    //      identifier
-    //      constant
-    //      "(" expression ")"
-    if(parserState.match(Token::Type::FALSE)) {
-        return std::make_unique<Expression::Literal>(false);
-    }
-    else if(parserState.match(Token::Type::TRUE)) {
-        return std::make_unique<Expression::Literal>(true);
-    }
-    else if(parserState.match(Token::Type::NUMBER)) {
-        return std::make_unique<Expression::Literal>(parserState.previous().literalValue);
-    }
-    else if(parserState.match(Token::Type::IDENTIFIER)) {
-        return std::make_unique<Expression::Variable>(parserState.previous());
-    }
-    else if(parserState.match(Token::Type::LEFT_PAREN)) {
-        auto expression = parseExpression(parserState);
+public:
+    //! Productions which can be parsed as the operand of another
+    enum class Production
+    {
+        EXPRESSION,
+        ASSIGNMENT,
+        CONDITIONAL,
+        BINARY,
+    };
+
+    ExpressionParser(ParserState<Tokens> &parserState)
+    :   m_ParserState(parserState)
+    {}
 
-        parserState.consume(Token::Type::RIGHT_PAREN, "Expect ')' after expression");
-        return std::make_unique<Expression::Grouping>(std::move(expression));
+    //---------------------------------------------------------------------------
+    // Public API
+    //---------------------------------------------------------------------------
+    Expression::ExpressionPtr parse(Production production)
+    {
+        m_Frames.emplace_back(production, 1, 0);
+
+        // Continue frame at top of stack until it's complete, then pass expression to parent
+        Expression::ExpressionPtr expression;
+        while(true) {
+            if(!continueFrame(m_Frames.back(), expression)) {
+                m_Frames.pop_back();
+                if(m_Frames.empty()) {
+                    return expression;
+                }
+            }
+        }
     }
 
-    parserState.error("Expect expression");
-    throw ParseError();
-}
+private:
+    typedef typename ParserState<Tokens>::TokenType TokenType;
 
-Expression::ExpressionPtr parsePostfix(ParserState &parserState)
-{
-    // postfix-expression ::=
-    //      primary-expression
-    //      postfix-expression "[" expression "]"
-    //      postfix-expression "(" argument-expression-list? ")"
-    //      postfix-expression "++"
-    //      postfix-expression "--"
-
-    // argument-expression-list ::=
-    //      assignment-expression
-    //      argument-expression-list "," assignment-expression
-
-    auto expression = parsePrimary(parserState);
-
-    while(true) {
-        // If this is a function call
-        if(parserState.match(Token::Type::LEFT_PAREN)) {
-            // Build list of arguments
-            Expression::ExpressionList arguments;
-            if(!parserState.check(Token::Type::RIGHT_PAREN)) {
-                do {
-                    arguments.emplace_back(parseAssignment(parserState));
-                } while(parserState.check(Token::Type::COMMA));
-            }
+    //---------------------------------------------------------------------------
+    // Frame
+    //---------------------------------------------------------------------------
+    //! Production being parsed. Frames progress through a stage for each level of the grammar from 
+    //! primary expressions up to their production, pushing a child frame whenever an operand is required
+    struct Frame
+    {
+        enum class Stage
+        {
+            UNARY,
+            PRIMARY,
+            GROUPING,
+            POSTFIX,
+            CALL_ARGUMENT,
+            SUBSCRIPT_INDEX,
+            PREFIX,
+            BINARY,
+            BINARY_RIGHT,
+            CONDITIONAL,
+            CONDITIONAL_TRUE,
+            CONDITIONAL_FALSE,
+            ASSIGNMENT,
+            ASSIGNMENT_VALUE,
+            COMMA,
+            COMMA_RIGHT,
+        };
+
+        Frame(Production production, int minPrecedence, size_t firstPrefix)
+        :   production(production), stage(Stage::UNARY), minPrecedence(minPrecedence), 
+            firstPrefix(firstPrefix), op(nullptr)
+        {}
+
+        Production production;
+        Stage stage;
+
+        //! Minimum precedence of binary operators this frame can consume
+        int minPrecedence;
+
+        //! Index of this frame's first prefix operator
+        size_t firstPrefix;
+
+        //! Operator and operands parsed before operand being parsed by child frame e.g. left operand of binary expression
+        const TokenType *op;
+        Expression::ExpressionPtr left;
+        Expression::ExpressionPtr middle;
+        Expression::ExpressionList arguments;
+    };
 
-            Token closingParen = parserState.consume(Token::Type::RIGHT_PAREN,
-                                                     "Expect ')' after arguments.");
+    //---------------------------------------------------------------------------
+    // Prefix
+    //---------------------------------------------------------------------------
+    //! Prefix operator or cast waiting to be applied to its operand
+    struct Prefix
+    {
+        //! Unary or increment/decrement operator, nullptr for casts
+        const TokenType *op;
 
-            // Create call expression
-            expression = std::make_unique<Expression::Call>(std::move(expression),
-                                                            closingParen,
-                                                            std::move(arguments));
-        }
-        // Otherwise, if this is an array index
-        if(parserState.match(Token::Type::LEFT_SQUARE_BRACKET)) {
-            auto index = parseExpression(parserState);
-            Token closingSquareBracket = parserState.consume(Token::Type::RIGHT_SQUARE_BRACKET,
-                                                             "Expect ']' after index.");
+        //! Type of cast
+        const Type::Base *type;
+        bool isConst;
+    };
 
-            // **TODO** everything all the way up(?) from unary are l-value so can be used - not just variable
-            auto expressionVariable = dynamic_cast<const Expression::Variable*>(expression.get());
-            if(expressionVariable) {
-                expression = std::make_unique<Expression::ArraySubscript>(expressionVariable->getName(),
-                                                                          std::move(index));
-            }
-            else {
-                parserState.error(closingSquareBracket, "Invalid subscript target");
+    //---------------------------------------------------------------------------
+    // Private methods
+    //---------------------------------------------------------------------------
+    //! Continue parsing frame with expression parsed by child. Returns true if frame pushed another 
+    //! child to parse an operand or false if frame is complete, in which case expression holds result
+    bool continueFrame(Frame &frame, Expression::ExpressionPtr &expression)
+    {
+        while(true) {
+            switch(frame.stage) {
+            case Frame::Stage::UNARY:
+                // unary-expression ::=
+                //      postfix-expression
+                //      "++" unary-expression
+                //      "--" unary-expression
+                //      "&" cast-expression
+                //      "*" cast-expression
+                //      "+" cast-expression
+                //      "-" cast-expression
+                //      "~" cast-expression
+                //      "!" cast-expression
+                //      "sizeof" unary-expression       **TODO** 
+                //      "sizeof" "(" type-name ")"      **TODO** 
+
+                // cast-expression ::=
+                //      unary-expression
+                //      "(" type-name ")" cast-expression
+
+                // **NOTE** as the operands of casts and unary operators are themselves cast or unary expressions, 
+                // they can be parsed by pushing them onto a stack and applying them once postfix expression is parsed
+                parsePrefixes();
+                frame.stage = Frame::Stage::PRIMARY;
+                break;
+
+            case Frame::Stage::PRIMARY:
+                // primary-expression ::=
+                //      identifier
+                //      constant
+                //      "(" expression ")"
+                if(m_ParserState.match(Token::Type::FALSE)) {
+                    expression = create<Expression::Literal>(false);
+                }
+                else if(m_ParserState.match(Token::Type::TRUE)) {
+                    expression = create<Expression::Literal>(true);
+                }
+                else if(m_ParserState.match(Token::Type::NUMBER)) {
+                    expression = create<Expression::Literal>(m_ParserState.getLiteralValue(m_ParserState.previous()));
+                }
+                else if(m_ParserState.match(Token::Type::IDENTIFIER)) {
+                    expression = create<Expression::Variable>(getToken(m_ParserState.previous()));
+                }
+                else if(m_ParserState.match(Token::Type::LEFT_PAREN)) {
+                    return parseOperand(frame, Frame::Stage::GROUPING, Production::EXPRESSION);
+                }
+                else {
+                    m_ParserState.error("Expect expression");
+                    throw ParseError();
+                }
+                frame.stage = Frame::Stage::POSTFIX;
+                break;
+
+            case Frame::Stage::GROUPING:
+                m_ParserState.consume(Token::Type::RIGHT_PAREN, "Expect ')' after expression");
+                expression = create<Expression::Grouping>(std::move(expression));
+                frame.stage = Frame::Stage::POSTFIX;
+                break;
+
+            case Frame::Stage::POSTFIX:
+            case Frame::Stage::CALL_ARGUMENT:
+            case Frame::Stage::SUBSCRIPT_INDEX:
+                if(continuePostfix(frame, expression)) {
+                    return true;
+                }
+                frame.stage = Frame::Stage::PREFIX;
+                break;
+
+            case Frame::Stage::PREFIX:
+                // If all prefixes have been applied, continue to binary expression
+                // **NOTE** otherwise, postfix expression is parsed from current position
+                frame.stage = applyPrefixes(frame, expression) ? Frame::Stage::BINARY : Frame::Stage::PRIMARY;
+                break;
+
+            case Frame::Stage::BINARY:
+            case Frame::Stage::BINARY_RIGHT:
+            {
+                // multiplicative-expression ::=
+                //      cast-expression
+                //      multiplicative-expression "*" cast-expression
+                //      multiplicative-expression "/" cast-expression
+                //      multiplicative-expression "%" cast-expression
+
+                // additive-expression ::=
+                //      multiplicative-expression
+                //      additive-expression "+" multiplicative-expression
+                //      additive-expression "-" multiplicative-expression
+
+                // shift-expression ::=
+                //      additive-expression
+                //      shift-expression "<<" additive-expression
+                //      shift-expression ">>" additive-expression
+
+                // relational-expression ::=
+                //      shift-expression
+                //      relational-expression "<" shift-expression
+                //      relational-expression ">" shift-expression
+                //      relational-expression "<=" shift-expression
+                //      relational-expression ">=" shift-expression
+
+                // equality-expression ::=
+                //      relational-expression
+                //      equality-expression "==" relational-expression
+                //      equality-expression "!=" relational-expression
+
+                // AND-expression ::=
+                //      equality-expression
+                //      AND-expression "&" equality-expression
+
+                // exclusive-OR-expression ::=
+                //      AND-expression
+                //      exclusive-OR-expression "^" AND-expression
+
+                // inclusive-OR-expression ::=
+                //      exclusive-OR-expression
+                //      inclusive-OR-expression "|" exclusive-OR-expression
+
+                // logical-AND-expression ::=
+                //      inclusive-OR-expression
+                //      logical-AND-expression "&&" inclusive-OR-expression
+
+                // logical-OR-expression ::=
+                //      logical-AND-expression
+                //      logical-OR-expression "||" logical-AND-expression
+
+                // **NOTE** rather than a production per level, all of these are parsed by precedence climbing: 
+                // operators are consumed while they bind at least as tightly as the frame's minimum precedence and, 
+                // because all are left-associative, right operands only consume operators which bind more tightly
+                if(frame.stage == Frame::Stage::BINARY_RIGHT) {
+                    if(frame.op->type == Token::Type::AMPERSAND_AMPERSAND || frame.op->type == Token::Type::PIPE_PIPE) {
+                        expression = create<Expression::Logical>(std::move(frame.left), getToken(*frame.op), std::move(expression));
+                    }
+                    else {
+                        expression = create<Expression::Binary>(std::move(frame.left), getToken(*frame.op), std::move(expression));
+                    }
+                }
+
+                const int precedence = binaryPrecedence[static_cast<size_t>(m_ParserState.peek().type)];
+                if(precedence >= frame.minPrecedence) {
+                    frame.left = std::move(expression);
+                    frame.op = &m_ParserState.advance();
+                    return parseOperand(frame, Frame::Stage::BINARY_RIGHT, Production::BINARY, precedence + 1);
+                }
+                else if(frame.production == Production::BINARY) {
+                    return false;
+                }
+                frame.stage = Frame::Stage::CONDITIONAL;
+                break;
             }
-        }
-        // Otherwise if this is an increment or decrement
-        else if(parserState.match({Token::Type::PLUS_PLUS, Token::Type::MINUS_MINUS})) {
-            Token op = parserState.previous();
 
-            // **TODO** everything all the way up(?) from unary are l-value so can be used - not just variable
-            auto expressionVariable = dynamic_cast<const Expression::Variable*>(expression.get());
-            if(expressionVariable) {
-                return std::make_unique<Expression::PostfixIncDec>(expressionVariable->getName(), op);
+            case Frame::Stage::CONDITIONAL:
+                // conditional-expression ::=
+                //      logical-OR-expression
+                //      logical-OR-expression "?" expression ":" conditional-expression
+                if(m_ParserState.match(Token::Type::QUESTION)) {
+                    frame.left = std::move(expression);
+                    frame.op = &m_ParserState.previous();
+                    return parseOperand(frame, Frame::Stage::CONDITIONAL_TRUE, Production::EXPRESSION);
+                }
+                else if(frame.production == Production::CONDITIONAL) {
+                    return false;
+                }
+                frame.stage = Frame::Stage::ASSIGNMENT;
+                break;
+
+            case Frame::Stage::CONDITIONAL_TRUE:
+                m_ParserState.consume(Token::Type::COLON, "Expect ':' in conditional expression.");
+                frame.middle = std::move(expression);
+                return parseOperand(frame, Frame::Stage::CONDITIONAL_FALSE, Production::CONDITIONAL);
+
+            case Frame::Stage::CONDITIONAL_FALSE:
+                expression = create<Expression::Conditional>(std::move(frame.left), getToken(*frame.op), 
+                                                             std::move(frame.middle), std::move(expression));
+                if(frame.production == Production::CONDITIONAL) {
+                    return false;
+                }
+                frame.stage = Frame::Stage::ASSIGNMENT;
+                break;
+
+            case Frame::Stage::ASSIGNMENT:
+                // assignment-expression ::=
+                //      conditional-expression
+                //      unary-expression assignment-operator assignment-expression
+                if(m_ParserState.match({Token::Type::EQUAL, Token::Type::STAR_EQUAL, Token::Type::SLASH_EQUAL, 
+                                        Token::Type::PERCENT_EQUAL, Token::Type::PLUS_EQUAL, Token::Type::MINUS_EQUAL, 
+                                        Token::Type::AMPERSAND_EQUAL, Token::Type::CARET_EQUAL, Token::Type::PIPE_EQUAL,
+                                        Token::Type::SHIFT_LEFT_EQUAL, Token::Type::SHIFT_RIGHT_EQUAL})) 
+                {
+                    frame.left = std::move(expression);
+                    frame.op = &m_ParserState.previous();
+                    return parseOperand(frame, Frame::Stage::ASSIGNMENT_VALUE, Production::ASSIGNMENT);
+                }
+                else if(frame.production == Production::ASSIGNMENT) {
+                    return false;
+                }
+                frame.stage = Frame::Stage::COMMA;
+                break;
+
+            case Frame::Stage::ASSIGNMENT_VALUE:
+            {
+                // **TODO** everything all the way up(?) from unary are l-value so can be used - not just variable
+                auto expressionVariable = dynamic_cast<const Expression::Variable*>(frame.left.get());
+                if(expressionVariable) {
+                    expression = create<Expression::Assignment>(expressionVariable->getName(), getToken(*frame.op), 
+                                                                std::move(expression));
+                }
+                else {
+                    m_ParserState.error(*frame.op, "Invalid assignment target");
+                    expression = std::move(frame.left);
+                }
+                if(frame.production == Production::ASSIGNMENT) {
+                    return false;
+                }
+                frame.stage = Frame::Stage::COMMA;
+                break;
             }
-            else {
-                parserState.error(op, "Invalid postfix target");
+
+            case Frame::Stage::COMMA:
+            case Frame::Stage::COMMA_RIGHT:
+                // expression ::=
+                //      assignment-expression
+                //      expression "," assignment-expression
+                if(frame.stage == Frame::Stage::COMMA_RIGHT) {
+                    expression = create<Expression::Binary>(std::move(frame.left), getToken(*frame.op), std::move(expression));
+                }
+                if(m_ParserState.match(Token::Type::COMMA)) {
+                    frame.left = std::move(expression);
+                    frame.op = &m_ParserState.previous();
+                    return parseOperand(frame, Frame::Stage::COMMA_RIGHT, Production::ASSIGNMENT);
+                }
+                return false;
             }
         }
-        else {
-            break;
-        }
     }
 
-    return expression;
-}
-
-
-Expression::ExpressionPtr parseUnary(ParserState &parserState)
-{
-    // unary-expression ::=
-    //      postfix-expression
-    //      "++" unary-expression
-    //      "--" unary-expression
-    //      "&" cast-expression
-    //      "*" cast-expression
-    //      "+" cast-expression
-    //      "-" cast-expression
-    //      "~" cast-expression
-    //      "!" cast-expression
-    //      "sizeof" unary-expression       **TODO** 
-    //      "sizeof" "(" type-name ")"      **TODO** 
-    if(parserState.match({Token::Type::AMPERSAND, Token::Type::STAR, Token::Type::PLUS, 
-                         Token::Type::MINUS, Token::Type::TILDA, Token::Type::NOT})) {
-        Token op = parserState.previous();
-        return std::make_unique<Expression::Unary>(op, parseCast(parserState));
-    }
-    else if(parserState.match({Token::Type::PLUS_PLUS, Token::Type::MINUS_MINUS})) {
-        Token op = parserState.previous();
-        auto expression = parseUnary(parserState);
-
-        // **TODO** everything all the way up(?) from unary are l-value so can be used - not just variable
-        auto expressionVariable = dynamic_cast<const Expression::Variable*>(expression.get());
-        if(expressionVariable) {
-            return std::make_unique<Expression::PrefixIncDec>(expressionVariable->getName(), op);
-        }
-        else {
-            parserState.error(op, "Invalid prefix target");
-        }
+    //! Create AST node using parser state's allocator
+    template<typename T, typename... Args>
+    auto create(Args&&... args)
+    {
+        return m_ParserState.template create<T>(std::forward<Args>(args)...);
     }
 
-    return parsePostfix(parserState);
-}
-
-Expression::ExpressionPtr parseCast(ParserState &parserState)
-{
-    // cast-expression ::=
-    //      unary-expression
-    //      "(" type-name ")" cast-expression
+    //! Get full token from parser state
+    decltype(auto) getToken(const TokenType &token) const
+    {
+        return m_ParserState.getToken(token);
+    }
 
-    // If next token is a left parenthesis
-    if(parserState.match(Token::Type::LEFT_PAREN)) {
-        // If this is followed by some part of a type declarator
-        if(parserState.match({Token::Type::TYPE_QUALIFIER, Token::Type::TYPE_SPECIFIER})) {
-            // Parse declaration specifiers
-            const auto [type, isConst] = parseDeclarationSpecifiers(parserState);
+    //! Push child frame to parse operand of production, after which frame will continue from stage
+    bool parseOperand(Frame &frame, typename Frame::Stage stage, Production production, int minPrecedence = 1)
+    {
+        frame.stage = stage;
+        m_Frames.emplace_back(production, minPrecedence, m_Prefixes.size());
+        return true;
+    }
 
-            parserState.consume(Token::Type::RIGHT_PAREN, "Expect ')' after cast type.");
+    //! Push any casts and prefix operators before postfix expression onto stack
+    void parsePrefixes()
+    {
+        while(true) {
+            // If next token is a left parenthesis
+            if(m_ParserState.match(Token::Type::LEFT_PAREN)) {
+                // If this is followed by some part of a type declarator
+                if(m_ParserState.match({Token::Type::TYPE_QUALIFIER, Token::Type::TYPE_SPECIFIER})) {
+                    // Parse declaration specifiers
+                    const auto [type, isConst] = parseDeclarationSpecifiers(m_ParserState);
+
+                    m_ParserState.consume(Token::Type::RIGHT_PAREN, "Expect ')' after cast type.");
+                    m_Prefixes.push_back({nullptr, type, isConst});
+                    continue;
+                }
+                // Otherwise, rewind parser state so left parenthesis can be parsed again
+                // **YUCK**
+                else {
+                    m_ParserState.rewind();
+                }
+            }
 
-            return std::make_unique<Expression::Cast>(type, isConst, parseCast(parserState));
-        }
-        // Otherwise, rewind parser state so left parenthesis can be parsed again
-        // **YUCK**
-        else {
-            parserState.rewind();
+            if(m_ParserState.match({Token::Type::AMPERSAND, Token::Type::STAR, Token::Type::PLUS, 
+                                    Token::Type::MINUS, Token::Type::TILDA, Token::Type::NOT,
+                                    Token::Type::PLUS_PLUS, Token::Type::MINUS_MINUS})) 
+            {
+                m_Prefixes.push_back({&m_ParserState.previous(), nullptr, false});
+            }
+            else {
+                return;
+            }
         }
     }
 
-    return parseUnary(parserState);
-}
-
-Expression::ExpressionPtr parseMultiplicative(ParserState &parserState)
-{
-    // multiplicative-expression ::=
-    //      cast-expression
-    //      multiplicative-parseExpression "*" cast-parseExpression
-    //      multiplicative-parseExpression "/" cast-parseExpression
-    //      multiplicative-parseExpression "%" cast-parseExpression
-    return parseBinary(parserState, parseCast, 
-                       {Token::Type::STAR, Token::Type::SLASH, Token::Type::PERCENT});
-}
-
-Expression::ExpressionPtr parseAdditive(ParserState &parserState)
-{
-    // additive-expression ::=
-    //      multiplicative-expression
-    //      additive-parseExpression "+" multiplicative-parseExpression
-    //      additive-parseExpression "-" multiplicative-parseExpression
-    return parseBinary(parserState, parseMultiplicative, 
-                       {Token::Type::MINUS, Token::Type::PLUS});
-}
-
-Expression::ExpressionPtr parseShift(ParserState &parserState)
-{
-    // shift-expression ::=
-    //      additive-expression
-    //      shift-parseExpression "<<" additive-parseExpression
-    //      shift-parseExpression ">>" additive-parseExpression
-    return parseBinary(parserState, parseAdditive, 
-                       {Token::Type::SHIFT_LEFT, Token::Type::SHIFT_RIGHT});
-}
+    //! Apply frame's prefixes to expression, innermost first. Returns false if an invalid
+    //! increment or decrement means the postfix expression which follows should be parsed instead
+    bool applyPrefixes(Frame &frame, Expression::ExpressionPtr &expression)
+    {
+        while(m_Prefixes.size() > frame.firstPrefix) {
+            const Prefix prefix = m_Prefixes.back();
+            m_Prefixes.pop_back();
 
-Expression::ExpressionPtr parseRelational(ParserState &parserState)
-{
-    // relational-expression ::=
-    //      shift-expression
-    //      relational-parseExpression "<" shift-parseExpression
-    //      relational-parseExpression ">" shift-parseExpression
-    //      relational-parseExpression "<=" shift-parseExpression
-    //      relational-parseExpression ">=" shift-parseExpression
-    return parseBinary(parserState, parseShift, 
-                       {Token::Type::GREATER, Token::Type::GREATER_EQUAL, 
-                        Token::Type::LESS, Token::Type::LESS_EQUAL});
-}
+            if(!prefix.op) {
+                expression = create<Expression::Cast>(prefix.type, prefix.isConst, std::move(expression));
+            }
+            else if(prefix.op->type == Token::Type::PLUS_PLUS || prefix.op->type == Token::Type::MINUS_MINUS) {
+                // **TODO** everything all the way up(?) from unary are l-value so can be used - not just variable
+                auto expressionVariable = dynamic_cast<const Expression::Variable*>(expression.get());
+                if(expressionVariable) {
+                    expression = create<Expression::PrefixIncDec>(expressionVariable->getName(), getToken(*prefix.op));
+                }
+                else {
+                    m_ParserState.error(*prefix.op, "Invalid prefix target");
+                    return false;
+                }
+            }
+            else {
+                expression = create<Expression::Unary>(getToken(*prefix.op), std::move(expression));
+            }
+        }
+        return true;
+    }
 
-Expression::ExpressionPtr parseEquality(ParserState &parserState)
-{
-    // equality-expression ::=
-    //      relational-expression
-    //      equality-parseExpression "==" relational-parseExpression
-    //      equality-parseExpression "!=" relational-parseExpression
-    return parseBinary(parserState, parseRelational, 
-                       {Token::Type::NOT_EQUAL, Token::Type::EQUAL_EQUAL});
-}
-Expression::ExpressionPtr parseAnd(ParserState &parserState)
-{
-    // AND-expression ::=
-    //      equality-expression
-    //      AND-expression "&" equality-expression
-    return parseBinary(parserState, parseEquality, {Token::Type::AMPERSAND});
-}
+    //! Continue postfix expression, returning true if child was pushed to parse call argument or subscript index
+    bool continuePostfix(Frame &frame, Expression::ExpressionPtr &expression)
+    {
+        // postfix-expression ::=
+        //      primary-expression
+        //      postfix-expression "[" expression "]"
+        //      postfix-expression "(" argument-expression-list? ")"
+        //      postfix-expression "++"
+        //      postfix-expression "--"
+
+        // argument-expression-list ::=
+        //      assignment-expression
+        //      argument-expression-list "," assignment-expression
+
+        // If a call argument has been parsed, add to list and create call expression if it was the last
+        bool afterCall = false;
+        if(frame.stage == Frame::Stage::CALL_ARGUMENT) {
+            frame.arguments.emplace_back(std::move(expression));
+            if(m_ParserState.match(Token::Type::COMMA)) {
+                return parseOperand(frame, Frame::Stage::CALL_ARGUMENT, Production::ASSIGNMENT);
+            }
 
-Expression::ExpressionPtr parseXor(ParserState &parserState)
-{
-    // exclusive-OR-expression ::=
-    //      AND-expression
-    //      exclusive-OR-expression "^" AND-expression
-    return parseBinary(parserState, parseAnd, {Token::Type::CARET});
-}
+            const auto &closingParen = m_ParserState.consume(Token::Type::RIGHT_PAREN, "Expect ')' after arguments.");
+            expression = create<Expression::Call>(std::move(frame.left), getToken(closingParen), 
+                                                  std::move(frame.arguments));
+            frame.arguments.clear();
+            afterCall = true;
+        }
+        // Otherwise, if a subscript index has been parsed
+        else if(frame.stage == Frame::Stage::SUBSCRIPT_INDEX) {
+            const auto &closingSquareBracket = m_ParserState.consume(Token::Type::RIGHT_SQUARE_BRACKET, "Expect ']' after index.");
 
-Expression::ExpressionPtr parseOr(ParserState &parserState)
-{
-    // inclusive-OR-expression ::=
-    //      exclusive-OR-expression
-    //      inclusive-OR-expression "|" exclusive-OR-expression
-    return parseBinary(parserState, parseXor, {Token::Type::PIPE});
-}
+            // **TODO** everything all the way up(?) from unary are l-value so can be used - not just variable
+            auto expressionVariable = dynamic_cast<const Expression::Variable*>(frame.left.get());
+            if(expressionVariable) {
+                expression = create<Expression::ArraySubscript>(expressionVariable->getName(),
+                                                                std::move(expression));
+            }
+            else {
+                m_ParserState.error(closingSquareBracket, "Invalid subscript target");
+                expression = std::move(frame.left);
+            }
+        }
 
-Expression::ExpressionPtr parseLogicalAnd(ParserState &parserState)
-{
-    // logical-AND-expression ::=
-    //      inclusive-OR-expression
-    //      logical-AND-expression "&&" inclusive-OR-expression
-    // **THINK** parseLogicalAnd here (obviously) stack-overflows - why is this the grammar?
-    auto expression = parseOr(parserState);
+        while(true) {
+            // If this is a function call
+            if(!afterCall && m_ParserState.match(Token::Type::LEFT_PAREN)) {
+                // If there are arguments, parse first
+                if(!m_ParserState.check(Token::Type::RIGHT_PAREN)) {
+                    frame.left = std::move(expression);
+                    return parseOperand(frame, Frame::Stage::CALL_ARGUMENT, Production::ASSIGNMENT);
+                }
+
+                const auto &closingParen = m_ParserState.consume(Token::Type::RIGHT_PAREN, "Expect ')' after arguments.");
+                expression = create<Expression::Call>(std::move(expression), getToken(closingParen), 
+                                                      Expression::ExpressionList{});
+            }
+            afterCall = false;
 
-    while(parserState.match(Token::Type::AMPERSAND_AMPERSAND)) {
-        Token op = parserState.previous();
-        auto right = parseOr(parserState);
-        expression = std::make_unique<Expression::Logical>(std::move(expression), op, std::move(right));
+            // Otherwise, if this is an array index, parse index
+            if(m_ParserState.match(Token::Type::LEFT_SQUARE_BRACKET)) {
+                frame.left = std::move(expression);
+                return parseOperand(frame, Frame::Stage::SUBSCRIPT_INDEX, Production::EXPRESSION);
+            }
+            // Otherwise if this is an increment or decrement
+            else if(m_ParserState.match({Token::Type::PLUS_PLUS, Token::Type::MINUS_MINUS})) {
+                const auto &op = m_ParserState.previous();
+
+                // **TODO** everything all the way up(?) from unary are l-value so can be used - not just variable
+                auto expressionVariable = dynamic_cast<const Expression::Variable*>(expression.get());
+                if(expressionVariable) {
+                    expression = create<Expression::PostfixIncDec>(expressionVariable->getName(), getToken(op));
+                    return false;
+                }
+                else {
+                    m_ParserState.error(op, "Invalid postfix target");
+                }
+            }
+            else {
+                return false;
+            }
+        }
     }
-    return expression;
-}
 
-Expression::ExpressionPtr parseLogicalOr(ParserState &parserState)
-{
-    // logical-OR-expression ::=
-    //      logical-AND-expression
-    //      logical-OR-expression "||" logical-AND-expression
-    // **THINK** parseLogicalOr here (obviously) stack-overflows - why is this the grammar?
-    auto expression = parseLogicalAnd(parserState);
-
-    while(parserState.match(Token::Type::PIPE_PIPE)) {
-        Token op = parserState.previous();
-        auto right = parseLogicalAnd(parserState);
-        expression = std::make_unique<Expression::Logical>(std::move(expression), op, std::move(right));
-    }
-    return expression;
-}
+    //---------------------------------------------------------------------------
+    // Members
+    //---------------------------------------------------------------------------
+    ParserState<Tokens> &m_ParserState;
+    std::vector<Frame> m_Frames;
+    std::vector<Prefix> m_Prefixes;
+};
 
-Expression::ExpressionPtr parseConditional(ParserState &parserState)
+template<typename Tokens>
+Expression::ExpressionPtr parseConditional(ParserState<Tokens> &parserState)
 {
-    // conditional-expression ::=
-    //      logical-OR-expression
-    //      logical-OR-expression "?" expression ":" conditional-expression
-    auto cond = parseLogicalOr(parserState);
-    if(parserState.match(Token::Type::QUESTION)) {
-        Token question = parserState.previous();
-        auto trueExpression = parseExpression(parserState);
-        parserState.consume(Token::Type::COLON, "Expect ':' in conditional expression.");
-        auto falseExpression = parseConditional(parserState);
-        return std::make_unique<Expression::Conditional>(std::move(cond), question, std::move(trueExpression), 
-                                                         std::move(falseExpression));
-    }
-
-    return cond;
+    return ExpressionParser<Tokens>(parserState).parse(ExpressionParser<Tokens>::Production::CONDITIONAL);
 }
 
-Expression::ExpressionPtr parseAssignment(ParserState &parserState)
+template<typename Tokens>
+Expression::ExpressionPtr parseAssignment(ParserState<Tokens> &parserState)
 {
-    // assignment-expression ::=
-    //      conditional-expression
-    //      unary-expression assignment-operator assignment-expression
-    auto expression = parseConditional(parserState);
-    if(parserState.match({Token::Type::EQUAL, Token::Type::STAR_EQUAL, Token::Type::SLASH_EQUAL, 
-                          Token::Type::PERCENT_EQUAL, Token::Type::PLUS_EQUAL, Token::Type::MINUS_EQUAL, 
-                          Token::Type::AMPERSAND_EQUAL, Token::Type::CARET_EQUAL, Token::Type::PIPE_EQUAL,
-                          Token::Type::SHIFT_LEFT_EQUAL, Token::Type::SHIFT_RIGHT_EQUAL})) 
-    {
-        Token op = parserState.previous();
-        auto value = parseAssignment(parserState);
-
-        // **TODO** everything all the way up(?) from unary are l-value so can be used - not just variable
-        auto expressionVariable = dynamic_cast<const Expression::Variable*>(expression.get());
-        if(expressionVariable) {
-            return std::make_unique<Expression::Assignment>(expressionVariable->getName(), op, std::move(value));
-        }
-        else {
-            parserState.error(op, "Invalid assignment target");
-        }
-    }
-
-    return expression;
+    return ExpressionParser<Tokens>(parserState).parse(ExpressionParser<Tokens>::Production::ASSIGNMENT);
 }
 
-Expression::ExpressionPtr parseExpression(ParserState &parserState)
+template<typename Tokens>
+Expression::ExpressionPtr parseExpression(ParserState<Tokens> &parserState)
 {
-    // expression ::=
-    //      assignment-expression
-    //      expression "," assignment-expression
-    return parseBinary(parserState, parseAssignment, 
-                       {Token::Type::COMMA});
+    return ExpressionParser<Tokens>(parserState).parse(ExpressionParser<Tokens>::Production::EXPRESSION);
 }
 
-Statement::StatementPtr parseLabelledStatement(ParserState &parserState)
+template<typename Tokens>
+Statement::StatementPtr parseLabelledStatement(ParserState<Tokens> &parserState)
 {
     // labeled-statement ::=
     //      "case" constant-expression ":" statement
     //      "default" ":" statement
-    const auto keyword = parserState.previous();
+    const Token keyword = parserState.getToken(parserState.previous());
 
     Expression::ExpressionPtr value;
     if(keyword.type == Token::Type::CASE) {
@@ -555,11 +853,12 @@ Statement::StatementPtr parseLabelledStatement(ParserState &parserState)
 
     parserState.consume(Token::Type::COLON, "Expect ':' after labelled statement."); 
  
-    return std::make_unique<Statement::Labelled>(keyword, std::move(value), 
-                                                 parseStatement(parserState));
+    return parserState.template create<Statement::Labelled>(keyword, std::move(value), 
+                                                            parseStatement(parserState));
 }
 
-Statement::StatementPtr parseCompoundStatement(ParserState &parserState)
+template<typename Tokens>
+Statement::StatementPtr parseCompoundStatement(ParserState<Tokens> &parserState)
 {
     // compound-statement ::=
     //      "{" block-item-list? "}"
@@ -575,34 +874,37 @@ Statement::StatementPtr parseCompoundStatement(ParserState &parserState)
     }
     parserState.consume(Token::Type::RIGHT_BRACE, "Expect '}' after compound statement.");
 
-    return std::make_unique<Statement::Compound>(std::move(statements));
+    return parserState.template create<Statement::Compound>(std::move(statements));
 }
 
-Statement::StatementPtr parseExpressionStatement(ParserState &parserState)
+template<typename Tokens>
+Statement::StatementPtr parseExpressionStatement(ParserState<Tokens> &parserState)
 {
     //  expression-statement ::=
     //      expression? ";"
     auto expression = parseExpression(parserState);
     
     parserState.consume(Token::Type::SEMICOLON, "Expect ';' after expression");
-    return std::make_unique<Statement::Expression>(std::move(expression));
+    return parserState.template create<Statement::Expression>(std::move(expression));
 }
 
-Statement::StatementPtr parsePrintStatement(ParserState &parserState)
+template<typename Tokens>
+Statement::StatementPtr parsePrintStatement(ParserState<Tokens> &parserState)
 {
     auto expression = parseExpression(parserState);
 
     parserState.consume(Token::Type::SEMICOLON, "Expect ';' after expression");
-    return std::make_unique<Statement::Print>(std::move(expression));
+    return parserState.template create<Statement::Print>(std::move(expression));
 }
 
-Statement::StatementPtr parseSelectionStatement(ParserState &parserState)
+template<typename Tokens>
+Statement::StatementPtr parseSelectionStatement(ParserState<Tokens> &parserState)
 {
     // selection-statement ::=
     //      "if" "(" expression ")" statement
     //      "if" "(" expression ")" statement "else" statement
     //      "switch" "(" expression ")" compound-statement
-    const auto keyword = parserState.previous();
+    const Token keyword = parserState.getToken(parserState.previous());
     parserState.consume(Token::Type::LEFT_PAREN, "Expect '(' after '" + std::string{keyword.lexeme} + "'");
     auto condition = parseExpression(parserState);
     parserState.consume(Token::Type::RIGHT_PAREN, "Expect ')' after '" + std::string{keyword.lexeme} + "'");
@@ -615,20 +917,21 @@ Statement::StatementPtr parseSelectionStatement(ParserState &parserState)
             elseBranch = parseStatement(parserState);
         }
 
-        return std::make_unique<Statement::If>(std::move(condition),
-                                               std::move(thenBranch),
-                                               std::move(elseBranch));
+        return parserState.template create<Statement::If>(std::move(condition),
+                                                          std::move(thenBranch),
+                                                          std::move(elseBranch));
     }
     // Otherwise (switch statement)
     else {
         // **NOTE** this is a slight simplification of the C standard where any type of statement can be used as the body of the switch
         parserState.consume(Token::Type::LEFT_BRACE, "Expect '{' after switch statement.");
         auto body = parseCompoundStatement(parserState);
-        return std::make_unique<Statement::Switch>(keyword, std::move(condition), std::move(body));
+        return parserState.template create<Statement::Switch>(keyword, std::move(condition), std::move(body));
     }
 }
 
-Statement::StatementPtr parseIterationStatement(ParserState &parserState)
+template<typename Tokens>
+Statement::StatementPtr parseIterationStatement(ParserState<Tokens> &parserState)
 {
     // iteration-statement ::=
     //      "while" "(" expression ")" statement
@@ -643,8 +946,8 @@ Statement::StatementPtr parseIterationStatement(ParserState &parserState)
         parserState.consume(Token::Type::RIGHT_PAREN, "Expect ')' after 'while'");
         auto body = parseStatement(parserState);
 
-        return std::make_unique<Statement::While>(std::move(condition), 
-                                                  std::move(body));
+        return parserState.template create<Statement::While>(std::move(condition), 
+                                                             std::move(body));
     }
     // Otherwise, if this is a do statement 
     else if(parserState.previous().type == Token::Type::DO) {
@@ -654,8 +957,8 @@ Statement::StatementPtr parseIterationStatement(ParserState &parserState)
         auto condition = parseExpression(parserState);
         parserState.consume(Token::Type::RIGHT_PAREN, "Expect ')' after 'while'");
         parserState.consume(Token::Type::SEMICOLON, "Expect ';' after while");
-        return std::make_unique<Statement::Do>(std::move(condition), 
-                                               std::move(body));
+        return parserState.template create<Statement::Do>(std::move(condition), 
+                                                          std::move(body));
     }
     // Otherwise, it's a for statement
     else {
@@ -693,27 +996,28 @@ Statement::StatementPtr parseIterationStatement(ParserState &parserState)
 
         // Return for statement
         // **NOTE** we could "de-sugar" into a while statement but this makes pretty-printing easier
-        return std::make_unique<Statement::For>(std::move(initialiser), 
-                                                std::move(condition),
-                                                std::move(increment),
-                                                std::move(body));
+        return parserState.template create<Statement::For>(std::move(initialiser), 
+                                                           std::move(condition),
+                                                           std::move(increment),
+                                                           std::move(body));
     }
 }
 
-Statement::StatementPtr parseJumpStatement(ParserState &parserState)
+template<typename Tokens>
+Statement::StatementPtr parseJumpStatement(ParserState<Tokens> &parserState)
 {
     // jump-statement ::=
     //      "continue" ";"
     //      "break" ";"
     //      "return" expression? ";"    // **TODO**
-    const Token token = parserState.previous();
+    const auto &token = parserState.previous();
     if(token.type == Token::Type::CONTINUE) {
         parserState.consume(Token::Type::SEMICOLON, "Expect ';' after continue");
-        return std::make_unique<Statement::Continue>(token);
+        return parserState.template create<Statement::Continue>(parserState.getToken(token));
     }
     else if(token.type == Token::Type::BREAK) {
         parserState.consume(Token::Type::SEMICOLON, "Expect ';' after break");
-        return std::make_unique<Statement::Break>(token);
+        return parserState.template create<Statement::Break>(parserState.getToken(token));
     }
     // Otherwise (return statement)
     else {
@@ -722,7 +1026,8 @@ Statement::StatementPtr parseJumpStatement(ParserState &parserState)
     }
 }
 
-Statement::StatementPtr parseStatement(ParserState &parserState)
+template<typename Tokens>
+Statement::StatementPtr parseStatement(ParserState<Tokens> &parserState)
 {
     // statement ::=
     //      labeled-statement
@@ -755,7 +1060,8 @@ Statement::StatementPtr parseStatement(ParserState &parserState)
     }
 }
 
-Statement::StatementPtr parseDeclaration(ParserState &parserState)
+template<typename Tokens>
+Statement::StatementPtr parseDeclaration(ParserState<Tokens> &parserState)
 {
     // declaration ::=
     //      declaration-specifiers init-declarator-list? ";"
@@ -796,23 +1102,28 @@ Statement::StatementPtr parseDeclaration(ParserState &parserState)
 
         // declarator ::=
         //      identifier
-        Token identifier = parserState.consume(Token::Type::IDENTIFIER, "Expect variable name");
+        const auto &identifier = parserState.consume(Token::Type::IDENTIFIER, "Expect variable name");
         Expression::ExpressionPtr initialiser;
         if(parserState.match(Token::Type::EQUAL)) {
             initialiser = parseAssignment(parserState);
         }
-        initDeclaratorList.emplace_back(identifier, std::move(initialiser));
+        initDeclaratorList.emplace_back(parserState.getToken(identifier), std::move(initialiser));
     } while(!parserState.isAtEnd() && parserState.match(Token::Type::COMMA));
 
     parserState.consume(Token::Type::SEMICOLON, "Expect ';' after variable declaration");
-    return std::make_unique<Statement::VarDeclaration>(type, isConst, std::move(initDeclaratorList));
+    return parserState.template create<Statement::VarDeclaration>(type, isConst, std::move(initDeclaratorList));
 }
 
-std::unique_ptr<const Statement::Base> parseBlockItem(ParserState &parserState)
+template<typename Tokens>
+Statement::StatementPtr parseBlockItem(ParserState<Tokens> &parserState)
 {
     // block-item ::=
     //      declaration
     //      statement
+
+    // **NOTE** block items are never nested within expressions and any tokens 
+    // statements they're nested in retain are copied so earlier tokens can be released
+    parserState.releaseTokens();
     try {
         if(parserState.match({Token::Type::TYPE_SPECIFIER, Token::Type::TYPE_QUALIFIER})) {
             return parseDeclaration(parserState);
@@ -826,6 +1137,16 @@ std::unique_ptr<const Statement::Base> parseBlockItem(ParserState &parserState)
         return nullptr;
     }
 }
+
+template<typename Tokens>
+Statement::StatementList parseBlockItemList(ParserState<Tokens> &parserState)
+{
+    Statement::StatementList statements;
+    while(!parserState.isAtEnd()) {
+        statements.emplace_back(parseBlockItem(parserState));
+    }
+    return statements;
+}
 }   // Anonymous namespace
 
 
@@ -837,7 +1158,6 @@ namespace MiniParse::Parser
 Expression::ExpressionPtr parseExpression(const std::vector<Token> &tokens, ErrorHandler &errorHandler)
 {
     ParserState parserState(tokens, errorHandler);
-
     try {
         return parseExpression(parserState);
     }
@@ -845,15 +1165,95 @@ Expression::ExpressionPtr parseExpression(const std::vector<Token> &tokens, Erro
         return nullptr;
     }
 }
-
+//---------------------------------------------------------------------------
+Expression::ExpressionPtr parseExpression(const std::vector<Token> &tokens, ErrorHandler &errorHandler, Arena &arena)
+{
+    ParserState parserState(tokens, errorHandler, &arena);
+    try {
+        return parseExpression(parserState);
+    }
+    catch(ParseError &) {
+        return nullptr;
+    }
+}
+//---------------------------------------------------------------------------
 Statement::StatementList parseBlockItemList(const std::vector<Token> &tokens, ErrorHandler &errorHandler)
 {
     ParserState parserState(tokens, errorHandler);
-    std::vector<std::unique_ptr<const Statement::Base>> statements;
-
-    while(!parserState.isAtEnd()) {
-        statements.emplace_back(parseBlockItem(parserState));
+    return parseBlockItemList(parserState);
+}
+//---------------------------------------------------------------------------
+Statement::StatementList parseBlockItemList(const std::vector<Token> &tokens, ErrorHandler &errorHandler, Arena &arena)
+{
+    ParserState parserState(tokens, errorHandler, &arena);
+    return parseBlockItemList(parserState);
+}
+//---------------------------------------------------------------------------
+Expression::ExpressionPtr parseExpression(const TokenStream &tokens, ErrorHandler &errorHandler)
+{
+    ParserState parserState(tokens, errorHandler);
+    try {
+        return parseExpression(parserState);
     }
-    return statements;
+    catch(ParseError &) {
+        return nullptr;
+    }
+}
+//---------------------------------------------------------------------------
+Expression::ExpressionPtr parseExpression(const TokenStream &tokens, ErrorHandler &errorHandler, Arena &arena)
+{
+    ParserState parserState(tokens, errorHandler, &arena);
+    try {
+        return parseExpression(parserState);
+    }
+    catch(ParseError &) {
+        return nullptr;
+    }
+}
+//---------------------------------------------------------------------------
+Statement::StatementList parseBlockItemList(const TokenStream &tokens, ErrorHandler &errorHandler)
+{
+    ParserState parserState(tokens, errorHandler);
+    return parseBlockItemList(parserState);
+}
+//---------------------------------------------------------------------------
+Statement::StatementList parseBlockItemList(const TokenStream &tokens, ErrorHandler &errorHandler, Arena &arena)
+{
+    ParserState parserState(tokens, errorHandler, &arena);
+    return parseBlockItemList(parserState);
+}
+//---------------------------------------------------------------------------
+Expression::ExpressionPtr parseExpression(Scanner::TokenCursor &tokens, ErrorHandler &errorHandler)
+{
+    ParserState parserState(tokens, errorHandler);
+    try {
+        return parseExpression(parserState);
+    }
+    catch(ParseError &) {
+        return nullptr;
+    }
+}
+//---------------------------------------------------------------------------
+Expression::ExpressionPtr parseExpression(Scanner::TokenCursor &tokens, ErrorHandler &errorHandler, Arena &arena)
+{
+    ParserState parserState(tokens, errorHandler, &arena);
+    try {
+        return parseExpression(parserState);
+    }
+    catch(ParseError &) {
+        return nullptr;
+    }
+}
+//---------------------------------------------------------------------------
+Statement::StatementList parseBlockItemList(Scanner::TokenCursor &tokens, ErrorHandler &errorHandler)
+{
+    ParserState parserState(tokens, errorHandler);
+    return parseBlockItemList(parserState);
+}
+//---------------------------------------------------------------------------
+Statement::StatementList parseBlockItemList(Scanner::TokenCursor &tokens, ErrorHandler &errorHandler, Arena &arena)
+{
+    ParserState parserState(tokens, errorHandler, &arena);
+    return parseBlockItemList(parserState);
 }
 }
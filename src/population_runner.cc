@@ -0,0 +1,85 @@
+#include "population_runner.h"
+
+// Standard C++ includes
+#include <algorithm>
+
+using namespace MiniParse::Interpreter;
+
+//---------------------------------------------------------------------------
+// MiniParse::Interpreter::PopulationRunner::Worker
+//---------------------------------------------------------------------------
+struct PopulationRunner::Worker
+{
+    Worker(const Statement::StatementList &statements, Environment &globals,
+           const TypeChecker::Resolution &resolution)
+    :   environment(&globals), executor(statements, environment, resolution)
+    {}
+
+    //! Environment holding values of the instance being executed, enclosed by shared globals
+    Environment environment;
+    Executor executor;
+
+    //! Values of bound variables in environment, in the same order as bindings
+    std::vector<Environment::Value*> values;
+};
+
+//---------------------------------------------------------------------------
+// MiniParse::Interpreter::PopulationRunner
+//---------------------------------------------------------------------------
+PopulationRunner::PopulationRunner(const Statement::StatementList &statements, Environment &globals,
+                                   const TypeChecker::Resolution &resolution, size_t numThreads)
+:   m_Statements(statements), m_Globals(globals), m_Resolution(resolution), m_Pool(std::max<size_t>(1, numThreads))
+{
+    // Create state for each of the pool's workers
+    for(size_t i = 0; i < m_Pool.getNumThreads(); i++) {
+        m_Workers.push_back(std::make_unique<Worker>(m_Statements, m_Globals, m_Resolution));
+    }
+}
+//---------------------------------------------------------------------------
+PopulationRunner::~PopulationRunner() = default;
+//---------------------------------------------------------------------------
+void PopulationRunner::run(size_t numInstances)
+{
+    m_Pool.run(numInstances,
+               [this](size_t instance, size_t worker)
+               {
+                   runInstance(*m_Workers[worker], instance);
+               });
+}
+//---------------------------------------------------------------------------
+void PopulationRunner::addBinding(std::string_view name, void *values, LoadFunction load, StoreFunction store)
+{
+    // If variable is already bound, update binding
+    // **NOTE** workers are idle between runs so their state can be updated directly
+    auto binding = std::find_if(m_Bindings.begin(), m_Bindings.end(),
+                                [name](const auto &b) { return b.name == name; });
+    if(binding != m_Bindings.end()) {
+        binding->values = values;
+        binding->load = load;
+        binding->store = store;
+    }
+    // Otherwise, add binding and define variable in each worker's environment
+    // **NOTE** variable may hide one in globals which executors have already bound to so these are invalidated
+    else {
+        const auto &b = m_Bindings.emplace_back(Binding{std::string{name}, values, load, store});
+        const Token token(Token::Type::IDENTIFIER, b.name, 0, Token::LiteralValue(), m_Globals.getSymbolTable().intern(b.name));
+        for(auto &w : m_Workers) {
+            w->environment.define(token, Token::LiteralValue{});
+            w->values.push_back(&w->environment.getValue(token));
+            w->executor.invalidateGlobals();
+        }
+    }
+}
+//---------------------------------------------------------------------------
+void PopulationRunner::runInstance(Worker &worker, size_t instance)
+{
+    for(size_t b = 0; b < m_Bindings.size(); b++) {
+        *worker.values[b] = m_Bindings[b].load(m_Bindings[b].values, instance);
+    }
+
+    worker.executor.execute();
+
+    for(size_t b = 0; b < m_Bindings.size(); b++) {
+        m_Bindings[b].store(m_Bindings[b].values, instance, std::get<Token::LiteralValue>(*worker.values[b]));
+    }
+}
@@ -1,11 +1,17 @@
 #include "pretty_printer.h"
 
 // Standard C++ includes
+#include <charconv>
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <type_traits>
+
+// Standard C includes
+#include <cmath>
 
 // Mini-parse includes
+#include "flat_ast.h"
 #include "type.h"
 #include "utils.h"
 
@@ -18,6 +24,62 @@ using namespace MiniParse::PrettyPrinter;
 //---------------------------------------------------------------------------
 namespace
 {
+//! Write floating point value as a C++ expression of type T. Finite values are written in shortest form
+//! which round-trips, always including a decimal point or exponent and a suffix for float. Non-finite
+//! values have no literal form so are written using std::numeric_limits
+template<typename T>
+void printFloat(std::ostream &stream, T value)
+{
+    constexpr const char *typeName = std::is_same_v<T, float> ? "float" : "double";
+    if(!std::isfinite(value)) {
+        // **NOTE** negative values are parenthesised so a preceding unary minus can't form a decrement
+        const char *constant = std::isnan(value) ? "quiet_NaN()" : "infinity()";
+        if(std::signbit(value)) {
+            stream << "(-std::numeric_limits<" << typeName << ">::" << constant << ")";
+        }
+        else {
+            stream << "std::numeric_limits<" << typeName << ">::" << constant;
+        }
+    }
+    else {
+        char buffer[64];
+        const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        const std::string_view chars(buffer, result.ptr - buffer);
+        stream << chars;
+        if(chars.find_first_of(".e") == std::string_view::npos) {
+            stream << ".0";
+        }
+        if constexpr(std::is_same_v<T, float>) {
+            stream << "f";
+        }
+    }
+}
+
+//! Write literal with suffix so it retains its type when compiled as C++
+void printLiteral(std::ostream &stream, const Token::LiteralValue &value)
+{
+    std::visit(
+        Utils::Overload{
+            [&stream](auto x) 
+            {
+                using T = decltype(x);
+                if constexpr(std::is_same_v<T, bool>) {
+                    stream << (x ? "true" : "false");
+                }
+                else if constexpr(std::is_floating_point_v<T>) {
+                    printFloat(stream, x);
+                }
+                else {
+                    stream << x;
+                    if constexpr(std::is_unsigned_v<T>) {
+                        stream << "u";
+                    }
+                }
+            },
+            [&stream](std::monostate) { stream << "invalid"; }},
+        value);
+}
+
 //---------------------------------------------------------------------------
 // Visitor
 //---------------------------------------------------------------------------
@@ -68,8 +130,11 @@ public:
     {
         call.getCallee()->accept(*this);
         m_StringStream << "(";
-        for(const auto &a : call.getArguments()) {
-            a->accept(*this);
+        for(size_t i = 0; i < call.getArguments().size(); i++) {
+            if(i != 0) {
+                m_StringStream << ", ";
+            }
+            call.getArguments()[i]->accept(*this);
         }
         m_StringStream << ")";
     }
@@ -98,11 +163,7 @@ public:
 
     virtual void visit(const Expression::Literal &literal) final
     {
-        std::visit(
-            Utils::Overload{
-                [this](auto x) { m_StringStream << x; },
-                [this](std::monostate) { m_StringStream << "invalid"; }},
-            literal.getValue());
+        printLiteral(m_StringStream, literal.getValue());
     }
 
     virtual void visit(const Expression::Logical &logical) final
@@ -129,7 +190,13 @@ public:
 
     virtual void visit(const Expression::Unary &unary) final
     {
+        // Separate nested operators so, for example, '- -x' isn't printed as a decrement
         m_StringStream << unary.getOperator().lexeme;
+        if(dynamic_cast<const Expression::Unary*>(unary.getRight())
+           || dynamic_cast<const Expression::PrefixIncDec*>(unary.getRight()))
+        {
+            m_StringStream << " ";
+        }
         unary.getRight()->accept(*this);
     }
     
@@ -231,13 +298,16 @@ public:
         }
         m_StringStream << varDeclaration.getType()->getTypeName() << " ";
 
-        for(const auto &var : varDeclaration.getInitDeclaratorList()) {
-            m_StringStream << std::get<0>(var).lexeme;
-            if(std::get<1>(var)) {
+        const auto &initDeclaratorList = varDeclaration.getInitDeclaratorList();
+        for(size_t i = 0; i < initDeclaratorList.size(); i++) {
+            if(i != 0) {
+                m_StringStream << ", ";
+            }
+            m_StringStream << std::get<0>(initDeclaratorList[i]).lexeme;
+            if(std::get<1>(initDeclaratorList[i])) {
                 m_StringStream << " = ";
-                std::get<1>(var)->accept(*this);
+                std::get<1>(initDeclaratorList[i])->accept(*this);
             }
-            m_StringStream << ", ";
         }
         m_StringStream << ";";
     }
@@ -252,15 +322,276 @@ public:
 
     virtual void visit(const Statement::Print &print) final
     {
-        m_StringStream << "print ";
+        m_StringStream << "print(";
         print.getExpression()->accept(*this);
+        m_StringStream << ");";
+    }
+
+private:
+    //---------------------------------------------------------------------------
+    // Members
+    //---------------------------------------------------------------------------
+    std::ostringstream m_StringStream;
+};
+
+//---------------------------------------------------------------------------
+// FlatVisitor
+//---------------------------------------------------------------------------
+//! Port of Visitor onto FlatAST::Tree which gives identical output
+class FlatVisitor : public FlatAST::ExpressionVisitor, public FlatAST::StatementVisitor
+{
+public:
+    FlatVisitor(const FlatAST::Tree &tree) : m_Tree(tree)
+    {}
+
+    //---------------------------------------------------------------------------
+    // Public API
+    //---------------------------------------------------------------------------
+    std::string print()
+    {
+        // Clear string stream
+        m_StringStream.str("");
+
+        for(const auto s : m_Tree.getStatements()) {
+            m_Tree.accept(s, *this);
+            m_StringStream << std::endl;
+        }
+
+        // Return string stream contents
+        return m_StringStream.str();
+    }
+
+    //---------------------------------------------------------------------------
+    // FlatAST::ExpressionVisitor virtuals
+    //---------------------------------------------------------------------------
+    virtual void visitArraySubscript(FlatAST::ExpressionIndex arraySubscript) final
+    {
+        m_StringStream << m_Tree.getName(arraySubscript).lexeme << "[";
+        m_Tree.accept(m_Tree.getIndex(arraySubscript), *this);
+        m_StringStream << "]";
+    }
+
+    virtual void visitAssignment(FlatAST::ExpressionIndex assignment) final
+    {
+        m_StringStream << m_Tree.getName(assignment).lexeme << " " << m_Tree.getOperator(assignment).lexeme << " ";
+        m_Tree.accept(m_Tree.getValue(assignment), *this);
+    }
+
+    virtual void visitBinary(FlatAST::ExpressionIndex binary) final
+    {
+        m_Tree.accept(m_Tree.getLeft(binary), *this);
+        m_StringStream << " " << m_Tree.getOperator(binary).lexeme << " ";
+        m_Tree.accept(m_Tree.getRight(binary), *this);
+    }
+
+    virtual void visitCall(FlatAST::ExpressionIndex call) final
+    {
+        m_Tree.accept(m_Tree.getCallee(call), *this);
+        m_StringStream << "(";
+        const auto arguments = m_Tree.getArguments(call);
+        for(size_t i = 0; i < arguments.size(); i++) {
+            if(i != 0) {
+                m_StringStream << ", ";
+            }
+            m_Tree.accept(arguments[i], *this);
+        }
+        m_StringStream << ")";
+    }
+
+    virtual void visitCast(FlatAST::ExpressionIndex cast) final
+    {
+        m_StringStream << "(" << m_Tree.getCastType(cast)->getTypeName() << ")";
+        m_Tree.accept(m_Tree.getExpression(cast), *this);
+    }
+
+    virtual void visitConditional(FlatAST::ExpressionIndex conditional) final
+    {
+        m_Tree.accept(m_Tree.getCondition(conditional), *this);
+        m_StringStream << " ? ";
+        m_Tree.accept(m_Tree.getTrue(conditional), *this);
+        m_StringStream << " : ";
+        m_Tree.accept(m_Tree.getFalse(conditional), *this);
+    }
+
+    virtual void visitGrouping(FlatAST::ExpressionIndex grouping) final
+    {
+        m_StringStream << "(";
+        m_Tree.accept(m_Tree.getExpression(grouping), *this);
+        m_StringStream << ")";
+    }
+
+    virtual void visitLiteral(FlatAST::ExpressionIndex literal) final
+    {
+        printLiteral(m_StringStream, m_Tree.getLiteral(literal));
+    }
+
+    virtual void visitLogical(FlatAST::ExpressionIndex logical) final
+    {
+        m_Tree.accept(m_Tree.getLeft(logical), *this);
+        m_StringStream << " " << m_Tree.getOperator(logical).lexeme << " ";
+        m_Tree.accept(m_Tree.getRight(logical), *this);
+    }
+
+    virtual void visitPostfixIncDec(FlatAST::ExpressionIndex postfixIncDec) final
+    {
+        m_StringStream << m_Tree.getName(postfixIncDec).lexeme << m_Tree.getOperator(postfixIncDec).lexeme;
+    }
+
+    virtual void visitPrefixIncDec(FlatAST::ExpressionIndex prefixIncDec) final
+    {
+        m_StringStream << m_Tree.getOperator(prefixIncDec).lexeme << m_Tree.getName(prefixIncDec).lexeme;
+    }
+
+    virtual void visitVariable(FlatAST::ExpressionIndex variable) final
+    {
+        m_StringStream << m_Tree.getName(variable).lexeme;
+    }
+
+    virtual void visitUnary(FlatAST::ExpressionIndex unary) final
+    {
+        // Separate nested operators so, for example, '- -x' isn't printed as a decrement
+        m_StringStream << m_Tree.getOperator(unary).lexeme;
+        const auto right = m_Tree.getRight(unary);
+        if(m_Tree.getKind(right) == FlatAST::ExpressionKind::UNARY
+           || m_Tree.getKind(right) == FlatAST::ExpressionKind::PREFIX_INC_DEC)
+        {
+            m_StringStream << " ";
+        }
+        m_Tree.accept(right, *this);
+    }
+
+    //---------------------------------------------------------------------------
+    // FlatAST::StatementVisitor virtuals
+    //---------------------------------------------------------------------------
+    virtual void visitBreak(FlatAST::StatementIndex) final
+    {
+        m_StringStream << "break;";
+    }
+
+    virtual void visitCompound(FlatAST::StatementIndex compound) final
+    {
+        m_StringStream << "{" << std::endl;
+        for(const auto s : m_Tree.getStatements(compound)) {
+            m_Tree.accept(s, *this);
+            m_StringStream << std::endl;
+        }
+        m_StringStream << "}" << std::endl;
+    }
+
+    virtual void visitContinue(FlatAST::StatementIndex) final
+    {
+        m_StringStream << "continue;";
+    }
+
+    virtual void visitDo(FlatAST::StatementIndex doStatement) final
+    {
+        m_StringStream << "do";
+        m_Tree.accept(m_Tree.getBody(doStatement), *this);
+        m_StringStream << "while(";
+        m_Tree.accept(m_Tree.getCondition(doStatement), *this);
+        m_StringStream << ");" << std::endl;
+    }
+
+    virtual void visitExpression(FlatAST::StatementIndex expression) final
+    {
+        m_Tree.accept(m_Tree.getExpression(expression), *this);
         m_StringStream << ";";
     }
 
+    virtual void visitFor(FlatAST::StatementIndex forStatement) final
+    {
+        m_StringStream << "for(";
+        if(m_Tree.getInitialiser(forStatement) != FlatAST::noStatement) {
+            m_Tree.accept(m_Tree.getInitialiser(forStatement), *this);
+        }
+        else {
+            m_StringStream << ";";
+        }
+        m_StringStream << " ";
+
+        if(m_Tree.getCondition(forStatement) != FlatAST::noExpression) {
+            m_Tree.accept(m_Tree.getCondition(forStatement), *this);
+        }
+
+        m_StringStream << "; ";
+        if(m_Tree.getIncrement(forStatement) != FlatAST::noExpression) {
+            m_Tree.accept(m_Tree.getIncrement(forStatement), *this);
+        }
+        m_StringStream << ")";
+        m_Tree.accept(m_Tree.getBody(forStatement), *this);
+    }
+
+    virtual void visitIf(FlatAST::StatementIndex ifStatement) final
+    {
+        m_StringStream << "if(";
+        m_Tree.accept(m_Tree.getCondition(ifStatement), *this);
+        m_StringStream << ")" << std::endl;
+        m_Tree.accept(m_Tree.getThenBranch(ifStatement), *this);
+        if(m_Tree.getElseBranch(ifStatement) != FlatAST::noStatement) {
+            m_StringStream << "else" << std::endl;
+            m_Tree.accept(m_Tree.getElseBranch(ifStatement), *this);
+        }
+    }
+
+    virtual void visitLabelled(FlatAST::StatementIndex labelled) final
+    {
+        m_StringStream << m_Tree.getToken(labelled).lexeme << " ";
+        if(m_Tree.getValue(labelled) != FlatAST::noExpression) {
+            m_Tree.accept(m_Tree.getValue(labelled), *this);
+        }
+        m_StringStream << " : ";
+        m_Tree.accept(m_Tree.getBody(labelled), *this);
+    }
+
+    virtual void visitSwitch(FlatAST::StatementIndex switchStatement) final
+    {
+        m_StringStream << "switch(";
+        m_Tree.accept(m_Tree.getCondition(switchStatement), *this);
+        m_StringStream << ")" << std::endl;
+        m_Tree.accept(m_Tree.getBody(switchStatement), *this);
+    }
+
+    virtual void visitVarDeclaration(FlatAST::StatementIndex varDeclaration) final
+    {
+        if(m_Tree.isConst(varDeclaration)) {
+            m_StringStream << "const ";
+        }
+        m_StringStream << m_Tree.getType(varDeclaration)->getTypeName() << " ";
+
+        const auto initDeclaratorList = m_Tree.getInitDeclaratorList(varDeclaration);
+        for(size_t i = 0; i < initDeclaratorList.size(); i++) {
+            if(i != 0) {
+                m_StringStream << ", ";
+            }
+            m_StringStream << m_Tree.getToken(initDeclaratorList[i].name).lexeme;
+            if(initDeclaratorList[i].initialiser != FlatAST::noExpression) {
+                m_StringStream << " = ";
+                m_Tree.accept(initDeclaratorList[i].initialiser, *this);
+            }
+        }
+        m_StringStream << ";";
+    }
+
+    virtual void visitWhile(FlatAST::StatementIndex whileStatement) final
+    {
+        m_StringStream << "while(";
+        m_Tree.accept(m_Tree.getCondition(whileStatement), *this);
+        m_StringStream << ")" << std::endl;
+        m_Tree.accept(m_Tree.getBody(whileStatement), *this);
+    }
+
+    virtual void visitPrint(FlatAST::StatementIndex print) final
+    {
+        m_StringStream << "print(";
+        m_Tree.accept(m_Tree.getExpression(print), *this);
+        m_StringStream << ");";
+    }
+
 private:
     //---------------------------------------------------------------------------
     // Members
     //---------------------------------------------------------------------------
+    const FlatAST::Tree &m_Tree;
     std::ostringstream m_StringStream;
 };
 }   // Anonymous namespace
@@ -270,3 +601,9 @@ std::string MiniParse::PrettyPrinter::print(const Statement::StatementList &stat
     Visitor visitor;
     return visitor.print(statements);
 }
+//---------------------------------------------------------------------------
+std::string MiniParse::PrettyPrinter::print(const FlatAST::Tree &tree)
+{
+    FlatVisitor visitor(tree);
+    return visitor.print();
+}
@@ -1,28 +1,62 @@
 #include "scanner.h"
 
 // Standard C++ includes
+#include <algorithm>
+#include <array>
 #include <charconv>
-#include <functional>
-#include <map>
-#include <set>
-#include <unordered_map>
+#include <exception>
+#include <iterator>
+#include <numeric>
+#include <thread>
 
 // Standard C includes
+#include <cassert>
 #include <cctype>
+#include <cstdint>
 
 // Mini-parse includes
 #include "error_handler.h"
+#include "token_stream.h"
 #include "utils.h"
 
 using namespace MiniParse;
 using namespace MiniParse::Scanner;
 
+//---------------------------------------------------------------------------
+// Macros
+//---------------------------------------------------------------------------
+// Skip runs of whitespace and identifier characters a vector at a time. The instruction set is chosen
+// at compile time so AVX2 kernels are only used if the compiler targets it e.g. with -mavx2 or /arch:AVX2
+// **NOTE** every x86-64 CPU supports SSE2 but MSVC doesn't define __SSE2__
+#if defined(__AVX2__)
+    #define MINI_PARSE_SCAN_AVX2
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define MINI_PARSE_SCAN_SSE2
+#endif
+
+#if defined(MINI_PARSE_SCAN_AVX2)
+    #include <immintrin.h>
+#elif defined(MINI_PARSE_SCAN_SSE2)
+    #include <emmintrin.h>
+#endif
+
+#if defined(MINI_PARSE_SCAN_SSE2) && defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
 //---------------------------------------------------------------------------
 // Anonymous namespace
 //---------------------------------------------------------------------------
 namespace
 {
-const std::unordered_map<std::string_view, Token::Type> keywords{
+struct Keyword
+{
+    std::string_view lexeme;
+    Token::Type type;
+};
+
+constexpr std::array<Keyword, 23> keywords{{
     {"const", Token::Type::TYPE_QUALIFIER},
     {"do", Token::Type::DO},
     {"else", Token::Type::ELSE},
@@ -45,12 +79,229 @@ const std::unordered_map<std::string_view, Token::Type> keywords{
     {"double", Token::Type::TYPE_SPECIFIER},
     {"signed", Token::Type::TYPE_SPECIFIER},
     {"unsigned", Token::Type::TYPE_SPECIFIER},
-    {"bool", Token::Type::TYPE_SPECIFIER}};
+    {"bool", Token::Type::TYPE_SPECIFIER}}};
 //---------------------------------------------------------------------------
-const std::map<std::set<char>, std::function<Token::LiteralValue(std::string_view, int)>> integerLiteralSuffixParsers{
-    {{}, [](std::string_view input, int base) { return Utils::toCharsThrow<int32_t>(input, base); }},
-    {{'U'}, [](std::string_view input, int base) { return Utils::toCharsThrow<uint32_t>(input, base); }},
+// Keyword perfect hash
+//---------------------------------------------------------------------------
+constexpr size_t keywordTableSize = 64;
+
+//! Hash lexeme from its first and last characters and length
+constexpr size_t hashKeyword(std::string_view lexeme, uint32_t seed)
+{
+    const uint32_t first = static_cast<unsigned char>(lexeme.front());
+    const uint32_t last = static_cast<unsigned char>(lexeme.back());
+    return (((first * seed) + last) * seed + static_cast<uint32_t>(lexeme.size())) & (keywordTableSize - 1);
+}
+
+//! Seed with which hashKeyword maps every keyword to a different slot of the keyword table
+constexpr uint32_t keywordSeed = []()
+{
+    for(uint32_t seed = 1;; seed++) {
+        std::array<bool, keywordTableSize> occupied{};
+        bool collision = false;
+        for(const auto &k : keywords) {
+            const size_t slot = hashKeyword(k.lexeme, seed);
+            collision |= occupied[slot];
+            occupied[slot] = true;
+        }
+        if(!collision) {
+            return seed;
+        }
+    }
+}();
+
+//! Keywords in the slots they hash to, empty slots have an empty lexeme
+constexpr auto keywordTable = []()
+{
+    std::array<Keyword, keywordTableSize> table{};
+    for(const auto &k : keywords) {
+        table[hashKeyword(k.lexeme, keywordSeed)] = k;
+    }
+    return table;
+}();
+//---------------------------------------------------------------------------
+//! Get type of token identifier should be scanned as
+Token::Type getIdentifierType(std::string_view lexeme)
+{
+    // **NOTE** only need to compare against the one keyword with matching hash
+    const auto &k = keywordTable[hashKeyword(lexeme, keywordSeed)];
+    return (k.lexeme == lexeme) ? k.type : Token::Type::IDENTIFIER;
+}
+//---------------------------------------------------------------------------
+// Integer literal suffixes
+//---------------------------------------------------------------------------
+enum IntegerLiteralSuffix : uint8_t
+{
+    SUFFIX_U    = (1 << 0),
+    SUFFIX_L    = (1 << 1),
 };
+
+//! Parsers for integer literals, indexed by set of suffixes. Unsupported sets of suffixes have no parser
+constexpr std::array<Token::LiteralValue(*)(std::string_view, int), 4> integerLiteralSuffixParsers{
+    [](std::string_view input, int base) { return Token::LiteralValue(Utils::toCharsThrow<int32_t>(input, base)); },
+    [](std::string_view input, int base) { return Token::LiteralValue(Utils::toCharsThrow<uint32_t>(input, base)); },
+    nullptr,
+    nullptr};
+//---------------------------------------------------------------------------
+// Character classes
+//---------------------------------------------------------------------------
+enum CharClass : uint8_t
+{
+    DIGIT               = (1 << 0),
+    HEX_DIGIT           = (1 << 1),
+    IDENTIFIER_START    = (1 << 2),
+    IDENTIFIER          = (1 << 3),
+    WHITESPACE          = (1 << 4),
+};
+
+//! Classes of each character, indexed by unsigned value so, unlike the <cctype> functions,
+//! lookups are independent of locale and well-defined for characters outside of ASCII.
+//! **NOTE** new lines aren't WHITESPACE as they need counting
+constexpr auto charClasses = []()
+{
+    std::array<uint8_t, 256> classes{};
+    for(int c = '0'; c <= '9'; c++) {
+        classes[c] |= DIGIT | HEX_DIGIT | IDENTIFIER;
+    }
+    for(int c = 'a'; c <= 'z'; c++) {
+        classes[c] |= IDENTIFIER_START | IDENTIFIER;
+        classes[c - 'a' + 'A'] |= IDENTIFIER_START | IDENTIFIER;
+    }
+    for(int c = 'a'; c <= 'f'; c++) {
+        classes[c] |= HEX_DIGIT;
+        classes[c - 'a' + 'A'] |= HEX_DIGIT;
+    }
+    classes['_'] |= IDENTIFIER_START | IDENTIFIER;
+    classes[' '] |= WHITESPACE;
+    classes['\t'] |= WHITESPACE;
+    classes['\r'] |= WHITESPACE;
+    return classes;
+}();
+
+bool isCharClass(char c, uint8_t charClass)
+{
+    return (charClasses[static_cast<unsigned char>(c)] & charClass) != 0;
+}
+
+#ifdef MINI_PARSE_SCAN_SSE2
+unsigned int countTrailingZeros(uint32_t mask)
+{
+    assert(mask != 0);
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+#endif
+
+//---------------------------------------------------------------------------
+// Character class kernels
+//---------------------------------------------------------------------------
+// Each kernel compares a vector of characters against the ranges making up its class, 
+// yielding lanes of all ones where characters are in the class. SSE2 and AVX2 only 
+// have signed byte comparisons but, as characters outside of ASCII are negative,
+// these are never in any of the ranges so this is fine
+#ifdef MINI_PARSE_SCAN_SSE2
+struct SSE2
+{
+    typedef __m128i Vector;
+    static constexpr size_t width = 16;
+
+    static Vector load(const char *characters){ return _mm_loadu_si128(reinterpret_cast<const __m128i*>(characters)); }
+    static uint32_t moveMask(Vector vector){ return static_cast<uint32_t>(_mm_movemask_epi8(vector)); }
+    static Vector set(char c){ return _mm_set1_epi8(c); }
+    static Vector equal(Vector a, Vector b){ return _mm_cmpeq_epi8(a, b); }
+    static Vector greater(Vector a, Vector b){ return _mm_cmpgt_epi8(a, b); }
+    static Vector bitwiseAnd(Vector a, Vector b){ return _mm_and_si128(a, b); }
+    static Vector bitwiseOr(Vector a, Vector b){ return _mm_or_si128(a, b); }
+};
+#endif
+
+#ifdef MINI_PARSE_SCAN_AVX2
+struct AVX2
+{
+    typedef __m256i Vector;
+    static constexpr size_t width = 32;
+
+    static Vector load(const char *characters){ return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(characters)); }
+    static uint32_t moveMask(Vector vector){ return static_cast<uint32_t>(_mm256_movemask_epi8(vector)); }
+    static Vector set(char c){ return _mm256_set1_epi8(c); }
+    static Vector equal(Vector a, Vector b){ return _mm256_cmpeq_epi8(a, b); }
+    static Vector greater(Vector a, Vector b){ return _mm256_cmpgt_epi8(a, b); }
+    static Vector bitwiseAnd(Vector a, Vector b){ return _mm256_and_si256(a, b); }
+    static Vector bitwiseOr(Vector a, Vector b){ return _mm256_or_si256(a, b); }
+};
+#endif
+
+struct Whitespace
+{
+    static constexpr uint8_t charClass = WHITESPACE;
+
+    template<typename ISA>
+    static typename ISA::Vector match(typename ISA::Vector c)
+    {
+        return ISA::bitwiseOr(ISA::equal(c, ISA::set(' ')),
+                              ISA::bitwiseOr(ISA::equal(c, ISA::set('\t')), ISA::equal(c, ISA::set('\r'))));
+    }
+};
+
+struct Digit
+{
+    static constexpr uint8_t charClass = DIGIT;
+
+    template<typename ISA>
+    static typename ISA::Vector match(typename ISA::Vector c)
+    {
+        return ISA::bitwiseAnd(ISA::greater(c, ISA::set('0' - 1)), ISA::greater(ISA::set('9' + 1), c));
+    }
+};
+
+struct Identifier
+{
+    static constexpr uint8_t charClass = IDENTIFIER;
+
+    template<typename ISA>
+    static typename ISA::Vector match(typename ISA::Vector c)
+    {
+        // Setting bit 5 maps upper case letters to lower case without mapping anything else into a-z
+        const auto lower = ISA::bitwiseOr(c, ISA::set(0x20));
+        const auto alpha = ISA::bitwiseAnd(ISA::greater(lower, ISA::set('a' - 1)), ISA::greater(ISA::set('z' + 1), lower));
+        return ISA::bitwiseOr(ISA::bitwiseOr(alpha, Digit::match<ISA>(c)), ISA::equal(c, ISA::set('_')));
+    }
+};
+
+//! Get position of first character at or after current which isn't in Class's character class. 
+//! Whole vectors are tested while they fit within the source and any remaining characters one at a time
+template<typename Class>
+size_t skipCharClass(std::string_view source, size_t current)
+{
+#ifdef MINI_PARSE_SCAN_AVX2
+    while((current + AVX2::width) <= source.size()) {
+        const uint32_t mask = ~AVX2::moveMask(Class::template match<AVX2>(AVX2::load(source.data() + current)));
+        if(mask != 0) {
+            return current + countTrailingZeros(mask);
+        }
+        current += AVX2::width;
+    }
+#endif
+#ifdef MINI_PARSE_SCAN_SSE2
+    while((current + SSE2::width) <= source.size()) {
+        const uint32_t mask = ~SSE2::moveMask(Class::template match<SSE2>(SSE2::load(source.data() + current))) & 0xFFFFu;
+        if(mask != 0) {
+            return current + countTrailingZeros(mask);
+        }
+        current += SSE2::width;
+    }
+#endif
+    while(current < source.size() && isCharClass(source[current], Class::charClass)) {
+        current++;
+    }
+    return current;
+}
+
 //---------------------------------------------------------------------------
 // ScanState
 //---------------------------------------------------------------------------
@@ -58,16 +309,25 @@ const std::map<std::set<char>, std::function<Token::LiteralValue(std::string_vie
 class ScanState
 {
 public:
-    ScanState(std::string_view source, ErrorHandler &errorHandler)
-        : m_Start(0), m_Current(0), m_Line(1), m_Source(source), m_ErrorHandler(errorHandler)
+    ScanState(std::string_view source, SymbolTable &symbolTable, ErrorHandler &errorHandler, size_t current = 0, size_t line = 1)
+        : m_Start(current), m_Current(current), m_Line(line), m_Source(source), m_SymbolTable(symbolTable), 
+          m_ErrorHandler(errorHandler)
     {}
 
     //---------------------------------------------------------------------------
     // Public API
     //---------------------------------------------------------------------------
     char advance() {
+        assert(!isAtEnd());
         m_Current++;
-        return m_Source.at(m_Current - 1);
+        return m_Source[m_Current - 1];
+    }
+
+    //! Advance past any characters in Class's character class
+    template<typename Class>
+    void skip()
+    {
+        m_Current = skipCharClass<Class>(m_Source, m_Current);
     }
 
     bool match(char expected)
@@ -75,7 +335,7 @@ public:
         if(isAtEnd()) {
             return false;
         }
-        if(m_Source.at(m_Current) != expected) {
+        if(m_Source[m_Current] != expected) {
             return false;
         }
 
@@ -93,7 +353,7 @@ public:
         if(isAtEnd()) {
             return '\0';
         }
-        return m_Source.at(m_Current);
+        return m_Source[m_Current];
     }
 
     char peekNext() const
@@ -102,7 +362,7 @@ public:
             return '\0';
         }
         else {
-            return m_Source.at(m_Current + 1);
+            return m_Source[m_Current + 1];
         }
     }
 
@@ -111,12 +371,16 @@ public:
         return m_Source.substr(m_Start, m_Current - m_Start);
     }
 
+    size_t getStart() const { return m_Start; }
+    size_t getCurrent() const { return m_Current; }
     size_t getLine() const { return m_Line; }
 
     bool isAtEnd() const { return m_Current >= m_Source.length(); }
 
     void nextLine() { m_Line++; }
 
+    Symbol internLexeme() { return m_SymbolTable.intern(getLexeme()); }
+
     void error(std::string_view message)
     {
         m_ErrorHandler.error(getLine(), message);
@@ -131,6 +395,7 @@ private:
 
     const std::string_view m_Source;
 
+    SymbolTable &m_SymbolTable;
     ErrorHandler &m_ErrorHandler;
 };
 
@@ -140,27 +405,81 @@ bool isodigit(char c)
 }
 
 //---------------------------------------------------------------------------
-void emplaceToken(std::vector<Token> &tokens, Token::Type type, const ScanState &scanState, Token::LiteralValue literalValue = Token::LiteralValue())
+template<typename Container>
+void emplaceToken(Container &tokens, Token::Type type, const ScanState &scanState, Token::LiteralValue literalValue = Token::LiteralValue())
 {
     tokens.emplace_back(type, scanState.getLexeme(), scanState.getLine(), literalValue);
 }
 //---------------------------------------------------------------------------
-std::set<char> scanIntegerSuffix(ScanState &scanState)
+void emplaceToken(TokenStream &tokens, Token::Type type, const ScanState &scanState, Token::LiteralValue literalValue = Token::LiteralValue())
+{
+    tokens.addToken(type, scanState.getStart(), scanState.getCurrent(), literalValue);
+}
+//---------------------------------------------------------------------------
+template<typename Container>
+void emplaceIdentifier(Container &tokens, ScanState &scanState)
+{
+    tokens.emplace_back(Token::Type::IDENTIFIER, scanState.getLexeme(), scanState.getLine(), 
+                        Token::LiteralValue(), scanState.internLexeme());
+}
+//---------------------------------------------------------------------------
+void emplaceIdentifier(TokenStream &tokens, ScanState &scanState)
+{
+    tokens.addIdentifier(scanState.getStart(), scanState.getCurrent(), scanState.internLexeme());
+}
+//---------------------------------------------------------------------------
+template<typename Container>
+void nextLine(Container&, ScanState &scanState)
+{
+    scanState.nextLine();
+}
+//---------------------------------------------------------------------------
+void nextLine(TokenStream &tokens, ScanState &scanState)
+{
+    // **NOTE** compact tokens don't store their line so record where new line starts
+    scanState.nextLine();
+    tokens.addLine(scanState.getCurrent());
+}
+//---------------------------------------------------------------------------
+uint8_t scanIntegerSuffix(ScanState &scanState)
 {
     // Read suffix
-    std::set<char> suffix;
-    while(std::toupper(scanState.peek()) == 'U' || std::toupper(scanState.peek()) == 'L') {
-        suffix.insert(std::toupper(scanState.advance()));
+    uint8_t suffix = 0;
+    while(true) {
+        const char c = scanState.peek();
+        if(c == 'u' || c == 'U') {
+            suffix |= SUFFIX_U;
+        }
+        else if(c == 'l' || c == 'L') {
+            suffix |= SUFFIX_L;
+        }
+        else {
+            return suffix;
+        }
+        scanState.advance();
+    }
+}
+//---------------------------------------------------------------------------
+template<typename Tokens>
+void emplaceIntegerToken(ScanState &scanState, Tokens &tokens, std::string_view digits, int base)
+{
+    const auto suffix = scanIntegerSuffix(scanState);
+    const auto parser = integerLiteralSuffixParsers[suffix];
+    if(parser) {
+        emplaceToken(tokens, Token::Type::NUMBER, scanState, parser(digits, base));
+    }
+    else {
+        scanState.error("Unsupported integer literal suffix.");
     }
-    return suffix;
 }
 //---------------------------------------------------------------------------
-void scanNumber(char c, ScanState &scanState, std::vector<Token> &tokens) 
+template<typename Tokens>
+void scanNumber(char c, ScanState &scanState, Tokens &tokens) 
 {
     // If this is a hexadecimal literal
     if(c == '0' && (scanState.match('x') || scanState.match('X'))) {
         // Read hexadecimal digits
-        while(std::isxdigit(scanState.peek())) {
+        while(isCharClass(scanState.peek(), HEX_DIGIT)) {
             scanState.advance();
         }
 
@@ -168,7 +487,7 @@ void scanNumber(char c, ScanState &scanState, std::vector<Token> &tokens)
         const bool isFloat = scanState.match('.');
 
         // Read hexadecimal digits
-        while(std::isxdigit(scanState.peek())) {
+        while(isCharClass(scanState.peek(), HEX_DIGIT)) {
             scanState.advance();
         }
 
@@ -188,9 +507,7 @@ void scanNumber(char c, ScanState &scanState, std::vector<Token> &tokens)
                 }
 
                 // Read DECIMAL digits
-                while(std::isdigit(scanState.peek())) {
-                    scanState.advance();
-                }
+                scanState.skip<Digit>();
 
                 // If literal has floating point suffix
                 if(std::tolower(scanState.peek()) == 'f') {
@@ -214,10 +531,9 @@ void scanNumber(char c, ScanState &scanState, std::vector<Token> &tokens)
         // Otherwise, number is hexadecimal integer
         else {
             // Add integer token
-            // **NOTE** skip 0x prefix
-            const auto suffix = scanIntegerSuffix(scanState);
-            emplaceToken(tokens, Token::Type::NUMBER, scanState,
-                         integerLiteralSuffixParsers.at(suffix)(scanState.getLexeme().substr(2), 16));
+            // **NOTE** skip 0x prefix and suffix isn't part of digits
+            const auto digits = scanState.getLexeme().substr(2);
+            emplaceIntegerToken(scanState, tokens, digits, 16);
         }
     }
     // Otherwise, if this is an octal integer
@@ -227,17 +543,13 @@ void scanNumber(char c, ScanState &scanState, std::vector<Token> &tokens)
     // Otherwise, if it's decimal
     else {
         // Read digits
-        while(std::isdigit(scanState.peek())) {
-            scanState.advance();
-        }
+        scanState.skip<Digit>();
 
         // Read decimal place
         const bool isFloat = scanState.match('.');
 
         // Read digits
-        while(std::isdigit(scanState.peek())) {
-            scanState.advance();
-        }
+        scanState.skip<Digit>();
 
         // If it's float
         if(isFloat) {
@@ -249,9 +561,7 @@ void scanNumber(char c, ScanState &scanState, std::vector<Token> &tokens)
                 }
 
                 // Read digits
-                while(std::isdigit(scanState.peek())) {
-                    scanState.advance();
-                }
+                scanState.skip<Digit>();
             }
             
             // If literal has floating point suffix
@@ -273,32 +583,69 @@ void scanNumber(char c, ScanState &scanState, std::vector<Token> &tokens)
         // Otherwise, number is integer
         else {
             // Add integer token
-            const auto suffix = scanIntegerSuffix(scanState);
-            emplaceToken(tokens, Token::Type::NUMBER, scanState,
-                         integerLiteralSuffixParsers.at(suffix)(scanState.getLexeme(), 10));
+            // **NOTE** suffix isn't part of digits
+            const auto digits = scanState.getLexeme();
+            emplaceIntegerToken(scanState, tokens, digits, 10);
         }
     }
 }
 //---------------------------------------------------------------------------
-void scanIdentifier(ScanState &scanState, std::vector<Token> &tokens)
+template<typename Tokens>
+void scanIdentifier(ScanState &scanState, Tokens &tokens)
 {
     // Read subsequent alphanumeric characters and underscores
-    while(std::isalnum(scanState.peek()) || scanState.peek() == '_') {
-        scanState.advance();
-    }
+    scanState.skip<Identifier>();
 
     // If identifier is a keyword, add appropriate token
-    const auto k = keywords.find(scanState.getLexeme());
-    if(k != keywords.cend()) {
-        emplaceToken(tokens, k->second, scanState);
+    const auto type = getIdentifierType(scanState.getLexeme());
+    if(type != Token::Type::IDENTIFIER) {
+        emplaceToken(tokens, type, scanState);
     }
-    // Otherwise, add identifier token
+    // Otherwise, add identifier token with interned symbol
     else {
-        emplaceToken(tokens, Token::Type::IDENTIFIER, scanState);
+        emplaceIdentifier(tokens, scanState);
     }
 }
 //---------------------------------------------------------------------------
-void scanToken(ScanState &scanState, std::vector<Token> &tokens)
+template<typename Tokens>
+void scanSubstitution(ScanState &scanState, Tokens &tokens)
+{
+    // GeNN-style substitution ::=
+    //      "$(" identifier ")"
+    //      "$(" identifier "," argument-expression-list ")"
+    if(!scanState.match('(')) {
+        scanState.error("Expect '(' after '$'.");
+        return;
+    }
+
+    // Scan name as identifier token
+    // **NOTE** names are never treated as keywords
+    scanState.resetLexeme();
+    if(!isCharClass(scanState.peek(), IDENTIFIER_START)) {
+        scanState.error("Expect name after '$('.");
+        return;
+    }
+    scanState.skip<Identifier>();
+    emplaceIdentifier(tokens, scanState);
+
+    // If substitution is closed, it's a variable so closing parenthesis is discarded
+    scanState.resetLexeme();
+    if(scanState.match(')')) {
+        return;
+    }
+    // Otherwise, if name is followed by a comma, it's a function call so add left parenthesis. 
+    // The arguments and closing parenthesis are then scanned as normal tokens
+    // **NOTE** the comma is used as the left parenthesis's lexeme
+    else if(scanState.match(',')) {
+        emplaceToken(tokens, Token::Type::LEFT_PAREN, scanState);
+    }
+    else {
+        scanState.error("Expect ')' or ',' after name in '$(' substitution.");
+    }
+}
+//---------------------------------------------------------------------------
+template<typename Tokens>
+void scanToken(ScanState &scanState, Tokens &tokens)
 {
     using namespace MiniParse;
 
@@ -318,6 +665,9 @@ void scanToken(ScanState &scanState, std::vector<Token> &tokens)
         case '~': emplaceToken(tokens, Token::Type::TILDA, scanState); break;
         case '?': emplaceToken(tokens, Token::Type::QUESTION, scanState); break;
 
+        // GeNN-style substitutions
+        case '$': scanSubstitution(scanState, tokens); break;
+
         // Operators
         case '!': emplaceToken(tokens, scanState.match('=') ? Token::Type::NOT_EQUAL : Token::Type::NOT, scanState); break;
         case '=': emplaceToken(tokens, scanState.match('=') ? Token::Type::EQUAL_EQUAL : Token::Type::EQUAL, scanState); break;
@@ -440,19 +790,20 @@ void scanToken(ScanState &scanState, std::vector<Token> &tokens)
         case ' ':
         case '\r':
         case '\t':
+            scanState.skip<Whitespace>();
             break;
 
         // New line
-        case '\n': scanState.nextLine(); break;
+        case '\n': nextLine(tokens, scanState); break;
 
         default:
         {
             // If we have a digit or a period, scan number
-            if(std::isdigit(c) || c == '.') {
+            if(isCharClass(c, DIGIT) || c == '.') {
                 scanNumber(c, scanState, tokens);
             }
             // Otherwise, scan identifier
-            else if(std::isalpha(c) || c == '_') {
+            else if(isCharClass(c, IDENTIFIER_START)) {
                 scanIdentifier(scanState, tokens);
             }
             else {
@@ -461,6 +812,113 @@ void scanToken(ScanState &scanState, std::vector<Token> &tokens)
         }
     }
 }
+//---------------------------------------------------------------------------
+template<typename Tokens>
+void scanTokens(ScanState &scanState, Tokens &tokens)
+{
+    while(!scanState.isAtEnd()) {
+        scanState.resetLexeme();
+        scanToken(scanState, tokens);
+    }
+}
+//---------------------------------------------------------------------------
+template<typename Tokens>
+void scanTokens(const std::string_view &source, Tokens &tokens, SymbolTable &symbolTable, ErrorHandler &errorHandler)
+{
+    ScanState scanState(source, symbolTable, errorHandler);
+
+    // Scan tokens
+    scanTokens(scanState, tokens);
+
+    scanState.resetLexeme();
+    emplaceToken(tokens, Token::Type::END_OF_FILE, scanState);
+}
+
+//---------------------------------------------------------------------------
+// Chunk
+//---------------------------------------------------------------------------
+//! Part of source scanned independently on a worker thread. Lines are numbered and
+//! identifiers interned as if the chunk was the whole source and corrected when stitching
+struct Chunk
+{
+    Chunk(std::string_view source, size_t begin, size_t end) 
+    :   source(source.substr(0, end)), tokens(this->source), begin(begin), numLines(0)
+    {}
+
+    //! Source up to the end of the chunk so offsets and lexemes are the same as when scanning the whole source
+    std::string_view source;
+    TokenStream tokens;
+    SymbolTable symbolTable;
+    ErrorRecorder errors;
+
+    //! Offset of the chunk's first character in source
+    size_t begin;
+
+    //! Number of new lines in chunk
+    size_t numLines;
+
+    //! Symbols in caller's symbol table of identifiers interned in chunk's
+    std::vector<Symbol> symbols;
+
+    //! Position chunk's tokens are copied to in the stitched stream
+    TokenStream::AppendPosition position;
+
+    std::exception_ptr exception;
+};
+
+//! Sources smaller than this are scanned by a single thread as it isn't worth splitting them
+constexpr size_t minChunkSize = 64 * 1024;
+
+//---------------------------------------------------------------------------
+//! Get offsets at which to split source into at most numChunks chunks, including 0 and the end of the source.
+//! Source is only split after new lines as no tokens or comments span lines and, as new lines end the
+//! line comments and terminate all other tokens, scanning never needs to look past one to finish a token
+std::vector<size_t> splitSource(std::string_view source, size_t numChunks)
+{
+    std::vector<size_t> boundaries{0};
+    for(size_t i = 1; i < numChunks; i++) {
+        const size_t target = std::max(boundaries.back(), (source.size() * i) / numChunks);
+        const size_t newLine = source.find('\n', target);
+        if(newLine == std::string_view::npos) {
+            break;
+        }
+        else if((newLine + 1) > boundaries.back() && (newLine + 1) < source.size()) {
+            boundaries.push_back(newLine + 1);
+        }
+    }
+    boundaries.push_back(source.size());
+    return boundaries;
+}
+//---------------------------------------------------------------------------
+//! Call function with each chunk on its own thread, recording any exception it raises in chunk
+template<typename F>
+void forEachChunk(std::vector<Chunk> &chunks, F function)
+{
+    std::vector<std::thread> threads;
+    threads.reserve(chunks.size());
+    for(auto &c : chunks) {
+        threads.emplace_back(
+            [&c, &function]()
+            {
+                try {
+                    function(c);
+                }
+                catch(...) {
+                    c.exception = std::current_exception();
+                }
+            });
+    }
+    for(auto &t : threads) {
+        t.join();
+    }
+
+    // Re-throw first exception raised by any thread
+    for(const auto &c : chunks) {
+        if(c.exception) {
+            std::rethrow_exception(c.exception);
+        }
+    }
+}
 }
 
 //---------------------------------------------------------------------------
@@ -468,19 +926,154 @@ void scanToken(ScanState &scanState, std::vector<Token> &tokens)
 //---------------------------------------------------------------------------
 namespace MiniParse::Scanner
 {
-std::vector<Token> scanSource(const std::string_view &source, ErrorHandler &errorHandler)
+std::vector<Token> scanSource(const std::string_view &source, SymbolTable &symbolTable, ErrorHandler &errorHandler)
 {
     std::vector<Token> tokens;
+    scanTokens(source, tokens, symbolTable, errorHandler);
+    return tokens;
+}
+//---------------------------------------------------------------------------
+TokenStream scanTokenStream(const std::string_view &source, SymbolTable &symbolTable, ErrorHandler &errorHandler)
+{
+    TokenStream tokens(source);
+    scanTokens(source, tokens, symbolTable, errorHandler);
+    return tokens;
+}
+//---------------------------------------------------------------------------
+TokenStream scanTokenStreamParallel(const std::string_view &source, SymbolTable &symbolTable, 
+                                    ErrorHandler &errorHandler, size_t numThreads)
+{
+    // Split source into chunks of at least minimum size, one per thread
+    if(numThreads == 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    const auto boundaries = splitSource(source, std::min(numThreads, std::max<size_t>(1, source.size() / minChunkSize)));
 
-    ScanState scanState(source, errorHandler);
+    // If source can't be split, scan it sequentially
+    if(boundaries.size() == 2) {
+        return scanTokenStream(source, symbolTable, errorHandler);
+    }
 
-    // Scan tokens
-    while(!scanState.isAtEnd()) {
-        scanState.resetLexeme();
-        scanToken(scanState, tokens);
+    // Scan each chunk on its own thread
+    std::vector<Chunk> chunks;
+    chunks.reserve(boundaries.size() - 1);
+    for(size_t i = 0; i < (boundaries.size() - 1); i++) {
+        chunks.emplace_back(source, boundaries[i], boundaries[i + 1]);
+    }
+    forEachChunk(chunks,
+                 [](Chunk &c)
+                 {
+                     ScanState scanState(c.source, c.symbolTable, c.errors, c.begin);
+                     scanTokens(scanState, c.tokens);
+                     c.numLines = scanState.getLine() - 1;
+                 });
+
+    // Reserve space for all tokens, including END_OF_FILE, so appending chunks never reallocates
+    TokenStream tokens(source);
+    tokens.reserve(std::accumulate(chunks.cbegin(), chunks.cend(), size_t{1},
+                                   [](size_t n, const Chunk &c) { return n + c.tokens.size(); }));
+
+    // Visit chunks in order
+    size_t numPreviousLines = 0;
+    for(auto &c : chunks) {
+        // Intern chunk's identifiers in order of their chunk symbols. As these were assigned in order of first 
+        // appearance in the chunk, identifiers get the same symbols as they would if the source was scanned sequentially
+        c.symbols.resize(c.symbolTable.size());
+        for(size_t i = 0; i < c.symbols.size(); i++) {
+            c.symbols[i] = symbolTable.intern(c.symbolTable.getName(static_cast<Symbol>(i)));
+        }
+
+        // Report errors with corrected lines and make space for chunk's tokens
+        c.errors.report(errorHandler, numPreviousLines);
+        c.position = tokens.prepareAppend(c.tokens);
+        numPreviousLines += c.numLines;
     }
 
+    // Copy each chunk's tokens into place on its own thread
+    // **NOTE** copying is parallelised as writing to the newly-allocated tokens is dominated by page faults
+    forEachChunk(chunks, [&tokens](const Chunk &c){ tokens.copyTokens(c.tokens, c.position, c.symbols); });
+
+    // Add END_OF_FILE token at end of source
+    ScanState scanState(source, symbolTable, errorHandler, source.size(), numPreviousLines + 1);
     emplaceToken(tokens, Token::Type::END_OF_FILE, scanState);
     return tokens;
 }
+//---------------------------------------------------------------------------
+// MiniParse::Scanner::TokenCursor
+//---------------------------------------------------------------------------
+TokenCursor::TokenCursor(std::string_view source, SymbolTable &symbolTable, ErrorHandler &errorHandler)
+:   m_Source(source), m_SymbolTable(symbolTable), m_ErrorHandler(errorHandler), m_Current(0), m_Line(1), m_FirstChunk(0), 
+    m_EndIndex(0), m_MaxNumChunks(0)
+{
+}
+//---------------------------------------------------------------------------
+void TokenCursor::release(size_t index)
+{
+    // Release chunks which only contain tokens before index
+    const size_t numReleased = std::min((index >> chunkBits) - m_FirstChunk, m_Chunks.size());
+    for(size_t i = 0; i < numReleased; i++) {
+        m_Chunks[i].clear();
+        m_SpareChunks.push_back(std::move(m_Chunks[i]));
+    }
+    m_Chunks.erase(m_Chunks.begin(), m_Chunks.begin() + numReleased);
+    m_FirstChunk += numReleased;
+}
+//---------------------------------------------------------------------------
+void TokenCursor::scanTokens()
+{
+    // **NOTE** parser never advances past END_OF_FILE token
+    assert(m_Current <= m_Source.size());
+
+    // If there's no space in last chunk, add another
+    if((m_EndIndex & (chunkSize - 1)) == 0) {
+        addChunk();
+    }
+
+    // Continue scanning from where we left off until chunk is full
+    // **NOTE** scanToken adds up to maxTokensPerScan tokens so chunk may overflow by up to maxTokensPerScan - 1
+    ScanState scanState(m_Source, m_SymbolTable, m_ErrorHandler, m_Current, m_Line);
+    {
+        auto &tokens = m_Chunks.back();
+        while(!scanState.isAtEnd() && tokens.size() < chunkSize) {
+            scanState.resetLexeme();
+            scanToken(scanState, tokens);
+        }
+    }
+
+    // If chunk has overflowed, move overflowing tokens into the start of another
+    if(m_Chunks.back().size() > chunkSize) {
+        auto &nextTokens = addChunk();
+        auto &tokens = m_Chunks[m_Chunks.size() - 2];
+        std::move(tokens.begin() + chunkSize, tokens.end(), std::back_inserter(nextTokens));
+        tokens.erase(tokens.begin() + chunkSize, tokens.end());
+    }
+
+    // If we've reached the end of the source and there's space, add END_OF_FILE
+    // **NOTE** position is moved past end of source so this only happens once
+    auto &tokens = m_Chunks.back();
+    if(scanState.isAtEnd() && tokens.size() < chunkSize) {
+        scanState.resetLexeme();
+        emplaceToken(tokens, Token::Type::END_OF_FILE, scanState);
+        m_Current = m_Source.size() + 1;
+    }
+    else {
+        m_Current = scanState.getCurrent();
+    }
+    m_Line = scanState.getLine();
+    m_EndIndex = (m_FirstChunk + m_Chunks.size() - 1) * chunkSize + tokens.size();
+}
+//---------------------------------------------------------------------------
+std::vector<Token> &TokenCursor::addChunk()
+{
+    if(m_SpareChunks.empty()) {
+        m_Chunks.emplace_back();
+        m_Chunks.back().reserve(chunkSize + maxTokensPerScan - 1);
+    }
+    else {
+        m_Chunks.push_back(std::move(m_SpareChunks.back()));
+        m_SpareChunks.pop_back();
+    }
+    m_MaxNumChunks = std::max(m_MaxNumChunks, m_Chunks.size());
+    return m_Chunks.back();
+}
 }
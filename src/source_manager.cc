@@ -0,0 +1,198 @@
+#include "source_manager.h"
+
+// Standard C++ includes
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+
+// Platform includes
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//---------------------------------------------------------------------------
+// MiniParse::SourceManager::Source
+//---------------------------------------------------------------------------
+struct MiniParse::SourceManager::Source
+{
+    Source(std::string name) : name(std::move(name)), mapping(nullptr)
+    {}
+
+    ~Source()
+    {
+        if(mapping) {
+#ifdef _WIN32
+            UnmapViewOfFile(mapping);
+#else
+            munmap(mapping, text.size());
+#endif
+        }
+    }
+
+    std::string name;
+    std::string_view text;
+
+    //! Text of in-memory sources
+    std::string ownedText;
+
+    //! Start of memory-mapped file
+    void *mapping;
+
+    //! Offsets at which each line starts, built the first time a location in the source is requested
+    mutable std::once_flag lineOffsetsFlag;
+    mutable std::vector<size_t> lineOffsets;
+};
+
+//---------------------------------------------------------------------------
+// MiniParse::SourceManager
+//---------------------------------------------------------------------------
+MiniParse::SourceManager::SourceManager()
+:   m_NumMappedBytes(0)
+{
+}
+//---------------------------------------------------------------------------
+MiniParse::SourceManager::~SourceManager() = default;
+//---------------------------------------------------------------------------
+std::string_view MiniParse::SourceManager::addFile(const std::filesystem::path &path)
+{
+    auto source = std::make_unique<Source>(path.string());
+    const auto error = [&path](const std::string &message)
+    {
+        return std::runtime_error(message + " '" + path.string() + "'");
+    };
+
+#ifdef _WIN32
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, 
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(file == INVALID_HANDLE_VALUE) {
+        throw error("Unable to open source file");
+    }
+
+    LARGE_INTEGER size;
+    if(!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        throw error("Unable to get size of source file");
+    }
+
+    // **NOTE** empty files can't be mapped but their text is just an empty view
+    if(size.QuadPart > 0) {
+        HANDLE fileMapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if(fileMapping) {
+            source->mapping = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(fileMapping);
+        }
+        if(!source->mapping) {
+            CloseHandle(file);
+            throw error("Unable to map source file");
+        }
+    }
+    CloseHandle(file);
+    const size_t numBytes = static_cast<size_t>(size.QuadPart);
+#else
+    const int file = open(path.c_str(), O_RDONLY);
+    if(file == -1) {
+        throw error("Unable to open source file");
+    }
+
+    struct stat status;
+    if(fstat(file, &status) == -1) {
+        close(file);
+        throw error("Unable to get size of source file");
+    }
+
+    // **NOTE** empty files can't be mapped but their text is just an empty view
+    const size_t numBytes = static_cast<size_t>(status.st_size);
+    if(numBytes > 0) {
+        void *mapping = mmap(nullptr, numBytes, PROT_READ, MAP_PRIVATE, file, 0);
+        if(mapping == MAP_FAILED) {
+            close(file);
+            throw error("Unable to map source file");
+        }
+        source->mapping = mapping;
+    }
+
+    // **NOTE** mapping remains valid after file is closed
+    close(file);
+#endif
+    source->text = std::string_view(static_cast<const char*>(source->mapping), numBytes);
+    m_NumMappedBytes += numBytes;
+    return addSource(std::move(source));
+}
+//---------------------------------------------------------------------------
+std::vector<std::string_view> MiniParse::SourceManager::addDirectory(const std::filesystem::path &directory, 
+                                                                     std::string_view extension)
+{
+    // Find files with extension and sort so sources are added in a deterministic order
+    std::vector<std::filesystem::path> paths;
+    for(const auto &entry : std::filesystem::directory_iterator(directory)) {
+        if(entry.is_regular_file() && entry.path().extension() == extension) {
+            paths.push_back(entry.path());
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+
+    std::vector<std::string_view> texts;
+    texts.reserve(paths.size());
+    std::transform(paths.cbegin(), paths.cend(), std::back_inserter(texts),
+                   [this](const auto &p) { return addFile(p); });
+    return texts;
+}
+//---------------------------------------------------------------------------
+std::string_view MiniParse::SourceManager::addSource(std::string name, std::string text)
+{
+    // **NOTE** text is moved into heap-allocated source so views of it remain valid
+    auto source = std::make_unique<Source>(std::move(name));
+    source->ownedText = std::move(text);
+    source->text = source->ownedText;
+    return addSource(std::move(source));
+}
+//---------------------------------------------------------------------------
+std::optional<MiniParse::SourceManager::Location> MiniParse::SourceManager::getLocation(const char *position) const
+{
+    // Find last source starting at or before position
+    auto s = m_SourcesByAddress.upper_bound(position);
+    if(s == m_SourcesByAddress.cbegin()) {
+        return std::nullopt;
+    }
+    const Source &source = *std::prev(s)->second;
+
+    // If position is past the end of source, it isn't in any
+    // **NOTE** the end itself is included as it is where END_OF_FILE tokens are
+    const size_t offset = static_cast<size_t>(position - source.text.data());
+    if(offset > source.text.size()) {
+        return std::nullopt;
+    }
+
+    // Build table of line offsets if this is the first location requested in this source
+    std::call_once(source.lineOffsetsFlag,
+                   [&source]()
+                   {
+                       source.lineOffsets.push_back(0);
+                       for(size_t i = 0; i < source.text.size(); i++) {
+                           if(source.text[i] == '\n') {
+                               source.lineOffsets.push_back(i + 1);
+                           }
+                       }
+                   });
+
+    // Line is one plus index of last line starting at or before offset
+    const auto line = std::upper_bound(source.lineOffsets.cbegin(), source.lineOffsets.cend(), offset);
+    return Location{source.name, static_cast<size_t>(std::distance(source.lineOffsets.cbegin(), line)),
+                    offset - *std::prev(line) + 1};
+}
+//---------------------------------------------------------------------------
+std::string_view MiniParse::SourceManager::addSource(std::unique_ptr<Source> source)
+{
+    if(!source->text.empty()) {
+        m_SourcesByAddress.emplace(source->text.data(), source.get());
+    }
+    m_Sources.push_back(std::move(source));
+    return m_Sources.back()->text;
+}
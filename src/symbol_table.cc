@@ -0,0 +1,115 @@
+#include "symbol_table.h"
+
+// Standard C++ includes
+#include <limits>
+#include <stdexcept>
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+//! FNV-1a hash which is cheap for short strings like identifiers
+uint32_t hashName(std::string_view name)
+{
+    uint32_t hash = 2166136261u;
+    for(const char c : name) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+    }
+    return hash;
+}
+}
+
+//---------------------------------------------------------------------------
+// MiniParse::SymbolTable
+//---------------------------------------------------------------------------
+MiniParse::SymbolTable::SymbolTable()
+:   m_Parent(nullptr), m_NumParentSymbols(0), m_Slots(64, 0)
+{
+}
+//---------------------------------------------------------------------------
+MiniParse::SymbolTable::SymbolTable(const SymbolTable *parent)
+:   m_Parent(parent), m_NumParentSymbols(parent->size()), m_Slots(64, 0)
+{
+}
+//---------------------------------------------------------------------------
+MiniParse::Symbol MiniParse::SymbolTable::intern(std::string_view name)
+{
+    // If name has already been interned in parent, return its symbol
+    const uint32_t hash = hashName(name);
+    if(m_Parent) {
+        const Symbol symbol = m_Parent->find(name, hash);
+        if(symbol != Symbol::NONE) {
+            return symbol;
+        }
+    }
+
+    // Otherwise, if it has already been interned in this table, return its symbol
+    size_t slot = findSlot(name, hash);
+    if(m_Slots[slot] != 0) {
+        return static_cast<Symbol>(m_NumParentSymbols + m_Slots[slot] - 1);
+    }
+
+    // **NOTE** largest ID is reserved for Symbol::NONE
+    if(size() >= (std::numeric_limits<uint32_t>::max() - 1)) {
+        throw std::length_error("Too many symbols");
+    }
+
+    // Otherwise, copy name and assign it next ID
+    const auto index = static_cast<uint32_t>(m_Names.size());
+    m_Names.emplace_back(name);
+    m_Hashes.push_back(hash);
+
+    // If table is now more than half full, double its size and re-insert names
+    if((m_Names.size() * 2) > m_Slots.size()) {
+        m_Slots.assign(m_Slots.size() * 2, 0);
+        for(uint32_t i = 0; i < index; i++) {
+            m_Slots[findSlot(m_Names[i], m_Hashes[i])] = i + 1;
+        }
+        slot = findSlot(name, hash);
+    }
+    m_Slots[slot] = index + 1;
+    return static_cast<Symbol>(m_NumParentSymbols + index);
+}
+//---------------------------------------------------------------------------
+MiniParse::Symbol MiniParse::SymbolTable::find(std::string_view name) const
+{
+    return find(name, hashName(name));
+}
+//---------------------------------------------------------------------------
+std::string_view MiniParse::SymbolTable::getName(Symbol symbol) const
+{
+    const size_t s = static_cast<size_t>(symbol);
+    if(s < m_NumParentSymbols) {
+        return m_Parent->getName(symbol);
+    }
+    else {
+        return m_Names.at(s - m_NumParentSymbols);
+    }
+}
+//---------------------------------------------------------------------------
+MiniParse::Symbol MiniParse::SymbolTable::find(std::string_view name, uint32_t hash) const
+{
+    if(m_Parent) {
+        const Symbol symbol = m_Parent->find(name, hash);
+        if(symbol != Symbol::NONE) {
+            return symbol;
+        }
+    }
+
+    const size_t slot = findSlot(name, hash);
+    return (m_Slots[slot] == 0) ? Symbol::NONE : static_cast<Symbol>(m_NumParentSymbols + m_Slots[slot] - 1);
+}
+//---------------------------------------------------------------------------
+size_t MiniParse::SymbolTable::findSlot(std::string_view name, uint32_t hash) const
+{
+    // Probe linearly from slot hash maps to until we find name or an empty slot
+    // **NOTE** table size is a power of two and table is never more than half full
+    const size_t mask = m_Slots.size() - 1;
+    for(size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+        const uint32_t s = m_Slots[slot];
+        if(s == 0 || (m_Hashes[s - 1] == hash && m_Names[s - 1] == name)) {
+            return slot;
+        }
+    }
+}
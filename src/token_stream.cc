@@ -0,0 +1,115 @@
+#include "token_stream.h"
+
+// Standard C++ includes
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+// Standard C includes
+#include <cassert>
+
+//---------------------------------------------------------------------------
+// MiniParse::TokenStream
+//---------------------------------------------------------------------------
+MiniParse::TokenStream::TokenStream(std::string_view source)
+:   m_Source(source), m_Literals{Token::LiteralValue()}, m_LineOffsets{0}
+{
+    // **NOTE** offsets and lengths are stored in 32 bits
+    if(source.size() > std::numeric_limits<uint32_t>::max()) {
+        throw std::length_error("Source too large for compact token stream");
+    }
+}
+//---------------------------------------------------------------------------
+void MiniParse::TokenStream::addToken(Token::Type type, size_t offset, size_t end, const Token::LiteralValue &literalValue)
+{
+    assert(end >= offset && end <= m_Source.size());
+
+    // If token has a literal value, add to table
+    uint32_t literalIndex = 0;
+    if(!std::holds_alternative<std::monostate>(literalValue)) {
+        literalIndex = static_cast<uint32_t>(m_Literals.size());
+        m_Literals.push_back(literalValue);
+    }
+    m_Tokens.push_back({type, static_cast<uint32_t>(offset), static_cast<uint32_t>(end - offset), literalIndex});
+}
+//---------------------------------------------------------------------------
+void MiniParse::TokenStream::addIdentifier(size_t offset, size_t end, Symbol symbol)
+{
+    assert(end >= offset && end <= m_Source.size());
+
+    CompactToken token{Token::Type::IDENTIFIER, static_cast<uint32_t>(offset), static_cast<uint32_t>(end - offset), 0};
+    token.symbol = symbol;
+    m_Tokens.push_back(token);
+}
+//---------------------------------------------------------------------------
+void MiniParse::TokenStream::addLine(size_t offset)
+{
+    assert(offset > m_LineOffsets.back());
+    m_LineOffsets.push_back(static_cast<uint32_t>(offset));
+}
+//---------------------------------------------------------------------------
+MiniParse::TokenStream::AppendPosition MiniParse::TokenStream::prepareAppend(const TokenStream &stream)
+{
+    assert(stream.m_Source.data() == m_Source.data());
+    assert(stream.m_LineOffsets.size() == 1 || stream.m_LineOffsets[1] > m_LineOffsets.back());
+
+    // Resize tokens to make space
+    const AppendPosition position{m_Tokens.size(), static_cast<uint32_t>(m_Literals.size() - 1)};
+    m_Tokens.resize(m_Tokens.size() + stream.m_Tokens.size());
+
+    // Copy literal values and offsets of lines other than the first
+    // **NOTE** both streams' literal tables start with the empty value and line offsets with the first line
+    m_Literals.insert(m_Literals.end(), std::next(stream.m_Literals.cbegin()), stream.m_Literals.cend());
+    m_LineOffsets.insert(m_LineOffsets.end(), std::next(stream.m_LineOffsets.cbegin()), stream.m_LineOffsets.cend());
+    return position;
+}
+//---------------------------------------------------------------------------
+void MiniParse::TokenStream::copyTokens(const TokenStream &stream, const AppendPosition &position, 
+                                        const std::vector<Symbol> &symbols)
+{
+    assert((position.firstToken + stream.m_Tokens.size()) <= m_Tokens.size());
+
+    // Copy tokens, mapping symbols and offsetting literal indices past those of preceding streams
+    auto token = m_Tokens.begin() + position.firstToken;
+    for(CompactToken t : stream.m_Tokens) {
+        if(t.type == Token::Type::IDENTIFIER) {
+            t.symbol = symbols[static_cast<size_t>(t.symbol)];
+        }
+        else if(t.literalIndex != 0) {
+            t.literalIndex += position.numPreviousLiterals;
+        }
+        *token++ = t;
+    }
+}
+//---------------------------------------------------------------------------
+size_t MiniParse::TokenStream::getLine(const CompactToken &token) const
+{
+    // Line is one plus index of last line starting before token
+    return std::distance(m_LineOffsets.cbegin(),
+                         std::upper_bound(m_LineOffsets.cbegin(), m_LineOffsets.cend(), token.offset));
+}
+//---------------------------------------------------------------------------
+size_t MiniParse::TokenStream::getLine(const CompactToken &token, size_t &hint) const
+{
+    assert(hint < m_LineOffsets.size());
+
+    // Move hint backwards until line starts before token and then forwards until next line doesn't
+    while(m_LineOffsets[hint] > token.offset) {
+        hint--;
+    }
+    while((hint + 1) < m_LineOffsets.size() && m_LineOffsets[hint + 1] <= token.offset) {
+        hint++;
+    }
+    return hint + 1;
+}
+//---------------------------------------------------------------------------
+MiniParse::Token MiniParse::TokenStream::getToken(const CompactToken &token) const
+{
+    return Token(token.type, getLexeme(token), getLine(token), getLiteralValue(token), getSymbol(token));
+}
+//---------------------------------------------------------------------------
+MiniParse::Token MiniParse::TokenStream::getToken(const CompactToken &token, size_t &hint) const
+{
+    return Token(token.type, getLexeme(token), getLine(token, hint), getLiteralValue(token), getSymbol(token));
+}
@@ -1,42 +1,184 @@
 #include "type.h"
 
 // Standard C++ includes
-#include <map>
-#include <unordered_map>
+#include <array>
+#include <utility>
+
+// Standard C includes
+#include <cassert>
 
 // Anonymous namespace
 namespace
 {
-const std::map<std::set<std::string_view>, const Type::NumericBase*> numericTypes{
-    {{"char"}, Type::Int8::getInstance()},
+using Type::numNumericTypes;
+
+//! Type specifier keywords, in order of their bits
+constexpr std::array<std::string_view, 9> typeSpecifierKeywords{
+    "char", "short", "int", "long", "float", "double", "signed", "unsigned", "bool"};
+
+constexpr Type::TypeSpecifiers encodeTypeSpecifiers(std::initializer_list<std::string_view> keywords)
+{
+    Type::TypeSpecifiers typeSpecifiers = 0;
+    for(const auto k : keywords) {
+        size_t i = 0;
+        while(typeSpecifierKeywords.at(i) != k) {
+            i++;
+        }
+        typeSpecifiers |= (1 << i);
+    }
+    return typeSpecifiers;
+}
+//----------------------------------------------------------------------------
+//! Index of numeric type specified by each set of type specifiers, -1 if set doesn't specify a type
+constexpr auto numericTypes = []()
+{
+    using namespace Type;
+
+    std::array<int, 1 << typeSpecifierKeywords.size()> types{};
+    for(auto &t : types) {
+        t = -1;
+    }
+
+    types[encodeTypeSpecifiers({"char"})] = getNumericIndex<int8_t>();
     
-    {{"unsigned", "char"}, Type::Uint8::getInstance()},
+    types[encodeTypeSpecifiers({"unsigned", "char"})] = getNumericIndex<uint8_t>();
 
-    {{"short"}, Type::Int16::getInstance()},
-    {{"short", "int"}, Type::Int16::getInstance()},
-    {{"signed", "short"}, Type::Int16::getInstance()},
-    {{"signed", "short", "int"}, Type::Int16::getInstance()},
+    types[encodeTypeSpecifiers({"short"})] = getNumericIndex<int16_t>();
+    types[encodeTypeSpecifiers({"short", "int"})] = getNumericIndex<int16_t>();
+    types[encodeTypeSpecifiers({"signed", "short"})] = getNumericIndex<int16_t>();
+    types[encodeTypeSpecifiers({"signed", "short", "int"})] = getNumericIndex<int16_t>();
     
-    {{"unsigned", "short"}, Type::Uint16::getInstance()},
-    {{"unsigned", "short", "int"}, Type::Uint16::getInstance()},
+    types[encodeTypeSpecifiers({"unsigned", "short"})] = getNumericIndex<uint16_t>();
+    types[encodeTypeSpecifiers({"unsigned", "short", "int"})] = getNumericIndex<uint16_t>();
 
-    {{"int"}, Type::Int32::getInstance()},
-    {{"signed"}, Type::Int32::getInstance()},
-    {{"signed", "int"}, Type::Int32::getInstance()},
+    types[encodeTypeSpecifiers({"int"})] = getNumericIndex<int32_t>();
+    types[encodeTypeSpecifiers({"signed"})] = getNumericIndex<int32_t>();
+    types[encodeTypeSpecifiers({"signed", "int"})] = getNumericIndex<int32_t>();
 
-    {{"unsigned"}, Type::Uint32::getInstance()},
-    {{"unsigned", "int"}, Type::Uint32::getInstance()},
+    types[encodeTypeSpecifiers({"unsigned"})] = getNumericIndex<uint32_t>();
+    types[encodeTypeSpecifiers({"unsigned", "int"})] = getNumericIndex<uint32_t>();
 
-    {{"float"}, Type::Float::getInstance()},
-    {{"double"}, Type::Double::getInstance()},
-};
+    types[encodeTypeSpecifiers({"float"})] = getNumericIndex<float>();
+    types[encodeTypeSpecifiers({"double"})] = getNumericIndex<double>();
+    return types;
+}();
 //----------------------------------------------------------------------------
-// Mapping of signed integer numericTypes to their unsigned equivalents
-const std::unordered_map<const Type::NumericBase*, const Type::NumericBase*> unsignedType{
-    {Type::Int8::getInstance(), Type::Uint8::getInstance()},
-    {Type::Int16::getInstance(), Type::Uint16::getInstance()},
-    {Type::Int32::getInstance(), Type::Uint32::getInstance()}
+//! Properties of numeric types required to build tables at compile time
+struct NumericProperties
+{
+    int rank;
+    bool isSigned;
+    bool isIntegral;
+    double min;
+    double max;
+
+    //! Index of the unsigned integer type corresponding to signed integer types
+    size_t unsignedIndex;
 };
+
+template<typename T>
+constexpr NumericProperties getNumericProperties()
+{
+    size_t unsignedIndex = 0;
+    if constexpr(std::is_integral_v<T> && std::is_signed_v<T>) {
+        unsignedIndex = Type::getNumericIndex<std::make_unsigned_t<T>>();
+    }
+    return {Type::TypeTraits<T>::NumericType::rank, std::is_signed_v<T>, std::is_integral_v<T>, 
+            std::numeric_limits<T>::min(), std::numeric_limits<T>::max(), unsignedIndex};
+}
+
+template<size_t... I>
+constexpr std::array<NumericProperties, numNumericTypes> getNumericProperties(std::index_sequence<I...>)
+{
+    return {getNumericProperties<std::tuple_element_t<I, Type::NumericUnderlyingTypes>>()...};
+}
+
+template<size_t... I>
+constexpr std::array<const Type::NumericBase*, numNumericTypes> getNumericInstances(std::index_sequence<I...>)
+{
+    return {Type::TypeTraits<std::tuple_element_t<I, Type::NumericUnderlyingTypes>>::NumericType::getInstance()...};
+}
+//----------------------------------------------------------------------------
+constexpr auto numericProperties = getNumericProperties(std::make_index_sequence<numNumericTypes>());
+
+//! Instance of each numeric type
+constexpr auto numericInstances = getNumericInstances(std::make_index_sequence<numNumericTypes>());
+
+//! Index of type each numeric type is promoted to
+constexpr auto promotedTypes = []()
+{
+    // If a small integer type is used in an expression, it is implicitly converted to int which is always signed. 
+    // This is known as the integer promotions or the integer promotion rule 
+    // **NOTE** this is true because in our type system unsigned short is uint16 which can be represented in int32
+    constexpr size_t int32Index = Type::getNumericIndex<int32_t>();
+    std::array<size_t, numNumericTypes> types{};
+    for(size_t i = 0; i < numNumericTypes; i++) {
+        types[i] = (numericProperties[i].rank < numericProperties[int32Index].rank) ? int32Index : i;
+    }
+    return types;
+}();
+
+//! Index of common type of each pair of numeric types
+constexpr auto commonTypes = []()
+{
+    constexpr size_t floatIndex = Type::getNumericIndex<float>();
+    constexpr size_t doubleIndex = Type::getNumericIndex<double>();
+
+    std::array<std::array<size_t, numNumericTypes>, numNumericTypes> types{};
+    for(size_t a = 0; a < numNumericTypes; a++) {
+        for(size_t b = 0; b < numNumericTypes; b++) {
+            // If either type is double, common type is double
+            if(a == doubleIndex || b == doubleIndex) {
+                types[a][b] = doubleIndex;
+            }
+            // Otherwise, if either type is float, common type is float
+            else if(a == floatIndex || b == floatIndex) {
+                types[a][b] = floatIndex;
+            }
+            // Otherwise, must be an integer type
+            else {
+                // Promote both numericTypes
+                const size_t aPromoted = promotedTypes[a];
+                const size_t bPromoted = promotedTypes[b];
+                const auto &aProps = numericProperties[aPromoted];
+                const auto &bProps = numericProperties[bPromoted];
+
+                // If both promoted operands have the same type, then no further conversion is needed.
+                if(aPromoted == bPromoted) {
+                    types[a][b] = aPromoted;
+                }
+                // Otherwise, if both promoted operands have signed integer numericTypes or both have unsigned integer numericTypes, 
+                // the operand with the type of lesser integer conversion rank is converted to the type of the operand with greater rank.
+                else if(aProps.isSigned == bProps.isSigned) {
+                    types[a][b] = (aProps.rank > bProps.rank) ? aPromoted : bPromoted;
+                }
+                // Otherwise, if signedness of promoted operands differ
+                else {
+                    const size_t signedOp = aProps.isSigned ? aPromoted : bPromoted;
+                    const size_t unsignedOp = aProps.isSigned ? bPromoted : aPromoted;
+                    const auto &signedProps = numericProperties[signedOp];
+                    const auto &unsignedProps = numericProperties[unsignedOp];
+
+                    // Otherwise, if the operand that has unsigned integer type has rank greater or equal to the rank of the type of the other operand, 
+                    // then the operand with signed integer type is converted to the type of the operand with unsigned integer type.
+                    if(unsignedProps.rank >= signedProps.rank) {
+                        types[a][b] = unsignedOp;
+                    }
+                    // Otherwise, if the type of the operand with signed integer type can represent all of the values of the type of the operand with unsigned integer type, 
+                    // then the operand with unsigned integer type is converted to the type of the operand with signed integer type.
+                    else if(signedProps.min <= unsignedProps.min && signedProps.max >= unsignedProps.max) {
+                        types[a][b] = signedOp;
+                    }
+                    // Otherwise, both operands are converted to the unsigned integer type corresponding to the type of the operand with signed integer type.
+                    else {
+                        types[a][b] = signedProps.unsignedIndex;
+                    }
+                }
+            }
+        }
+    }
+    return types;
+}();
 }   // Anonymous namespace
 
 //----------------------------------------------------------------------------
@@ -62,78 +204,36 @@ IMPLEMENT_TYPE(Sqrt);
 //----------------------------------------------------------------------------
 // Free functions
 //----------------------------------------------------------------------------
-const NumericBase *getNumericType(const std::set<std::string_view> &typeSpecifiers)
+TypeSpecifiers getTypeSpecifier(std::string_view keyword)
+{
+    for(size_t i = 0; i < typeSpecifierKeywords.size(); i++) {
+        if(typeSpecifierKeywords[i] == keyword) {
+            return static_cast<TypeSpecifiers>(1 << i);
+        }
+    }
+    return 0;
+}
+//----------------------------------------------------------------------------
+const NumericBase *getNumericType(TypeSpecifiers typeSpecifiers)
 {
-    const auto type = numericTypes.find(typeSpecifiers);
-    return (type == numericTypes.cend()) ? nullptr : type->second;
+    assert(typeSpecifiers < numericTypes.size());
+    const int type = numericTypes[typeSpecifiers];
+    return (type == -1) ? nullptr : numericInstances[type];
 }
 //----------------------------------------------------------------------------
-const NumericPtrBase *getNumericPtrType(const std::set<std::string_view> &typeSpecifiers)
+const NumericPtrBase *getNumericPtrType(TypeSpecifiers typeSpecifiers)
 {
-    const auto type = numericTypes.find(typeSpecifiers);
-    return (type == numericTypes.cend()) ? nullptr : type->second->getPointerType();
+    const auto *type = getNumericType(typeSpecifiers);
+    return type ? type->getPointerType() : nullptr;
 }
 //----------------------------------------------------------------------------
 const NumericBase *getPromotedType(const NumericBase *type)
 {
-    // If a small integer type is used in an expression, it is implicitly converted to int which is always signed. 
-    // This is known as the integer promotions or the integer promotion rule 
-    // **NOTE** this is true because in our type system unsigned short is uint16 which can be represented in int32
-    if(type->getRank() < Int32::getInstance()->getRank()) {
-        return Int32::getInstance();
-    }
-    else {
-        return type;
-    }
+    return numericInstances[promotedTypes[type->getIndex()]];
 }
 //----------------------------------------------------------------------------
 const NumericBase *getCommonType(const NumericBase *a, const NumericBase *b)
 {
-    // If either type is double, common type is double
-    const auto aTypeHash = a->getTypeHash();
-    const auto bTypeHash = b->getTypeHash();
-    if(aTypeHash == Double::getInstance()->getTypeHash() || bTypeHash == Double::getInstance()->getTypeHash()) {
-        return Double::getInstance();
-    }
-    // Otherwise, if either type is float, common type is float
-    if(aTypeHash == Float::getInstance()->getTypeHash() || bTypeHash == Float::getInstance()->getTypeHash()) {
-        return Float::getInstance();
-    }
-    // Otherwise, must be an integer type
-    else {
-        // Promote both numericTypes
-        const auto *aPromoted = getPromotedType(a);
-        const auto *bPromoted = getPromotedType(b);
-
-        // If both promoted operands have the same type, then no further conversion is needed.
-        if(aPromoted->getTypeHash() == bPromoted->getTypeHash()) {
-            return aPromoted;
-        }
-        // Otherwise, if both promoted operands have signed integer numericTypes or both have unsigned integer numericTypes, 
-        // the operand with the type of lesser integer conversion rank is converted to the type of the operand with greater rank.
-        else if(aPromoted->isSigned() == bPromoted->isSigned()) {
-            return (aPromoted->getRank() > bPromoted->getRank()) ? aPromoted : bPromoted;
-        }
-        // Otherwise, if signedness of promoted operands differ
-        else {
-            const auto *signedOp = aPromoted->isSigned() ? aPromoted : bPromoted;
-            const auto *unsignedOp = aPromoted->isSigned() ? bPromoted : aPromoted;
-
-            // Otherwise, if the operand that has unsigned integer type has rank greater or equal to the rank of the type of the other operand, 
-            // then the operand with signed integer type is converted to the type of the operand with unsigned integer type.
-            if(unsignedOp->getRank() >= signedOp->getRank()) {
-                return unsignedOp;
-            }
-            // Otherwise, if the type of the operand with signed integer type can represent all of the values of the type of the operand with unsigned integer type, 
-            // then the operand with unsigned integer type is converted to the type of the operand with signed integer type.
-            else if(signedOp->getMin() <= unsignedOp->getMin() && signedOp->getMax() >= unsignedOp->getMax()) {
-                return signedOp;
-            }
-            // Otherwise, both operands are converted to the unsigned integer type corresponding to the type of the operand with signed integer type.
-            else {
-                return unsignedType.at(signedOp);
-            }
-        }
-    }
+    return numericInstances[commonTypes[a->getIndex()][b->getIndex()]];
+}
 }
-}
\ No newline at end of file
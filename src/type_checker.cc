@@ -1,10 +1,16 @@
 #include "type_checker.h"
 
 // Standard C++ includes
+#include <algorithm>
+#include <optional>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 // Standard C includes
 #include <cassert>
+#include <cstdint>
 
 // GeNN includes
 #include "type.h"
@@ -22,6 +28,9 @@ using namespace MiniParse::TypeChecker;
 //---------------------------------------------------------------------------
 namespace
 {
+//! Case values are looked up in a jump table rather than by binary search if at least this fraction of table entries are used
+constexpr size_t minJumpTableDensityDivisor = 4;
+
 //---------------------------------------------------------------------------
 // TypeCheckError
 //---------------------------------------------------------------------------
@@ -29,6 +38,244 @@ class TypeCheckError
 {
 };
 
+//---------------------------------------------------------------------------
+// ConstantEvaluator
+//---------------------------------------------------------------------------
+//! Visitor which evaluates type-checked integer constant expressions, such as case values
+class ConstantEvaluator : public Expression::Visitor
+{
+public:
+    ConstantEvaluator(const ResolvedTypeMap &resolvedTypes)
+    :   m_ResolvedTypes(resolvedTypes)
+    {
+    }
+
+    //---------------------------------------------------------------------------
+    // Public API
+    //---------------------------------------------------------------------------
+    //! Evaluate expression, returning nothing if it isn't an integer constant expression
+    std::optional<int64_t> evaluate(const Expression::Base *expression)
+    {
+        expression->accept(*this);
+        if(m_Value) {
+            m_Value = convert(*m_Value, getType(expression));
+        }
+        return m_Value;
+    }
+
+    //! Convert value to integral type, wrapping as C++ would
+    static std::optional<int64_t> convert(int64_t value, const Type::NumericBase *type)
+    {
+        if(type == Type::Bool::getInstance()) {
+            return (value != 0);
+        }
+        else if(type == Type::Int8::getInstance()) {
+            return static_cast<int8_t>(value);
+        }
+        else if(type == Type::Int16::getInstance()) {
+            return static_cast<int16_t>(value);
+        }
+        else if(type == Type::Int32::getInstance()) {
+            return static_cast<int32_t>(value);
+        }
+        else if(type == Type::Uint8::getInstance()) {
+            return static_cast<uint8_t>(value);
+        }
+        else if(type == Type::Uint16::getInstance()) {
+            return static_cast<uint16_t>(value);
+        }
+        else if(type == Type::Uint32::getInstance()) {
+            return static_cast<uint32_t>(value);
+        }
+        else {
+            return std::nullopt;
+        }
+    }
+
+    //---------------------------------------------------------------------------
+    // Expression::Visitor virtuals
+    //---------------------------------------------------------------------------
+    virtual void visit(const Expression::ArraySubscript&) final
+    {
+        m_Value = std::nullopt;
+    }
+
+    virtual void visit(const Expression::Assignment&) final
+    {
+        m_Value = std::nullopt;
+    }
+
+    virtual void visit(const Expression::Binary &binary) final
+    {
+        const auto opType = binary.getOperator().type;
+        const auto *leftType = getType(binary.getLeft());
+        const auto *rightType = getType(binary.getRight());
+        if(opType == Token::Type::COMMA || !leftType || !rightType) {
+            m_Value = std::nullopt;
+            return;
+        }
+
+        // Shifts are performed in promoted type of left operand, other operations in common type
+        const bool shift = (opType == Token::Type::SHIFT_LEFT || opType == Token::Type::SHIFT_RIGHT);
+        const auto *operationType = shift ? Type::getPromotedType(leftType) : Type::getCommonType(leftType, rightType);
+        const auto left = evaluateAs(binary.getLeft(), operationType);
+        const auto right = evaluateAs(binary.getRight(), shift ? Type::getPromotedType(rightType) : operationType);
+        if(!left || !right) {
+            m_Value = std::nullopt;
+            return;
+        }
+
+        const int64_t l = *left;
+        const int64_t r = *right;
+        switch(opType) {
+        case Token::Type::PLUS:             m_Value = l + r; break;
+        case Token::Type::MINUS:            m_Value = l - r; break;
+        case Token::Type::STAR:             m_Value = l * r; break;
+        case Token::Type::AMPERSAND:        m_Value = l & r; break;
+        case Token::Type::PIPE:             m_Value = l | r; break;
+        case Token::Type::CARET:            m_Value = l ^ r; break;
+        case Token::Type::LESS:             m_Value = (l < r); break;
+        case Token::Type::LESS_EQUAL:       m_Value = (l <= r); break;
+        case Token::Type::GREATER:          m_Value = (l > r); break;
+        case Token::Type::GREATER_EQUAL:    m_Value = (l >= r); break;
+        case Token::Type::EQUAL_EQUAL:      m_Value = (l == r); break;
+        case Token::Type::NOT_EQUAL:        m_Value = (l != r); break;
+        case Token::Type::SLASH:            m_Value = (r == 0) ? std::nullopt : std::make_optional(l / r); break;
+        case Token::Type::PERCENT:          m_Value = (r == 0) ? std::nullopt : std::make_optional(l % r); break;
+        case Token::Type::SHIFT_LEFT:       m_Value = (r < 0 || r >= 32) ? std::nullopt : std::make_optional(static_cast<int64_t>(static_cast<uint64_t>(l) << r)); break;
+        case Token::Type::SHIFT_RIGHT:      m_Value = (r < 0 || r >= 32) ? std::nullopt : std::make_optional(l >> r); break;
+        default:                            m_Value = std::nullopt; break;
+        }
+    }
+
+    virtual void visit(const Expression::Call&) final
+    {
+        m_Value = std::nullopt;
+    }
+
+    virtual void visit(const Expression::Cast &cast) final
+    {
+        // **NOTE** floating point literals can be cast to integer types
+        const auto *literal = dynamic_cast<const Expression::Literal*>(cast.getExpression());
+        const auto *castType = Type::dynamicCast<Type::NumericBase>(cast.getType());
+        if(literal && castType && castType->isIntegral()) {
+            m_Value = std::visit(
+                Utils::Overload{
+                    [](auto v)->std::optional<int64_t> { return static_cast<int64_t>(v); },
+                    [](std::monostate)->std::optional<int64_t> { return std::nullopt; }},
+                literal->getValue());
+        }
+        else {
+            cast.getExpression()->accept(*this);
+        }
+    }
+
+    virtual void visit(const Expression::Conditional &conditional) final
+    {
+        const auto condition = evaluate(conditional.getCondition());
+        if(condition) {
+            evaluate(*condition ? conditional.getTrue() : conditional.getFalse());
+        }
+    }
+
+    virtual void visit(const Expression::Grouping &grouping) final
+    {
+        grouping.getExpression()->accept(*this);
+    }
+
+    virtual void visit(const Expression::Literal &literal) final
+    {
+        m_Value = std::visit(
+            Utils::Overload{
+                [](auto v)->std::optional<int64_t>
+                {
+                    if constexpr(std::is_integral_v<decltype(v)>) {
+                        return static_cast<int64_t>(v);
+                    }
+                    else {
+                        return std::nullopt;
+                    }
+                },
+                [](std::monostate)->std::optional<int64_t> { return std::nullopt; }},
+            literal.getValue());
+    }
+
+    virtual void visit(const Expression::Logical &logical) final
+    {
+        // **NOTE** right operand must be constant even if it isn't evaluated
+        const auto left = evaluate(logical.getLeft());
+        const auto right = evaluate(logical.getRight());
+        if(left && right) {
+            m_Value = (logical.getOperator().type == Token::Type::AMPERSAND_AMPERSAND) ? (*left && *right) : (*left || *right);
+        }
+        else {
+            m_Value = std::nullopt;
+        }
+    }
+
+    virtual void visit(const Expression::PostfixIncDec&) final
+    {
+        m_Value = std::nullopt;
+    }
+
+    virtual void visit(const Expression::PrefixIncDec&) final
+    {
+        m_Value = std::nullopt;
+    }
+
+    virtual void visit(const Expression::Variable&) final
+    {
+        m_Value = std::nullopt;
+    }
+
+    virtual void visit(const Expression::Unary &unary) final
+    {
+        const auto opType = unary.getOperator().type;
+        const auto *rightType = getType(unary.getRight());
+        const auto right = rightType ? evaluateAs(unary.getRight(), Type::getPromotedType(rightType)) : std::nullopt;
+        if(!right) {
+            m_Value = std::nullopt;
+        }
+        else if(opType == Token::Type::PLUS) {
+            m_Value = *right;
+        }
+        else if(opType == Token::Type::MINUS) {
+            m_Value = -*right;
+        }
+        else if(opType == Token::Type::TILDA) {
+            m_Value = ~*right;
+        }
+        else if(opType == Token::Type::NOT) {
+            m_Value = !*right;
+        }
+        else {
+            m_Value = std::nullopt;
+        }
+    }
+
+private:
+    //---------------------------------------------------------------------------
+    // Private methods
+    //---------------------------------------------------------------------------
+    const Type::NumericBase *getType(const Expression::Base *expression) const
+    {
+        const auto type = m_ResolvedTypes.find(expression);
+        return (type == m_ResolvedTypes.cend()) ? nullptr : Type::dynamicCast<Type::NumericBase>(type->second);
+    }
+
+    std::optional<int64_t> evaluateAs(const Expression::Base *expression, const Type::NumericBase *type)
+    {
+        const auto value = evaluate(expression);
+        return value ? convert(*value, type) : std::nullopt;
+    }
+
+    //---------------------------------------------------------------------------
+    // Members
+    //---------------------------------------------------------------------------
+    const ResolvedTypeMap &m_ResolvedTypes;
+    std::optional<int64_t> m_Value;
+};
+
 //---------------------------------------------------------------------------
 // Vistor
 //---------------------------------------------------------------------------
@@ -36,7 +283,7 @@ class Visitor : public Expression::Visitor, public Statement::Visitor
 {
 public:
     Visitor(ErrorHandler &errorHandler)
-        : m_Environment(nullptr), m_Type(nullptr), m_Const(false),
+        : m_Environment(nullptr), m_ScopeDepth(0), m_Type(nullptr), m_Const(false),
         m_ErrorHandler(errorHandler), m_InLoop(false), m_InSwitch(false)
     {
     }
@@ -44,13 +291,17 @@ public:
     //---------------------------------------------------------------------------
     // Public API
     //---------------------------------------------------------------------------
+    const Resolution &getResolution() const{ return m_Resolution; }
+
     void typeCheck(const Statement::StatementList &statements, Environment &environment)
     {
         Environment *previous = m_Environment;
         m_Environment = &environment;
+        m_ScopeDepth++;
         for (auto &s : statements) {
             s.get()->accept(*this);
         }
+        m_ScopeDepth--;
         m_Environment = previous;
     }
 
@@ -60,14 +311,17 @@ public:
     virtual void visit(const Expression::ArraySubscript &arraySubscript) final
     {
         // Get pointer type
-        auto pointerType = dynamic_cast<const Type::NumericPtrBase *>(
+        auto pointerType = Type::dynamicCast<Type::NumericPtrBase>(
             std::get<0>(m_Environment->getType(arraySubscript.getPointerName(), m_ErrorHandler)));
 
         // If pointer is indeed a pointer
         if (pointerType) {
             // Evaluate pointer type
-            auto indexType = evaluateType(arraySubscript.getIndex().get());
-            auto indexNumericType = dynamic_cast<const Type::NumericBase *>(indexType);
+            if (evaluateOperands({arraySubscript.getIndex().get()})) {
+                return;
+            }
+            auto indexType = std::get<0>(popOperand());
+            auto indexNumericType = Type::dynamicCast<Type::NumericBase>(indexType);
             if (!indexNumericType || !indexNumericType->isIntegral()) {
                 m_ErrorHandler.error(arraySubscript.getPointerName(),
                                      "Invalid subscript index type '" + indexType->getTypeName() + "'");
@@ -87,30 +341,38 @@ public:
 
     virtual void visit(const Expression::Assignment &assignment) final
     {
-        const auto [rhsType, rhsConst] = evaluateTypeConst(assignment.getValue());
+        if (evaluateOperands({assignment.getValue()})) {
+            return;
+        }
+        const auto [rhsType, rhsConst] = popOperand();
         m_Type = m_Environment->assign(assignment.getVarName(), rhsType, rhsConst,
                                        assignment.getOperator().type, m_ErrorHandler);
         m_Const = false;
+        m_Resolution.slots[&assignment] = resolveSlot(assignment.getVarName());
     }
 
     virtual void visit(const Expression::Binary &binary) final
     {
+        // Evaluate right operand and then left
+        if (evaluateOperands({binary.getRight(), binary.getLeft()})) {
+            return;
+        }
         const auto opType = binary.getOperator().type;
-        const auto [rightType, rightConst] = evaluateTypeConst(binary.getRight());
+        const auto [leftType, leftConst] = popOperand();
+        const auto [rightType, rightConst] = popOperand();
         if (opType == Token::Type::COMMA) {
             m_Type = rightType;
             m_Const = rightConst;
         }
         else {
             // If we're subtracting two pointers
-            const auto [leftType, leftConst] = evaluateTypeConst(binary.getLeft());
-            auto leftNumericType = dynamic_cast<const Type::NumericBase *>(leftType);
-            auto rightNumericType = dynamic_cast<const Type::NumericBase *>(rightType);
-            auto leftNumericPtrType = dynamic_cast<const Type::NumericPtrBase *>(leftType);
-            auto rightNumericPtrType = dynamic_cast<const Type::NumericPtrBase *>(rightType);
+            auto leftNumericType = Type::dynamicCast<Type::NumericBase>(leftType);
+            auto rightNumericType = Type::dynamicCast<Type::NumericBase>(rightType);
+            auto leftNumericPtrType = Type::dynamicCast<Type::NumericPtrBase>(leftType);
+            auto rightNumericPtrType = Type::dynamicCast<Type::NumericPtrBase>(rightType);
             if (leftNumericPtrType && rightNumericPtrType && opType == Token::Type::MINUS) {
                 // Check pointers are compatible
-                if (leftNumericPtrType->getTypeHash() != rightNumericPtrType->getTypeHash()) {
+                if (leftNumericPtrType->getID() != rightNumericPtrType->getID()) {
                     m_ErrorHandler.error(binary.getOperator(), "Invalid operand types '" + leftType->getTypeName() + "' and '" + rightType->getTypeName());
                     throw TypeCheckError();
                 }
@@ -169,6 +431,14 @@ public:
                         m_Const = false;
                     }
                 }
+                // Otherwise, if operator is relational or equality, result is an int like a logical operator
+                else if (opType == Token::Type::GREATER || opType == Token::Type::GREATER_EQUAL
+                         || opType == Token::Type::LESS || opType == Token::Type::LESS_EQUAL
+                         || opType == Token::Type::EQUAL_EQUAL || opType == Token::Type::NOT_EQUAL)
+                {
+                    m_Type = Type::Int32::getInstance();
+                    m_Const = false;
+                }
                 // Otherwise, any numeric type will do, take common type
                 else {
                     m_Type = Type::getCommonType(leftNumericType, rightNumericType);
@@ -185,8 +455,13 @@ public:
     virtual void visit(const Expression::Call &call) final
     {
         // Evaluate callee type
-        auto calleeType = evaluateType(call.getCallee());
-        auto calleeFunctionType = dynamic_cast<const Type::ForeignFunctionBase *>(calleeType);
+        const size_t numOperands = m_Frames.back().numOperands;
+        if (numOperands == 0) {
+            pushOperand(call.getCallee());
+            return;
+        }
+        auto calleeType = std::get<0>(m_Operands[m_Operands.size() - numOperands]);
+        auto calleeFunctionType = Type::dynamicCast<Type::ForeignFunctionBase>(calleeType);
 
         // If callee's a function
         if (calleeFunctionType) {
@@ -201,12 +476,16 @@ public:
                 throw TypeCheckError();
             }
             else {
-                // Loop through arguments
+                // Evaluate next argument type
                 // **TODO** check
-                /*for(size_t i = 0; i < argTypes.size(); i++) {
-                    // Evaluate argument type
-                    auto callArgType = evaluateType(call.getArguments().at(i).get());
-                }*/
+                if (numOperands <= argTypes.size()) {
+                    pushOperand(call.getArguments().at(numOperands - 1).get());
+                    return;
+                }
+
+                // Pop argument and callee types
+                m_Operands.resize(m_Operands.size() - numOperands);
+
                 // Type is return type of function
                 m_Type = calleeFunctionType->getReturnType();
                 m_Const = false;
@@ -223,16 +502,24 @@ public:
     {
         // **TODO** any numeric can be cast to any numeric and any pointer to pointer but no intermixing
         // **TODO** const cannot be removed like this
+        if (evaluateOperands({cast.getExpression()})) {
+            return;
+        }
+        popOperand();
         m_Type = cast.getType();
         m_Const = cast.isConst();
     }
 
     virtual void visit(const Expression::Conditional &conditional) final
     {
-        const auto [trueType, trueConst] = evaluateTypeConst(conditional.getTrue());
-        const auto [falseType, falseConst] = evaluateTypeConst(conditional.getFalse());
-        auto trueNumericType = dynamic_cast<const Type::NumericBase *>(trueType);
-        auto falseNumericType = dynamic_cast<const Type::NumericBase *>(falseType);
+        if (evaluateOperands({conditional.getCondition(), conditional.getTrue(), conditional.getFalse()})) {
+            return;
+        }
+        const auto [falseType, falseConst] = popOperand();
+        const auto [trueType, trueConst] = popOperand();
+        popOperand();
+        auto trueNumericType = Type::dynamicCast<Type::NumericBase>(trueType);
+        auto falseNumericType = Type::dynamicCast<Type::NumericBase>(falseType);
         if (trueNumericType && falseNumericType) {
             m_Type = Type::getCommonType(trueNumericType, falseNumericType);
             m_Const = trueConst || falseConst;
@@ -246,7 +533,10 @@ public:
 
     virtual void visit(const Expression::Grouping &grouping) final
     {
-        std::tie(m_Type, m_Const) = evaluateTypeConst(grouping.getExpression());
+        if (evaluateOperands({grouping.getExpression()})) {
+            return;
+        }
+        std::tie(m_Type, m_Const) = popOperand();
     }
 
     virtual void visit(const Expression::Literal &literal) final
@@ -261,8 +551,10 @@ public:
 
     virtual void visit(const Expression::Logical &logical) final
     {
-        logical.getLeft()->accept(*this);
-        logical.getRight()->accept(*this);
+        if (evaluateOperands({logical.getLeft(), logical.getRight()})) {
+            return;
+        }
+        m_Operands.resize(m_Operands.size() - 2);
         m_Type = Type::Int32::getInstance();
         m_Const = false;
     }
@@ -272,6 +564,7 @@ public:
         m_Type = m_Environment->incDec(postfixIncDec.getVarName(),
                                        postfixIncDec.getOperator(), m_ErrorHandler);
         m_Const = false;
+        m_Resolution.slots[&postfixIncDec] = resolveSlot(postfixIncDec.getVarName());
     }
 
     virtual void visit(const Expression::PrefixIncDec &prefixIncDec) final
@@ -279,20 +572,25 @@ public:
         m_Type = m_Environment->incDec(prefixIncDec.getVarName(),
                                        prefixIncDec.getOperator(), m_ErrorHandler);
         m_Const = false;
+        m_Resolution.slots[&prefixIncDec] = resolveSlot(prefixIncDec.getVarName());
     }
 
     virtual void visit(const Expression::Variable &variable)
     {
         std::tie(m_Type, m_Const) = m_Environment->getType(variable.getName(), m_ErrorHandler);
+        m_Resolution.slots[&variable] = resolveSlot(variable.getName());
     }
 
     virtual void visit(const Expression::Unary &unary) final
     {
-        const auto [rightType, rightConst] = evaluateTypeConst(unary.getRight());
+        if (evaluateOperands({unary.getRight()})) {
+            return;
+        }
+        const auto [rightType, rightConst] = popOperand();
 
         // If operator is pointer de-reference
         if (unary.getOperator().type == Token::Type::STAR) {
-            auto rightNumericPtrType = dynamic_cast<const Type::NumericPtrBase *>(rightType);
+            auto rightNumericPtrType = Type::dynamicCast<Type::NumericPtrBase>(rightType);
             if (!rightNumericPtrType) {
                 m_ErrorHandler.error(unary.getOperator(),
                                      "Invalid operand type '" + rightType->getTypeName() + "'");
@@ -307,7 +605,7 @@ public:
         }
         // Otherwise
         else {
-            auto rightNumericType = dynamic_cast<const Type::NumericBase *>(rightType);
+            auto rightNumericType = Type::dynamicCast<Type::NumericBase>(rightType);
             if (rightNumericType) {
                 // If operator is arithmetic, return promoted type
                 if (unary.getOperator().type == Token::Type::PLUS || unary.getOperator().type == Token::Type::MINUS) {
@@ -360,6 +658,7 @@ public:
     {
         Environment environment(m_Environment);
         typeCheck(compound.getStatements(), environment);
+        m_Resolution.statementSlots[&compound] = environment.getNumSlots();
     }
 
     virtual void visit(const Statement::Continue &continueStatement) final
@@ -371,15 +670,16 @@ public:
 
     virtual void visit(const Statement::Do &doStatement) final
     {
+        const bool previousInLoop = m_InLoop;
         m_InLoop = true;
         doStatement.getBody()->accept(*this);
-        m_InLoop = false;
-        doStatement.getCondition()->accept(*this);
+        m_InLoop = previousInLoop;
+        evaluateType(doStatement.getCondition());
     }
 
     virtual void visit(const Statement::Expression &expression) final
     {
-        expression.getExpression()->accept(*this);
+        evaluateType(expression.getExpression());
     }
 
     virtual void visit(const Statement::For &forStatement) final
@@ -388,6 +688,7 @@ public:
         Environment *previous = m_Environment;
         Environment environment(m_Environment);
         m_Environment = &environment;
+        m_ScopeDepth++;
 
         // Interpret initialiser if statement present
         if (forStatement.getInitialiser()) {
@@ -395,24 +696,27 @@ public:
         }
 
         if (forStatement.getCondition()) {
-            forStatement.getCondition()->accept(*this);
+            evaluateType(forStatement.getCondition());
         }
 
         if (forStatement.getIncrement()) {
-            forStatement.getIncrement()->accept(*this);
+            evaluateType(forStatement.getIncrement());
         }
 
+        const bool previousInLoop = m_InLoop;
         m_InLoop = true;
         forStatement.getBody()->accept(*this);
-        m_InLoop = false;
+        m_InLoop = previousInLoop;
 
         // Restore environment
+        m_Resolution.statementSlots[&forStatement] = environment.getNumSlots();
+        m_ScopeDepth--;
         m_Environment = previous;
     }
 
     virtual void visit(const Statement::If &ifStatement) final
     {
-        ifStatement.getCondition()->accept(*this);
+        evaluateType(ifStatement.getCondition());
         ifStatement.getThenBranch()->accept(*this);
         if (ifStatement.getElseBranch()) {
             ifStatement.getElseBranch()->accept(*this);
@@ -427,7 +731,7 @@ public:
 
         if (labelled.getValue()) {
             auto valType = evaluateType(labelled.getValue());
-            auto valNumericType = dynamic_cast<const Type::NumericBase *>(valType);
+            auto valNumericType = Type::dynamicCast<Type::NumericBase>(valType);
             if (!valNumericType || !valNumericType->isIntegral()) {
                 m_ErrorHandler.error(labelled.getKeyword(),
                                      "Invalid case value '" + valType->getTypeName() + "'");
@@ -435,26 +739,81 @@ public:
             }
         }
 
+        // Resolve label within enclosing switch statement
+        if (!m_SwitchContexts.empty()) {
+            auto &switchContext = m_SwitchContexts.back();
+            const auto statement = switchContext.labelStatements.find(&labelled);
+            Statement::Switch::Case labelCase{0, switchContext.numLabels++, 
+                                              (statement == switchContext.labelStatements.cend()) ? std::nullopt : std::make_optional(statement->second)};
+
+            // If label is a case, evaluate its value and convert to promoted type of condition
+            if (labelled.getValue()) {
+                ConstantEvaluator constantEvaluator(m_Resolution.types);
+                const auto value = constantEvaluator.evaluate(labelled.getValue());
+                if (!value) {
+                    m_ErrorHandler.error(labelled.getKeyword(), "Case value is not an integer constant expression");
+                    throw TypeCheckError();
+                }
+                labelCase.value = *ConstantEvaluator::convert(*value, switchContext.conditionType);
+                if (std::any_of(switchContext.cases.cbegin(), switchContext.cases.cend(),
+                                [&labelCase](const auto &c) { return c.value == labelCase.value; }))
+                {
+                    m_ErrorHandler.error(labelled.getKeyword(), "Duplicate case value");
+                    throw TypeCheckError();
+                }
+                switchContext.cases.push_back(labelCase);
+            }
+            // Otherwise, check it's the only default
+            else if (switchContext.defaultCase) {
+                m_ErrorHandler.error(labelled.getKeyword(), "Multiple default labels in one switch");
+                throw TypeCheckError();
+            }
+            else {
+                switchContext.defaultCase = labelCase;
+            }
+        }
+
         labelled.getBody()->accept(*this);
     }
 
     virtual void visit(const Statement::Switch &switchStatement) final
     {
         auto condType = evaluateType(switchStatement.getCondition());
-        auto condNumericType = dynamic_cast<const Type::NumericBase *>(condType);
+        auto condNumericType = Type::dynamicCast<Type::NumericBase>(condType);
         if (!condNumericType || !condNumericType->isIntegral()) {
             m_ErrorHandler.error(switchStatement.getSwitch(),
                                  "Invalid condition '" + condType->getTypeName() + "'");
             throw TypeCheckError();
         }
 
+        // Find labels which begin statements in body, following chains of labels such as 'case 1: case 2:'
+        m_SwitchContexts.push_back({Type::getPromotedType(condNumericType), {}, {}, {}, 0});
+        if (const auto *compoundBody = dynamic_cast<const Statement::Compound*>(switchStatement.getBody())) {
+            const auto &statements = compoundBody->getStatements();
+            for (size_t i = 0; i < statements.size(); i++) {
+                for (const auto *labelled = dynamic_cast<const Statement::Labelled*>(statements[i].get()); labelled;
+                     labelled = dynamic_cast<const Statement::Labelled*>(labelled->getBody()))
+                {
+                    m_SwitchContexts.back().labelStatements.emplace(labelled, i);
+                }
+            }
+        }
+
+        const bool previousInSwitch = m_InSwitch;
         m_InSwitch = true;
         switchStatement.getBody()->accept(*this);
-        m_InSwitch = false;
+        m_InSwitch = previousInSwitch;
+
+        // Resolve cases into table
+        auto &switchContext = m_SwitchContexts.back();
+        // **NOTE** tables are keyed by address so any left by a freed switch statement at the same address are replaced
+        m_Resolution.switchTables.insert_or_assign(&switchStatement, SwitchTable(std::move(switchContext.cases), switchContext.defaultCase));
+        m_SwitchContexts.pop_back();
     }
 
     virtual void visit(const Statement::VarDeclaration &varDeclaration) final
     {
+        m_Resolution.statementSlots[&varDeclaration] = m_Environment->getNumSlots();
         for (const auto &var : varDeclaration.getInitDeclaratorList()) {
             m_Environment->define(std::get<0>(var), varDeclaration.getType(),
                                   varDeclaration.isConst(), m_ErrorHandler);
@@ -465,32 +824,100 @@ public:
                 const auto [initialiserType, initialiserConst] = evaluateTypeConst(std::get<1>(var).get());
 
                 // Assign initialiser expression to variable
-                m_Environment->assign(std::get<0>(var), initialiserType, initialiserConst, Token::Type::EQUAL, m_ErrorHandler);
+                m_Environment->assign(std::get<0>(var), initialiserType, initialiserConst, Token::Type::EQUAL, m_ErrorHandler, true);
             }
         }
     }
 
     virtual void visit(const Statement::While &whileStatement) final
     {
-        whileStatement.getCondition()->accept(*this);
+        evaluateType(whileStatement.getCondition());
+        const bool previousInLoop = m_InLoop;
         m_InLoop = true;
         whileStatement.getBody()->accept(*this);
-        m_InLoop = false;
+        m_InLoop = previousInLoop;
     }
 
     virtual void visit(const Statement::Print &print) final
     {
-        print.getExpression()->accept(*this);
+        evaluateType(print.getExpression());
     }
 
 private:
+    //---------------------------------------------------------------------------
+    // SwitchContext
+    //---------------------------------------------------------------------------
+    //! Labels found so far within body of switch statement
+    struct SwitchContext
+    {
+        const Type::NumericBase *conditionType;
+        std::unordered_map<const Statement::Labelled*, size_t> labelStatements;
+        std::vector<Statement::Switch::Case> cases;
+        std::optional<Statement::Switch::Case> defaultCase;
+        size_t numLabels;
+    };
+
+    //---------------------------------------------------------------------------
+    // Frame
+    //---------------------------------------------------------------------------
+    //! Expression being evaluated and how many of its operands have been evaluated so far
+    struct Frame
+    {
+        const Expression::Base *expression;
+        size_t numOperands;
+    };
+
     //---------------------------------------------------------------------------
     // Private methods
     //---------------------------------------------------------------------------
     std::tuple<const Type::Base *, bool> evaluateTypeConst(const Expression::Base *expression)
     {
-        expression->accept(*this);
-        return std::make_tuple(m_Type, m_Const);
+        // **NOTE** rather than recursing, expressions are visited repeatedly from an explicit stack of 
+        // frames until they have evaluated all of their operands so nesting depth is only limited by heap memory
+        const size_t numFrames = m_Frames.size();
+        m_Frames.push_back({expression, 0});
+        while (m_Frames.size() > numFrames) {
+            // Visit expression at top of stack
+            const size_t numVisitFrames = m_Frames.size();
+            const auto *visitExpression = m_Frames.back().expression;
+            visitExpression->accept(*this);
+
+            // If visit didn't push an operand, it's complete so record type and push as operand of parent
+            if (m_Frames.size() == numVisitFrames) {
+                m_Resolution.types[visitExpression] = m_Type;
+                m_Operands.emplace_back(m_Type, m_Const);
+                m_Frames.pop_back();
+            }
+        }
+        return popOperand();
+    }
+
+    //! Push operand of expression being visited to be evaluated, after which expression will be visited again
+    void pushOperand(const Expression::Base *operand)
+    {
+        m_Frames.back().numOperands++;
+        m_Frames.push_back({operand, 0});
+    }
+
+    //! Push next operand of expression being visited to be evaluated, returning false once all have been evaluated
+    //! and their types are on the top of the operand stack (in order) for the expression to pop
+    bool evaluateOperands(std::initializer_list<const Expression::Base*> operands)
+    {
+        const size_t numOperands = m_Frames.back().numOperands;
+        if (numOperands < operands.size()) {
+            pushOperand(operands.begin()[numOperands]);
+            return true;
+        }
+        else {
+            return false;
+        }
+    }
+
+    std::tuple<const Type::Base *, bool> popOperand()
+    {
+        const auto operand = m_Operands.back();
+        m_Operands.pop_back();
+        return operand;
     }
 
     const Type::Base *evaluateType(const Expression::Base *expression)
@@ -498,56 +925,151 @@ private:
         return std::get<0>(evaluateTypeConst(expression));
     }
 
+    Expression::VariableSlot resolveSlot(const Token &name)
+    {
+        // If variable is defined in one of the scopes being checked, it's a local
+        const auto [depth, slot] = m_Environment->getSlot(name, m_ErrorHandler);
+        if(depth < m_ScopeDepth) {
+            return Expression::VariableSlot{false, depth, slot};
+        }
+        // Otherwise, it's defined in the environment provided by caller so give it a global index
+        else {
+            const auto global = m_GlobalIndices.try_emplace(m_Environment->getSymbol(name), m_GlobalIndices.size());
+            return Expression::VariableSlot{true, 0, global.first->second};
+        }
+    }
+
     //---------------------------------------------------------------------------
     // Members
     //---------------------------------------------------------------------------
     Environment *m_Environment;
+    size_t m_ScopeDepth;
+    std::unordered_map<Symbol, size_t> m_GlobalIndices;
     const Type::Base *m_Type;
     bool m_Const;
+    Resolution m_Resolution;
+
+    //! Stack of expressions being evaluated and of types of operands evaluated so far
+    std::vector<Frame> m_Frames;
+    std::vector<std::tuple<const Type::Base *, bool>> m_Operands;
 
     ErrorHandler &m_ErrorHandler;
     bool m_InLoop;
     bool m_InSwitch;
+    std::vector<SwitchContext> m_SwitchContexts;
 };
 }
 
+//---------------------------------------------------------------------------
+// MiniParse::TypeChecker::SwitchTable
+//---------------------------------------------------------------------------
+SwitchTable::SwitchTable(std::vector<Case> cases, std::optional<Case> defaultCase)
+:   m_Cases(std::move(cases)), m_Default(defaultCase)
+{
+    std::sort(m_Cases.begin(), m_Cases.end(), [](const Case &a, const Case &b) { return a.value < b.value; });
+
+    // If values are dense enough, build jump table
+    if(!m_Cases.empty()) {
+        const uint64_t range = static_cast<uint64_t>(m_Cases.back().value - m_Cases.front().value) + 1;
+        if(range <= (m_Cases.size() * minJumpTableDensityDivisor)) {
+            m_JumpTable.resize(range, static_cast<uint32_t>(m_Cases.size()));
+            for(size_t c = 0; c < m_Cases.size(); c++) {
+                m_JumpTable[m_Cases[c].value - m_Cases.front().value] = static_cast<uint32_t>(c);
+            }
+        }
+    }
+}
+//---------------------------------------------------------------------------
+const SwitchTable::Case *SwitchTable::findCase(int64_t value) const
+{
+    const Case *defaultCase = m_Default ? &m_Default.value() : nullptr;
+    if(m_Cases.empty() || value < m_Cases.front().value || value > m_Cases.back().value) {
+        return defaultCase;
+    }
+    else if(!m_JumpTable.empty()) {
+        const uint32_t c = m_JumpTable[value - m_Cases.front().value];
+        return (c == m_Cases.size()) ? defaultCase : &m_Cases[c];
+    }
+    else {
+        const auto c = std::lower_bound(m_Cases.cbegin(), m_Cases.cend(), value,
+                                        [](const Case &c, int64_t v) { return c.value < v; });
+        return (c->value == value) ? &(*c) : defaultCase;
+    }
+}
+
+//---------------------------------------------------------------------------
+// MiniParse::TypeChecker::Resolution
+//---------------------------------------------------------------------------
+std::optional<Expression::VariableSlot> Resolution::getSlot(const Expression::Base *expression) const
+{
+    const auto slot = slots.find(expression);
+    if(slot == slots.cend()) {
+        return std::nullopt;
+    }
+    else {
+        return slot->second;
+    }
+}
+//---------------------------------------------------------------------------
+size_t Resolution::getNumSlots(const Statement::Base *statement) const
+{
+    const auto numSlots = statementSlots.find(statement);
+    return (numSlots == statementSlots.cend()) ? 0 : numSlots->second;
+}
+//---------------------------------------------------------------------------
+size_t Resolution::getFirstSlot(const Statement::VarDeclaration *varDeclaration) const
+{
+    const auto firstSlot = statementSlots.find(varDeclaration);
+    return (firstSlot == statementSlots.cend()) ? 0 : firstSlot->second;
+}
+//---------------------------------------------------------------------------
+const SwitchTable &Resolution::getSwitchTable(const Statement::Switch *switchStatement) const
+{
+    const auto switchTable = switchTables.find(switchStatement);
+    if(switchTable == switchTables.cend()) {
+        throw std::runtime_error("Switch statement at line " + std::to_string(switchStatement->getSwitch().line)
+                                 + " has not been resolved by type checker");
+    }
+    return switchTable->second;
+}
+
 //---------------------------------------------------------------------------
 // MiniParse::TypeChecker::Environment
 //---------------------------------------------------------------------------
 void Environment::define(const Token &name, const Type::Base *type, bool isConst, ErrorHandler &errorHandler)
 {
-    if(!m_Types.try_emplace(name.lexeme, type, isConst).second) {
+    if(!m_Types.try_emplace(getSymbol(name), type, isConst, m_Types.size()).second) {
         errorHandler.error(name, "Redeclaration of variable");
         throw TypeCheckError();
     }
 }
 //---------------------------------------------------------------------------
 const Type::Base *Environment::assign(const Token &name, const Type::Base *assignedType, bool assignedConst, 
-                                      Token::Type op, ErrorHandler &errorHandler)
+                                      Token::Type op, ErrorHandler &errorHandler, bool initializer)
 {
     // If type isn't found
-    auto existingType = m_Types.find(name.lexeme);
+    auto existingType = m_Types.find(getSymbol(name));
     if(existingType == m_Types.end()) {
         if(m_Enclosing) {
             return m_Enclosing->assign(name, assignedType, 
-                                       assignedConst, op, errorHandler);
+                                       assignedConst, op, errorHandler, initializer);
         }
         else {
             errorHandler.error(name, "Undefined variable");
             throw TypeCheckError();
         }
     }
-    // Otherwise, if type is found and it's const, give error
-    else if(std::get<1>(existingType->second)) {
+    // Otherwise, if type is found and it's const, give error unless this is its initialiser
+    else if(!initializer && std::get<1>(existingType->second)) {
         errorHandler.error(name, "Assignment of read-only variable");
         throw TypeCheckError();
     }
 
-    auto numericExistingType = dynamic_cast<const Type::NumericBase *>(std::get<0>(existingType->second));
-    auto numericAssignedType = dynamic_cast<const Type::NumericBase *>(assignedType);
+    auto numericExistingType = Type::dynamicCast<Type::NumericBase>(std::get<0>(existingType->second));
+    auto numericAssignedType = Type::dynamicCast<Type::NumericBase>(assignedType);
 
-    auto numericPtrExistingType = dynamic_cast<const Type::NumericPtrBase *>(std::get<0>(existingType->second));
-    auto numericPtrAssignedType = dynamic_cast<const Type::NumericPtrBase *>(assignedType);
+    auto numericPtrExistingType = Type::dynamicCast<Type::NumericPtrBase>(std::get<0>(existingType->second));
+    auto numericPtrAssignedType = Type::dynamicCast<Type::NumericPtrBase>(assignedType);
 
     // If assignment operation is plain equals, any type is fine so return
     // **TODO** pointer type check
@@ -562,7 +1084,7 @@ const Type::Base *Environment::assign(const Token &name, const Type::Base *assig
             }*/
 
             // If pointer types aren't compatible
-            if (numericPtrExistingType->getTypeHash() != numericPtrAssignedType->getTypeHash()) {
+            if (numericPtrExistingType->getID() != numericPtrAssignedType->getID()) {
                 errorHandler.error(name, "Invalid operand types '" + numericPtrExistingType->getTypeName() + "' and '" + numericPtrAssignedType->getTypeName());
                 throw TypeCheckError();
             }
@@ -619,7 +1141,7 @@ const Type::Base *Environment::assign(const Token &name, const Type::Base *assig
 //---------------------------------------------------------------------------
 const Type::Base *Environment::incDec(const Token &name, const Token &op, ErrorHandler &errorHandler)
 {
-    auto existingType = m_Types.find(name.lexeme);
+    auto existingType = m_Types.find(getSymbol(name));
     if(existingType == m_Types.end()) {
         if(m_Enclosing) {
             return m_Enclosing->incDec(name, op, errorHandler);
@@ -637,7 +1159,7 @@ const Type::Base *Environment::incDec(const Token &name, const Token &op, ErrorH
     // Otherwise, return type
     // **TODO** pointer
     else {
-        auto numericExistingType = dynamic_cast<const Type::NumericBase *>(std::get<0>(existingType->second));
+        auto numericExistingType = Type::dynamicCast<Type::NumericBase>(std::get<0>(existingType->second));
         if(numericExistingType == nullptr) {
             errorHandler.error(op, "Invalid operand types '" + std::get<0>(existingType->second)->getTypeName() + "'");
             throw TypeCheckError();
@@ -650,7 +1172,7 @@ const Type::Base *Environment::incDec(const Token &name, const Token &op, ErrorH
 //---------------------------------------------------------------------------
 std::tuple<const Type::Base *, bool> Environment::getType(const Token &name, ErrorHandler &errorHandler) const
 {
-    auto type = m_Types.find(std::string{name.lexeme});
+    auto type = m_Types.find(getSymbol(name));
     if(type == m_Types.end()) {
         if(m_Enclosing) {
             return m_Enclosing->getType(name, errorHandler);
@@ -661,13 +1183,39 @@ std::tuple<const Type::Base *, bool> Environment::getType(const Token &name, Err
         }
     }
     else {
-        return type->second;
+        return std::make_tuple(std::get<0>(type->second), std::get<1>(type->second));
     }
 }
 //---------------------------------------------------------------------------
-void MiniParse::TypeChecker::typeCheck(const Statement::StatementList &statements, Environment &environment, 
-                                       ErrorHandler &errorHandler)
+std::tuple<size_t, size_t> Environment::getSlot(const Token &name, ErrorHandler &errorHandler) const
+{
+    auto type = m_Types.find(getSymbol(name));
+    if(type == m_Types.end()) {
+        if(m_Enclosing) {
+            const auto [depth, slot] = m_Enclosing->getSlot(name, errorHandler);
+            return std::make_tuple(depth + 1, slot);
+        }
+        else {
+            errorHandler.error(name, "Undefined variable");
+            throw TypeCheckError();
+        }
+    }
+    else {
+        return std::make_tuple(0, std::get<2>(type->second));
+    }
+}
+//---------------------------------------------------------------------------
+Symbol Environment::getSymbol(const Token &name) const
+{
+    return (name.symbol == Symbol::NONE) ? m_SymbolTable.intern(name.lexeme) : name.symbol;
+}
+//---------------------------------------------------------------------------
+Resolution MiniParse::TypeChecker::typeCheck(const Statement::StatementList &statements, Environment &environment, 
+                                             ErrorHandler &errorHandler)
 {
+    // Check statements in their own scope so variables they declare are kept separate from those provided
+    Environment programEnvironment(&environment);
     Visitor visitor(errorHandler);
-    visitor.typeCheck(statements, environment);
+    visitor.typeCheck(statements, programEnvironment);
+    return visitor.getResolution();
 }
\ No newline at end of file
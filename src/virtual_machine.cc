@@ -0,0 +1,148 @@
+#include "virtual_machine.h"
+
+// Standard C++ includes
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+//---------------------------------------------------------------------------
+// Macros
+//---------------------------------------------------------------------------
+// With GCC and Clang, use 'labels as values' extension to dispatch each instruction
+// with an indirect jump from the end of the previous one rather than a central switch
+#ifdef __GNUC__
+    #define MINI_PARSE_THREADED_DISPATCH
+#endif
+
+using namespace MiniParse::Bytecode;
+
+//---------------------------------------------------------------------------
+// MiniParse::Bytecode::VirtualMachine
+//---------------------------------------------------------------------------
+VirtualMachine::VirtualMachine(const Program &program)
+:   m_Program(program), m_Registers(program.getNumRegisters())
+{
+    if(program.getControlFlow() != ControlFlow::BRANCH) {
+        throw std::runtime_error("Programs compiled with masked control flow require BatchVirtualMachine");
+    }
+
+    // Copy constants into final registers
+    std::copy(program.getConstants().cbegin(), program.getConstants().cend(),
+              m_Registers.end() - program.getConstants().size());
+}
+//---------------------------------------------------------------------------
+void VirtualMachine::execute()
+{
+    const Instruction *pc = m_Program.getInstructions().data();
+    const Instruction *const instructions = pc;
+    Register *const r = m_Registers.data();
+    const Program::Function *const functions = m_Program.getFunctions().data();
+
+#ifdef MINI_PARSE_THREADED_DISPATCH
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Wpedantic"
+    #define MINI_PARSE_OPCODE_LABEL(OP) &&OP_##OP,
+    #define MINI_PARSE_MASKED_OPCODE_LABEL(OP) &&OP_INVALID,
+    static const void *const labels[] = {MINI_PARSE_OPCODES(MINI_PARSE_OPCODE_LABEL)
+                                         MINI_PARSE_MASKED_OPCODES(MINI_PARSE_MASKED_OPCODE_LABEL)};
+    #undef MINI_PARSE_OPCODE_LABEL
+    #undef MINI_PARSE_MASKED_OPCODE_LABEL
+
+    #define CASE(OP) OP_##OP:
+    #define DISPATCH() goto *labels[static_cast<size_t>(pc->opCode)]
+    #define NEXT() pc++; DISPATCH()
+    #define DISPATCH_JUMP() DISPATCH()
+    DISPATCH();
+#else
+    #define CASE(OP) case OpCode::OP:
+    #define NEXT() pc++; continue
+    #define DISPATCH_JUMP() continue
+    while(true) {
+        switch(pc->opCode) {
+#endif
+
+    #define ARITHMETIC_CASES(TYPE, FIELD)                                                                   \
+        CASE(ADD_##TYPE) r[pc->dst].FIELD = r[pc->a].FIELD + r[pc->b].FIELD; NEXT();                        \
+        CASE(SUB_##TYPE) r[pc->dst].FIELD = r[pc->a].FIELD - r[pc->b].FIELD; NEXT();                        \
+        CASE(MUL_##TYPE) r[pc->dst].FIELD = r[pc->a].FIELD * r[pc->b].FIELD; NEXT();                        \
+        CASE(DIV_##TYPE) r[pc->dst].FIELD = r[pc->a].FIELD / r[pc->b].FIELD; NEXT();                        \
+        CASE(LT_##TYPE) r[pc->dst].i32 = r[pc->a].FIELD < r[pc->b].FIELD; NEXT();                           \
+        CASE(LE_##TYPE) r[pc->dst].i32 = r[pc->a].FIELD <= r[pc->b].FIELD; NEXT();                          \
+        CASE(GT_##TYPE) r[pc->dst].i32 = r[pc->a].FIELD > r[pc->b].FIELD; NEXT();                           \
+        CASE(GE_##TYPE) r[pc->dst].i32 = r[pc->a].FIELD >= r[pc->b].FIELD; NEXT();                          \
+        CASE(EQ_##TYPE) r[pc->dst].i32 = r[pc->a].FIELD == r[pc->b].FIELD; NEXT();                          \
+        CASE(NE_##TYPE) r[pc->dst].i32 = r[pc->a].FIELD != r[pc->b].FIELD; NEXT();                          \
+        CASE(NEG_##TYPE) r[pc->dst].FIELD = -r[pc->a].FIELD; NEXT();                                        \
+        CASE(NOT_##TYPE) r[pc->dst].i32 = !r[pc->a].FIELD; NEXT();                                          \
+        CASE(MOV_##TYPE) r[pc->dst].FIELD = r[pc->a].FIELD; NEXT();
+
+    #define INTEGER_CASES(TYPE, FIELD)                                                                      \
+        CASE(MOD_##TYPE) r[pc->dst].FIELD = r[pc->a].FIELD % r[pc->b].FIELD; NEXT();                        \
+        CASE(AND_##TYPE) r[pc->dst].FIELD = r[pc->a].FIELD & r[pc->b].FIELD; NEXT();                        \
+        CASE(OR_##TYPE) r[pc->dst].FIELD = r[pc->a].FIELD | r[pc->b].FIELD; NEXT();                         \
+        CASE(XOR_##TYPE) r[pc->dst].FIELD = r[pc->a].FIELD ^ r[pc->b].FIELD; NEXT();                        \
+        CASE(SHL_##TYPE) r[pc->dst].FIELD = r[pc->a].FIELD << r[pc->b].FIELD; NEXT();                       \
+        CASE(SHR_##TYPE) r[pc->dst].FIELD = r[pc->a].FIELD >> r[pc->b].FIELD; NEXT();                       \
+        CASE(BNOT_##TYPE) r[pc->dst].FIELD = ~r[pc->a].FIELD; NEXT();
+
+    #define CONVERSION_CASE(FROM, FROM_FIELD, TO, TO_FIELD, TO_TYPE)                                        \
+        CASE(CVT_##FROM##_##TO) r[pc->dst].TO_FIELD = static_cast<TO_TYPE>(r[pc->a].FROM_FIELD); NEXT();
+
+    ARITHMETIC_CASES(I32, i32)
+    ARITHMETIC_CASES(U32, u32)
+    ARITHMETIC_CASES(F32, f32)
+    ARITHMETIC_CASES(F64, f64)
+    INTEGER_CASES(I32, i32)
+    INTEGER_CASES(U32, u32)
+
+    CONVERSION_CASE(I32, i32, U32, u32, uint32_t)
+    CONVERSION_CASE(I32, i32, F32, f32, float)
+    CONVERSION_CASE(I32, i32, F64, f64, double)
+    CONVERSION_CASE(U32, u32, I32, i32, int32_t)
+    CONVERSION_CASE(U32, u32, F32, f32, float)
+    CONVERSION_CASE(U32, u32, F64, f64, double)
+    CONVERSION_CASE(F32, f32, I32, i32, int32_t)
+    CONVERSION_CASE(F32, f32, U32, u32, uint32_t)
+    CONVERSION_CASE(F32, f32, F64, f64, double)
+    CONVERSION_CASE(F64, f64, I32, i32, int32_t)
+    CONVERSION_CASE(F64, f64, U32, u32, uint32_t)
+    CONVERSION_CASE(F64, f64, F32, f32, float)
+
+    CASE(SEXT8) r[pc->dst].i32 = static_cast<int8_t>(r[pc->a].i32); NEXT();
+    CASE(SEXT16) r[pc->dst].i32 = static_cast<int16_t>(r[pc->a].i32); NEXT();
+    CASE(ZEXT8) r[pc->dst].u32 = static_cast<uint8_t>(r[pc->a].u32); NEXT();
+    CASE(ZEXT16) r[pc->dst].u32 = static_cast<uint16_t>(r[pc->a].u32); NEXT();
+
+    CASE(PRINT_I32) std::cout << "(int32_t)" << r[pc->a].i32 << std::endl; NEXT();
+    CASE(PRINT_U32) std::cout << "(uint32_t)" << r[pc->a].u32 << std::endl; NEXT();
+    CASE(PRINT_F32) std::cout << "(float)" << r[pc->a].f32 << std::endl; NEXT();
+    CASE(PRINT_F64) std::cout << "(double)" << r[pc->a].f64 << std::endl; NEXT();
+    CASE(PRINT_BOOL) std::cout << "(bool)" << (r[pc->a].i32 != 0) << std::endl; NEXT();
+
+    CASE(JMP) pc = instructions + pc->dst; DISPATCH_JUMP();
+    CASE(JZ) pc = (r[pc->a].i32 == 0) ? (instructions + pc->dst) : (pc + 1); DISPATCH_JUMP();
+    CASE(JNZ) pc = (r[pc->a].i32 != 0) ? (instructions + pc->dst) : (pc + 1); DISPATCH_JUMP();
+    CASE(CALL_F64) r[pc->dst].f64 = functions[pc->b](r[pc->a].f64); NEXT();
+    CASE(HALT) return;
+
+#ifdef MINI_PARSE_THREADED_DISPATCH
+    OP_INVALID:
+        throw std::runtime_error("Invalid opcode '" + std::string{getOpCodeName(pc->opCode)} + "'");
+    #pragma GCC diagnostic pop
+#else
+        default:
+            throw std::runtime_error("Invalid opcode '" + std::string{getOpCodeName(pc->opCode)} + "'");
+        }
+    }
+#endif
+
+    #undef ARITHMETIC_CASES
+    #undef INTEGER_CASES
+    #undef CONVERSION_CASE
+    #undef CASE
+    #undef NEXT
+    #undef DISPATCH_JUMP
+#ifdef MINI_PARSE_THREADED_DISPATCH
+    #undef DISPATCH
+#endif
+}
@@ -0,0 +1,162 @@
+#include "work_stealing_pool.h"
+
+// Standard C++ includes
+#include <algorithm>
+#include <thread>
+
+//---------------------------------------------------------------------------
+// MiniParse::WorkStealingPool::Worker
+//---------------------------------------------------------------------------
+struct MiniParse::WorkStealingPool::Worker
+{
+    Worker(size_t index) : index(index), begin(0), end(0)
+    {}
+
+    const size_t index;
+    std::thread thread;
+
+    //! Range of task indices remaining to worker, protected by mutex so other workers can steal from it
+    std::mutex mutex;
+    size_t begin;
+    size_t end;
+};
+
+//---------------------------------------------------------------------------
+// MiniParse::WorkStealingPool
+//---------------------------------------------------------------------------
+MiniParse::WorkStealingPool::WorkStealingPool(size_t numThreads)
+:   m_Generation(0), m_NumRemaining(0), m_Stop(false)
+{
+    if(numThreads == 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Create workers and then start their threads
+    for(size_t i = 0; i < numThreads; i++) {
+        m_Workers.push_back(std::make_unique<Worker>(i));
+    }
+    for(auto &w : m_Workers) {
+        w->thread = std::thread(&WorkStealingPool::workerThread, this, std::ref(*w));
+    }
+}
+//---------------------------------------------------------------------------
+MiniParse::WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stop = true;
+    }
+    m_StartCondition.notify_all();
+    for(auto &w : m_Workers) {
+        w->thread.join();
+    }
+}
+//---------------------------------------------------------------------------
+void MiniParse::WorkStealingPool::run(size_t numTasks, Task task)
+{
+    // Give each worker a contiguous range of tasks
+    // **NOTE** workers are idle between runs so their state can be updated directly
+    m_Task = std::move(task);
+    for(auto &w : m_Workers) {
+        w->begin = (numTasks * w->index) / m_Workers.size();
+        w->end = (numTasks * (w->index + 1)) / m_Workers.size();
+    }
+
+    // Start workers
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_NumRemaining = m_Workers.size();
+        m_Exception = nullptr;
+        m_Generation++;
+    }
+    m_StartCondition.notify_all();
+
+    // Wait for all workers to complete
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_DoneCondition.wait(lock, [this]() { return (m_NumRemaining == 0); });
+    }
+    m_Task = nullptr;
+
+    // Re-throw first exception raised by any task
+    if(m_Exception) {
+        std::rethrow_exception(m_Exception);
+    }
+}
+//---------------------------------------------------------------------------
+void MiniParse::WorkStealingPool::workerThread(Worker &worker)
+{
+    size_t generation = 0;
+    while(true) {
+        // Wait for next run or for pool to be destroyed
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_StartCondition.wait(lock, [this, generation]() { return m_Stop || (m_Generation != generation); });
+            if(m_Stop) {
+                return;
+            }
+            generation = m_Generation;
+        }
+
+        // Run tasks until there are none left to take or steal
+        try {
+            size_t task;
+            while(getTask(worker, task)) {
+                m_Task(task, worker.index);
+            }
+        }
+        catch(...) {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if(!m_Exception) {
+                m_Exception = std::current_exception();
+            }
+        }
+
+        // Signal completion
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if(--m_NumRemaining == 0) {
+                m_DoneCondition.notify_one();
+            }
+        }
+    }
+}
+//---------------------------------------------------------------------------
+bool MiniParse::WorkStealingPool::getTask(Worker &worker, size_t &task)
+{
+    // If worker has tasks remaining in its own range, take the first
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if(worker.begin < worker.end) {
+            task = worker.begin++;
+            return true;
+        }
+    }
+
+    // Otherwise, visit other workers, starting with the next
+    for(size_t i = 1; i < m_Workers.size(); i++) {
+        Worker &victim = *m_Workers[(worker.index + i) % m_Workers.size()];
+
+        // If victim has tasks remaining, steal second half of its range, rounding up so single tasks can be stolen
+        size_t begin;
+        size_t end;
+        {
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if(victim.begin == victim.end) {
+                continue;
+            }
+            end = victim.end;
+            begin = victim.end - ((victim.end - victim.begin + 1) / 2);
+            victim.end = begin;
+        }
+
+        // Take first stolen task and make the rest worker's range
+        // **NOTE** worker's range is empty so others can't have stolen from it since it was checked
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        task = begin;
+        worker.begin = begin + 1;
+        worker.end = end;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+// Standard C++ includes
+#include <stdexcept>
+#include <string>
+
+// Mini-parse includes
+#include "error_handler.h"
+
+//---------------------------------------------------------------------------
+// Test::ErrorHandler
+//---------------------------------------------------------------------------
+//! Error handler which throws on the first error so tests fail on unexpected errors
+namespace Test
+{
+typedef MiniParse::ThrowingErrorHandler ErrorHandler;
+
+//---------------------------------------------------------------------------
+// Free functions
+//---------------------------------------------------------------------------
+//! Throw if condition doesn't hold
+inline void check(bool condition, const std::string &message)
+{
+    if(!condition) {
+        throw std::runtime_error(message);
+    }
+}
+}   // namespace Test
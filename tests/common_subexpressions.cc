@@ -0,0 +1,85 @@
+// Standard C++ includes
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+// Standard C includes
+#include <cstdlib>
+
+// Mini-parse includes
+#include "arena.h"
+#include "interpreter.h"
+#include "optimiser.h"
+#include "parser.h"
+#include "pretty_printer.h"
+#include "scanner.h"
+#include "symbol_table.h"
+#include "type.h"
+#include "type_checker.h"
+
+// Test includes
+#include "common.h"
+
+using namespace MiniParse;
+
+//---------------------------------------------------------------------------
+// Entry point
+//---------------------------------------------------------------------------
+//! Check that common subexpression elimination distinguishes literals which only differ beyond
+//! the 6th decimal place, while still eliminating repeated subexpressions with identical literals
+int main()
+{
+    try
+    {
+        const std::string source(
+            "a = x * 0.0000001;\n"
+            "b = x * 0.0000002;\n"
+            "c = x * 0.0000001;\n");
+
+        Test::ErrorHandler errorHandler;
+        SymbolTable symbolTable;
+        const auto tokens = Scanner::scanSource(source, symbolTable, errorHandler);
+
+        Arena arena;
+        auto statements = Parser::parseBlockItemList(tokens, errorHandler, arena);
+
+        TypeChecker::Environment typeEnvironment(symbolTable);
+        typeEnvironment.define<Type::Double>("x", true);
+        typeEnvironment.define<Type::Double>("a");
+        typeEnvironment.define<Type::Double>("b");
+        typeEnvironment.define<Type::Double>("c");
+        auto resolution = TypeChecker::typeCheck(statements, typeEnvironment, errorHandler);
+
+        size_t numEliminated = 0;
+        const auto optimisedStatements = Optimiser::eliminateCommonSubexpressions(statements, resolution, numEliminated);
+        const std::string printed = PrettyPrinter::print(optimisedStatements);
+        std::cout << printed << std::endl;
+        Test::check(numEliminated > 0, "Repeated subexpression x * 0.0000001 wasn't eliminated:\n" + printed);
+
+        auto makeToken = [&symbolTable](const char *name)
+        {
+            return Token(Token::Type::IDENTIFIER, name, 0, Token::LiteralValue(), symbolTable.intern(name));
+        };
+        Interpreter::Environment environment(symbolTable);
+        environment.define(makeToken("x"), 1.0);
+        for(const char *name : {"a", "b", "c"}) {
+            environment.define(makeToken(name), 0.0);
+        }
+        Interpreter::interpret(optimisedStatements, environment, resolution);
+
+        const std::vector<std::tuple<const char*, double>> expected{{"a", 1E-7}, {"b", 2E-7}, {"c", 1E-7}};
+        for(const auto &[name, value] : expected) {
+            const double result = std::get<double>(std::get<Token::LiteralValue>(environment.get(makeToken(name))));
+            std::cout << name << " = " << result << std::endl;
+            Test::check(result == value, std::string{name} + " = " + std::to_string(result)
+                        + " after common subexpression elimination:\n" + printed);
+        }
+    }
+    catch(const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
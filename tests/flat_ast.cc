@@ -0,0 +1,144 @@
+// Standard C++ includes
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Standard C includes
+#include <cstdlib>
+
+// Mini-parse includes
+#include "arena.h"
+#include "flat_ast.h"
+#include "parser.h"
+#include "pretty_printer.h"
+#include "scanner.h"
+#include "symbol_table.h"
+#include "type.h"
+#include "type_checker.h"
+
+// Test includes
+#include "common.h"
+
+using namespace MiniParse;
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+//! Snippets used by the other tests, followed by one which uses every kind of node
+const std::vector<std::string> sources{
+    "char c = 1;\n"
+    "short sh = c + 1;\n"
+    "unsigned char uc = (unsigned char)sh;\n"
+    "unsigned short us = uc * 2;\n"
+    "unsigned int ui = us + 3u;\n"
+    "float f = ui * 0.5f;\n"
+    "double d = f + x;\n"
+    "for(int i = 0; i < n; i++) {\n"
+    "    d += p[i] * (i < 2 ? f : 1.0);\n"
+    "    ui <<= 1;\n"
+    "    if(!(sh & 1) || uc > 3) {\n"
+    "        d -= exp(sqrt(d));\n"
+    "    }\n"
+    "}\n"
+    "switch(n % 4) {\n"
+    "case 0:\n"
+    "    x = d;\n"
+    "    break;\n"
+    "default:\n"
+    "    x = -c;\n"
+    "}\n",
+
+    "int i = 0;\n"
+    "do {\n"
+    "    if(k >= n) {\n"
+    "        break;\n"
+    "    }\n"
+    "    s += p[k];\n"
+    "    i++;\n"
+    "} while(i < n);\n",
+
+    "int i = 0;\n"
+    "while(i < n) {\n"
+    "    s += (k < n) ? p[k] : 0.0;\n"
+    "    i++;\n"
+    "}\n",
+
+    "a = x * 0.0000001;\n"
+    "b = x * 0.0000002;\n"
+    "c = x * 0.0000001;\n",
+
+    "const int j = 1, k, l = - -j;\n"
+    "--k;\n"
+    "k--;\n"
+    "l = - ++k;\n"
+    "print(l);\n"
+    "while(true) {\n"
+    "    if(k)\n"
+    "        continue;\n"
+    "    else\n"
+    "        break;\n"
+    "}\n"
+    "for(;;) {\n"
+    "    break;\n"
+    "}\n"
+    "for(k = 0; ; k++) {\n"
+    "}\n"
+    "x = (const double)k + 1.5f * 2u + false + 0.1 * 0.25;\n"};
+}
+
+//---------------------------------------------------------------------------
+// Entry point
+//---------------------------------------------------------------------------
+//! Check that printing statements flattened into a FlatAST::Tree gives the same output as printing the original
+//! statements and that the types resolved by the type checker are copied into the tree
+int main()
+{
+    try
+    {
+        Test::ErrorHandler errorHandler;
+        for(const auto &source : sources) {
+            SymbolTable symbolTable;
+            const auto tokens = Scanner::scanSource(source, symbolTable, errorHandler);
+
+            Arena arena;
+            const auto statements = Parser::parseBlockItemList(tokens, errorHandler, arena);
+            const std::string printed = PrettyPrinter::print(statements);
+
+            const FlatAST::Tree tree(statements);
+            const std::string flatPrinted = PrettyPrinter::print(tree);
+            Test::check(printed == flatPrinted, "Flattened statements printed as:\n" + flatPrinted + "rather than:\n" + printed);
+            std::cout << tree.getNumStatements() << " statements and " << tree.getNumExpressions()
+                      << " expressions flattened into " << tree.getNumBytes() << " bytes" << std::endl;
+        }
+
+        // Flatten first snippet after type checking
+        SymbolTable symbolTable;
+        const auto tokens = Scanner::scanSource(sources.front(), symbolTable, errorHandler);
+
+        Arena arena;
+        const auto statements = Parser::parseBlockItemList(tokens, errorHandler, arena);
+
+        TypeChecker::Environment typeEnvironment(symbolTable);
+        typeEnvironment.define<Type::Double>("x");
+        typeEnvironment.define<Type::Int32>("n", true);
+        typeEnvironment.define<Type::DoublePtr>("p", true);
+        typeEnvironment.define<Type::Exp>("exp");
+        typeEnvironment.define<Type::Sqrt>("sqrt");
+        const auto resolution = TypeChecker::typeCheck(statements, typeEnvironment, errorHandler);
+
+        const FlatAST::Tree tree(statements, resolution);
+        Test::check(PrettyPrinter::print(tree) == PrettyPrinter::print(statements),
+                    "Type checked statements flattened incorrectly");
+        for(size_t e = 0; e < tree.getNumExpressions(); e++) {
+            Test::check(tree.getType(FlatAST::ExpressionIndex{static_cast<uint32_t>(e)}) != nullptr,
+                        "Expression " + std::to_string(e) + " has no type");
+        }
+    }
+    catch(const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,130 @@
+// Standard C++ includes
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Standard C includes
+#include <cstdlib>
+
+// Mini-parse includes
+#include "arena.h"
+#include "optimiser.h"
+#include "parser.h"
+#include "pretty_printer.h"
+#include "scanner.h"
+#include "symbol_table.h"
+#include "type.h"
+#include "type_checker.h"
+
+// Test includes
+#include "common.h"
+
+using namespace MiniParse;
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+struct TestCase
+{
+    std::string name;
+    std::string source;
+
+    //! Should the read of p[k] be hoisted out of the loop
+    bool expectHoisted;
+};
+}
+
+//---------------------------------------------------------------------------
+// Entry point
+//---------------------------------------------------------------------------
+//! Check that array reads are only hoisted out of loops if they are certain to be
+//! evaluated as, otherwise, the hoisted read may be out of bounds where the original wasn't
+int main()
+{
+    try
+    {
+        const std::vector<TestCase> tests{
+            {"read in loop body",
+             "int i = 0;\n"
+             "do {\n"
+             "    s += p[k];\n"
+             "    i++;\n"
+             "} while(i < n);\n", true},
+            {"read guarded by if",
+             "for(int i = 0; i < 10; i++) {\n"
+             "    if(k < n) {\n"
+             "        s += p[k];\n"
+             "    }\n"
+             "}\n", false},
+            {"read in loop which may not run",
+             "int i = 0;\n"
+             "while(i < n) {\n"
+             "    s += p[k];\n"
+             "    i++;\n"
+             "}\n", false},
+            {"read in conditional arm",
+             "int i = 0;\n"
+             "do {\n"
+             "    s += (k < n) ? p[k] : 0.0;\n"
+             "    i++;\n"
+             "} while(i < n);\n", false},
+            {"read on right of logical operator",
+             "int i = 0;\n"
+             "do {\n"
+             "    if(k < n && p[k] > 0.0) {\n"
+             "        s += 1.0;\n"
+             "    }\n"
+             "    i++;\n"
+             "} while(i < n);\n", false},
+            {"read after break",
+             "int i = 0;\n"
+             "do {\n"
+             "    if(k >= n) {\n"
+             "        break;\n"
+             "    }\n"
+             "    s += p[k];\n"
+             "    i++;\n"
+             "} while(i < n);\n", false}};
+
+        Test::ErrorHandler errorHandler;
+        SymbolTable symbolTable;
+        for(const auto &t : tests) {
+            const auto tokens = Scanner::scanSource(t.source, symbolTable, errorHandler);
+
+            Arena arena;
+            auto statements = Parser::parseBlockItemList(tokens, errorHandler, arena);
+
+            TypeChecker::Environment typeEnvironment(symbolTable);
+            typeEnvironment.define<Type::DoublePtr>("p", true);
+            typeEnvironment.define<Type::Int32>("k", true);
+            typeEnvironment.define<Type::Int32>("n", true);
+            typeEnvironment.define<Type::Double>("s");
+            auto resolution = TypeChecker::typeCheck(statements, typeEnvironment, errorHandler);
+
+            size_t numHoisted = 0;
+            const auto hoistedStatements = Optimiser::hoistLoopInvariants(statements, typeEnvironment, resolution,
+                                                                          errorHandler, numHoisted);
+
+            // Snippets don't declare any const variables so any const declaration initialised from p[k] is a hoisted read
+            const std::string printed = PrettyPrinter::print(hoistedStatements);
+            std::istringstream printedStream(printed);
+            bool hoisted = false;
+            for(std::string line; std::getline(printedStream, line);) {
+                if(line.compare(0, 6, "const ") == 0 && line.find("p[k]") != std::string::npos) {
+                    hoisted = true;
+                }
+            }
+            std::cout << t.name << ": " << (hoisted ? "hoisted" : "not hoisted") << std::endl;
+            Test::check(hoisted == t.expectHoisted, "Loop invariant test '" + t.name + "' "
+                        + (hoisted ? "hoisted" : "didn't hoist") + " array read:\n" + printed);
+        }
+    }
+    catch(const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
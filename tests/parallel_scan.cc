@@ -0,0 +1,139 @@
+// Standard C++ includes
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Standard C includes
+#include <cstdlib>
+
+// Mini-parse includes
+#include "error_handler.h"
+#include "scanner.h"
+#include "symbol_table.h"
+#include "token_stream.h"
+
+// Test includes
+#include "common.h"
+
+using namespace MiniParse;
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+//! Lines which the source may be split between. Line comments contain substitutions, quotes and comment
+//! markers, substitutions have arguments on following lines and quotes and incomplete substitutions are errors
+const std::string block(
+    "x = $(f,\n"
+    "    $(y), // $(g, \" //\n"
+    "    z) + 1.5f;\n"
+    "// \"$(\n"
+    "$(h, 1) + \"b\";\n"
+    "q = $(\n"
+    "w = $(v) / 2u;\n");
+
+//! Source must be large enough to split into several chunks
+constexpr size_t sourceSize = 256 * 1024;
+
+//! Amount block is shifted by between scans. As this is shorter than every line of block and chunks
+//! start after the first new line past their target offset, every line of block starts a chunk
+constexpr size_t shiftStep = 5;
+
+//---------------------------------------------------------------------------
+// ErrorList
+//---------------------------------------------------------------------------
+//! Error handler which records errors so those reported by different scans can be compared
+class ErrorList : public ErrorHandler
+{
+public:
+    virtual void error(size_t line, std::string_view message) final
+    {
+        m_Errors.push_back(std::to_string(line) + ": " + std::string{message});
+    }
+
+    virtual void error(const Token &token, std::string_view message) final
+    {
+        m_Errors.push_back(std::to_string(token.line) + " at '" + std::string{token.lexeme} + "': " + std::string{message});
+    }
+
+    const std::vector<std::string> &getErrors() const{ return m_Errors; }
+
+private:
+    std::vector<std::string> m_Errors;
+};
+}
+
+//---------------------------------------------------------------------------
+// Entry point
+//---------------------------------------------------------------------------
+//! Check that scanning in parallel gives the same tokens, symbols and errors as scanning sequentially when the
+//! source is split next to every line of a block of comments, substitutions and errors, by shifting the block
+//! through the source with a comment line of increasing length
+int main()
+{
+    try
+    {
+        size_t numScans = 0;
+        for(size_t shift = 0; shift <= block.size(); shift += shiftStep) {
+            std::string source = "//" + std::string(shift, '/') + "\n";
+            while(source.size() < sourceSize) {
+                source += block;
+            }
+
+            SymbolTable symbolTable;
+            ErrorList errors;
+            const auto tokens = Scanner::scanTokenStream(source, symbolTable, errors);
+            Test::check(!errors.getErrors().empty(), "Source didn't contain any errors");
+
+            for(const size_t numThreads : {2, 3, 4}) {
+                const std::string context = " with " + std::to_string(numThreads) + " threads and shift "
+                                            + std::to_string(shift);
+
+                SymbolTable parallelSymbolTable;
+                ErrorList parallelErrors;
+                const auto parallelTokens = Scanner::scanTokenStreamParallel(source, parallelSymbolTable, parallelErrors,
+                                                                             numThreads);
+
+                // Check tokens match
+                Test::check(parallelTokens.size() == tokens.size(),
+                            std::to_string(parallelTokens.size()) + " tokens rather than "
+                            + std::to_string(tokens.size()) + context);
+                size_t lineHint = 0;
+                size_t parallelLineHint = 0;
+                for(size_t i = 0; i < tokens.size(); i++) {
+                    const auto token = tokens.getToken(tokens[i], lineHint);
+                    const auto parallelToken = parallelTokens.getToken(parallelTokens[i], parallelLineHint);
+                    // **NOTE** message is only built on failure as checking every token would otherwise be slow
+                    if(parallelToken.type != token.type || parallelToken.lexeme != token.lexeme
+                       || parallelToken.line != token.line || parallelToken.symbol != token.symbol
+                       || parallelToken.literalValue != token.literalValue)
+                    {
+                        throw std::runtime_error("Token " + std::to_string(i) + " '" + std::string{parallelToken.lexeme}
+                                                 + "' on line " + std::to_string(parallelToken.line) + " doesn't match '"
+                                                 + std::string{token.lexeme} + "' on line " + std::to_string(token.line)
+                                                 + context);
+                    }
+                }
+
+                // Check identifiers are interned in the same order
+                Test::check(parallelSymbolTable.size() == symbolTable.size(), "Different number of symbols" + context);
+                for(size_t s = 0; s < symbolTable.size(); s++) {
+                    Test::check(parallelSymbolTable.getName(static_cast<Symbol>(s)) == symbolTable.getName(static_cast<Symbol>(s)),
+                                "Symbol " + std::to_string(s) + " doesn't match" + context);
+                }
+
+                // Check errors are reported in the same order on the same lines
+                Test::check(parallelErrors.getErrors() == errors.getErrors(), "Errors don't match" + context);
+                numScans++;
+            }
+        }
+        std::cout << numScans << " parallel scans matched sequential scans" << std::endl;
+    }
+    catch(const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,141 @@
+// Standard C++ includes
+#include <atomic>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Standard C includes
+#include <cstdlib>
+
+// Mini-parse includes
+#include "arena.h"
+#include "parser.h"
+#include "scanner.h"
+#include "symbol_table.h"
+#include "type.h"
+#include "type_checker.h"
+
+// Test includes
+#include "common.h"
+
+using namespace MiniParse;
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+//! Snippet which looks up type specifiers and promotes, converts and finds common types of every numeric type
+const std::string source(
+    "char c = 1;\n"
+    "short sh = c + 1;\n"
+    "unsigned char uc = (unsigned char)sh;\n"
+    "unsigned short us = uc * 2;\n"
+    "unsigned int ui = us + 3u;\n"
+    "float f = ui * 0.5f;\n"
+    "double d = f + x;\n"
+    "for(int i = 0; i < n; i++) {\n"
+    "    d += p[i] * (i < 2 ? f : 1.0);\n"
+    "    ui <<= 1;\n"
+    "    if(!(sh & 1) || uc > 3) {\n"
+    "        d -= exp(sqrt(d));\n"
+    "    }\n"
+    "}\n"
+    "switch(n % 4) {\n"
+    "case 0:\n"
+    "    x = d;\n"
+    "    break;\n"
+    "default:\n"
+    "    x = -c;\n"
+    "}\n");
+}
+
+//---------------------------------------------------------------------------
+// Entry point
+//---------------------------------------------------------------------------
+//! Scan, parse and type check the same snippet repeatedly on several threads which start together so, when
+//! built with 'make tsan', ThreadSanitizer reports any data races on the type singletons or other shared state.
+//! The number of threads and repetitions can be given on the command line
+int main(int argc, char **argv)
+{
+    try
+    {
+        const size_t numThreads = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 8;
+        const size_t numRepeats = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 200;
+
+        // Intern globals in shared table which each thread's table is layered over
+        SymbolTable globalSymbolTable;
+        for(const char *name : {"x", "n", "p", "exp", "sqrt"}) {
+            globalSymbolTable.intern(name);
+        }
+
+        std::atomic<bool> start{false};
+        std::vector<size_t> numResolvedTypes(numThreads, 0);
+        std::vector<std::exception_ptr> exceptions(numThreads);
+        std::vector<std::thread> threads;
+        for(size_t t = 0; t < numThreads; t++) {
+            threads.emplace_back(
+                [t, numRepeats, &start, &globalSymbolTable, &numResolvedTypes, &exceptions]()
+                {
+                    try
+                    {
+                        while(!start.load(std::memory_order_acquire)) {
+                            std::this_thread::yield();
+                        }
+
+                        Test::ErrorHandler errorHandler;
+                        for(size_t r = 0; r < numRepeats; r++) {
+                            SymbolTable symbolTable(&globalSymbolTable);
+                            const auto tokens = Scanner::scanSource(source, symbolTable, errorHandler);
+
+                            Arena arena;
+                            auto statements = Parser::parseBlockItemList(tokens, errorHandler, arena);
+
+                            TypeChecker::Environment typeEnvironment(symbolTable);
+                            typeEnvironment.define<Type::Double>("x");
+                            typeEnvironment.define<Type::Int32>("n", true);
+                            typeEnvironment.define<Type::DoublePtr>("p", true);
+                            typeEnvironment.define<Type::Exp>("exp");
+                            typeEnvironment.define<Type::Sqrt>("sqrt");
+                            const auto resolution = TypeChecker::typeCheck(statements, typeEnvironment, errorHandler);
+
+                            // Every repetition should resolve the same number of expressions
+                            const size_t numTypes = resolution.types.size();
+                            Test::check(r == 0 || numTypes == numResolvedTypes[t],
+                                        "Thread " + std::to_string(t) + " resolved " + std::to_string(numTypes)
+                                        + " types rather than " + std::to_string(numResolvedTypes[t]));
+                            numResolvedTypes[t] = numTypes;
+                        }
+                    }
+                    catch(...) {
+                        exceptions[t] = std::current_exception();
+                    }
+                });
+        }
+
+        // Release threads together, wait for them and rethrow first error
+        start.store(true, std::memory_order_release);
+        for(auto &t : threads) {
+            t.join();
+        }
+        for(const auto &e : exceptions) {
+            if(e) {
+                std::rethrow_exception(e);
+            }
+        }
+
+        for(size_t t = 1; t < numThreads; t++) {
+            Test::check(numResolvedTypes[t] == numResolvedTypes[0],
+                        "Threads 0 and " + std::to_string(t) + " resolved different numbers of types");
+        }
+        std::cout << numThreads << " threads type checked " << numRepeats << " times, resolving "
+                  << numResolvedTypes[0] << " types each time" << std::endl;
+    }
+    catch(const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
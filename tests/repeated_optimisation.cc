@@ -0,0 +1,115 @@
+// Standard C++ includes
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+// Standard C includes
+#include <cstdlib>
+
+// Mini-parse includes
+#include "arena.h"
+#include "interpreter.h"
+#include "optimiser.h"
+#include "parser.h"
+#include "pretty_printer.h"
+#include "scanner.h"
+#include "symbol_table.h"
+#include "type.h"
+#include "type_checker.h"
+
+// Test includes
+#include "common.h"
+
+using namespace MiniParse;
+
+//---------------------------------------------------------------------------
+// Entry point
+//---------------------------------------------------------------------------
+//! Optimise statements repeatedly, freeing each generation once the next has been built, and check they still give
+//! the same results. Resolution is keyed by node address so nodes allocated where freed nodes were must not inherit
+//! their types, slots or switch tables. The number of generations can be given on the command line
+int main(int argc, char **argv)
+{
+    try
+    {
+        const size_t numGenerations = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 20;
+        const std::string source(
+            "switch(x) {\n"
+            "case 1:\n"
+            "    a = 10;\n"
+            "    break;\n"
+            "case 2:\n"
+            "    a = 20;\n"
+            "    break;\n"
+            "default:\n"
+            "    a = 30;\n"
+            "}\n"
+            "switch(x + 1) {\n"
+            "case 5:\n"
+            "    b = 60;\n"
+            "    break;\n"
+            "case 3:\n"
+            "    b = 99;\n"
+            "    break;\n"
+            "}\n"
+            "for(int i = 0; i < x; i++) {\n"
+            "    switch(i) {\n"
+            "    case 0:\n"
+            "        c += 1;\n"
+            "        break;\n"
+            "    default:\n"
+            "        c += 100;\n"
+            "    }\n"
+            "}\n");
+
+        Test::ErrorHandler errorHandler;
+        SymbolTable symbolTable;
+        const auto tokens = Scanner::scanSource(source, symbolTable, errorHandler);
+
+        Arena arena;
+        auto statements = Parser::parseBlockItemList(tokens, errorHandler, arena);
+
+        TypeChecker::Environment typeEnvironment(symbolTable);
+        typeEnvironment.define<Type::Int32>("x", true);
+        typeEnvironment.define<Type::Int32>("a");
+        typeEnvironment.define<Type::Int32>("b");
+        typeEnvironment.define<Type::Int32>("c");
+        auto resolution = TypeChecker::typeCheck(statements, typeEnvironment, errorHandler);
+
+        auto makeToken = [&symbolTable](const char *name)
+        {
+            return Token(Token::Type::IDENTIFIER, name, 0, Token::LiteralValue(), symbolTable.intern(name));
+        };
+        const std::vector<std::tuple<const char*, int32_t>> expected{{"a", 20}, {"b", 99}, {"c", 101}};
+
+        // Folding x changes the nodes allocated so freed nodes' addresses are reused by different nodes in later generations
+        const Optimiser::ConstantValues constantValues{{"x", int32_t{2}}};
+        Statement::StatementList optimisedStatements = Optimiser::optimise(statements, resolution, constantValues);
+        for(size_t g = 0; g < numGenerations; g++) {
+            // Replace previous generation, freeing its nodes
+            optimisedStatements = Optimiser::optimise(optimisedStatements, resolution, constantValues);
+
+            Interpreter::Environment environment(symbolTable);
+            environment.define(makeToken("x"), int32_t{2});
+            for(const auto &e : expected) {
+                environment.define(makeToken(std::get<0>(e)), int32_t{0});
+            }
+            Interpreter::interpret(optimisedStatements, environment, resolution);
+
+            for(const auto &[name, value] : expected) {
+                const int32_t result = std::get<int32_t>(std::get<Token::LiteralValue>(environment.get(makeToken(name))));
+                Test::check(result == value, std::string{name} + " = " + std::to_string(result) + " rather than "
+                            + std::to_string(value) + " after " + std::to_string(g + 2) + " generations of optimisation:\n"
+                            + PrettyPrinter::print(optimisedStatements));
+            }
+        }
+        std::cout << numGenerations << " generations of optimisation gave the same results" << std::endl;
+    }
+    catch(const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
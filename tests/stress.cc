@@ -0,0 +1,82 @@
+// Standard C++ includes
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+// Standard C includes
+#include <cstdlib>
+
+// Mini-parse includes
+#include "arena.h"
+#include "interpreter.h"
+#include "parser.h"
+#include "scanner.h"
+#include "symbol_table.h"
+#include "type.h"
+#include "type_checker.h"
+
+// Test includes
+#include "common.h"
+
+using namespace MiniParse;
+
+//---------------------------------------------------------------------------
+// Entry point
+//---------------------------------------------------------------------------
+//! Build expressions nested depth deep (1000000 or the number given on the command line) or with chains
+//! of depth operators which would overflow the stack if they were parsed, type checked, evaluated or destroyed recursively
+int main(int argc, char **argv)
+{
+    try
+    {
+        const size_t depth = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+        auto repeat = [depth](const std::string &s)
+        {
+            std::string repeated;
+            repeated.reserve(s.size() * depth);
+            for(size_t i = 0; i < depth; i++) {
+                repeated += s;
+            }
+            return repeated;
+        };
+        const std::vector<std::tuple<std::string, std::string, int32_t>> tests{
+            {"nested parentheses", repeat("(") + "x" + repeat(")"), 3},
+            {"nested unary operators", repeat("-(") + "x" + repeat(")"), (depth % 2) ? -3 : 3},
+            {"binary operator chain", repeat("x + ") + "x", static_cast<int32_t>(3 * (depth + 1))},
+            {"conditional chain", repeat("0 ? 0 : ") + "x", 3},
+            {"assignment chain", repeat("result = ") + "x", 3}};
+
+        Test::ErrorHandler errorHandler;
+        SymbolTable symbolTable;
+        const Token resultToken(Token::Type::IDENTIFIER, "result", 0, Token::LiteralValue(), symbolTable.intern("result"));
+        for(const auto &[name, expression, expected] : tests) {
+            const std::string source = "result = " + expression + ";\n";
+            const auto tokens = Scanner::scanSource(source, symbolTable, errorHandler);
+
+            Arena arena;
+            auto statements = Parser::parseBlockItemList(tokens, errorHandler, arena);
+
+            TypeChecker::Environment typeEnvironment(symbolTable);
+            typeEnvironment.define<Type::Int32>("x", true);
+            typeEnvironment.define<Type::Int32>("result");
+            const auto resolution = TypeChecker::typeCheck(statements, typeEnvironment, errorHandler);
+
+            Interpreter::Environment environment(symbolTable);
+            environment.define(Token(Token::Type::IDENTIFIER, "x", 0, Token::LiteralValue(), symbolTable.intern("x")), int32_t{3});
+            environment.define(resultToken, int32_t{0});
+            Interpreter::interpret(statements, environment, resolution);
+
+            const int32_t result = std::get<int32_t>(std::get<Token::LiteralValue>(environment.get(resultToken)));
+            std::cout << name << " " << depth << " deep = " << result << std::endl;
+            Test::check(result == expected, "Stress test '" + name + "' gave " + std::to_string(result)
+                        + " rather than " + std::to_string(expected));
+        }
+    }
+    catch(const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
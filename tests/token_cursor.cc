@@ -0,0 +1,77 @@
+// Standard C++ includes
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Standard C includes
+#include <cstdlib>
+
+// Mini-parse includes
+#include "arena.h"
+#include "parser.h"
+#include "pretty_printer.h"
+#include "scanner.h"
+#include "symbol_table.h"
+
+// Test includes
+#include "common.h"
+
+using namespace MiniParse;
+
+//---------------------------------------------------------------------------
+// Entry point
+//---------------------------------------------------------------------------
+//! Check that TokenCursor gives the same tokens and statements as scanning the whole source, when
+//! $(name, substitutions, which are scanned as two tokens, fall at every position around chunk boundaries
+int main()
+{
+    try
+    {
+        Test::ErrorHandler errorHandler;
+        size_t numSources = 0;
+        for(const bool shift : {false, true}) {
+            for(size_t numLines = 0; numLines <= 140; numLines++) {
+                // Prefix of 2 tokens per line, shifted by 3 tokens to reach odd positions, followed by substitutions
+                std::string source = shift ? "-x;\n" : "";
+                for(size_t i = 0; i < numLines; i++) {
+                    source += "x;\n";
+                }
+                for(size_t i = 0; i < 4; i++) {
+                    source += "$(f, x);\n";
+                }
+
+                SymbolTable symbolTable;
+                const auto tokens = Scanner::scanSource(source, symbolTable, errorHandler);
+
+                // Check cursor gives same tokens
+                const std::string context = " with " + std::to_string(numLines) + " lines" + (shift ? " shifted" : "");
+                {
+                    Scanner::TokenCursor cursor(source, symbolTable, errorHandler);
+                    for(size_t i = 0; i < tokens.size(); i++) {
+                        const auto &token = cursor[i];
+                        Test::check(token.type == tokens[i].type && token.lexeme == tokens[i].lexeme
+                                    && token.line == tokens[i].line && token.symbol == tokens[i].symbol,
+                                    "Token " + std::to_string(i) + " '" + std::string{token.lexeme} + "' from cursor doesn't match '"
+                                    + std::string{tokens[i].lexeme} + "'" + context);
+                    }
+                }
+
+                // Check parsing from cursor gives same statements
+                Arena arena;
+                const auto statements = Parser::parseBlockItemList(tokens, errorHandler, arena);
+                Scanner::TokenCursor cursor(source, symbolTable, errorHandler);
+                Arena cursorArena;
+                const auto cursorStatements = Parser::parseBlockItemList(cursor, errorHandler, cursorArena);
+                Test::check(PrettyPrinter::print(statements) == PrettyPrinter::print(cursorStatements),
+                            "Statements parsed from cursor don't match" + context);
+                numSources++;
+            }
+        }
+        std::cout << numSources << " sources scanned and parsed through cursor" << std::endl;
+    }
+    catch(const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}